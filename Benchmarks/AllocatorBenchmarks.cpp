@@ -0,0 +1,195 @@
+#include "Benchmark.h"
+#include "Core/FrameArena.h"
+#include "Core/LinearAllocator.h"
+#include "Core/MemoryHelperFuncs.h"
+#include "Core/PoolAllocator.h"
+#include "Graphics/API/DX12/DescriptorFreeList.h"
+#include <array>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+namespace {
+    //Roughly the size of a scene node, the common pooled object
+    struct PooledObject {
+        std::array<float, 48> Data{};
+    };
+
+    //Fills a vector of GetArg() elements without reserving, the transient CPU data pattern
+    void StdVectorPushBack(State& state) {
+        const auto count = static_cast<int>(state.GetArg());
+
+        for (auto _ : state) {
+            std::vector<int> values;
+            DoNotOptimize(values);
+
+            for (int i = 0; i < count; ++i) {
+                values.push_back(i);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    void FrameVectorPushBack(State& state) {
+        const auto count = static_cast<int>(state.GetArg());
+
+        for (auto _ : state) {
+            FrameArena::Scope scope(FrameArena::Get());
+            FrameVector<int> values;
+            DoNotOptimize(values);
+
+            for (int i = 0; i < count; ++i) {
+                values.push_back(i);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //Many small blocks per frame, released all at once
+    void NewDeleteSmallBlocks(State& state) {
+        constexpr size_t NumBlocks = 1024;
+        std::vector<std::byte*> blocks(NumBlocks);
+
+        for (auto _ : state) {
+            for (auto& block : blocks) {
+                block = new std::byte[64];
+                DoNotOptimize(block);
+            }
+            for (const auto block : blocks) {
+                delete[] block;
+            }
+        }
+
+        state.SetItemsPerIteration(NumBlocks);
+    }
+
+    void FrameArenaSmallBlocks(State& state) {
+        constexpr size_t NumBlocks = 1024;
+        auto& arena = FrameArena::Get();
+
+        for (auto _ : state) {
+            FrameArena::Scope scope(arena);
+
+            for (size_t i = 0; i < NumBlocks; ++i) {
+                auto block = arena.Allocate(64, 16);
+                DoNotOptimize(block);
+            }
+        }
+
+        state.SetItemsPerIteration(NumBlocks);
+    }
+
+    //Creates GetArg() objects and releases them again. Every make_shared goes through the tracked
+    //operator new, configure with CYREX_MEMORY_TRACKING=OFF to compare the pool against the plain heap.
+    void MakeSharedObjects(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        std::vector<std::shared_ptr<PooledObject>> objects(count);
+
+        for (auto _ : state) {
+            for (auto& object : objects) {
+                object = std::make_shared<PooledObject>();
+            }
+            for (auto& object : objects) {
+                object.reset();
+            }
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    void MakePooledObjects(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        std::vector<std::shared_ptr<PooledObject>> objects(count);
+
+        for (auto _ : state) {
+            for (auto& object : objects) {
+                object = MakePooled<PooledObject>();
+            }
+            for (auto& object : objects) {
+                object.reset();
+            }
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //Steady state of a descriptor heap page: the oldest allocation is freed and a new one of
+    //random size is made, so the free list fragments and merges like it does at runtime
+    void DescriptorFreeListAllocateFree(State& state) {
+        constexpr uint32_t NumDescriptors = 1024;
+        constexpr size_t NumLive          = 192;
+
+        DescriptorFreeList freeList(NumDescriptors);
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> sizeDist(1, 8);
+
+        std::deque<std::pair<uint32_t, uint32_t>> live;
+
+        while (live.size() < NumLive) {
+            const auto size = sizeDist(rng);
+            live.emplace_back(*freeList.Allocate(size), size);
+        }
+
+        //Sizes are drawn up front so the random number generator is not measured
+        std::vector<uint32_t> sizes(4096);
+        for (auto& size : sizes) {
+            size = sizeDist(rng);
+        }
+
+        size_t next = 0;
+
+        for (auto _ : state) {
+            const auto [offset, size] = live.front();
+            live.pop_front();
+            freeList.Free(offset, size);
+
+            const auto newSize   = sizes[next++ & (sizes.size() - 1)];
+            const auto newOffset = freeList.Allocate(newSize);
+
+            live.emplace_back(newOffset.value_or(0), newOffset ? newSize : 0);
+            DoNotOptimize(newOffset);
+        }
+    }
+
+    //Upload buffer page: constant buffers and texture rows of mixed alignment until the page is full
+    void LinearAllocatorUploadPage(State& state) {
+        constexpr std::array<std::pair<size_t, size_t>, 4> Requests{ {
+            { 256,  256 },
+            { 64,   256 },
+            { 4096, 512 },
+            { 1000, 16  },
+        } };
+
+        LinearAllocator allocator(Cyrex::_2MB);
+        size_t next = 0;
+
+        for (auto _ : state) {
+            const auto [size, alignment] = Requests[next++ & (Requests.size() - 1)];
+
+            if (!allocator.HasSpace(size, alignment)) [[unlikely]] {
+                allocator.Reset();
+            }
+
+            auto offset = allocator.Allocate(size, alignment);
+            DoNotOptimize(offset);
+        }
+    }
+}
+
+CRX_BENCHMARK_ARGS(StdVectorPushBack, 64, 4096);
+CRX_BENCHMARK_ARGS(FrameVectorPushBack, 64, 4096);
+CRX_BENCHMARK(NewDeleteSmallBlocks);
+CRX_BENCHMARK(FrameArenaSmallBlocks);
+CRX_BENCHMARK_ARGS(MakeSharedObjects, 1000, 100000);
+CRX_BENCHMARK_ARGS(MakePooledObjects, 1000, 100000);
+CRX_BENCHMARK(DescriptorFreeListAllocateFree);
+CRX_BENCHMARK(LinearAllocatorUploadPage);
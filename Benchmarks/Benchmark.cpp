@@ -0,0 +1,234 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+using namespace Cyrex::Benchmark;
+
+namespace {
+    struct Registration {
+        std::string Name;
+        Function Func;
+        std::vector<int64_t> Args;
+    };
+
+    std::vector<Registration>& GetRegistry() {
+        static std::vector<Registration> registry;
+        return registry;
+    }
+
+    //Samples shorter than this are dominated by timer resolution, no matter what the options say
+    constexpr double MinTimedNanoseconds = 100'000.0;
+    constexpr uint64_t MaxIterations     = 1'000'000'000;
+
+    double RunOnce(Function function, uint64_t iterations, int64_t arg, uint64_t& itemsPerIteration, Result& result) {
+        State state(iterations, arg);
+        function(state);
+
+        if (state.IsSkipped()) {
+            result.Message = state.GetMessage();
+            result.Failed  = state.HasFailed();
+        }
+
+        itemsPerIteration = state.GetItemsPerIteration();
+        return state.GetElapsedNanoseconds();
+    }
+
+    double Median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+
+        const auto middle = values.size() / 2;
+        return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) * 0.5;
+    }
+
+    Result Run(const std::string& name, Function function, int64_t arg, const Options& options) {
+        Result result{};
+        result.Name = name;
+
+        uint64_t itemsPerIteration = 0;
+
+        const auto warmupNs = options.WarmupSeconds * 1e9;
+        const auto targetNs = std::max(options.MinSampleSeconds * 1e9, MinTimedNanoseconds);
+
+        //Warm up caches, branch predictors and the CPU clock while doubling the iteration
+        //count, then scale the count so one sample takes about targetNs
+        uint64_t iterations = 1;
+        double elapsed      = 0.0;
+        double warmedUp     = 0.0;
+
+        while (true) {
+            elapsed   = RunOnce(function, iterations, arg, itemsPerIteration, result);
+            warmedUp += elapsed;
+
+            if (!result.Message.empty()) {
+                return result;
+            }
+
+            if ((warmedUp >= warmupNs && elapsed >= MinTimedNanoseconds) || iterations >= MaxIterations) {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        const auto nsPerIteration = std::max(elapsed / static_cast<double>(iterations), 0.1);
+        iterations = std::clamp<uint64_t>(static_cast<uint64_t>(std::ceil(targetNs / nsPerIteration)), 1, MaxIterations);
+
+        std::vector<double> samples;
+        samples.reserve(options.NumSamples);
+
+        for (uint32_t i = 0; i < options.NumSamples; ++i) {
+            samples.push_back(RunOnce(function, iterations, arg, itemsPerIteration, result) / static_cast<double>(iterations));
+        }
+
+        result.Iterations        = iterations;
+        result.NumSamples        = options.NumSamples;
+        result.MedianNanoseconds = Median(samples);
+        result.MinNanoseconds    = *std::min_element(samples.begin(), samples.end());
+
+        double sum = 0.0;
+        for (auto& sample : samples) {
+            sum   += sample;
+            sample = std::abs(sample - result.MedianNanoseconds);
+        }
+
+        result.MeanNanoseconds = sum / static_cast<double>(samples.size());
+        result.MadNanoseconds  = Median(samples);
+        result.ItemsPerSecond  = itemsPerIteration ? itemsPerIteration * 1e9 / result.MedianNanoseconds : 0.0;
+
+        return result;
+    }
+
+    void PrintResult(const Result& result) {
+        if (!result.Message.empty()) {
+            std::printf("%-52s %s\n", result.Name.c_str(), result.Message.c_str());
+            std::fflush(stdout);
+            return;
+        }
+
+        const auto madPercent = result.MedianNanoseconds > 0.0 ? result.MadNanoseconds / result.MedianNanoseconds * 100.0 : 0.0;
+
+        std::printf("%-52s %14.2f ns %7.2f %% %14.2f ns %12llu",
+            result.Name.c_str(),
+            result.MedianNanoseconds,
+            madPercent,
+            result.MinNanoseconds,
+            static_cast<unsigned long long>(result.Iterations));
+
+        if (result.ItemsPerSecond > 0.0) {
+            std::printf(" %10.2f M items/s", result.ItemsPerSecond / 1e6);
+        }
+
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    void WriteEscaped(std::ofstream& file, const std::string& text) {
+        for (const auto c : text) {
+            if (c == '"' || c == '\\') {
+                file << '\\';
+            }
+            file << c;
+        }
+    }
+}
+
+void Cyrex::Benchmark::Detail::UseCharPointer(const volatile char*) noexcept {}
+
+int Cyrex::Benchmark::Register(const char* name, Function function, std::vector<int64_t> args) {
+    GetRegistry().push_back({ name, function, std::move(args) });
+    return 0;
+}
+
+size_t Cyrex::Benchmark::RunBenchmarks(const Options& options, std::vector<Result>& results) {
+    auto registry = GetRegistry();
+
+    std::sort(registry.begin(), registry.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.Name < rhs.Name;
+    });
+
+    if (!options.ListOnly) {
+        std::printf("%-52s %17s %9s %17s %12s\n", "Benchmark", "Median", "MAD", "Min", "Iterations");
+        std::printf("%s\n", std::string(112, '-').c_str());
+    }
+
+    size_t numRun = 0;
+
+    for (const auto& registration : registry) {
+        std::vector<int64_t> args = registration.Args;
+        const bool hasArgs        = !args.empty();
+
+        if (!hasArgs) {
+            args.push_back(0);
+        }
+
+        for (const auto arg : args) {
+            const auto name = hasArgs ? registration.Name + "/" + std::to_string(arg) : registration.Name;
+
+            if (!options.Filter.empty() && name.find(options.Filter) == std::string::npos) {
+                continue;
+            }
+
+            numRun++;
+
+            if (options.ListOnly) {
+                std::printf("%s\n", name.c_str());
+                continue;
+            }
+
+            results.push_back(Run(name, registration.Func, arg, options));
+            PrintResult(results.back());
+        }
+    }
+
+    return numRun;
+}
+
+bool Cyrex::Benchmark::WriteJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file) {
+        return false;
+    }
+
+    char date[64]{};
+    const auto now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    file.precision(17);
+    file << "{\n  \"context\": {\n"
+         << "    \"date\": \"" << date << "\",\n"
+         << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+         << "    \"build_type\": \"release\"\n"
+#else
+         << "    \"build_type\": \"debug\"\n"
+#endif
+         << "  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+
+        file << (i ? ",\n" : "\n") << "    {\"name\": \"";
+        WriteEscaped(file, result.Name);
+        file << "\", \"iterations\": " << result.Iterations
+             << ", \"samples\": "         << result.NumSamples
+             << ", \"median_ns\": "       << result.MedianNanoseconds
+             << ", \"mad_ns\": "          << result.MadNanoseconds
+             << ", \"min_ns\": "          << result.MinNanoseconds
+             << ", \"mean_ns\": "         << result.MeanNanoseconds
+             << ", \"items_per_second\": " << result.ItemsPerSecond;
+
+        if (!result.Message.empty()) {
+            file << ", \"message\": \"";
+            WriteEscaped(file, result.Message);
+            file << "\"";
+        }
+        file << "}";
+    }
+
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Cyrex::Benchmark {
+    namespace Detail {
+        void UseCharPointer(const volatile char* ptr) noexcept;
+    }
+
+    //Makes the compiler assume value is read and may have been written, so the
+    //computation producing it is not optimized away or hoisted out of the loop
+    template<class T>
+    inline void DoNotOptimize(T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : "+m"(value) : : "memory");
+#else
+        Detail::UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+        _ReadWriteBarrier();
+#endif
+    }
+
+    template<class T>
+    inline void DoNotOptimize(const T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "m"(value) : "memory");
+#else
+        Detail::UseCharPointer(&reinterpret_cast<const volatile char&>(value));
+        _ReadWriteBarrier();
+#endif
+    }
+
+    //Forces every pending write to memory to be treated as observable
+    inline void ClobberMemory() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+    //Passed to every benchmark. The timed region is the range-for loop over the state:
+    //    for (auto _ : state) { ... }
+    //Benchmarks that run their own threads call StartTimer/StopTimer around the
+    //work and do GetIterations() operations in total.
+    class State {
+    public:
+        class Iterator {
+        public:
+            Iterator(State* state, uint64_t remaining) noexcept : m_state(state), m_remaining(remaining) {}
+
+            [[nodiscard]] int operator*() const noexcept { return 0; }
+            Iterator& operator++() noexcept { --m_remaining; return *this; }
+
+            [[nodiscard]] bool operator!=(const Iterator&) noexcept {
+                if (m_remaining != 0) [[likely]] {
+                    return true;
+                }
+                m_state->StopTimer();
+                return false;
+            }
+        private:
+            State* m_state;
+            uint64_t m_remaining;
+        };
+
+        State(uint64_t iterations, int64_t arg) noexcept
+            :
+            m_iterations(iterations),
+            m_arg(arg)
+        {}
+
+        [[nodiscard]] Iterator begin() noexcept { StartTimer(); return { this, m_iterations }; }
+        [[nodiscard]] Iterator end() noexcept { return { this, 0 }; }
+
+        void StartTimer() noexcept { m_start = Clock::now(); }
+        void StopTimer() noexcept { m_elapsed += Clock::now() - m_start; }
+
+        [[nodiscard]] uint64_t GetIterations() const noexcept { return m_iterations; }
+        [[nodiscard]] int64_t GetArg() const noexcept { return m_arg; }
+
+        //Reported as items per second, e.g. nodes visited by one iteration
+        void SetItemsPerIteration(uint64_t items) noexcept { m_itemsPerIteration = items; }
+        [[nodiscard]] uint64_t GetItemsPerIteration() const noexcept { return m_itemsPerIteration; }
+
+        [[nodiscard]] double GetElapsedNanoseconds() const noexcept {
+            return std::chrono::duration<double, std::nano>(m_elapsed).count();
+        }
+
+        //Called before the timed loop, the benchmark then returns without running it.
+        //Used when the CPU lacks the instruction set a kernel needs.
+        void SkipWithMessage(std::string message) { m_message = std::move(message); }
+
+        //Verifies the setup, e.g. that a SIMD kernel matches its scalar reference. On failure
+        //the benchmark is skipped and the run exits with an error, so ctest catches it.
+        bool Check(bool condition, const char* what) {
+            if (!condition) {
+                m_message = std::string("failed check: ") + what;
+                m_failed  = true;
+            }
+            return condition;
+        }
+
+        [[nodiscard]] bool IsSkipped() const noexcept { return !m_message.empty(); }
+        [[nodiscard]] bool HasFailed() const noexcept { return m_failed; }
+        [[nodiscard]] const std::string& GetMessage() const noexcept { return m_message; }
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        uint64_t m_iterations;
+        int64_t m_arg;
+        uint64_t m_itemsPerIteration{ 0 };
+
+        std::string m_message;
+        bool m_failed{ false };
+
+        Clock::time_point m_start;
+        Clock::duration m_elapsed{ 0 };
+    };
+
+    using Function = void(*)(State&);
+
+    struct Options {
+        std::string Filter;
+        std::string JsonPath;
+        double WarmupSeconds{ 0.05 };
+        double MinSampleSeconds{ 0.01 };
+        uint32_t NumSamples{ 21 };
+        bool ListOnly{ false };
+    };
+
+    struct Result {
+        std::string Name;
+        uint64_t Iterations;
+        uint32_t NumSamples;
+        double MedianNanoseconds;
+        //Median absolute deviation of the samples, robust against outliers unlike the standard deviation
+        double MadNanoseconds;
+        double MinNanoseconds;
+        double MeanNanoseconds;
+        double ItemsPerSecond;
+        //Why the benchmark did not run
+        std::string Message;
+        bool Failed{ false };
+    };
+
+    //Registers a benchmark that runs once per argument, or once without one if args is empty
+    int Register(const char* name, Function function, std::vector<int64_t> args = {});
+
+    //Returns the number of benchmarks that were run, results of failed checks included
+    size_t RunBenchmarks(const Options& options, std::vector<Result>& results);
+    bool WriteJson(const std::string& path, const std::vector<Result>& results);
+}
+
+#define CRX_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define CRX_BENCHMARK_CONCAT(a, b) CRX_BENCHMARK_CONCAT_INNER(a, b)
+
+#define CRX_BENCHMARK(function) \
+    static const int CRX_BENCHMARK_CONCAT(crxBenchmark, __LINE__) = ::Cyrex::Benchmark::Register(#function, function)
+
+#define CRX_BENCHMARK_ARGS(function, ...) \
+    static const int CRX_BENCHMARK_CONCAT(crxBenchmark, __LINE__) = ::Cyrex::Benchmark::Register(#function, function, { __VA_ARGS__ })
@@ -0,0 +1,175 @@
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include "MathChecks.h"
+#include "Core/Math/CullingKernels.h"
+#include "Core/Math/Frustum.h"
+#include "Core/Math/Matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+namespace {
+    Frustum MakeFrustum() {
+        const auto view       = Matrix::CreateLookAtLH(Vector3(0.0f, 10.0f, -250.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3::Up);
+        const auto projection = Matrix::CreatePerspectiveFieldOfViewLH(MathConstants::PI_DIV2, 16.0f / 9.0f, 0.1f, 1000.0f);
+
+        return Frustum(view * projection);
+    }
+
+    //Volumes around the camera in every direction, roughly a quarter of them in view
+    struct Bounds {
+        Vector3SoA Centers;
+        Vector3SoA Extents;
+        std::vector<float> Radii;
+    };
+
+    Bounds MakeBounds(size_t count) {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> position(-1200.0f, 1200.0f);
+        std::uniform_real_distribution<float> size(0.5f, 20.0f);
+
+        Bounds bounds{ Vector3SoA(count), Vector3SoA(count), std::vector<float>(count) };
+
+        for (size_t i = 0; i < count; ++i) {
+            const Vector3 extents(size(rng), size(rng), size(rng));
+
+            bounds.Centers.Set(i, Vector3(position(rng), position(rng) * 0.25f, position(rng)));
+            bounds.Extents.Set(i, extents);
+            bounds.Radii[i] = extents.Length();
+        }
+        return bounds;
+    }
+
+    bool IsVisible(const std::vector<uint64_t>& visible, size_t i) {
+        return (visible[i / 64] >> (i % 64)) & 1;
+    }
+
+    //How close the volume comes to crossing a plane, where the rounding of the kernels may
+    //differ. A box's radius is its extents projected onto the plane's normal.
+    float DistanceToBoundary(const Frustum& frustum, const Vector3& center, const Vector3& extents, float radius) {
+        float distance = INFINITY;
+
+        for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+            const auto& plane = frustum.GetPlane(p);
+            const float projectedRadius = radius + std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+
+            distance = std::min(distance, std::abs(plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w + projectedRadius));
+        }
+        return distance;
+    }
+
+    template<typename Cull, typename Reference>
+    void CullVolumes(State& state, Cull cull, Reference reference) {
+        const auto count  = static_cast<size_t>(state.GetArg());
+        const auto bounds = MakeBounds(count);
+        const auto frustum = MakeFrustum();
+
+        //Set bits past the count have to be cleared by the kernel
+        std::vector<uint64_t> visible(CullingKernels::VisibilityWords(count), ~0ull);
+        cull(frustum, bounds, visible.data());
+
+        size_t numVisible = 0;
+
+        for (size_t i = 0; i < visible.size() * 64; ++i) {
+            if (i >= count) {
+                if (!state.Check(!IsVisible(visible, i), "clears the bits past the count")) {
+                    return;
+                }
+                continue;
+            }
+
+            float boundaryDistance = 0.0f;
+            const bool isVisible = reference(frustum, bounds, i, boundaryDistance);
+
+            if (!state.Check(IsVisible(visible, i) == isVisible || boundaryDistance < 1e-3f, "matches the Frustum test")) {
+                return;
+            }
+            numVisible += isVisible;
+        }
+
+        if (!state.Check(numVisible > 0 && numVisible < count, "culls some of the volumes")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            cull(frustum, bounds, visible.data());
+            ClobberMemory();
+        }
+
+        //1000 M items/s is one volume per nanosecond
+        state.SetItemsPerIteration(count);
+    }
+
+    using BoxKernel    = void(*)(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept;
+    using SphereKernel = void(*)(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept;
+
+    template<BoxKernel Kernel, IsaLevel KernelIsa>
+    void CullBoxes(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        CullVolumes(state,
+            [](const Frustum& frustum, const Bounds& bounds, uint64_t* visible) { Kernel(frustum, bounds.Centers, bounds.Extents, visible); },
+            [](const Frustum& frustum, const Bounds& bounds, size_t i, float& boundaryDistance) {
+                const auto center  = bounds.Centers.Get(i);
+                const auto extents = bounds.Extents.Get(i);
+
+                boundaryDistance = DistanceToBoundary(frustum, center, extents, 0.0f);
+                return frustum.IntersectsBox(center, extents);
+            });
+    }
+
+    template<SphereKernel Kernel, IsaLevel KernelIsa>
+    void CullSpheres(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        CullVolumes(state,
+            [](const Frustum& frustum, const Bounds& bounds, uint64_t* visible) { Kernel(frustum, bounds.Centers, bounds.Radii.data(), visible); },
+            [](const Frustum& frustum, const Bounds& bounds, size_t i, float& boundaryDistance) {
+                boundaryDistance = DistanceToBoundary(frustum, bounds.Centers.Get(i), Vector3(), bounds.Radii[i]);
+                return frustum.IntersectsSphere(bounds.Centers.Get(i), bounds.Radii[i]);
+            });
+    }
+
+    //Through the free functions, at the level CpuDispatch picked or --isa forced
+    void CullBoxesDispatched(State& state)   { CullBoxes<Math::CullBoxes, IsaLevel::Scalar>(state); }
+    void CullSpheresDispatched(State& state) { CullSpheres<Math::CullSpheres, IsaLevel::Scalar>(state); }
+
+    using namespace CullingKernels;
+
+    void CullBoxesScalar(State& state)   { CullBoxes<CullBoxes_Scalar, IsaLevel::Scalar>(state); }
+    void CullSpheresScalar(State& state) { CullSpheres<CullSpheres_Scalar, IsaLevel::Scalar>(state); }
+
+#if CRX_SIMD_X86
+    void CullBoxesSSE(State& state)   { CullBoxes<CullBoxes_SSE, IsaLevel::SSE>(state); }
+    void CullSpheresSSE(State& state) { CullSpheres<CullSpheres_SSE, IsaLevel::SSE>(state); }
+
+    void CullBoxesAVX2(State& state)   { CullBoxes<CullBoxes_AVX2, IsaLevel::AVX2>(state); }
+    void CullSpheresAVX2(State& state) { CullSpheres<CullSpheres_AVX2, IsaLevel::AVX2>(state); }
+
+    void CullBoxesAVX512(State& state)   { CullBoxes<CullBoxes_AVX512, IsaLevel::AVX512>(state); }
+    void CullSpheresAVX512(State& state) { CullSpheres<CullSpheres_AVX512, IsaLevel::AVX512>(state); }
+#endif
+}
+
+//An odd count so the tails and the partial last word are covered
+CRX_BENCHMARK_ARGS(CullBoxesScalar, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullSpheresScalar, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullBoxesDispatched, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullSpheresDispatched, 1021, 65536);
+#if CRX_SIMD_X86
+CRX_BENCHMARK_ARGS(CullBoxesSSE, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullSpheresSSE, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullBoxesAVX2, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullSpheresAVX2, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullBoxesAVX512, 1021, 65536);
+CRX_BENCHMARK_ARGS(CullSpheresAVX512, 1021, 65536);
+#endif
@@ -0,0 +1,128 @@
+#include "Benchmark.h"
+#include "Graphics/Fence.h"
+#include "Graphics/FenceCompletionService.h"
+#include "Graphics/API/Null/NullCommandQueue.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+namespace {
+    //Enqueue a callback, signal its value and wait for it, the latency of the service thread
+    void FenceCallbackRoundTrip(State& state) {
+        CpuFence fence;
+        FenceCompletionService service;
+
+        //Only the service thread appends, WaitForCallbacks orders it before the reads
+        std::vector<uint32_t> order;
+        constexpr uint64_t Values[] = { 1, 1, 2, 3, 3, 5 };
+
+        for (uint32_t i = 0; i < std::size(Values); ++i) {
+            service.Enqueue(fence, Values[i], [&order, i] { order.push_back(i); });
+        }
+
+        fence.Signal(2);
+        service.WaitForCallbacks(fence, 2);
+
+        const bool isPartial = order == std::vector<uint32_t>{ 0, 1, 2 } && service.GetNumPendingCallbacks() == 3;
+
+        fence.Signal(5);
+        service.WaitForCallbacks(fence, 5);
+
+        const bool isInOrder = order == std::vector<uint32_t>{ 0, 1, 2, 3, 4, 5 } && service.GetNumPendingCallbacks() == 0;
+
+        //Arms 6, then enqueues 6 again once nothing is pending
+        service.Enqueue(fence, 6, [&order] { order.push_back(6); });
+        fence.Signal(6);
+        service.WaitForCallbacks(fence, 6);
+        service.Enqueue(fence, 6, [&order] { order.push_back(7); });
+        service.WaitForCallbacks(fence, 6);
+
+        if (!state.Check(isPartial, "only the callbacks up to the fence value run") ||
+            !state.Check(isInOrder, "callbacks run in the order they were enqueued") ||
+            !state.Check(order.size() == 8, "a value that was already armed is armed again")) {
+            return;
+        }
+
+        uint64_t value = 6;
+
+        for (auto _ : state) {
+            service.Enqueue(fence, ++value, [] {});
+            fence.Signal(value);
+            service.WaitForCallbacks(fence, value);
+        }
+    }
+
+    //Acquire, record, submit and flush on a queue that recycles its lists through the service
+    void NullCommandQueueRecycle(State& state) {
+        FenceCompletionService service;
+        NullCommandQueue queue(service);
+
+        auto commandList = queue.AcquireCommandList();
+        const auto original = commandList.get();
+
+        commandList->Draw(3);
+        const auto fenceValue = queue.Submit({ &commandList, 1 });
+        commandList.reset();
+        queue.Flush();
+
+        commandList = queue.AcquireCommandList();
+
+        const bool isRecycled = commandList.get() == original &&
+                                static_cast<NullCommandList&>(*commandList).GetStats().NumDraws == 0;
+
+        if (!state.Check(queue.IsFenceComplete(fenceValue) && queue.GetStats().NumDraws == 1, "the submitted work is counted") ||
+            !state.Check(isRecycled, "the list is reset and handed out again once its fence is reached")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            commandList = queue.AcquireCommandList();
+            commandList->Draw(3);
+            queue.Submit({ &commandList, 1 });
+            commandList.reset();
+            queue.Flush();
+        }
+    }
+
+    //Start the service, destroy a queue with recycling in flight before it and shut it down
+    //with a callback still pending. Fences have to outlive the service or be unregistered.
+    void FenceServiceLifetime(State& state) {
+        uint32_t failures = 0;
+
+        for (auto _ : state) {
+            CpuFence fence;
+            auto service = std::make_unique<FenceCompletionService>();
+            std::atomic_uint32_t numCallbacks{ 0 };
+
+            {
+                NullCommandQueue queue(*service);
+
+                for (uint32_t i = 0; i < 4; ++i) {
+                    auto commandList = queue.AcquireCommandList();
+                    queue.Submit({ &commandList, 1 });
+                }
+            }
+
+            failures += service->GetNumPendingCallbacks() != 0;
+
+            //The service polls every fence it tracks when woken, the queue's is gone by now
+            service->Enqueue(fence, 1, [&numCallbacks] { numCallbacks++; });
+            service->Enqueue(fence, 2, [&numCallbacks] { numCallbacks++; });
+            fence.Signal(1);
+            service->WaitForCallbacks(fence, 1);
+            fence.Signal(2);
+            service.reset();
+
+            failures += numCallbacks != 2;
+        }
+
+        state.Check(failures == 0, "destroyed queues leave nothing behind and shutdown runs every pending callback");
+    }
+}
+
+CRX_BENCHMARK(FenceCallbackRoundTrip);
+CRX_BENCHMARK(NullCommandQueueRecycle);
+CRX_BENCHMARK(FenceServiceLifetime);
@@ -0,0 +1,220 @@
+#include "Benchmark.h"
+#include "JobSystemInstance.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Jobs/TaskGraph.h"
+#include "Core/Math/Matrix.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+namespace {
+    //Round trip of a single job: schedule, execute on a worker, wake the waiting thread
+    void JobRunWait(State& state) {
+        auto& jobSystem = GetJobSystem();
+
+        for (auto _ : state) {
+            JobCounter counter;
+            jobSystem.Run([] {}, &counter);
+            jobSystem.Wait(counter);
+        }
+    }
+
+    //GetArg() empty jobs scheduled at once, the per job overhead of the scheduler
+    void JobRunBatch(State& state) {
+        auto& jobSystem   = GetJobSystem();
+        const auto numJobs = static_cast<uint32_t>(state.GetArg());
+
+        for (auto _ : state) {
+            JobCounter counter;
+
+            for (uint32_t i = 0; i < numJobs; ++i) {
+                jobSystem.Run([] {}, &counter);
+            }
+            jobSystem.Wait(counter);
+        }
+
+        state.SetItemsPerIteration(numJobs);
+    }
+
+    //World transforms of GetArg() nodes in batches of 256
+    void ParallelForTransforms(State& state) {
+        auto& jobSystem     = GetJobSystem();
+        const auto numNodes = static_cast<uint32_t>(state.GetArg());
+
+        const Matrix parent(Vector3(1.0f, 2.0f, 3.0f), Quaternion::FromPitchYawRoll(0.1f, 0.2f, 0.3f), Vector3(1.0f, 1.0f, 1.0f));
+        std::vector<Matrix> local(numNodes, parent);
+        std::vector<Matrix> world(numNodes);
+        DoNotOptimize(world);
+
+        for (auto _ : state) {
+            jobSystem.ParallelFor(numNodes, 256, [&](uint32_t i) {
+                world[i] = local[i] * parent;
+            });
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(numNodes);
+    }
+
+    //World transforms of 65536 nodes with GetArg() workers, how ParallelFor scales
+    void ParallelForWorkers(State& state) {
+        auto& jobSystem = GetJobSystem(static_cast<uint32_t>(state.GetArg()));
+        constexpr uint32_t NumNodes = 65536;
+
+        const Matrix parent(Vector3(1.0f, 2.0f, 3.0f), Quaternion::FromPitchYawRoll(0.1f, 0.2f, 0.3f), Vector3(1.0f, 1.0f, 1.0f));
+        std::vector<Matrix> local(NumNodes, parent);
+        std::vector<Matrix> world(NumNodes);
+
+        jobSystem.ParallelFor(NumNodes, 256, [&](uint32_t i) {
+            world[i] = local[i] * parent;
+        });
+
+        for (uint32_t i = 0; i < NumNodes; ++i) {
+            if (!state.Check(world[i] == local[i] * parent, "every index is visited")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            jobSystem.ParallelFor(NumNodes, 256, [&](uint32_t i) {
+                world[i] = local[i] * parent;
+            });
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumNodes);
+    }
+
+    //A float sum over 2^20 values with GetArg() workers. The partial sums are combined in batch
+    //order, so the result has to match a serial sum done batch by batch bit for bit.
+    void ParallelReduceWorkers(State& state) {
+        auto& jobSystem = GetJobSystem(static_cast<uint32_t>(state.GetArg()));
+        constexpr uint32_t NumValues = 1 << 20;
+        constexpr uint32_t BatchSize = 4096;
+
+        std::vector<float> values(NumValues);
+        for (uint32_t i = 0; i < NumValues; ++i) {
+            values[i] = 1.0f / static_cast<float>(i + 1);
+        }
+
+        const auto map = [&](uint32_t i) { return values[i]; };
+        const auto sum = [](float a, float b) { return a + b; };
+
+        float expected = 0.0f;
+        for (uint32_t begin = 0; begin < NumValues; begin += BatchSize) {
+            expected += std::accumulate(values.begin() + begin, values.begin() + begin + BatchSize, 0.0f);
+        }
+
+        const auto squares = jobSystem.ParallelReduce(NumValues, 1000, uint64_t{ 0 }, [](uint32_t i) { return uint64_t{ i } * i; }, std::plus<>());
+        const auto n       = uint64_t{ NumValues - 1 };
+
+        if (!state.Check(squares == n * (n + 1) * (2 * n + 1) / 6, "ParallelReduce visits every index once") ||
+            !state.Check(jobSystem.ParallelReduce(NumValues, BatchSize, 0.0f, map, sum) == expected, "ParallelReduce combines the batches in order") ||
+            !state.Check(jobSystem.ParallelReduce(0, BatchSize, 42.0f, map, sum) == 42.0f, "ParallelReduce of nothing is the identity")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            auto result = jobSystem.ParallelReduce(NumValues, BatchSize, 0.0f, map, sum);
+            DoNotOptimize(result);
+        }
+
+        state.SetItemsPerIteration(NumValues);
+    }
+
+    //Jobs that wait on jobs of their own, a job that depends on all of them and a counter that
+    //is reused every round, with GetArg() workers. Every result is checked.
+    void JobStress(State& state) {
+        auto& jobSystem = GetJobSystem(static_cast<uint32_t>(state.GetArg()));
+
+        constexpr uint32_t NumParents  = 64;
+        constexpr uint32_t NumChildren = 16;
+        constexpr uint64_t Expected    = uint64_t{ NumParents * NumChildren } * (NumParents * NumChildren + 1) / 2;
+
+        std::vector<uint32_t> values(NumParents * NumChildren);
+        std::vector<uint64_t> partials(NumParents);
+
+        JobCounter parents;
+
+        const auto runRound = [&] {
+            std::fill(values.begin(), values.end(), 0);
+
+            for (uint32_t parent = 0; parent < NumParents; ++parent) {
+                jobSystem.Run([&, parent] {
+                    JobCounter children;
+
+                    for (uint32_t child = 0; child < NumChildren; ++child) {
+                        jobSystem.Run([&, parent, child] {
+                            const auto index = parent * NumChildren + child;
+                            values[index] = index + 1;
+                        }, &children);
+                    }
+
+                    //Runs other jobs, possibly other parents, until the children are done
+                    jobSystem.Wait(children);
+
+                    partials[parent] = std::accumulate(values.begin() + parent * NumChildren, values.begin() + (parent + 1) * NumChildren, uint64_t{ 0 });
+                }, &parents);
+            }
+
+            //Only starts once every parent has finished
+            std::atomic_uint64_t total{ 0 };
+            JobCounter sum;
+
+            jobSystem.Run([&] {
+                total = std::accumulate(partials.begin(), partials.end(), uint64_t{ 0 });
+            }, &sum, &parents);
+
+            jobSystem.Wait(sum);
+            jobSystem.Wait(parents);
+
+            return total.load();
+        };
+
+        if (!state.Check(runRound() == Expected && runRound() == Expected, "nested jobs and dependencies give the sum")) {
+            return;
+        }
+
+        uint64_t failures = 0;
+
+        for (auto _ : state) {
+            failures += runRound() != Expected;
+        }
+
+        state.Check(failures == 0 && parents.IsDone(), "every round gives the sum");
+        state.SetItemsPerIteration(NumParents * (NumChildren + 1) + 1);
+    }
+
+    //The shape of the frame graph Graphics builds: two roots, a join, a fan out and a join
+    void TaskGraphExecute(State& state) {
+        auto& jobSystem = GetJobSystem();
+
+        TaskGraph graph;
+        const auto timer      = graph.AddTask("UpdateTimer", [] {});
+        const auto swapChain  = graph.AddTask("WaitForSwapChain", [] {});
+        const auto camera     = graph.AddTask("UpdateCamera", [] {}, { timer, swapChain });
+        const auto pointLights       = graph.AddTask("UpdatePointLights", [] {}, { camera });
+        const auto spotLights        = graph.AddTask("UpdateSpotLights", [] {}, { camera });
+        const auto directionalLights = graph.AddTask("UpdateDirectionalLights", [] {}, { camera });
+        graph.AddTask("PackLights", [] {}, { pointLights, spotLights, directionalLights });
+
+        for (auto _ : state) {
+            graph.Execute(jobSystem);
+        }
+
+        state.SetItemsPerIteration(graph.GetNumTasks());
+    }
+}
+
+CRX_BENCHMARK(JobRunWait);
+CRX_BENCHMARK_ARGS(JobRunBatch, 64);
+CRX_BENCHMARK_ARGS(ParallelForTransforms, 4096, 65536);
+CRX_BENCHMARK(TaskGraphExecute);
+CRX_BENCHMARK_ARGS(ParallelForWorkers, 1, 2, 4, 8, 16);
+CRX_BENCHMARK_ARGS(ParallelReduceWorkers, 1, 2, 4, 8, 16);
+CRX_BENCHMARK_ARGS(JobStress, 1, 2, 4, 8, 16);
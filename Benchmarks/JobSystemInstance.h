@@ -0,0 +1,29 @@
+#pragma once
+#include "Core/Jobs/JobSystem.h"
+#include <algorithm>
+#include <thread>
+
+namespace Cyrex::Benchmark {
+    //As many workers as the Application would use
+    inline uint32_t GetDefaultNumWorkers() noexcept {
+        return static_cast<uint32_t>(std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+    }
+
+    //Created on first use and shared by every benchmark that schedules jobs. Asking for another
+    //worker count recreates it, benchmarks run one at a time so nothing else holds on to it.
+    inline JobSystem& GetJobSystem(uint32_t numWorkers = GetDefaultNumWorkers()) {
+        struct Instance {
+            uint32_t NumWorkers{ 0 };
+            ~Instance() { JobSystem::Destroy(); }
+        };
+
+        static Instance instance;
+
+        if (instance.NumWorkers != numWorkers) {
+            JobSystem::Destroy();
+            JobSystem::Create(numWorkers);
+            instance.NumWorkers = numWorkers;
+        }
+        return JobSystem::Get();
+    }
+}
@@ -0,0 +1,392 @@
+#include "Benchmark.h"
+#include "Core/LogBuffer.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+//Severities below CRX_LOG_MIN_LEVEL are compiled out, everything else is kept
+static_assert(Logger::IsEnabled(Logger::Level::crx_critical) && Logger::IsEnabled(Logger::Level::crx_wcritical));
+static_assert(Logger::IsEnabled(Logger::Level::crx_error) == (4 >= CRX_LOG_MIN_LEVEL));
+static_assert(Logger::IsEnabled(Logger::Level::crx_info) == (2 >= CRX_LOG_MIN_LEVEL));
+static_assert(Logger::IsEnabled(Logger::Level::crx_default) == (1 >= CRX_LOG_MIN_LEVEL));
+static_assert(Logger::IsEnabled(Logger::Level::crx_debug) == (0 >= CRX_LOG_MIN_LEVEL));
+static_assert(Logger::IsEnabled(Logger::Level::crx_wdebug) == Logger::IsEnabled(Logger::Level::crx_debug));
+
+#ifndef __cpp_lib_format
+//Without <format> LogFormat.h checks the format strings, it has to reject what std::format_string would
+static_assert(LogRecord::Detail::IsValidFormat<int, double>("{:>6}|{1:.2f}") == false);
+static_assert(LogRecord::Detail::IsValidFormat<int>("{} {}") == false);
+static_assert(LogRecord::Detail::IsValidFormat<int>("{:+}") == false);
+static_assert(LogRecord::Detail::IsValidFormat<int>("{") == false && LogRecord::Detail::IsValidFormat<int>("}") == false);
+static_assert(LogRecord::Detail::IsValidFormat<int, double>("{{{:>6}}} {:*^10.3e}"));
+static_assert(LogRecord::Detail::IsValidFormat<int, double>("{1} {0:x} {1}"));
+#endif
+
+//Logger itself writes to the Windows console, so this measures the path a message takes on
+//the calling thread: LogRecord::EncodeRecord into the thread's ring buffer, as Logger::Enqueue does.
+namespace {
+    //Same size as the thread buffers of the Logger
+    constexpr size_t BufferSize = 64 * 1024;
+
+    using RecordHeader = LogRecord::Header<uint32_t>;
+
+    const std::string MeshName = "Sponza/sponza_04_Material__29";
+
+    //Returns false if the buffer is full
+    template<class... Args>
+    bool Enqueue(LogRingBuffer& buffer, const Args& ...args) noexcept {
+        const RecordHeader header{ 1, std::time(nullptr) };
+
+        if (!LogRecord::EncodeRecord([&buffer](size_t size) { return buffer.TryReserve(size); }, header, args...)) [[unlikely]] {
+            return false;
+        }
+
+        buffer.Commit();
+        return true;
+    }
+
+    //A typical message: text, a name, numbers and a pointer
+    bool EnqueueMessage(LogRingBuffer& buffer, uint64_t i) noexcept {
+        return Enqueue(buffer, "Loaded mesh ", MeshName, " with ", i, " vertices in ", 1.25f, " ms at ", &buffer);
+    }
+
+    //The same message the way Logger::Log wrote it before the ring buffers: one global lock,
+    //the time prefix rebuilt through a stringstream and the arguments streamed under the lock
+    void LogStreamMessage(std::ostream& ostream, std::string& prefix, uint64_t i) {
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::stringstream time;
+        time << std::put_time(std::localtime(&now), "%X");
+
+        prefix.clear();
+        prefix.append("[").append(time.str()).append("] ").append("<INFO> ");
+
+        //Stands in for the console, which does not grow
+        if (ostream.tellp() > static_cast<std::streamoff>(BufferSize)) [[unlikely]] {
+            ostream.seekp(0);
+        }
+
+        ostream << prefix << "Loaded mesh " << MeshName << " with " << i << " vertices in " << 1.25f << " ms at " << &ostream << std::endl;
+    }
+
+    void Discard(const std::byte*, size_t) noexcept {}
+
+    //The producer side only, full buffers are emptied without formatting the records
+    void LogEnqueue(State& state) {
+        LogRingBuffer buffer(BufferSize);
+        uint64_t i = 0;
+
+        for (auto _ : state) {
+            while (!EnqueueMessage(buffer, i)) [[unlikely]] {
+                buffer.ConsumeAll(Discard);
+            }
+            i++;
+        }
+    }
+
+    //Formatting a record into text, what the logging thread does for every message
+    void LogDecode(State& state) {
+        LogRingBuffer buffer(BufferSize);
+        EnqueueMessage(buffer, 1234);
+
+        std::vector<std::byte> record;
+        buffer.ConsumeAll([&](const std::byte* data, size_t size) {
+            record.assign(data, data + size);
+        });
+
+        std::ostringstream stream;
+        LogRecord::Decode(stream, record.data() + sizeof(RecordHeader), record.data() + record.size());
+
+        std::ostringstream expected;
+        expected << "Loaded mesh " << MeshName << " with " << 1234 << " vertices in " << 1.25f << " ms at " << &buffer;
+
+        RecordHeader header;
+        std::memcpy(&header, record.data(), sizeof(header));
+
+        if (!state.Check(header.Lvl == 1, "the header leads the record") ||
+            !state.Check(stream.str() == expected.str(), "a record decodes to what streaming the arguments writes")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            stream.str({});
+            LogRecord::Decode(stream, record.data() + sizeof(RecordHeader), record.data() + record.size());
+            DoNotOptimize(stream);
+        }
+    }
+
+    //Records of every size up to the largest pushed through the smallest ring, so the end of
+    //the buffer is hit at every offset. Each record carries its index and is filled with it.
+    void LogRingBufferWrap(State& state) {
+        LogRingBuffer buffer(256);
+        const auto maxSize = buffer.MaxRecordSize();
+
+        uint64_t numWritten  = 0;
+        uint64_t numConsumed = 0;
+        uint64_t failures    = 0;
+
+        const auto write = [&](size_t size) {
+            auto data = buffer.TryReserve(size);
+
+            if (!data) {
+                return false;
+            }
+
+            std::memset(data, static_cast<int>(numWritten & 0xff), size);
+            buffer.Commit();
+            numWritten++;
+            return true;
+        };
+
+        const auto consume = [&] {
+            buffer.ConsumeAll([&](const std::byte* data, size_t size) {
+                const auto expected = static_cast<std::byte>(numConsumed & 0xff);
+                failures += std::any_of(data, data + size, [&](std::byte b) { return b != expected; });
+                numConsumed++;
+            });
+        };
+
+        //21 one byte records leave a gap smaller than a block header in front of the end
+        for (uint32_t i = 0; i < 21; ++i) {
+            write(1);
+        }
+        consume();
+
+        const bool isTailWrapped = write(8);
+        consume();
+
+        for (size_t size = 1; size <= maxSize; ++size) {
+            for (uint32_t i = 0; i < 7; ++i) {
+                if (!write(size)) {
+                    consume();
+                    failures += !write(size);
+                }
+            }
+        }
+        consume();
+
+        if (!state.Check(isTailWrapped, "a record wraps around a gap smaller than a block header") ||
+            !state.Check(failures == 0 && numConsumed == numWritten && buffer.Empty(), "every record comes back intact and in order") ||
+            !state.Check(!buffer.TryReserve(maxSize + 1), "records larger than MaxRecordSize are refused")) {
+            return;
+        }
+
+        size_t size = 1;
+
+        for (auto _ : state) {
+            if (!write(size)) [[unlikely]] {
+                consume();
+                write(size);
+            }
+            size = size == maxSize ? 1 : size + 1;
+        }
+    }
+
+    //Logging below CRX_LOG_MIN_LEVEL. Logger.cpp is not built into the benchmarks, so these
+    //only link because the calls never reach Logger::Get.
+    void LogDisabledLevel(State& state) {
+#if CRX_LOG_MIN_LEVEL > 0
+        uint64_t i = 0;
+
+        for (auto _ : state) {
+            crxlog::debug("Loaded mesh ", MeshName, " with ", i, " vertices in ", 1.25f, " ms");
+            crxlog::wdebug(L"Loaded mesh ", i);
+            crxlog::fmt::debug("Loaded mesh {} with {} vertices in {} ms", MeshName, i, 1.25f);
+            DoNotOptimize(++i);
+        }
+#else
+        state.SkipWithMessage("every level is enabled");
+#endif
+    }
+
+    //A record led by a FormatCall, the format string is checked against the arguments by
+    //LogRecord::FormatString as crxlog::fmt does and the text is only formatted when decoding
+    template<class... Args>
+    bool EnqueueFormat(LogRingBuffer& buffer, LogRecord::FormatString<const Args&...> format, const Args& ...args) noexcept {
+        return Enqueue(buffer, LogRecord::MakeFormatCall<decltype(LogRecord::ToArg(args))...>(format.get()), args...);
+    }
+
+    std::vector<std::string> DecodeAll(LogRingBuffer& buffer) {
+        std::vector<std::string> records;
+
+        buffer.ConsumeAll([&](const std::byte* data, size_t size) {
+            std::ostringstream stream;
+            LogRecord::Decode(stream, data + sizeof(RecordHeader), data + size);
+            records.push_back(stream.str());
+        });
+
+        return records;
+    }
+
+    //The expected text is what std::format writes, so the checks hold with and without <format>
+    void LogFormatDecode(State& state) {
+        LogRingBuffer buffer(BufferSize);
+
+        EnqueueFormat(buffer, "Loaded mesh {} with {} vertices in {:.2f} ms", MeshName, 1234u, 1.25f);
+        EnqueueFormat(buffer, "{:>6}|{:<4}|{:^7}|{:04x}|{:X}|{:e}|{{{}}}", -42, 'c', true, 255, 48879, 1500.0, 0.1);
+        EnqueueFormat(buffer, "{1} before {0}, {1:*>5}", "first", "second");
+        EnqueueFormat(buffer, "{}", static_cast<const void*>(&buffer));
+
+        std::array<char, 32> address{};
+        std::to_chars(address.data(), address.data() + address.size(), reinterpret_cast<uintptr_t>(&buffer), 16);
+
+        const auto records = DecodeAll(buffer);
+
+        if (!state.Check(records.size() == 4, "every format record is decoded") ||
+            !state.Check(records[0] == "Loaded mesh " + MeshName + " with 1234 vertices in 1.25 ms\n", "arguments replace the fields") ||
+            !state.Check(records[1] == "   -42|c   | true  |00ff|BEEF|1.500000e+03|{0.1}\n", "fill, alignment, width, precision and types are applied") ||
+            !state.Check(records[2] == "second before first, second\n", "fields pick their argument by index") ||
+            !state.Check(records[3] == std::string("0x") + address.data() + "\n", "pointers are written in hex")) {
+            return;
+        }
+
+        EnqueueFormat(buffer, "Loaded mesh {} with {} vertices in {:.2f} ms", MeshName, 1234u, 1.25f);
+
+        std::vector<std::byte> record;
+        buffer.ConsumeAll([&](const std::byte* data, size_t size) {
+            record.assign(data, data + size);
+        });
+
+        std::ostringstream stream;
+
+        for (auto _ : state) {
+            stream.str({});
+            LogRecord::Decode(stream, record.data() + sizeof(RecordHeader), record.data() + record.size());
+            DoNotOptimize(stream);
+        }
+    }
+
+    //Baseline for LogEnqueue, formats on the calling thread into a string stream instead of the console
+    void LogMutexStream(State& state) {
+        std::ostringstream stream;
+        std::string prefix;
+        uint64_t i = 0;
+
+        for (auto _ : state) {
+            LogStreamMessage(stream, prefix, i++);
+        }
+    }
+
+    //GetArg() threads log into their own buffers while one thread formats everything,
+    //the time per message includes waiting for a full buffer to be drained
+    void LogEnqueueContended(State& state) {
+        const auto numThreads = static_cast<uint32_t>(state.GetArg());
+        const auto perThread  = std::max<uint64_t>(1, state.GetIterations() / numThreads);
+
+        std::vector<std::unique_ptr<LogRingBuffer>> buffers;
+        for (uint32_t i = 0; i < numThreads; ++i) {
+            buffers.push_back(std::make_unique<LogRingBuffer>(BufferSize));
+        }
+
+        std::atomic_bool go{ false };
+        std::atomic_uint32_t numDone{ 0 };
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i < numThreads; ++i) {
+            threads.emplace_back([&, i] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                for (uint64_t message = 0; message < perThread; ++message) {
+                    while (!EnqueueMessage(*buffers[i], message)) {
+                        std::this_thread::yield();
+                    }
+                }
+                numDone.fetch_add(1, std::memory_order_release);
+            });
+        }
+
+        threads.emplace_back([&] {
+            std::ostringstream stream;
+
+            const auto decode = [&](const std::byte* data, size_t size) {
+                stream.str({});
+                LogRecord::Decode(stream, data + sizeof(RecordHeader), data + size);
+            };
+
+            while (true) {
+                const bool done = numDone.load(std::memory_order_acquire) == numThreads;
+                size_t numRecords = 0;
+
+                for (auto& buffer : buffers) {
+                    numRecords += buffer->ConsumeAll(decode);
+                }
+
+                if (done) {
+                    break;
+                }
+                if (!numRecords) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        state.StartTimer();
+        go.store(true, std::memory_order_release);
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        state.StopTimer();
+    }
+
+    //Baseline for LogEnqueueContended, GetArg() threads take turns formatting into one stream
+    void LogMutexStreamContended(State& state) {
+        const auto numThreads = static_cast<uint32_t>(state.GetArg());
+        const auto perThread  = std::max<uint64_t>(1, state.GetIterations() / numThreads);
+
+        std::ostringstream stream;
+        std::atomic_bool go{ false };
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i < numThreads; ++i) {
+            threads.emplace_back([&] {
+                std::string prefix;
+
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                for (uint64_t message = 0; message < perThread; ++message) {
+                    LogStreamMessage(stream, prefix, message);
+                }
+            });
+        }
+
+        state.StartTimer();
+        go.store(true, std::memory_order_release);
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        state.StopTimer();
+    }
+}
+
+CRX_BENCHMARK(LogEnqueue);
+CRX_BENCHMARK(LogDecode);
+CRX_BENCHMARK(LogRingBufferWrap);
+CRX_BENCHMARK(LogDisabledLevel);
+CRX_BENCHMARK(LogFormatDecode);
+CRX_BENCHMARK(LogMutexStream);
+CRX_BENCHMARK_ARGS(LogEnqueueContended, 1, 2, 4);
+CRX_BENCHMARK_ARGS(LogMutexStreamContended, 1, 2, 4);
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+namespace {
+    void PrintUsage() {
+        std::printf(
+            "Usage: CyrexBenchmarks [options]\n"
+            "  --filter=<text>     Only run benchmarks whose name contains text\n"
+            "  --json=<path>       Write the results as JSON\n"
+            "  --samples=<n>       Number of timed samples per benchmark (default 21)\n"
+            "  --min-time=<sec>    Minimum duration of one sample (default 0.01)\n"
+            "  --warmup=<sec>      Warmup duration per benchmark (default 0.05)\n"
+            "  --isa=<level>       Run the kernels at most at scalar, sse, avx2 or avx512\n"
+            "  --quick             Few short samples, for checking that everything runs\n"
+            "  --list              List the benchmarks without running them\n");
+    }
+
+    bool ParseOption(std::string_view arg, std::string_view name, std::string_view& value) {
+        if (arg.substr(0, name.size()) != name) {
+            return false;
+        }
+        value = arg.substr(name.size());
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        std::string_view value;
+
+        if (ParseOption(arg, "--filter=", value)) {
+            options.Filter = value;
+        }
+        else if (ParseOption(arg, "--json=", value)) {
+            options.JsonPath = value;
+        }
+        else if (ParseOption(arg, "--samples=", value)) {
+            options.NumSamples = static_cast<uint32_t>(std::max(1, std::atoi(std::string(value).c_str())));
+        }
+        else if (ParseOption(arg, "--min-time=", value)) {
+            options.MinSampleSeconds = std::atof(std::string(value).c_str());
+        }
+        else if (ParseOption(arg, "--warmup=", value)) {
+            options.WarmupSeconds = std::atof(std::string(value).c_str());
+        }
+        else if (ParseOption(arg, "--isa=", value)) {
+            const auto level = CpuDispatch::FromString(value);
+
+            if (!level) {
+                PrintUsage();
+                return 1;
+            }
+            CpuDispatch::ForceLevel(*level);
+        }
+        else if (arg == "--quick") {
+            options.NumSamples       = 3;
+            options.MinSampleSeconds = 0.001;
+            options.WarmupSeconds    = 0.001;
+        }
+        else if (arg == "--list") {
+            options.ListOnly = true;
+        }
+        else {
+            PrintUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::printf("SIMD kernels: %s (CPU supports %s)\n",
+        CpuDispatch::ToString(CpuDispatch::GetLevel()),
+        CpuDispatch::ToString(CpuDispatch::GetSupportedLevel()));
+
+    std::vector<Result> results;
+
+    if (RunBenchmarks(options, results) == 0) {
+        std::fprintf(stderr, "No benchmark matches the filter\n");
+        return 1;
+    }
+
+    if (!options.JsonPath.empty() && !WriteJson(options.JsonPath, results)) {
+        std::fprintf(stderr, "Failed to write %s\n", options.JsonPath.c_str());
+        return 1;
+    }
+
+    const auto numFailed = std::count_if(results.begin(), results.end(), [](const auto& result) { return result.Failed; });
+
+    if (numFailed != 0) {
+        std::fprintf(stderr, "%d benchmark(s) failed their checks\n", static_cast<int>(numFailed));
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,368 @@
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include "MathChecks.h"
+#include "Core/Math/Affine3x4.h"
+#include "Core/Math/Matrix.h"
+#include "Core/Math/MatrixKernels.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/Vector3.h"
+#include "Core/Math/Vector4.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+//The math types have to stay usable in constant expressions
+static_assert(Vector3::Cross(Vector3::Right, Vector3::Up) == Vector3::Forward);
+static_assert(Quaternion::Identity * Quaternion(0.0f, 0.0f, 1.0f, 0.0f) == Quaternion(0.0f, 0.0f, 1.0f, 0.0f));
+static_assert(Matrix::CreateRotation(Quaternion::Identity) == Matrix::Identity);
+static_assert(Matrix::CreateScale(2.0f) * Matrix::CreateScale(0.5f) == Matrix::Identity);
+static_assert(Matrix::Inverse(Matrix::CreateScale(4.0f)) == Matrix::CreateScale(0.25f));
+static_assert(Matrix::CreateTranslation(Vector3(1.0f, 2.0f, 3.0f)).Transposed().m03 == 1.0f);
+
+namespace {
+    //Large enough to leave L1, small enough to stay in L2
+    constexpr size_t NumElements = 1024;
+
+    std::vector<Matrix> MakeTransforms(size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<Matrix> transforms;
+        transforms.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto rotation    = Quaternion::FromPitchYawRoll(dist(rng) * 3.0f, dist(rng) * 3.0f, dist(rng) * 3.0f);
+            const auto translation = Vector3(dist(rng) * 100.0f, dist(rng) * 100.0f, dist(rng) * 100.0f);
+            const auto scale       = Vector3(1.0f + dist(rng) * 0.5f, 1.0f + dist(rng) * 0.5f, 1.0f + dist(rng) * 0.5f);
+
+            transforms.emplace_back(translation, rotation, scale);
+        }
+
+        return transforms;
+    }
+
+    std::vector<Vector4> MakePoints(size_t count) {
+        std::mt19937 rng(5678);
+        std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+        std::vector<Vector4> points;
+        points.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            points.emplace_back(dist(rng), dist(rng), dist(rng), 1.0f);
+        }
+
+        return points;
+    }
+
+    //Every variant of a matrix operation is checked against the scalar reference on the
+    //benchmark's inputs before it is timed
+    using MatrixBinaryKernel = void(*)(const Matrix& lhs, const Matrix& rhs, Matrix& out);
+    using MatrixUnaryKernel  = void(*)(const Matrix& in, Matrix& out);
+
+    template<MatrixBinaryKernel Kernel, uint32_t MaxUlps>
+    void MatrixMultiplyVariant(State& state) {
+        const auto lhs = MakeTransforms(NumElements);
+        const auto rhs = MakeTransforms(NumElements);
+        std::vector<Matrix> out(NumElements);
+
+        for (size_t i = 0; i < NumElements; ++i) {
+            Kernel(lhs[i], rhs[i], out[i]);
+
+            if (!state.Check(NearlyEqual(out[i], Matrix::MultiplyScalar(lhs[i], rhs[i]), MaxUlps), "product matches the scalar reference")) {
+                return;
+            }
+        }
+
+        //Lets out escape, so ClobberMemory keeps the stores to it
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                Kernel(lhs[i], rhs[i], out[i]);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    template<MatrixUnaryKernel Kernel, MatrixUnaryKernel Reference, uint32_t MaxUlps>
+    void MatrixUnaryVariant(State& state) {
+        const auto in = MakeTransforms(NumElements);
+        std::vector<Matrix> out(NumElements);
+
+        for (size_t i = 0; i < NumElements; ++i) {
+            Matrix expected;
+            Kernel(in[i], out[i]);
+            Reference(in[i], expected);
+
+            if (!state.Check(NearlyEqual(out[i], expected, MaxUlps), "result matches the scalar reference")) {
+                return;
+            }
+        }
+
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                Kernel(in[i], out[i]);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    void MultiplyOperator(const Matrix& lhs, const Matrix& rhs, Matrix& out) { out = lhs * rhs; }
+    void MultiplyScalar(const Matrix& lhs, const Matrix& rhs, Matrix& out)   { out = Matrix::MultiplyScalar(lhs, rhs); }
+    void InverseOperator(const Matrix& in, Matrix& out)    { out = Matrix::Inverse(in); }
+    void InverseScalar(const Matrix& in, Matrix& out)      { out = Matrix::InverseScalar(in); }
+    void TransposeOperator(const Matrix& in, Matrix& out)  { out = Matrix::Transpose(in); }
+    void TransposeScalar(const Matrix& in, Matrix& out)    { out = Matrix::TransposeScalar(in); }
+
+    //What Matrix uses on this platform
+    void MatrixMultiply(State& state)  { MatrixMultiplyVariant<MultiplyOperator, 2>(state); }
+    void MatrixInverse(State& state)   { MatrixUnaryVariant<InverseOperator, InverseScalar, 64>(state); }
+    void MatrixTranspose(State& state) { MatrixUnaryVariant<TransposeOperator, TransposeScalar, 0>(state); }
+
+    void MatrixMultiplyScalar(State& state)  { MatrixMultiplyVariant<MultiplyScalar, 0>(state); }
+    void MatrixInverseScalar(State& state)   { MatrixUnaryVariant<InverseScalar, InverseScalar, 0>(state); }
+    void MatrixTransposeScalar(State& state) { MatrixUnaryVariant<TransposeScalar, TransposeScalar, 0>(state); }
+
+#if CRX_SIMD_X86
+    void MultiplySSE(const Matrix& lhs, const Matrix& rhs, Matrix& out)  { MatrixKernels::Multiply_SSE(lhs.Data(), rhs.Data(), out.Data()); }
+    void MultiplyAVX2(const Matrix& lhs, const Matrix& rhs, Matrix& out) { MatrixKernels::Multiply_AVX2(lhs.Data(), rhs.Data(), out.Data()); }
+
+    void MatrixMultiplySSE(State& state) { MatrixMultiplyVariant<MultiplySSE, 2>(state); }
+
+    void MatrixMultiplyAVX2(State& state) {
+        if (CpuDispatch::GetLevel() < IsaLevel::AVX2) {
+            state.SkipWithMessage("skipped, the CPU has no AVX2 and FMA");
+            return;
+        }
+        //Fused multiply adds round once instead of twice
+        MatrixMultiplyVariant<MultiplyAVX2, 4>(state);
+    }
+#endif
+
+    //The reference itself, M * M^-1 has to be the identity
+    void MatrixInverseIdentity(State& state) {
+        const auto in = MakeTransforms(NumElements);
+
+        for (const auto& matrix : in) {
+            if (!state.Check(NearlyEqual(matrix * Matrix::InverseScalar(matrix), Matrix(), 256), "M * InverseScalar(M) is the identity")) {
+                return;
+            }
+        }
+
+        std::vector<Matrix> out(NumElements);
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                out[i] = in[i] * Matrix::Inverse(in[i]);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    void MatrixCompose(State& state) {
+        const auto rotation    = Quaternion::FromPitchYawRoll(0.3f, 1.2f, -0.7f);
+        const auto translation = Vector3(10.0f, -4.0f, 2.5f);
+        const auto scale       = Vector3(1.5f, 1.5f, 1.5f);
+
+        std::vector<Matrix> out(NumElements);
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                out[i] = Matrix(translation, rotation, scale);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    //The 48 byte transform the scene graph stores, checked against the Matrix results
+    void AffineMultiply(State& state) {
+        const auto lhs = MakeTransforms(NumElements);
+        const auto rhs = MakeTransforms(NumElements);
+
+        const std::vector<Affine3x4> lhsAffine(lhs.begin(), lhs.end());
+        const std::vector<Affine3x4> rhsAffine(rhs.begin(), rhs.end());
+        std::vector<Affine3x4> out(NumElements);
+
+        for (size_t i = 0; i < NumElements; ++i) {
+            out[i] = lhsAffine[i] * rhsAffine[i];
+
+            //The translations are summed in another order, and cancel at the magnitude of the inputs
+            const auto magnitude = std::max(MaxMagnitude(lhs[i].Data(), 16), MaxMagnitude(rhs[i].Data(), 16));
+
+            if (!state.Check(NearlyEqual(out[i].ToMatrix(), Matrix::MultiplyScalar(lhs[i], rhs[i]), 4, magnitude), "product matches the Matrix product")) {
+                return;
+            }
+        }
+
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                out[i] = lhsAffine[i] * rhsAffine[i];
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    template<Affine3x4(*Kernel)(const Affine3x4&) noexcept>
+    void AffineInverseVariant(State& state) {
+        const auto in = MakeTransforms(NumElements);
+
+        const std::vector<Affine3x4> inAffine(in.begin(), in.end());
+        std::vector<Affine3x4> out(NumElements);
+
+        for (size_t i = 0; i < NumElements; ++i) {
+            out[i] = Kernel(inAffine[i]);
+
+            if (!state.Check(NearlyEqual(out[i].ToMatrix(), Matrix::InverseScalar(in[i]), 64), "inverse matches the Matrix inverse")) {
+                return;
+            }
+        }
+
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                out[i] = Kernel(inAffine[i]);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    void AffineInverse(State& state)       { AffineInverseVariant<Affine3x4::Inverse>(state); }
+    void AffineInverseScalar(State& state) { AffineInverseVariant<Affine3x4::InverseScalar>(state); }
+
+    void Vector4TransformCoord(State& state) {
+        const auto transform = MakeTransforms(1).front();
+        const auto in        = MakePoints(NumElements);
+        std::vector<Vector4> out(NumElements);
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                out[i] = Vector4::TransformCoord(in[i], transform);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    void Vector3TransformCoord(State& state) {
+        const auto transform = MakeTransforms(1).front();
+        const auto points    = MakePoints(NumElements);
+
+        std::vector<Vector3> in(points.begin(), points.end());
+        std::vector<Vector3> out(NumElements);
+
+        for (size_t i = 0; i < NumElements; ++i) {
+            if (!state.Check(NearlyEqual(Vector3::TransformCoord(in[i], transform), transform * in[i], 8), "TransformCoord matches Matrix * Vector3")) {
+                return;
+            }
+        }
+
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                out[i] = Vector3::TransformCoord(in[i], transform);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+
+    void Vector3Cross(State& state) {
+        const auto points = MakePoints(NumElements);
+        std::vector<Vector3> in(points.begin(), points.end());
+        std::vector<Vector3> out(NumElements);
+
+        const bool isConstructed = Vector3(1.0f, 2.0f, 3.0f) == Vector3(std::array{ 1.0f, 2.0f, 3.0f }.data());
+        const bool isLeftHanded  = Vector3::Cross(Vector3::Right, Vector3::Up) == Vector3::Forward &&
+                                   Vector3::Cross(Vector3::Up, Vector3::Forward) == Vector3::Right &&
+                                   Vector3::Cross(Vector3::Forward, Vector3::Right) == Vector3::Up;
+
+        if (!state.Check(isConstructed, "Vector3(x, y, z) keeps z") || !state.Check(isLeftHanded, "Cross of the basis vectors")) {
+            return;
+        }
+
+        for (size_t i = 0; i + 1 < NumElements; ++i) {
+            const auto cross = Vector3::Cross(in[i], in[i + 1]);
+            const auto scale = in[i].Length() * in[i + 1].Length();
+
+            if (!state.Check(std::abs(cross.Dot(in[i])) <= scale * 1e-4f && std::abs(cross.Dot(in[i + 1])) <= scale * 1e-4f, "Cross is orthogonal to its inputs")) {
+                return;
+            }
+        }
+
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i + 1 < NumElements; ++i) {
+                out[i] = Vector3::Cross(in[i], in[i + 1]);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements - 1);
+    }
+
+    void QuaternionFromPitchYawRoll(State& state) {
+        std::vector<Quaternion> out(NumElements);
+        DoNotOptimize(out);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < NumElements; ++i) {
+                const auto angle = static_cast<float>(i) * 0.01f;
+                out[i] = Quaternion::FromPitchYawRoll(angle, angle * 0.5f, angle * 0.25f);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(NumElements);
+    }
+}
+
+CRX_BENCHMARK(MatrixMultiply);
+CRX_BENCHMARK(MatrixMultiplyScalar);
+#if CRX_SIMD_X86
+CRX_BENCHMARK(MatrixMultiplySSE);
+CRX_BENCHMARK(MatrixMultiplyAVX2);
+#endif
+CRX_BENCHMARK(MatrixInverse);
+CRX_BENCHMARK(MatrixInverseScalar);
+CRX_BENCHMARK(MatrixInverseIdentity);
+CRX_BENCHMARK(MatrixTranspose);
+CRX_BENCHMARK(MatrixTransposeScalar);
+CRX_BENCHMARK(MatrixCompose);
+CRX_BENCHMARK(AffineMultiply);
+CRX_BENCHMARK(AffineInverse);
+CRX_BENCHMARK(AffineInverseScalar);
+CRX_BENCHMARK(Vector4TransformCoord);
+CRX_BENCHMARK(Vector3TransformCoord);
+CRX_BENCHMARK(Vector3Cross);
+CRX_BENCHMARK(QuaternionFromPitchYawRoll);
@@ -0,0 +1,53 @@
+#pragma once
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include "Core/Math/Math.h"
+#include "Core/Math/Matrix.h"
+#include "Core/Math/Vector3.h"
+#include <algorithm>
+#include <cmath>
+
+//Comparisons the benchmarks use to check SIMD kernels against their scalar reference
+namespace Cyrex::Benchmark {
+    //Kernels forced to an instruction set the CPU lacks would fault, so their benchmarks skip instead
+    inline bool SkipUnsupported(State& state, IsaLevel isa) {
+        if (CpuDispatch::GetLevel() < isa) {
+            state.SkipWithMessage("skipped, the CPU lacks the instruction set");
+            return true;
+        }
+        return false;
+    }
+
+    //Within maxUlps, or within maxUlps epsilons of the largest value the result was computed
+    //from, because cancellation leaves small elements with no meaningful ULPs
+    inline bool NearlyEqual(float lhs, float rhs, uint32_t maxUlps, float magnitude) noexcept {
+        return Math::UlpDistance(lhs, rhs) <= maxUlps || std::abs(lhs - rhs) <= maxUlps * Math::MathConstants::EPSILON * magnitude;
+    }
+
+    inline float MaxMagnitude(const float* data, size_t count) noexcept {
+        float magnitude = 1.0f;
+
+        for (size_t i = 0; i < count; ++i) {
+            magnitude = std::max(magnitude, std::abs(data[i]));
+        }
+        return magnitude;
+    }
+
+    inline bool NearlyEqual(const Math::Matrix& lhs, const Math::Matrix& rhs, uint32_t maxUlps, float magnitude) noexcept {
+        return std::equal(lhs.Data(), lhs.Data() + 16, rhs.Data(), [=](float a, float b) {
+            return NearlyEqual(a, b, maxUlps, magnitude);
+        });
+    }
+
+    inline bool NearlyEqual(const Math::Matrix& lhs, const Math::Matrix& rhs, uint32_t maxUlps) noexcept {
+        return NearlyEqual(lhs, rhs, maxUlps, MaxMagnitude(rhs.Data(), 16));
+    }
+
+    inline bool NearlyEqual(const Math::Vector3& lhs, const Math::Vector3& rhs, uint32_t maxUlps) noexcept {
+        const auto magnitude = std::max({ 1.0f, std::abs(rhs.x), std::abs(rhs.y), std::abs(rhs.z) });
+
+        return NearlyEqual(lhs.x, rhs.x, maxUlps, magnitude) &&
+               NearlyEqual(lhs.y, rhs.y, maxUlps, magnitude) &&
+               NearlyEqual(lhs.z, rhs.z, maxUlps, magnitude);
+    }
+}
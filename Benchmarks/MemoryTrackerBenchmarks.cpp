@@ -0,0 +1,184 @@
+#include "Benchmark.h"
+#include "Core/MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+namespace {
+    //Nothing else the benchmarks run allocates under this tag
+    constexpr MemoryTag Tag = MemoryTag::Textures;
+
+    //Allocations stay in the counters of their thread until a flush, the snapshots still see them
+    void MemoryTrackerSnapshot(State& state) {
+        constexpr size_t BlockSize = 64;
+        constexpr int64_t NumBlocks = 100;
+
+        const auto before = MemoryTracker::TakeSnapshot();
+
+        for (int64_t i = 0; i < NumBlocks; ++i) {
+            MemoryTracker::OnAllocate(Tag, BlockSize);
+        }
+
+        const auto allocated = MemoryTracker::TakeSnapshot() - before;
+
+        for (int64_t i = 0; i < NumBlocks; ++i) {
+            MemoryTracker::OnDeallocate(Tag, BlockSize);
+        }
+
+        const auto released = MemoryTracker::TakeSnapshot() - before;
+
+        if (!state.Check(allocated[Tag].LiveBytes == NumBlocks * BlockSize && allocated[Tag].LiveAllocations == NumBlocks, "live allocations are counted") ||
+            !state.Check(allocated[Tag].TotalBytes == NumBlocks * BlockSize && allocated[Tag].TotalAllocations == NumBlocks, "total allocations are counted") ||
+            !state.Check(released[Tag].LiveBytes == 0 && released[Tag].LiveAllocations == 0, "released allocations are no longer live") ||
+            !state.Check(released[Tag].TotalAllocations == NumBlocks, "released allocations stay in the totals") ||
+            !state.Check(allocated.GetTotal().TotalAllocations >= NumBlocks, "the total covers every tag")) {
+            return;
+        }
+
+#if CRX_MEMORY_TRACKING
+        //operator new charges the tag of the thread that calls it
+        const auto beforeNew = MemoryTracker::TakeSnapshot();
+        {
+            CRX_MEMORY_TAG(Textures);
+            auto block = std::make_unique<std::byte[]>(256);
+            DoNotOptimize(block.get());
+        }
+        const auto afterNew = MemoryTracker::TakeSnapshot() - beforeNew;
+
+        if (!state.Check(afterNew[Tag].TotalBytes == 256 && afterNew[Tag].TotalAllocations == 1 && afterNew[Tag].LiveBytes == 0, "operator new charges the thread's tag")) {
+            return;
+        }
+#endif
+
+        for (auto _ : state) {
+            DoNotOptimize(MemoryTracker::TakeSnapshot());
+        }
+    }
+
+    //A block that is freed again before the next snapshot still raises the high-water mark
+    void MemoryTrackerPeak(State& state) {
+        constexpr size_t BlockSize = 4 * 1024 * 1024;
+
+        const auto before = MemoryTracker::TakeSnapshot();
+
+        MemoryTracker::OnAllocate(Tag, BlockSize);
+        MemoryTracker::OnDeallocate(Tag, BlockSize);
+
+        const auto after = MemoryTracker::TakeSnapshot();
+        const auto diff  = after - before;
+
+        if (!state.Check(after[Tag].PeakBytes >= before[Tag].LiveBytes + static_cast<int64_t>(BlockSize), "the peak keeps a freed block") ||
+            !state.Check(after[Tag].PeakBytes >= after[Tag].LiveBytes, "the peak is never below the live bytes") ||
+            !state.Check(diff[Tag].PeakBytes == after[Tag].PeakBytes, "a difference keeps the later peak") ||
+            !state.Check(diff[Tag].LiveBytes == 0 && diff[Tag].TotalBytes == static_cast<int64_t>(BlockSize), "the difference holds what happened in between")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            MemoryTracker::OnAllocate(Tag, BlockSize);
+            MemoryTracker::OnDeallocate(Tag, BlockSize);
+        }
+    }
+
+    //Counters of a running thread are summed into the snapshot and handed over when it exits
+    void MemoryTrackerThreads(State& state) {
+        constexpr size_t BlockSize = 1000;
+        constexpr int64_t NumBlocks = 10;
+
+        const auto before = MemoryTracker::TakeSnapshot();
+
+        std::atomic_bool allocated{ false };
+        std::atomic_bool release{ false };
+
+        std::thread thread([&] {
+            for (int64_t i = 0; i < NumBlocks; ++i) {
+                MemoryTracker::OnAllocate(Tag, BlockSize);
+            }
+            allocated.store(true, std::memory_order_release);
+
+            while (!release.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            //Half is freed here, the rest by the thread that takes the snapshots
+            for (int64_t i = 0; i < NumBlocks / 2; ++i) {
+                MemoryTracker::OnDeallocate(Tag, BlockSize);
+            }
+        });
+
+        while (!allocated.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        const auto running = MemoryTracker::TakeSnapshot() - before;
+
+        release.store(true, std::memory_order_release);
+        thread.join();
+
+        for (int64_t i = 0; i < NumBlocks / 2; ++i) {
+            MemoryTracker::OnDeallocate(Tag, BlockSize);
+        }
+
+        const auto exited = MemoryTracker::TakeSnapshot() - before;
+
+        if (!state.Check(running[Tag].LiveBytes == NumBlocks * BlockSize && running[Tag].LiveAllocations == NumBlocks, "a running thread's allocations are in the snapshot") ||
+            !state.Check(exited[Tag].LiveBytes == 0 && exited[Tag].LiveAllocations == 0, "memory freed on another thread balances out") ||
+            !state.Check(exited[Tag].TotalAllocations == NumBlocks, "an exited thread's allocations stay in the totals")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            std::thread([] { MemoryTracker::OnAllocate(Tag, BlockSize); MemoryTracker::OnDeallocate(Tag, BlockSize); }).join();
+        }
+    }
+
+    //The bookkeeping every tracked new and delete pays
+    void MemoryTrackerOnAllocate(State& state) {
+        for (auto _ : state) {
+            MemoryTracker::OnAllocate(Tag, 64);
+            MemoryTracker::OnDeallocate(Tag, 64);
+        }
+    }
+
+    //GetArg() threads charging the same tag, they share no cache line between flushes
+    void MemoryTrackerOnAllocateContended(State& state) {
+        const auto numThreads = static_cast<uint32_t>(state.GetArg());
+        const auto perThread  = std::max<uint64_t>(1, state.GetIterations() / numThreads);
+
+        std::atomic_bool go{ false };
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i < numThreads; ++i) {
+            threads.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                for (uint64_t allocation = 0; allocation < perThread; ++allocation) {
+                    MemoryTracker::OnAllocate(Tag, 64);
+                    MemoryTracker::OnDeallocate(Tag, 64);
+                }
+            });
+        }
+
+        state.StartTimer();
+        go.store(true, std::memory_order_release);
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        state.StopTimer();
+    }
+}
+
+CRX_BENCHMARK(MemoryTrackerSnapshot);
+CRX_BENCHMARK(MemoryTrackerPeak);
+CRX_BENCHMARK(MemoryTrackerThreads);
+CRX_BENCHMARK(MemoryTrackerOnAllocate);
+CRX_BENCHMARK_ARGS(MemoryTrackerOnAllocateContended, 1, 2, 4);
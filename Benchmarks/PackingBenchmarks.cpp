@@ -0,0 +1,338 @@
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include "MathChecks.h"
+#include "Core/Math/PackingKernels.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+namespace {
+    std::vector<float> MakeFloats(size_t count, float low, float high, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(low, high);
+
+        std::vector<float> values(count);
+        std::generate(values.begin(), values.end(), [&] { return dist(rng); });
+        return values;
+    }
+
+    //Every binade a half can hold and some it cannot, both signs
+    std::vector<float> MakeHalfRangeFloats(size_t count) {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> exponent(-26.0f, 17.0f);
+        std::uniform_int_distribution<int> sign(0, 1);
+
+        std::vector<float> values(count);
+        std::generate(values.begin(), values.end(), [&] { return std::exp2(exponent(rng)) * (sign(rng) ? -1.0f : 1.0f); });
+        return values;
+    }
+
+    Vector3SoA MakeNormals(size_t count) {
+        std::mt19937 rng(5);
+        std::normal_distribution<float> dist;
+
+        Vector3SoA normals(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            normals.Set(i, Vector3(dist(rng), dist(rng), dist(rng)).Normalized());
+        }
+        return normals;
+    }
+
+    bool IsNaNHalf(uint16_t half) { return (half & 0x7C00u) == 0x7C00u && (half & 0x03FFu) != 0; }
+
+    using FloatToHalfKernel = void(*)(std::span<const float> in, std::span<uint16_t> out) noexcept;
+    using HalfToFloatKernel = void(*)(std::span<const uint16_t> in, std::span<float> out) noexcept;
+
+    template<FloatToHalfKernel Encode, HalfToFloatKernel Decode, IsaLevel KernelIsa>
+    void PackHalf(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        //Every half decodes like the scalar decode and encodes back to itself
+        std::vector<uint16_t> halves(65536);
+        for (size_t i = 0; i < halves.size(); ++i) {
+            halves[i] = static_cast<uint16_t>(i);
+        }
+
+        std::vector<float> decoded(halves.size());
+        std::vector<float> expectedDecoded(halves.size());
+        std::vector<uint16_t> encoded(halves.size());
+
+        Decode(halves, decoded);
+        PackingKernels::HalfToFloat_Scalar(halves, expectedDecoded);
+        Encode(decoded, encoded);
+
+        for (size_t i = 0; i < halves.size(); ++i) {
+            //F16C quiets signaling NaNs, so only NaN itself has to survive
+            if (IsNaNHalf(halves[i])) {
+                if (!state.Check(std::isnan(decoded[i]) && IsNaNHalf(encoded[i]), "keeps NaNs NaN")) {
+                    return;
+                }
+                continue;
+            }
+
+            const bool isSameFloat = std::bit_cast<uint32_t>(decoded[i]) == std::bit_cast<uint32_t>(expectedDecoded[i]);
+            const bool isRoundTrip = encoded[i] == halves[i];
+
+            if (!state.Check(isSameFloat && isRoundTrip, "decodes every half and encodes it back")) {
+                return;
+            }
+        }
+
+        //Floats round like the scalar encode, to within half a unit in the last place of a half
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto in    = MakeHalfRangeFloats(count);
+
+        std::vector<uint16_t> out(count);
+        std::vector<uint16_t> expected(count);
+
+        std::vector<float> roundTrip(count);
+
+        Encode(in, out);
+        PackingKernels::FloatToHalf_Scalar(in, expected);
+        PackingKernels::HalfToFloat_Scalar(out, roundTrip);
+
+        for (size_t i = 0; i < count; ++i) {
+            const float magnitude = std::abs(in[i]);
+            const bool isInRange  = magnitude >= 0x1p-14f && magnitude <= 65504.0f;
+            const bool isAccurate = !isInRange || std::abs(roundTrip[i] - in[i]) <= magnitude * 0x1p-11f;
+
+            if (!state.Check(out[i] == expected[i] && isAccurate, "matches the scalar encode")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            Encode(in, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    template<HalfToFloatKernel Decode, IsaLevel KernelIsa>
+    void UnpackHalf(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        const auto count = static_cast<size_t>(state.GetArg());
+
+        std::vector<uint16_t> in(count);
+        std::vector<float> out(count);
+        PackingKernels::FloatToHalf_Scalar(MakeHalfRangeFloats(count), in);
+
+        for (auto _ : state) {
+            Decode(in, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    using EncodeOctahedralKernel = void(*)(ConstVector3Span normals, std::span<uint32_t> out) noexcept;
+    using DecodeOctahedralKernel = void(*)(std::span<const uint32_t> in, Vector3Span normals) noexcept;
+
+    template<EncodeOctahedralKernel Encode, DecodeOctahedralKernel Decode, IsaLevel KernelIsa>
+    void PackOctahedral(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        const auto count   = static_cast<size_t>(state.GetArg());
+        const auto normals = MakeNormals(count);
+
+        std::vector<uint32_t> out(count);
+        std::vector<uint32_t> expected(count);
+        Vector3SoA decoded(count);
+
+        Encode(normals, out);
+        Decode(out, decoded);
+        PackingKernels::EncodeOctahedral_Scalar(normals, expected);
+
+        //0.005 degrees
+        constexpr float MaxError = 8.7e-5f;
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto normal    = decoded.Get(i);
+            const bool isUnit    = std::abs(normal.Length() - 1.0f) <= 1e-6f;
+            const bool isNearby  = (normal - normals.Get(i)).Length() <= MaxError;
+
+            if (!state.Check(out[i] == expected[i] && isUnit && isNearby, "round trips within 0.005 degrees")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            Encode(normals, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    template<DecodeOctahedralKernel Decode, IsaLevel KernelIsa>
+    void UnpackOctahedral(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        const auto count = static_cast<size_t>(state.GetArg());
+
+        std::vector<uint32_t> in(count);
+        Vector3SoA out(count);
+        PackingKernels::EncodeOctahedral_Scalar(MakeNormals(count), in);
+
+        for (auto _ : state) {
+            Decode(in, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //A normalized format, checked against the scalar encode and to half a step after decoding
+    template<typename T, typename Encode, typename Decode, typename ScalarEncode>
+    void PackNormalized(State& state, float low, float high, float step, Encode encode, Decode decode, ScalarEncode scalarEncode) {
+        const auto count = static_cast<size_t>(state.GetArg());
+
+        //Past the range on both sides, to cover the clamping
+        auto in = MakeFloats(count, low - 0.1f, high + 0.1f, 9);
+        in[0] = NAN;
+
+        std::vector<T> out(count);
+        std::vector<T> expected(count);
+        std::vector<float> decoded(count);
+
+        encode(std::span<const float>(in), std::span<T>(out));
+        decode(std::span<const T>(out), std::span<float>(decoded));
+        scalarEncode(std::span<const float>(in), std::span<T>(expected));
+
+        for (size_t i = 0; i < count; ++i) {
+            const float clamped = std::isnan(in[i]) ? low : std::clamp(in[i], low, high);
+
+            if (!state.Check(out[i] == expected[i] && std::abs(decoded[i] - clamped) <= step * 0.5001f, "round trips within half a step")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            encode(std::span<const float>(in), std::span<T>(out));
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //Through the free functions, at the level CpuDispatch picked or --isa forced
+    void PackHalfDispatched(State& state)       { PackHalf<FloatToHalf, HalfToFloat, IsaLevel::Scalar>(state); }
+    void PackOctahedralDispatched(State& state) { PackOctahedral<EncodeOctahedral, DecodeOctahedral, IsaLevel::Scalar>(state); }
+
+    void PackSnorm16Dispatched(State& state) {
+        PackNormalized<int16_t>(state, -1.0f, 1.0f, 1.0f / 32767.0f,
+            [](auto in, auto out) { FloatToSnorm16(in, out); },
+            [](auto in, auto out) { Snorm16ToFloat(in, out); },
+            [](auto in, auto out) { PackingKernels::FloatToSnorm16_Scalar(in, out); });
+    }
+
+    void PackUnorm16Dispatched(State& state) {
+        PackNormalized<uint16_t>(state, 0.0f, 1.0f, 1.0f / 65535.0f,
+            [](auto in, auto out) { FloatToUnorm16(in, out); },
+            [](auto in, auto out) { Unorm16ToFloat(in, out); },
+            [](auto in, auto out) { PackingKernels::FloatToUnorm16_Scalar(in, out); });
+    }
+
+    void PackUnorm1010102Dispatched(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+
+        Vector3SoA xyz(count);
+        const auto x = MakeFloats(count, -0.1f, 1.1f, 13);
+        const auto y = MakeFloats(count, -0.1f, 1.1f, 14);
+        const auto z = MakeFloats(count, -0.1f, 1.1f, 15);
+        const auto w = MakeFloats(count, -0.1f, 1.1f, 16);
+
+        for (size_t i = 0; i < count; ++i) {
+            xyz.Set(i, Vector3(x[i], y[i], z[i]));
+        }
+
+        std::vector<uint32_t> out(count);
+        std::vector<uint32_t> expected(count);
+        Vector3SoA decoded(count);
+        std::vector<float> decodedW(count);
+
+        PackUnorm1010102(xyz, w, out);
+        UnpackUnorm1010102(out, decoded, decodedW);
+        PackingKernels::PackUnorm1010102_Scalar(xyz, w, expected);
+
+        const auto isNear = [](float value, float original, float step) {
+            return std::abs(value - std::clamp(original, 0.0f, 1.0f)) <= step * 0.5001f;
+        };
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto value = decoded.Get(i);
+
+            const bool isAccurate =
+                isNear(value.x, x[i], 1.0f / 1023.0f) && isNear(value.y, y[i], 1.0f / 1023.0f) &&
+                isNear(value.z, z[i], 1.0f / 1023.0f) && isNear(decodedW[i], w[i], 1.0f / 3.0f);
+
+            if (!state.Check(out[i] == expected[i] && isAccurate, "round trips within half a step")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            PackUnorm1010102(xyz, w, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    using namespace PackingKernels;
+
+    void PackHalfScalar(State& state)         { PackHalf<FloatToHalf_Scalar, HalfToFloat_Scalar, IsaLevel::Scalar>(state); }
+    void UnpackHalfScalar(State& state)       { UnpackHalf<HalfToFloat_Scalar, IsaLevel::Scalar>(state); }
+    void PackOctahedralScalar(State& state)   { PackOctahedral<EncodeOctahedral_Scalar, DecodeOctahedral_Scalar, IsaLevel::Scalar>(state); }
+    void UnpackOctahedralScalar(State& state) { UnpackOctahedral<DecodeOctahedral_Scalar, IsaLevel::Scalar>(state); }
+
+#if CRX_SIMD_X86
+    void PackHalfSSE(State& state)         { PackHalf<FloatToHalf_SSE, HalfToFloat_SSE, IsaLevel::SSE>(state); }
+    void UnpackHalfSSE(State& state)       { UnpackHalf<HalfToFloat_SSE, IsaLevel::SSE>(state); }
+    void PackOctahedralSSE(State& state)   { PackOctahedral<EncodeOctahedral_SSE, DecodeOctahedral_SSE, IsaLevel::SSE>(state); }
+    void UnpackOctahedralSSE(State& state) { UnpackOctahedral<DecodeOctahedral_SSE, IsaLevel::SSE>(state); }
+
+    void PackHalfAVX2(State& state)         { PackHalf<FloatToHalf_AVX2, HalfToFloat_AVX2, IsaLevel::AVX2>(state); }
+    void UnpackHalfAVX2(State& state)       { UnpackHalf<HalfToFloat_AVX2, IsaLevel::AVX2>(state); }
+    void PackOctahedralAVX2(State& state)   { PackOctahedral<EncodeOctahedral_AVX2, DecodeOctahedral_AVX2, IsaLevel::AVX2>(state); }
+    void UnpackOctahedralAVX2(State& state) { UnpackOctahedral<DecodeOctahedral_AVX2, IsaLevel::AVX2>(state); }
+#endif
+}
+
+//An odd count so the tails are covered
+CRX_BENCHMARK_ARGS(PackHalfScalar, 65535);
+CRX_BENCHMARK_ARGS(UnpackHalfScalar, 65535);
+CRX_BENCHMARK_ARGS(PackOctahedralScalar, 65535);
+CRX_BENCHMARK_ARGS(UnpackOctahedralScalar, 65535);
+CRX_BENCHMARK_ARGS(PackHalfDispatched, 65535);
+CRX_BENCHMARK_ARGS(PackOctahedralDispatched, 65535);
+CRX_BENCHMARK_ARGS(PackSnorm16Dispatched, 65535);
+CRX_BENCHMARK_ARGS(PackUnorm16Dispatched, 65535);
+CRX_BENCHMARK_ARGS(PackUnorm1010102Dispatched, 65535);
+#if CRX_SIMD_X86
+CRX_BENCHMARK_ARGS(PackHalfSSE, 65535);
+CRX_BENCHMARK_ARGS(UnpackHalfSSE, 65535);
+CRX_BENCHMARK_ARGS(PackOctahedralSSE, 65535);
+CRX_BENCHMARK_ARGS(UnpackOctahedralSSE, 65535);
+CRX_BENCHMARK_ARGS(PackHalfAVX2, 65535);
+CRX_BENCHMARK_ARGS(UnpackHalfAVX2, 65535);
+CRX_BENCHMARK_ARGS(PackOctahedralAVX2, 65535);
+CRX_BENCHMARK_ARGS(UnpackOctahedralAVX2, 65535);
+#endif
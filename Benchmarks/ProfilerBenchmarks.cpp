@@ -0,0 +1,243 @@
+#include "Benchmark.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+namespace {
+    //What an instrumented scope may cost while a capture is running
+    constexpr double ScopeBudgetNs = 50.0;
+
+    struct TraceEvent {
+        std::string Name;
+        std::string Phase;
+        std::string ThreadName;
+        uint32_t Tid = 0;
+        double Ts    = 0.0;
+        double Dur   = 0.0;
+    };
+
+    //The value of "key" in one exported event, without the quotes of a string
+    std::string_view FindValue(std::string_view event, std::string_view key) {
+        const auto quotedKey = "\"" + std::string(key) + "\":";
+        const auto pos       = event.find(quotedKey);
+
+        if (pos == std::string_view::npos) {
+            return {};
+        }
+
+        auto value = event.substr(pos + quotedKey.size());
+
+        if (value.starts_with('"')) {
+            size_t end = 1;
+            while (end < value.size() && value[end] != '"') {
+                end += value[end] == '\\' ? 2 : 1;
+            }
+            return value.substr(1, end - 1);
+        }
+        return value.substr(0, value.find_first_of(",}"));
+    }
+
+    //The exporter writes one event per line between the header and the closing brackets
+    bool ReadTrace(const std::filesystem::path& path, std::vector<TraceEvent>& events) {
+        std::ifstream file(path);
+        std::string line;
+
+        if (!std::getline(file, line) || line != "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") {
+            return false;
+        }
+
+        while (std::getline(file, line)) {
+            if (line == "]}") {
+                return true;
+            }
+
+            std::string_view event(line);
+            if (event.ends_with(',')) {
+                event.remove_suffix(1);
+            }
+
+            if (!event.starts_with('{') || !event.ends_with('}')) {
+                return false;
+            }
+
+            TraceEvent& parsed = events.emplace_back();
+            parsed.Name        = FindValue(event, "name");
+            parsed.Phase       = FindValue(event, "ph");
+            parsed.Tid         = static_cast<uint32_t>(std::stoul(std::string(FindValue(event, "tid"))));
+
+            if (parsed.Phase == "M") {
+                parsed.ThreadName = FindValue(event.substr(event.find("\"args\"")), "name");
+            }
+            else {
+                parsed.Ts = std::stod(std::string(FindValue(event, "ts")));
+            }
+
+            if (parsed.Phase == "X") {
+                parsed.Dur = std::stod(std::string(FindValue(event, "dur")));
+            }
+        }
+
+        return false;
+    }
+
+    const TraceEvent* FindEvent(const std::vector<TraceEvent>& events, std::string_view phase, std::string_view name) {
+        const auto it = std::find_if(events.begin(), events.end(), [&](const TraceEvent& event) {
+            return event.Phase == phase && event.Name == name;
+        });
+        return it != events.end() ? &*it : nullptr;
+    }
+
+    //Inner lies within outer, allowing for the three decimals the exporter writes
+    bool Contains(const TraceEvent& outer, const TraceEvent& inner) {
+        constexpr double Rounding = 0.002;
+        return inner.Ts + Rounding >= outer.Ts && inner.Ts + inner.Dur <= outer.Ts + outer.Dur + Rounding;
+    }
+
+    void RecordNested(const char* outerName, const char* innerName) {
+        ProfileScope outer(outerName);
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        {
+            ProfileScope inner(innerName);
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    void ProfilerNow(State& state) {
+        for (auto _ : state) {
+            auto now = Profiler::Now();
+            DoNotOptimize(now);
+        }
+    }
+
+    //The cost every instrumented scope pays outside of a capture
+    void ProfileScopeIdle(State& state) {
+        for (auto _ : state) {
+            CRX_PROFILE_SCOPE("Idle");
+            ClobberMemory();
+        }
+    }
+
+    void ProfileScopeCapturing(State& state) {
+        auto& profiler = Profiler::Get();
+        profiler.BeginCapture();
+
+        //The best of a few batches, so a preempted batch does not fail the budget
+        constexpr int NumScopes = 20000;
+        double bestNs = ScopeBudgetNs * 1000.0;
+
+        for (int batch = 0; batch < 5; ++batch) {
+            const auto start = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < NumScopes; ++i) {
+                ProfileScope scope("Budget");
+                ClobberMemory();
+            }
+
+            const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            bestNs = std::min(bestNs, elapsed / NumScopes);
+        }
+
+        if (!state.Check(bestNs < ScopeBudgetNs, "a captured scope stays within 50 ns")) {
+            profiler.EndCapture();
+            return;
+        }
+
+        for (auto _ : state) {
+            CRX_PROFILE_SCOPE("Capturing");
+            ClobberMemory();
+        }
+
+        profiler.EndCapture();
+    }
+
+    //Nested scopes on two named threads and two frames, exported and read back
+    void ProfilerExportChromeTrace(State& state) {
+        auto& profiler = Profiler::Get();
+        const auto path = std::filesystem::temp_directory_path() / "CyrexProfilerBenchmark.json";
+
+        //The quotes have to come out escaped
+        profiler.SetThreadName(std::this_thread::get_id(), "Bench \"Main\"");
+        profiler.BeginCapture();
+
+        RecordNested("MainOuter", "MainInner");
+        profiler.MarkFrame();
+
+        std::thread worker([&] {
+            profiler.SetThreadName(std::this_thread::get_id(), "Bench Worker");
+            RecordNested("WorkerOuter", "WorkerInner");
+        });
+        worker.join();
+
+        profiler.MarkFrame();
+        profiler.EndCapture();
+
+        std::vector<TraceEvent> events;
+        const auto exported = profiler.ExportChromeTrace(path.string());
+        const auto parsed   = exported && ReadTrace(path, events);
+
+        std::filesystem::remove(path);
+
+        if (!state.Check(parsed, "the trace is exported as one event per line")) {
+            return;
+        }
+
+        const auto mainOuter   = FindEvent(events, "X", "MainOuter");
+        const auto mainInner   = FindEvent(events, "X", "MainInner");
+        const auto workerOuter = FindEvent(events, "X", "WorkerOuter");
+        const auto workerInner = FindEvent(events, "X", "WorkerInner");
+
+        if (!state.Check(mainOuter && mainInner && workerOuter && workerInner, "every scope is exported")) {
+            return;
+        }
+
+        //Thread ids are reused, an exited worker of an earlier run can still hold the same name
+        const auto isThreadName = [&](std::string_view name, uint32_t tid) {
+            return std::any_of(events.begin(), events.end(), [&](const TraceEvent& event) {
+                return event.Phase == "M" && event.Tid == tid && event.ThreadName == name;
+            });
+        };
+
+        std::vector<const TraceEvent*> frames;
+        for (const auto& event : events) {
+            if (event.Phase == "i") {
+                frames.push_back(&event);
+            }
+        }
+
+        const auto frameNumber = [](const TraceEvent& frame) {
+            return std::stoull(frame.Name.substr(frame.Name.find(' ') + 1));
+        };
+
+        if (!state.Check(isThreadName("Bench \\\"Main\\\"", mainOuter->Tid) && isThreadName("Bench Worker", workerOuter->Tid), "threads are exported with their names") ||
+            !state.Check(mainInner->Tid == mainOuter->Tid && workerInner->Tid == workerOuter->Tid && mainOuter->Tid != workerOuter->Tid, "scopes carry the tid of their thread") ||
+            !state.Check(mainOuter->Ts >= 0.0 && mainOuter->Dur >= 150.0 && mainInner->Dur >= 50.0, "times are in microseconds from the capture start") ||
+            !state.Check(Contains(*mainOuter, *mainInner) && Contains(*workerOuter, *workerInner), "nested scopes lie within their parent") ||
+            !state.Check(workerOuter->Ts >= mainOuter->Ts + mainOuter->Dur, "the worker's scopes follow the main thread's") ||
+            !state.Check(frames.size() == 2 && frames[0]->Tid == mainOuter->Tid && frames[1]->Tid == mainOuter->Tid, "frame markers are on the frame thread") ||
+            !state.Check(frameNumber(*frames[1]) == frameNumber(*frames[0]) + 1, "frame markers are numbered in order") ||
+            !state.Check(frames[0]->Ts >= mainOuter->Ts + mainOuter->Dur && frames[1]->Ts >= workerOuter->Ts + workerOuter->Dur, "frame markers follow the scopes of their frame")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            DoNotOptimize(profiler.ExportChromeTrace(path.string()));
+        }
+
+        std::filesystem::remove(path);
+    }
+}
+
+CRX_BENCHMARK(ProfilerNow);
+CRX_BENCHMARK(ProfileScopeIdle);
+CRX_BENCHMARK(ProfileScopeCapturing);
+CRX_BENCHMARK(ProfilerExportChromeTrace);
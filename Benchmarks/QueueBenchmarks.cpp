@@ -0,0 +1,244 @@
+#include "Benchmark.h"
+#include "Core/LockFreeQueue.h"
+#include "Core/ThreadSafeQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+namespace {
+    constexpr size_t QueueCapacity = 4096;
+
+    template<class T>
+    bool TryPush(ThreadSafeQueue<T>& queue, T value) {
+        queue.Push(std::move(value));
+        return true;
+    }
+
+    template<class Queue, class T>
+    bool TryPush(Queue& queue, T value) {
+        return queue.TryPush(std::move(value));
+    }
+
+    template<class Queue>
+    Queue MakeQueue() {
+        if constexpr (std::is_constructible_v<Queue, size_t>) {
+            return Queue(QueueCapacity);
+        }
+        else {
+            return Queue();
+        }
+    }
+
+    template<class Queue>
+    constexpr bool HasBatch = !std::is_same_v<Queue, ThreadSafeQueue<uint64_t>>;
+
+    //One push followed by one pop, the cost of the queue without contention
+    template<class Queue>
+    void QueuePushPop(State& state) {
+        auto queue = MakeQueue<Queue>();
+        uint64_t value = 0;
+
+        for (auto _ : state) {
+            TryPush(queue, value);
+            queue.TryPop(value);
+            DoNotOptimize(value);
+        }
+    }
+
+    //GetArg() values pushed with one TryPushBatch and popped with one TryPopBatch
+    template<class Queue>
+    void QueuePushPopBatch(State& state) {
+        const auto batchSize = static_cast<size_t>(state.GetArg());
+
+        auto queue = MakeQueue<Queue>();
+        std::vector<uint64_t> values(batchSize);
+        std::vector<uint64_t> popped(batchSize);
+
+        for (size_t i = 0; i < batchSize; ++i) {
+            values[i] = i;
+        }
+
+        const bool isFifo = queue.TryPushBatch(values.begin(), values.end()) == batchSize &&
+                            queue.TryPopBatch(popped.begin(), batchSize + 1) == batchSize &&
+                            popped == values;
+
+        //A full queue takes what fits, an empty one gives nothing
+        std::vector<uint64_t> overflow(queue.Capacity() + 1);
+        const bool isBounded = queue.TryPushBatch(overflow.begin(), overflow.end()) == queue.Capacity() &&
+                               queue.TryPushBatch(values.begin(), values.end()) == 0 &&
+                               queue.TryPopBatch(overflow.begin(), overflow.size()) == queue.Capacity() &&
+                               queue.TryPopBatch(popped.begin(), batchSize) == 0;
+
+        if (!state.Check(isFifo, "a batch is popped in the order it was pushed") ||
+            !state.Check(isBounded, "batches stop at the capacity and at empty")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            queue.TryPushBatch(values.begin(), values.end());
+            queue.TryPopBatch(popped.begin(), batchSize);
+            DoNotOptimize(popped.data());
+        }
+
+        state.SetItemsPerIteration(batchSize);
+    }
+
+    //numPairs producers push perThread values each and as many consumers pop them, batchSize
+    //at a time when it is above 1. Producer p pushes p * perThread up to (p + 1) * perThread,
+    //consume sees every value popped.
+    template<class Queue, class Consume>
+    void MoveValues(uint32_t numPairs, uint64_t perThread, size_t batchSize, Consume consume) {
+        const auto total = numPairs * perThread;
+
+        auto queue = MakeQueue<Queue>();
+        std::atomic_bool go{ false };
+        std::atomic_uint64_t numPopped{ 0 };
+        std::vector<std::thread> threads;
+
+        const auto waitForGo = [&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        };
+
+        for (uint32_t i = 0; i < numPairs; ++i) {
+            threads.emplace_back([&, i] {
+                waitForGo();
+
+                std::vector<uint64_t> batch(batchSize);
+                auto value = i * perThread;
+                const auto end = value + perThread;
+
+                while (value < end) {
+                    if constexpr (HasBatch<Queue>) {
+                        if (batchSize > 1) {
+                            const auto count = std::min<uint64_t>(batchSize, end - value);
+                            std::iota(batch.begin(), batch.begin() + count, value);
+
+                            //A batch can go in over several calls when the queue is nearly full
+                            for (size_t pushed = 0; pushed < count;) {
+                                const auto n = queue.TryPushBatch(batch.begin() + pushed, batch.begin() + count);
+                                pushed += n;
+
+                                if (n == 0) {
+                                    std::this_thread::yield();
+                                }
+                            }
+
+                            value += count;
+                            continue;
+                        }
+                    }
+
+                    if (TryPush(queue, value)) {
+                        ++value;
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+            threads.emplace_back([&] {
+                waitForGo();
+
+                std::vector<uint64_t> batch(batchSize);
+
+                while (numPopped.load(std::memory_order_relaxed) < total) {
+                    size_t count = 0;
+
+                    if constexpr (HasBatch<Queue>) {
+                        count = queue.TryPopBatch(batch.begin(), batchSize);
+                    }
+                    else {
+                        count = queue.TryPop(batch[0]) ? 1 : 0;
+                    }
+
+                    if (count == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    for (size_t j = 0; j < count; ++j) {
+                        consume(batch[j]);
+                    }
+                    numPopped.fetch_add(count, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        go.store(true, std::memory_order_release);
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    //Every value pushed is popped exactly once
+    template<class Queue>
+    bool IsExactlyOnce(uint32_t numPairs, size_t batchSize) {
+        constexpr uint64_t PerThread = 4 * QueueCapacity;
+
+        std::vector<std::atomic_uint32_t> seen(numPairs * PerThread);
+        std::atomic_bool isInRange{ true };
+
+        MoveValues<Queue>(numPairs, PerThread, batchSize, [&](uint64_t value) {
+            if (value < seen.size()) {
+                seen[value].fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                isInRange = false;
+            }
+        });
+
+        return isInRange && std::all_of(seen.begin(), seen.end(), [](const auto& count) { return count.load() == 1; });
+    }
+
+    //GetArg() producers and as many consumers move GetIterations() values in total
+    template<class Queue, size_t BatchSize = 1>
+    void QueueContended(State& state) {
+        const auto numPairs  = static_cast<uint32_t>(state.GetArg());
+        const auto perThread = std::max<uint64_t>(1, state.GetIterations() / numPairs);
+
+        if (!state.Check(IsExactlyOnce<Queue>(numPairs, BatchSize), "every value is popped exactly once")) {
+            return;
+        }
+
+        state.StartTimer();
+        MoveValues<Queue>(numPairs, perThread, BatchSize, [](uint64_t value) { DoNotOptimize(value); });
+        state.StopTimer();
+    }
+
+    void ThreadSafeQueuePushPop(State& state) { QueuePushPop<ThreadSafeQueue<uint64_t>>(state); }
+    void SPSCQueuePushPop(State& state)       { QueuePushPop<SPSCQueue<uint64_t>>(state); }
+    void MPMCQueuePushPop(State& state)       { QueuePushPop<MPMCQueue<uint64_t>>(state); }
+
+    void SPSCQueuePushPopBatch(State& state) { QueuePushPopBatch<SPSCQueue<uint64_t>>(state); }
+    void MPMCQueuePushPopBatch(State& state) { QueuePushPopBatch<MPMCQueue<uint64_t>>(state); }
+
+    void ThreadSafeQueueContended(State& state) { QueueContended<ThreadSafeQueue<uint64_t>>(state); }
+    void MPMCQueueContended(State& state)       { QueueContended<MPMCQueue<uint64_t>>(state); }
+    void MPMCQueueContendedBatch(State& state)  { QueueContended<MPMCQueue<uint64_t>, 32>(state); }
+
+    //The SPSC queue only allows a single producer and consumer
+    void SPSCQueueProducerConsumer(State& state)      { QueueContended<SPSCQueue<uint64_t>>(state); }
+    void SPSCQueueProducerConsumerBatch(State& state) { QueueContended<SPSCQueue<uint64_t>, 32>(state); }
+}
+
+CRX_BENCHMARK(ThreadSafeQueuePushPop);
+CRX_BENCHMARK(SPSCQueuePushPop);
+CRX_BENCHMARK(MPMCQueuePushPop);
+
+CRX_BENCHMARK_ARGS(SPSCQueuePushPopBatch, 8, 64);
+CRX_BENCHMARK_ARGS(MPMCQueuePushPopBatch, 8, 64);
+
+CRX_BENCHMARK_ARGS(ThreadSafeQueueContended, 1, 2, 4, 8, 16, 32);
+CRX_BENCHMARK_ARGS(MPMCQueueContended, 1, 2, 4, 8, 16, 32);
+CRX_BENCHMARK_ARGS(MPMCQueueContendedBatch, 1, 2, 4, 8, 16, 32);
+CRX_BENCHMARK_ARGS(SPSCQueueProducerConsumer, 1);
+CRX_BENCHMARK_ARGS(SPSCQueueProducerConsumerBatch, 1);
@@ -0,0 +1,190 @@
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include "MathChecks.h"
+#include "Core/Math/RNG.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+namespace {
+    constexpr uint64_t Seed = 0x5EED;
+
+    //What Rng::Random did before, a new engine seeded from std::random_device on every call
+    void RandomPerCallEngine(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        std::vector<float> out(count);
+
+        for (auto _ : state) {
+            for (auto& value : out) {
+                std::default_random_engine engine{ std::random_device{}() };
+                value = std::uniform_real_distribution<float>{ 0.0f, 1.0f }(engine);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    void RandomNextFloat(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        std::vector<float> out(count);
+        Rng rng(Seed);
+
+        for (auto _ : state) {
+            for (auto& value : out) {
+                value = rng.NextFloat();
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //Every kernel has to produce the scalar kernel's stream bit for bit, or replays would depend
+    //on the CPU they run on
+    using FloatKernel = void(*)(RngState& state, float* out, size_t blocks) noexcept;
+
+    template<FloatKernel Kernel, IsaLevel KernelIsa>
+    void RandomFloatKernel(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        const auto blocks = static_cast<size_t>(state.GetArg()) / RngState::Lanes;
+        std::vector<float> out(blocks * RngState::Lanes);
+        std::vector<float> expected(out.size());
+
+        RngState kernelState{};
+        RngState expectedState{};
+
+        for (size_t lane = 0; lane < RngState::Lanes; ++lane) {
+            for (size_t word = 0; word < 4; ++word) {
+                kernelState.S[word][lane] = expectedState.S[word][lane] = static_cast<uint32_t>(Seed + lane * 4 + word);
+            }
+        }
+
+        //Twice, so the state the kernel stores is checked as well
+        for (int pass = 0; pass < 2; ++pass) {
+            Kernel(kernelState, out.data(), blocks);
+            RngKernels::NextFloats_Scalar(expectedState, expected.data(), blocks);
+
+            if (!state.Check(out == expected, "matches the scalar stream")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            Kernel(kernelState, out.data(), blocks);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(out.size());
+    }
+
+    //Fills of odd sizes in between single draws have to continue the single draw sequence
+    void RandomFillDispatched(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        std::vector<float> out(count);
+
+        Rng rng(Seed, 1);
+        Rng reference(Seed, 1);
+
+        const bool isSameStart = rng.NextFloat() == reference.NextFloat();
+        rng.Fill(out);
+
+        bool isSameSequence = isSameStart;
+        for (const auto value : out) {
+            isSameSequence = isSameSequence && value == reference.NextFloat();
+        }
+
+        std::vector<int32_t> ints(count);
+        rng.Fill(ints, -5, 5);
+
+        for (const auto value : ints) {
+            isSameSequence = isSameSequence && value == reference.Range(-5, 5);
+        }
+
+        if (!state.Check(isSameSequence && rng.NextUInt() == reference.NextUInt(), "matches the single draws")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            rng.Fill(out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    void RandomFillOnUnitSphere(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        Vector3SoA out(count);
+        Rng rng(Seed);
+
+        rng.FillOnHemisphere(out, Vector3::Up);
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto point = out.Get(i);
+
+            if (!state.Check(std::abs(point.Length() - 1.0f) < 1e-5f && point.y >= 0.0f, "on the upper unit hemisphere")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            rng.FillOnUnitSphere(out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    void RandomFillInUnitDisk(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        std::vector<float> x(count);
+        std::vector<float> y(count);
+        Rng rng(Seed);
+
+        rng.FillInUnitDisk(x, y);
+
+        for (size_t i = 0; i < count; ++i) {
+            if (!state.Check(x[i] * x[i] + y[i] * y[i] <= 1.0f + 1e-6f, "in the unit disk")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            rng.FillInUnitDisk(x, y);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    using namespace RngKernels;
+
+    void RandomFloatsScalar(State& state) { RandomFloatKernel<NextFloats_Scalar, IsaLevel::Scalar>(state); }
+#if CRX_SIMD_X86
+    void RandomFloatsSSE(State& state)    { RandomFloatKernel<NextFloats_SSE, IsaLevel::SSE>(state); }
+    void RandomFloatsAVX2(State& state)   { RandomFloatKernel<NextFloats_AVX2, IsaLevel::AVX2>(state); }
+    void RandomFloatsAVX512(State& state) { RandomFloatKernel<NextFloats_AVX512, IsaLevel::AVX512>(state); }
+#endif
+}
+
+CRX_BENCHMARK_ARGS(RandomPerCallEngine, 1024);
+CRX_BENCHMARK_ARGS(RandomNextFloat, 65536);
+CRX_BENCHMARK_ARGS(RandomFloatsScalar, 65536);
+#if CRX_SIMD_X86
+CRX_BENCHMARK_ARGS(RandomFloatsSSE, 65536);
+CRX_BENCHMARK_ARGS(RandomFloatsAVX2, 65536);
+CRX_BENCHMARK_ARGS(RandomFloatsAVX512, 65536);
+#endif
+//An odd count so the buffered values and the tail are covered
+CRX_BENCHMARK_ARGS(RandomFillDispatched, 65531);
+CRX_BENCHMARK_ARGS(RandomFillOnUnitSphere, 65536);
+CRX_BENCHMARK_ARGS(RandomFillInUnitDisk, 65536);
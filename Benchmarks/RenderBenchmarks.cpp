@@ -0,0 +1,234 @@
+#include "Benchmark.h"
+#include "JobSystemInstance.h"
+#include "Core/Math/Matrix.h"
+#include "Core/Math/Rectangle.h"
+#include "Graphics/API/Null/NullDevice.h"
+#include "Graphics/EffectPSO.h"
+#include "Graphics/Lights.h"
+#include "Graphics/Material.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/RenderList.h"
+#include "Graphics/Viewport.h"
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+//Records frames into the null backend with the same EffectPSO, Mesh and DrawRenderItems
+//Graphics::RecordScene uses. The GPU objects are stand-ins passed to EffectPSO and Mesh.
+namespace {
+    //Stand-ins for GPU objects. The null backend only compares and tracks them, it never
+    //dereferences them, so they share one allocation instead of being real objects.
+    template<class T>
+    std::shared_ptr<T> MakeHandle(const std::shared_ptr<std::byte[]>& storage, size_t index) {
+        return std::shared_ptr<T>(storage, reinterpret_cast<T*>(storage.get() + index));
+    }
+
+    //The lighting effect with the lights of the Sponza scene
+    EffectPSO MakeEffect(const std::shared_ptr<std::byte[]>& handles) {
+        EffectPSO effect(MakeHandle<RootSignature>(handles, 0), MakeHandle<PipelineStateObject>(handles, 1), MakeHandle<ShaderResourceView>(handles, 2));
+
+        effect.SetPointLights(std::vector<PointLight>(4));
+        effect.SetSpotLights(std::vector<SpotLight>(2));
+        effect.SetDirectionalLights(std::vector<DirectionalLight>(1));
+
+        return effect;
+    }
+
+    constexpr size_t LightBytes = 4 * sizeof(PointLight) + 2 * sizeof(SpotLight) + sizeof(DirectionalLight);
+
+    //Sponza sized material set, every material with a diffuse, normal and specular texture
+    std::vector<std::unique_ptr<Mesh>> MakeMeshes(const std::shared_ptr<std::byte[]>& handles, size_t numMeshes, uint32_t indexCount) {
+        constexpr size_t NumMaterials = 32;
+        size_t nextHandle = 16;
+
+        std::vector<std::shared_ptr<Material>> materials;
+
+        for (size_t i = 0; i < NumMaterials; ++i) {
+            auto material = std::make_shared<Material>(Material::White);
+            material->SetTexture(Material::Diffuse, MakeHandle<Texture>(handles, nextHandle++));
+            material->SetTexture(Material::Normal, MakeHandle<Texture>(handles, nextHandle++));
+            material->SetTexture(Material::Specular, MakeHandle<Texture>(handles, nextHandle++));
+            materials.push_back(std::move(material));
+        }
+
+        std::vector<std::unique_ptr<Mesh>> meshes;
+
+        for (size_t i = 0; i < numMeshes; ++i) {
+            auto mesh = std::make_unique<Mesh>();
+            mesh->SetVertexBuffer(0, MakeHandle<VertexBuffer>(handles, nextHandle++), indexCount);
+            mesh->SetIndexBuffer(MakeHandle<IndexBuffer>(handles, nextHandle++), indexCount);
+            mesh->SetMaterial(materials[i % NumMaterials]);
+            meshes.push_back(std::move(mesh));
+        }
+
+        return meshes;
+    }
+
+    //Graphics::RecordRenderItems into one command list, then submitting it
+    void RecordFrame(State& state) {
+        const auto numItems = static_cast<uint32_t>(state.GetArg());
+        constexpr uint32_t IndexCount = 3 * 1024;
+
+        auto handles      = std::make_shared<std::byte[]>(16 + 32 * 3 + numItems * 2);
+        const auto meshes = MakeMeshes(handles, numItems, IndexCount);
+        const auto effect = MakeEffect(handles);
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> dist(-50.0f, 50.0f);
+
+        std::vector<RenderItem> items;
+
+        for (const auto& mesh : meshes) {
+            items.push_back({ Matrix(Vector3(dist(rng), dist(rng), dist(rng)), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)), mesh.get() });
+        }
+
+        NullDevice device;
+        auto& commandQueue = device.GetNullQueue(QueueType::Direct);
+
+        const Viewport viewport{ 0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f };
+        const Rectangle scissorRect;
+
+        const auto recordFrame = [&] {
+            auto commandList = commandQueue.AcquireCommandList();
+
+            commandList->SetViewport(viewport);
+            commandList->SetScissorRect(scissorRect);
+
+            DrawRenderItems(*commandList, effect, items);
+
+            return commandList;
+        };
+
+        //Every item sets its world matrix and material, the lights are only uploaded once
+        auto commandList   = recordFrame();
+        const auto& stats  = static_cast<const NullCommandList&>(*commandList).GetStats();
+        const auto n       = uint64_t{ numItems };
+
+        const bool isDrawn = stats.NumDraws == n && stats.NumVertices == n * IndexCount && stats.NumBufferBindings == 2 * n;
+
+        const bool isStateFiltered = stats.NumPipelineStateChanges == 1 && stats.NumRootSignatureChanges == 1 &&
+                                     //Pipeline state, root signature and topology of every item after the first
+                                     stats.NumRedundantStateChanges == 3 * (n - 1);
+
+        const bool isUploaded = stats.NumUploads == 2 * n + 3 && stats.NumRootConstantUpdates == 1 &&
+                                stats.NumUploadedBytes == n * (sizeof(EffectPSO::Matrices) + sizeof(MaterialProperties)) + LightBytes &&
+                                stats.NumDescriptorsStaged == n * Material::NumTypes && stats.NumDescriptorTablesCommitted == n;
+
+        //Applying again without a change only sets the pipeline state and root signature
+        EffectPSO unchanged = effect;
+        unchanged.Apply(*commandList);
+        const auto numUploads = stats.NumUploads;
+        unchanged.Apply(*commandList);
+
+        const bool isClean = stats.NumUploads == numUploads && stats.NumRedundantStateChanges == 3 * (n - 1) + 4;
+
+        commandQueue.Submit({ &commandList, 1 });
+
+        if (!state.Check(isDrawn, "every item is drawn with its buffers") ||
+            !state.Check(isStateFiltered, "the pipeline state and root signature are set once") ||
+            !state.Check(isUploaded, "matrices and materials are uploaded per item, the lights once") ||
+            !state.Check(isClean, "an effect without changes uploads nothing")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            commandList = recordFrame();
+
+            auto fenceValue = commandQueue.Submit({ &commandList, 1 });
+            DoNotOptimize(fenceValue);
+        }
+
+        state.SetItemsPerIteration(numItems);
+    }
+
+    //4000 meshes split into at most GetArg() chunks, recorded in parallel with RecordChunks
+    //and submitted in chunk order
+    void RecordChunksParallel(State& state) {
+        constexpr uint32_t NumItems = 4000;
+        const auto maxChunks = static_cast<uint32_t>(state.GetArg());
+
+        auto& jobSystem = GetJobSystem();
+        auto handles    = std::make_shared<std::byte[]>(16 + 2 * NumItems);
+        const auto effect = MakeEffect(handles);
+
+        //Mesh i draws 3 * (i + 1) indices, so the work of a list tells which items it holds
+        std::vector<std::unique_ptr<Mesh>> meshes;
+        std::vector<RenderItem> items;
+
+        for (uint32_t i = 0; i < NumItems; ++i) {
+            auto mesh = std::make_unique<Mesh>();
+            mesh->SetVertexBuffer(0, MakeHandle<VertexBuffer>(handles, 16 + 2 * i), 3);
+            mesh->SetIndexBuffer(MakeHandle<IndexBuffer>(handles, 16 + 2 * i + 1), 3 * (i + 1));
+
+            items.push_back({ Matrix(), mesh.get() });
+            meshes.push_back(std::move(mesh));
+        }
+
+        NullDevice device;
+        auto& commandQueue = device.GetNullQueue(QueueType::Direct);
+
+        const auto chunks = SplitIntoChunks(items.size(), 256, maxChunks);
+
+        const auto acquire = [&](uint32_t) { return commandQueue.AcquireCommandList(); };
+        const auto record  = [&](ICommandList& commandList, const RenderChunk& chunk) {
+            DrawRenderItems(commandList, effect, std::span(items).subspan(chunk.Begin, chunk.Size()));
+        };
+
+        //Every chunk is contiguous, starts where the last one ended and is at most one item
+        //larger than any other
+        bool isSplit = !chunks.empty() && chunks.size() <= maxChunks && chunks.back().End == NumItems;
+
+        for (size_t i = 0; i < chunks.size() && isSplit; ++i) {
+            isSplit = chunks[i].Begin == (i == 0 ? 0 : chunks[i - 1].End) &&
+                      chunks[i].Size() + 1 >= chunks.front().Size() &&
+                      chunks[i].Size() <= chunks.back().Size() + 1;
+        }
+
+        auto commandLists = RecordChunks<std::shared_ptr<ICommandList>>(jobSystem, chunks, acquire, record);
+
+        bool isInOrder       = commandLists.size() == chunks.size();
+        bool isEffectApplied = true;
+
+        for (size_t i = 0; i < commandLists.size() && isInOrder; ++i) {
+            const auto& stats = static_cast<const NullCommandList&>(*commandLists[i]).GetStats();
+
+            //3 * (Begin + 1) + ... + 3 * End
+            const auto first = uint64_t{ chunks[i].Begin } + 1;
+            const auto last  = uint64_t{ chunks[i].End };
+
+            isInOrder = stats.NumDraws == chunks[i].Size() && stats.NumVertices == 3 * (first + last) * (last - first + 1) / 2;
+
+            //Root arguments don't carry over between lists, so every list binds the effect
+            //and uploads the lights again
+            isEffectApplied = isEffectApplied && stats.NumPipelineStateChanges == 1 && stats.NumUploads == chunks[i].Size() + 3;
+        }
+
+        commandQueue.Submit(commandLists);
+
+        const auto stats = commandQueue.GetStats();
+
+        if (!state.Check(isSplit, "SplitIntoChunks covers every item with balanced chunks") ||
+            !state.Check(isInOrder, "RecordChunks returns the lists in chunk order") ||
+            !state.Check(isEffectApplied, "every list applies the effect from scratch") ||
+            !state.Check(stats.NumDraws == NumItems && stats.NumVertices == 3ull * NumItems * (NumItems + 1) / 2, "every item is drawn once")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            commandLists = RecordChunks<std::shared_ptr<ICommandList>>(jobSystem, chunks, acquire, record);
+
+            auto fenceValue = commandQueue.Submit(commandLists);
+            DoNotOptimize(fenceValue);
+        }
+
+        state.SetItemsPerIteration(NumItems);
+    }
+}
+
+CRX_BENCHMARK_ARGS(RecordFrame, 400, 4000);
+CRX_BENCHMARK_ARGS(RecordChunksParallel, 1, 2, 4, 8, 16);
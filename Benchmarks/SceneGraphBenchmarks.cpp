@@ -0,0 +1,542 @@
+#include "Benchmark.h"
+#include "JobSystemInstance.h"
+#include "MathChecks.h"
+#include "Core/Math/Affine3x4.h"
+#include "Core/Math/Matrix.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/Vector3.h"
+#include "Core/PoolAllocator.h"
+#include "Core/Visitor.h"
+#include "Graphics/SceneNode.h"
+#include "Graphics/TransformHierarchy.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+namespace {
+    //Calls func for every node, in the order SceneVisitor sees them
+    template<class Func>
+    class NodeVisitor final : public IVisitor {
+    public:
+        explicit NodeVisitor(Func& func) noexcept
+            :
+            m_func(func)
+        {}
+
+        void Visit(Scene&) override {}
+        void Visit(SceneNode& sceneNode) override { m_func(sceneNode); }
+        void Visit(Mesh&) override {}
+    private:
+        Func& m_func;
+    };
+
+    template<class Func>
+    void ForEachNode(SceneNode& root, Func&& func) {
+        NodeVisitor<std::remove_reference_t<Func>> visitor(func);
+        root.Accept(visitor);
+    }
+
+    //Builds a tree level by level with a few children per node, about as deep as an imported
+    //scene. Names are long enough to be allocated on the heap between the nodes, like assimp's.
+    template<class MakeNode>
+    std::shared_ptr<SceneNode> BuildScene(size_t numNodes, MakeNode&& makeNode) {
+        std::mt19937 rng(99);
+        std::uniform_int_distribution<int> childDist(1, 6);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        auto root = makeNode();
+        size_t numCreated = 1;
+
+        std::vector<SceneNode*> parents{ root.get() };
+
+        for (size_t next = 0; next < parents.size() && numCreated < numNodes; ++next) {
+            const auto parent = parents[next];
+
+            const auto numChildren = childDist(rng);
+
+            for (int i = 0; i < numChildren && numCreated < numNodes; ++i, ++numCreated) {
+                auto node = makeNode();
+                node->SetName("sponza_node_" + std::to_string(numCreated) + "_Material");
+                node->SetLocalTransform(Matrix(
+                    Vector3(dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f),
+                    Quaternion::FromPitchYawRoll(dist(rng), dist(rng), dist(rng)),
+                    Vector3(1.0f, 1.0f, 1.0f)));
+
+                parent->AddChild(node);
+                parents.push_back(node.get());
+            }
+        }
+
+        return root;
+    }
+
+    std::shared_ptr<SceneNode> MakeSharedNode() { return std::make_shared<SceneNode>(); }
+    std::shared_ptr<SceneNode> MakePooledNode() { return MakePooled<SceneNode>(); }
+
+    template<class MakeNode>
+    void SceneGraphBuild(State& state, MakeNode&& makeNode) {
+        const auto numNodes = static_cast<size_t>(state.GetArg());
+
+        for (auto _ : state) {
+            auto root = BuildScene(numNodes, makeNode);
+            DoNotOptimize(root);
+        }
+
+        state.SetItemsPerIteration(numNodes);
+    }
+
+    //Every node asks for its world transform, like SceneVisitor::Visit does each frame
+    template<class MakeNode>
+    void SceneGraphTraverse(State& state, MakeNode&& makeNode) {
+        const auto numNodes = static_cast<size_t>(state.GetArg());
+        const auto root     = BuildScene(numNodes, makeNode);
+
+        for (auto _ : state) {
+            Matrix sum;
+
+            ForEachNode(*root, [&](const SceneNode& node) {
+                const auto world = node.GetWorldTransform();
+                sum.m30 += world.m30;
+            });
+
+            DoNotOptimize(sum);
+        }
+
+        state.SetItemsPerIteration(numNodes);
+    }
+
+    //Chains of HierarchyDepth nodes stored parent first, the order a flattened hierarchy is
+    //updated in. Isolates the cost of composing the transforms from walking the nodes.
+    constexpr size_t HierarchyDepth = 64;
+    constexpr uint32_t NoParent     = UINT32_MAX;
+
+    Matrix ToMatrix(const Matrix& matrix)    { return matrix; }
+    Matrix ToMatrix(const Affine3x4& affine) { return affine.ToMatrix(); }
+
+    template<class Transform>
+    void SceneGraphDeepHierarchy(State& state) {
+        const auto numNodes = static_cast<size_t>(state.GetArg());
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        std::vector<Transform> local;
+        std::vector<Transform> world(numNodes);
+        std::vector<uint32_t> parents(numNodes);
+        local.reserve(numNodes);
+
+        for (size_t i = 0; i < numNodes; ++i) {
+            local.emplace_back(Matrix(
+                Vector3(dist(rng), dist(rng), dist(rng)),
+                Quaternion::FromPitchYawRoll(dist(rng) * 0.1f, dist(rng) * 0.1f, dist(rng) * 0.1f),
+                Vector3(1.0f, 1.0f, 1.0f)));
+
+            parents[i] = (i % HierarchyDepth == 0) ? NoParent : static_cast<uint32_t>(i - 1);
+        }
+
+        const auto update = [&] {
+            for (size_t i = 0; i < numNodes; ++i) {
+                world[i] = parents[i] == NoParent ? local[i] : local[i] * world[parents[i]];
+            }
+        };
+
+        //Against the scalar Matrix product. The error grows with the depth of the chain.
+        update();
+
+        Matrix expected;
+        for (size_t i = 0; i < numNodes; ++i) {
+            expected = parents[i] == NoParent ? ToMatrix(local[i]) : Matrix::MultiplyScalar(ToMatrix(local[i]), expected);
+
+            if (!state.Check(NearlyEqual(ToMatrix(world[i]), expected, 16 * HierarchyDepth, MaxMagnitude(expected.Data(), 16)), "world transforms match the Matrix reference")) {
+                return;
+            }
+        }
+
+        DoNotOptimize(world);
+
+        for (auto _ : state) {
+            update();
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(numNodes);
+    }
+
+    void SceneGraphDeepHierarchyMatrix(State& state) { SceneGraphDeepHierarchy<Matrix>(state); }
+    void SceneGraphDeepHierarchyAffine(State& state) { SceneGraphDeepHierarchy<Affine3x4>(state); }
+
+    Matrix MakeSmallTransform(std::mt19937& rng) {
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        return Matrix(
+            Vector3(dist(rng), dist(rng), dist(rng)),
+            Quaternion::FromPitchYawRoll(dist(rng) * 0.1f, dist(rng) * 0.1f, dist(rng) * 0.1f),
+            Vector3(1.0f, 1.0f, 1.0f));
+    }
+
+    //Deep puts chains of HierarchyDepth nodes under the root, wide puts every node directly under it
+    size_t GetSyntheticParent(size_t node, bool isDeep) noexcept {
+        const bool isChainStart = !isDeep || (node - 1) % HierarchyDepth == 0;
+        return isChainStart ? 0 : node - 1;
+    }
+
+    //Every node, the root first. That is also the order they are visited in.
+    std::vector<std::shared_ptr<SceneNode>> BuildSyntheticScene(size_t numNodes, bool isDeep) {
+        std::mt19937 rng(13);
+
+        std::vector<std::shared_ptr<SceneNode>> nodes{ MakePooledNode() };
+        nodes.reserve(numNodes);
+
+        for (size_t i = 1; i < numNodes; ++i) {
+            auto node = MakePooledNode();
+            node->SetLocalTransform(MakeSmallTransform(rng));
+
+            nodes[GetSyntheticParent(i, isDeep)]->AddChild(node);
+            nodes.push_back(std::move(node));
+        }
+
+        return nodes;
+    }
+
+    //The walk to the root SceneNode did on every call before the world transforms were cached
+    Affine3x4 ComposeWorldAffine(const std::vector<std::shared_ptr<SceneNode>>& nodes, size_t node, bool isDeep) noexcept {
+        if (node == 0) {
+            return nodes[0]->GetLocalAffine() * Affine3x4();
+        }
+        return nodes[node]->GetLocalAffine() * ComposeWorldAffine(nodes, GetSyntheticParent(node, isDeep), isDeep);
+    }
+
+    //Every node every frame, like SceneVisitor. Uncached is the walk to the root per node, cached
+    //reads the stored transforms and animated moves every 64th node before the traversal.
+    enum class WorldUpdate { Uncached, Cached, Animated };
+    constexpr size_t AnimatedStride = 64;
+
+    template<bool IsDeep, WorldUpdate Update>
+    void SceneGraphWorld(State& state) {
+        const auto numNodes = static_cast<size_t>(state.GetArg());
+        const auto nodes    = BuildSyntheticScene(numNodes, IsDeep);
+        const auto& root    = nodes.front();
+
+        //The cache against the walk, the same products in the same order
+        for (size_t i = 0; i < numNodes; ++i) {
+            if (!state.Check(nodes[i]->GetWorldTransform() == ComposeWorldAffine(nodes, i, IsDeep).ToMatrix(), "cached world transforms match the walk")) {
+                return;
+            }
+        }
+
+        size_t numVisited = 0;
+        ForEachNode(*root, [&](const SceneNode& node) {
+            numVisited += &node == nodes[numVisited].get();
+        });
+
+        if (!state.Check(numVisited == numNodes, "nodes are visited in the order they were created")) {
+            return;
+        }
+
+        //Moving a node changes its version and its descendants', nothing else
+        std::vector<uint64_t> versions;
+        for (const auto& node : nodes) {
+            versions.push_back(node->GetWorldVersion());
+        }
+
+        const auto moved = numNodes / 2;
+        nodes[moved]->SetLocalTransform(Matrix());
+
+        for (size_t i = 0; i < numNodes; ++i) {
+            const bool isMoved = i == moved || (IsDeep && i > moved && (i - 1) / HierarchyDepth == (moved - 1) / HierarchyDepth);
+
+            if (!state.Check((nodes[i]->GetWorldVersion() != versions[i]) == isMoved, "moving a node changes the versions below it")) {
+                return;
+            }
+            if (!state.Check(nodes[i]->GetWorldTransform() == ComposeWorldAffine(nodes, i, IsDeep).ToMatrix(), "moved world transforms match the walk")) {
+                return;
+            }
+        }
+
+        std::mt19937 rng(17);
+        std::vector<Matrix> animated;
+        for (size_t i = 1; i < numNodes; i += AnimatedStride) {
+            animated.push_back(MakeSmallTransform(rng));
+        }
+
+        for (auto _ : state) {
+            if constexpr (Update == WorldUpdate::Animated) {
+                for (size_t i = 1, j = 0; i < numNodes; i += AnimatedStride, ++j) {
+                    nodes[i]->SetLocalTransform(animated[j]);
+                }
+            }
+
+            float sum = 0.0f;
+            size_t i  = 0;
+
+            ForEachNode(*root, [&](const SceneNode& node) {
+                if constexpr (Update == WorldUpdate::Uncached) {
+                    sum += ComposeWorldAffine(nodes, i++, IsDeep).GetTranslation().x;
+                }
+                else {
+                    sum += node.GetWorldAffine().GetTranslation().x;
+                }
+            });
+
+            DoNotOptimize(sum);
+        }
+
+        state.SetItemsPerIteration(numNodes);
+    }
+
+    //The world transform from the parent chain, independent of the order the arrays are in
+    Affine3x4 ComposeWorldTransform(const TransformHierarchy& hierarchy, TransformHierarchy::Handle node) {
+        const auto parent = hierarchy.GetParent(node);
+
+        if (parent == TransformHierarchy::InvalidHandle) {
+            return hierarchy.GetLocalTransform(node);
+        }
+        return hierarchy.GetLocalTransform(node) * ComposeWorldTransform(hierarchy, parent);
+    }
+
+    //A random tree created in no particular order, then reshaped, so the arrays are reordered
+    //on almost every change
+    bool CheckTransformHierarchy(State& state) {
+        constexpr size_t NumNodes = 1000;
+
+        std::mt19937 rng(21);
+        TransformHierarchy hierarchy;
+
+        std::vector<TransformHierarchy::Handle> handles{ hierarchy.Create(Affine3x4(MakeSmallTransform(rng))) };
+
+        for (size_t i = 1; i < NumNodes; ++i) {
+            const auto parent = handles[std::uniform_int_distribution<size_t>(0, i - 1)(rng)];
+            handles.push_back(hierarchy.Create(Affine3x4(MakeSmallTransform(rng)), parent));
+        }
+
+        const auto check = [&](const char* message) {
+            hierarchy.Update(GetJobSystem());
+
+            for (auto handle : handles) {
+                if (!state.Check(hierarchy.GetWorldTransform(handle).ToMatrix() == ComposeWorldTransform(hierarchy, handle).ToMatrix(), message)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        const auto isInSubtree = [&](TransformHierarchy::Handle node, TransformHierarchy::Handle root) {
+            for (; node != TransformHierarchy::InvalidHandle; node = hierarchy.GetParent(node)) {
+                if (node == root) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        if (!check("created nodes match their parent chain")) {
+            return false;
+        }
+
+        //Under another node, which may come before or after it in the arrays, or to a root
+        for (size_t i = 1; i + 1 < NumNodes; i += 7) {
+            const auto parent = i % 2 ? handles[std::uniform_int_distribution<size_t>(0, NumNodes - 1)(rng)] : TransformHierarchy::InvalidHandle;
+
+            if (parent == TransformHierarchy::InvalidHandle || !isInSubtree(parent, handles[i])) {
+                hierarchy.SetParent(handles[i], parent);
+            }
+            hierarchy.SetLocalTransform(handles[i + 1], Affine3x4(MakeSmallTransform(rng)));
+        }
+
+        if (!check("reparented nodes match their parent chain")) {
+            return false;
+        }
+
+        //Takes the descendants along
+        const auto destroyed = handles[NumNodes / 2];
+        std::erase_if(handles, [&](TransformHierarchy::Handle handle) { return isInSubtree(handle, destroyed); });
+
+        hierarchy.Destroy(destroyed);
+
+        if (!state.Check(hierarchy.GetNumNodes() == handles.size(), "destroying a node destroys its subtree")) {
+            return false;
+        }
+
+        return check("the rest survives destroying a subtree");
+    }
+
+    //The synthetic scenes again, as a TransformHierarchy
+    enum class FlatUpdate { SingleThreaded, Parallel };
+
+    template<bool IsDeep, FlatUpdate Update>
+    void SceneGraphFlat(State& state) {
+        if (!CheckTransformHierarchy(state)) {
+            return;
+        }
+
+        const auto numNodes = static_cast<size_t>(state.GetArg());
+        const auto nodes    = BuildSyntheticScene(numNodes, IsDeep);
+
+        TransformHierarchy hierarchy;
+        std::vector<TransformHierarchy::Handle> handles;
+
+        for (size_t i = 0; i < numNodes; ++i) {
+            const auto parent = i == 0 ? TransformHierarchy::InvalidHandle : handles[GetSyntheticParent(i, IsDeep)];
+            handles.push_back(hierarchy.Create(nodes[i]->GetLocalAffine(), parent));
+        }
+
+        auto& jobSystem = GetJobSystem();
+
+        const auto update = [&] {
+            if constexpr (Update == FlatUpdate::Parallel) {
+                hierarchy.Update(jobSystem);
+            }
+            else {
+                hierarchy.Update();
+            }
+        };
+
+        update();
+
+        for (size_t i = 0; i < numNodes; ++i) {
+            if (!state.Check(hierarchy.GetWorldTransform(handles[i]).ToMatrix() == nodes[i]->GetWorldTransform(), "flat world transforms match the scene graph")) {
+                return;
+            }
+        }
+
+        std::mt19937 rng(17);
+        std::vector<Affine3x4> animated;
+        for (size_t i = 1; i < numNodes; i += AnimatedStride) {
+            animated.emplace_back(MakeSmallTransform(rng));
+        }
+
+        //The work of SceneGraphWorld*Animated: move every 64th node, then read every world transform
+        for (auto _ : state) {
+            for (size_t i = 1, j = 0; i < numNodes; i += AnimatedStride, ++j) {
+                hierarchy.SetLocalTransform(handles[i], animated[j]);
+            }
+
+            update();
+
+            float sum = 0.0f;
+
+            for (auto handle : handles) {
+                sum += hierarchy.GetWorldTransform(handle).GetTranslation().x;
+            }
+
+            DoNotOptimize(sum);
+        }
+
+        state.SetItemsPerIteration(numNodes);
+    }
+
+    //The synthetic scenes bound to a TransformHierarchy. Every frame moves every 64th node,
+    //updates the hierarchy and reads every inverse world transform, only the moved ones are inverted.
+    template<bool IsDeep>
+    void SceneGraphBoundInverse(State& state) {
+        const auto numNodes = static_cast<size_t>(state.GetArg());
+        const auto nodes    = BuildSyntheticScene(numNodes, IsDeep);
+        const auto& root    = nodes.front();
+
+        std::vector<Matrix> inverses;
+        for (const auto& node : nodes) {
+            inverses.push_back(node->GetInverseWorldTransform());
+        }
+
+        const auto hierarchy = std::make_shared<TransformHierarchy>();
+        root->BindTransforms(hierarchy);
+
+        for (size_t i = 0; i < numNodes; ++i) {
+            if (!state.Check(nodes[i]->GetInverseWorldTransform() == inverses[i], "bound inverse world transforms match the unbound ones")) {
+                return;
+            }
+        }
+
+        //The hierarchy only moves nodes when it is updated, the cached inverse follows it
+        const auto moved = numNodes / 2;
+        nodes[moved]->SetLocalTransform(Matrix());
+
+        const bool isUntilUpdate = nodes[moved]->GetInverseWorldTransform() == inverses[moved];
+
+        hierarchy->Update();
+
+        for (size_t i = 0; i < numNodes; ++i) {
+            const bool isMoved = i == moved || (IsDeep && i > moved && (i - 1) / HierarchyDepth == (moved - 1) / HierarchyDepth);
+            const auto& node   = *nodes[i];
+            const auto inverse = node.GetInverseWorldTransform();
+
+            if (!state.Check(inverse == Affine3x4::Inverse(node.GetWorldAffine()).ToMatrix(), "cached inverses match the world transforms") ||
+                !state.Check((inverse != inverses[i]) == isMoved, "only the moved inverses change")) {
+                return;
+            }
+        }
+
+        if (!state.Check(isUntilUpdate, "the inverse changes with the update, not the local transform")) {
+            return;
+        }
+
+        std::mt19937 rng(17);
+        std::vector<Matrix> animated;
+        for (size_t i = 1; i < numNodes; i += AnimatedStride) {
+            animated.push_back(MakeSmallTransform(rng));
+        }
+
+        for (auto _ : state) {
+            for (size_t i = 1, j = 0; i < numNodes; i += AnimatedStride, ++j) {
+                nodes[i]->SetLocalTransform(animated[j]);
+            }
+
+            hierarchy->Update();
+
+            float sum = 0.0f;
+
+            ForEachNode(*root, [&](const SceneNode& node) {
+                sum += node.GetInverseWorldTransform().m30;
+            });
+
+            DoNotOptimize(sum);
+        }
+
+        state.SetItemsPerIteration(numNodes);
+    }
+
+    void SceneGraphBoundInverseDeep(State& state) { SceneGraphBoundInverse<true>(state); }
+    void SceneGraphBoundInverseWide(State& state) { SceneGraphBoundInverse<false>(state); }
+
+    void SceneGraphFlatDeepUpdate(State& state)         { SceneGraphFlat<true, FlatUpdate::SingleThreaded>(state); }
+    void SceneGraphFlatDeepParallelUpdate(State& state) { SceneGraphFlat<true, FlatUpdate::Parallel>(state); }
+    void SceneGraphFlatWideUpdate(State& state)         { SceneGraphFlat<false, FlatUpdate::SingleThreaded>(state); }
+    void SceneGraphFlatWideParallelUpdate(State& state) { SceneGraphFlat<false, FlatUpdate::Parallel>(state); }
+
+    void SceneGraphWorldDeepUncached(State& state) { SceneGraphWorld<true, WorldUpdate::Uncached>(state); }
+    void SceneGraphWorldDeepCached(State& state)   { SceneGraphWorld<true, WorldUpdate::Cached>(state); }
+    void SceneGraphWorldDeepAnimated(State& state) { SceneGraphWorld<true, WorldUpdate::Animated>(state); }
+    void SceneGraphWorldWideUncached(State& state) { SceneGraphWorld<false, WorldUpdate::Uncached>(state); }
+    void SceneGraphWorldWideCached(State& state)   { SceneGraphWorld<false, WorldUpdate::Cached>(state); }
+    void SceneGraphWorldWideAnimated(State& state) { SceneGraphWorld<false, WorldUpdate::Animated>(state); }
+
+    void SceneGraphBuildShared(State& state)    { SceneGraphBuild(state, MakeSharedNode); }
+    void SceneGraphBuildPooled(State& state)    { SceneGraphBuild(state, MakePooledNode); }
+    void SceneGraphTraverseShared(State& state) { SceneGraphTraverse(state, MakeSharedNode); }
+    void SceneGraphTraversePooled(State& state) { SceneGraphTraverse(state, MakePooledNode); }
+}
+
+CRX_BENCHMARK_ARGS(SceneGraphBuildShared, 1000, 100000);
+CRX_BENCHMARK_ARGS(SceneGraphBuildPooled, 1000, 100000);
+CRX_BENCHMARK_ARGS(SceneGraphTraverseShared, 1000, 100000);
+CRX_BENCHMARK_ARGS(SceneGraphTraversePooled, 1000, 100000);
+CRX_BENCHMARK_ARGS(SceneGraphDeepHierarchyMatrix, 4096, 262144);
+CRX_BENCHMARK_ARGS(SceneGraphDeepHierarchyAffine, 4096, 262144);
+CRX_BENCHMARK_ARGS(SceneGraphWorldDeepUncached, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphWorldDeepCached, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphWorldDeepAnimated, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphWorldWideUncached, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphWorldWideCached, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphWorldWideAnimated, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphFlatDeepUpdate, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphFlatDeepParallelUpdate, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphFlatWideUpdate, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphFlatWideParallelUpdate, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphBoundInverseDeep, 4096, 65536);
+CRX_BENCHMARK_ARGS(SceneGraphBoundInverseWide, 4096, 65536);
@@ -0,0 +1,135 @@
+#include "Benchmark.h"
+#include "Core/Time/FrameTimeHistogram.h"
+#include "Core/Time/GameTimer.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+
+namespace {
+    //Percentiles report the upper edge of their bucket
+    bool IsInBucketOf(double percentile, double milliseconds) noexcept {
+        return percentile >= milliseconds && percentile <= milliseconds + FrameTimeHistogram::BucketWidthMilliseconds;
+    }
+
+    void AddFrames(FrameTimeHistogram& histogram, uint32_t count, double milliseconds) noexcept {
+        for (uint32_t i = 0; i < count; ++i) {
+            histogram.AddFrame(milliseconds);
+        }
+    }
+
+    //Adding a frame to a full window and reading the stats every 64 frames, as an overlay would
+    void FrameTimeHistogramAddFrame(State& state) {
+        FrameTimeHistogram histogram;
+
+        //A steady 60 Hz with a few 30 and 10 Hz frames
+        AddFrames(histogram, 1000, 16.625);
+        AddFrames(histogram, 20, 34.025);
+        AddFrames(histogram, 4, 100.025);
+
+        const auto mixed = histogram.GetStats();
+        const double average = (1000 * 16.625 + 20 * 34.025 + 4 * 100.025) / FrameTimeHistogram::WindowSize;
+
+        const bool isMixedCorrect = mixed.NumFrames == FrameTimeHistogram::WindowSize &&
+                                    IsInBucketOf(mixed.P50Milliseconds, 16.625) &&
+                                    IsInBucketOf(mixed.P95Milliseconds, 16.625) &&
+                                    IsInBucketOf(mixed.P99Milliseconds, 34.025) &&
+                                    std::abs(mixed.MaxMilliseconds - 100.025) < 1e-4 &&
+                                    std::abs(mixed.AverageMilliseconds - average) < 1e-3;
+
+        //Only the frames slower than twice the median, to the bucket width
+        const bool isHitchCountCorrect = mixed.NumHitches == 24;
+
+        //A full window of steady frames pushes the slow ones out
+        AddFrames(histogram, FrameTimeHistogram::WindowSize, 8.325);
+        const auto steady = histogram.GetStats();
+
+        const bool isWindowSliding = steady.NumFrames == FrameTimeHistogram::WindowSize && steady.NumHitches == 0 &&
+                                     IsInBucketOf(steady.P99Milliseconds, 8.325) && std::abs(steady.MaxMilliseconds - 8.325) < 1e-4;
+
+        //Beyond the last bucket only the maximum is exact
+        histogram.Clear();
+        AddFrames(histogram, 98, 16.625);
+        AddFrames(histogram, 2, 500.0);
+        const auto stall = histogram.GetStats();
+
+        const bool isStallCorrect = stall.NumFrames == 100 && stall.NumHitches == 2 && stall.MaxMilliseconds == 500.0 &&
+                                    stall.P99Milliseconds == FrameTimeHistogram::NumBuckets * FrameTimeHistogram::BucketWidthMilliseconds;
+
+        histogram.Clear();
+
+        if (!state.Check(isMixedCorrect, "percentiles, maximum and average of a known distribution") ||
+            !state.Check(isHitchCountCorrect, "frames slower than twice the median are hitches") ||
+            !state.Check(isWindowSliding, "frames leave the window once it is full") ||
+            !state.Check(isStallCorrect, "frames past the last bucket count as hitches and keep their maximum") ||
+            !state.Check(histogram.GetStats().NumFrames == 0, "Clear empties the window")) {
+            return;
+        }
+
+        AddFrames(histogram, FrameTimeHistogram::WindowSize, 16.625);
+        uint32_t i = 0;
+
+        for (auto _ : state) {
+            histogram.AddFrame(16.0 + (i & 7) * 0.25);
+
+            if ((++i & 63) == 0) {
+                auto stats = histogram.GetStats();
+                DoNotOptimize(stats);
+            }
+        }
+    }
+
+    //A frame that stalls for 50 fixed steps only runs the first few and drops the rest
+    void GameTimerStepFixed(State& state) {
+        GameTimer timer;
+        timer.SetFixedDeltaSeconds(0.0001);
+
+        timer.Tick();
+        while (timer.StepFixed()) {}
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        timer.Tick();
+
+        uint32_t numSteps = 0;
+        while (timer.StepFixed()) {
+            numSteps++;
+        }
+
+        const auto numSkipped = timer.GetNumSkippedSteps();
+        const auto alpha      = timer.GetInterpolationAlpha();
+
+        //The next frame starts with a fresh step budget and none of the stall
+        std::this_thread::sleep_for(std::chrono::microseconds(300));
+        timer.Tick();
+
+        uint32_t numNextSteps = 0;
+        while (timer.StepFixed()) {
+            numNextSteps++;
+        }
+
+        if (!state.Check(numSteps == 8 && numSkipped >= 50 - 8, "a stall runs at most 8 steps and skips the rest") ||
+            !state.Check(alpha >= 0.0 && alpha < 1.0, "less than a step is left after a stall") ||
+            !state.Check(numNextSteps >= 3 && numNextSteps <= 8, "the frame after a stall steps again")) {
+            return;
+        }
+
+        //A step shorter than a clock tick still has to leave StepFixed something to divide by
+        GameTimer tinyStepTimer;
+        tinyStepTimer.SetFixedDeltaSeconds(1e-15);
+
+        if (!state.Check(tinyStepTimer.GetFixedDeltaSeconds() > 0.0, "the fixed step is at least one clock tick")) {
+            return;
+        }
+
+        for (auto _ : state) {
+            timer.Tick();
+            while (timer.StepFixed()) {}
+            DoNotOptimize(timer.GetInterpolationAlpha());
+        }
+    }
+}
+
+CRX_BENCHMARK(FrameTimeHistogramAddFrame);
+CRX_BENCHMARK(GameTimerStepFixed);
@@ -0,0 +1,186 @@
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include "MathChecks.h"
+#include "Core/Math/Matrix.h"
+#include "Core/Math/TransformKernels.h"
+#include <algorithm>
+#include <random>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+namespace {
+    //A forced level counts as the CPU's, so --isa also limits the explicit variants
+    Vector3SoA MakeVectors(size_t count, float range, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-range, range);
+
+        Vector3SoA vectors(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            vectors.Set(i, Vector3(dist(rng), dist(rng), dist(rng)));
+        }
+        return vectors;
+    }
+
+    Matrix MakeWorldMatrix() {
+        return Matrix(Vector3(12.0f, -3.0f, 40.0f), Quaternion::FromPitchYawRoll(0.4f, -1.1f, 0.25f), Vector3(1.5f, 0.75f, 2.0f));
+    }
+
+    Matrix MakeViewProjectionMatrix() {
+        const auto view       = Matrix::CreateLookAtLH(Vector3(0.0f, 10.0f, -250.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3::Up);
+        const auto projection = Matrix::CreatePerspectiveFieldOfViewLH(MathConstants::PI_DIV2, 16.0f / 9.0f, 0.1f, 1000.0f);
+
+        return view * projection;
+    }
+
+    using VectorKernel = void(*)(const Matrix& matrix, ConstVector3Span in, Vector3Span out);
+    using BoundsKernel = void(*)(const Matrix& matrix, ConstVector3Span centers, ConstVector3Span extents, Vector3Span outCenters, Vector3Span outExtents);
+
+    Vector3 ReferenceCoord(const Vector3& vec3, const Matrix& matrix)  { return Vector3::TransformCoord(vec3, matrix); }
+    Vector3 ReferenceNormal(const Vector3& vec3, const Matrix& matrix) { return Vector3::TransformNormal(vec3, matrix); }
+
+    //Positions by a world and by a view projection matrix, the latter with the perspective divide
+    template<VectorKernel Kernel, Vector3(*Reference)(const Vector3&, const Matrix&), IsaLevel KernelIsa, uint32_t MaxUlps>
+    void TransformVectors(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto in    = MakeVectors(count, 100.0f, 42);
+        Vector3SoA out(count);
+
+        for (const auto& matrix : { MakeWorldMatrix(), MakeViewProjectionMatrix() }) {
+            Kernel(matrix, in, out);
+
+            for (size_t i = 0; i < count; ++i) {
+                if (!state.Check(NearlyEqual(out.Get(i), Reference(in.Get(i), matrix), MaxUlps), "matches the Vector3 transform")) {
+                    return;
+                }
+            }
+        }
+
+        const auto matrix = MakeWorldMatrix();
+
+        for (auto _ : state) {
+            Kernel(matrix, in, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //The bounds of the 8 transformed corners
+    void ReferenceBounds(const Matrix& matrix, const Vector3& center, const Vector3& extents, Vector3& outCenter, Vector3& outExtents) {
+        Vector3 min = Vector3::Infinity;
+        Vector3 max = Vector3::InfinityNeg;
+
+        for (int corner = 0; corner < 8; ++corner) {
+            const Vector3 sign((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f);
+            const auto point = Vector3::TransformCoord(center + sign * extents, matrix);
+
+            min = Vector3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+            max = Vector3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+        }
+
+        outCenter  = (min + max) * 0.5f;
+        outExtents = (max - min) * 0.5f;
+    }
+
+    template<BoundsKernel Kernel, IsaLevel KernelIsa>
+    void TransformBoxes(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        const auto count  = static_cast<size_t>(state.GetArg());
+        const auto matrix = MakeWorldMatrix();
+
+        const auto centers = MakeVectors(count, 100.0f, 7);
+        auto extents       = MakeVectors(count, 5.0f, 8);
+
+        for (size_t i = 0; i < count; ++i) {
+            extents.Set(i, extents.Get(i).Abs());
+        }
+
+        Vector3SoA outCenters(count);
+        Vector3SoA outExtents(count);
+
+        Kernel(matrix, centers, extents, outCenters, outExtents);
+
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 center;
+            Vector3 extent;
+            ReferenceBounds(matrix, centers.Get(i), extents.Get(i), center, extent);
+
+            //The corners are rounded at the magnitude of the box's far side, not of its center or extents
+            const auto farSide   = center.Abs() + extent;
+            const auto magnitude = std::max({ 1.0f, farSide.x, farSide.y, farSide.z });
+
+            const auto outCenter = outCenters.Get(i);
+            const auto outExtent = outExtents.Get(i);
+
+            const bool isEqual =
+                NearlyEqual(outCenter.x, center.x, 8, magnitude) && NearlyEqual(outExtent.x, extent.x, 8, magnitude) &&
+                NearlyEqual(outCenter.y, center.y, 8, magnitude) && NearlyEqual(outExtent.y, extent.y, 8, magnitude) &&
+                NearlyEqual(outCenter.z, center.z, 8, magnitude) && NearlyEqual(outExtent.z, extent.z, 8, magnitude);
+
+            if (!state.Check(isEqual, "matches the bounds of the corners")) {
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            Kernel(matrix, centers, extents, outCenters, outExtents);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //Through the free functions, at the level CpuDispatch picked or --isa forced
+    void TransformCoordsDispatched(State& state)  { TransformVectors<TransformCoords, ReferenceCoord, IsaLevel::Scalar, 8>(state); }
+    void TransformNormalsDispatched(State& state) { TransformVectors<TransformNormals, ReferenceNormal, IsaLevel::Scalar, 8>(state); }
+    void TransformBoundsDispatched(State& state)  { TransformBoxes<TransformBounds, IsaLevel::Scalar>(state); }
+
+    using namespace TransformKernels;
+
+    void TransformCoordsScalar(State& state)  { TransformVectors<TransformCoords_Scalar, ReferenceCoord, IsaLevel::Scalar, 2>(state); }
+    void TransformNormalsScalar(State& state) { TransformVectors<TransformNormals_Scalar, ReferenceNormal, IsaLevel::Scalar, 2>(state); }
+    void TransformBoundsScalar(State& state)  { TransformBoxes<TransformBounds_Scalar, IsaLevel::Scalar>(state); }
+
+#if CRX_SIMD_X86
+    void TransformCoordsSSE(State& state)  { TransformVectors<TransformCoords_SSE, ReferenceCoord, IsaLevel::SSE, 2>(state); }
+    void TransformNormalsSSE(State& state) { TransformVectors<TransformNormals_SSE, ReferenceNormal, IsaLevel::SSE, 2>(state); }
+    void TransformBoundsSSE(State& state)  { TransformBoxes<TransformBounds_SSE, IsaLevel::SSE>(state); }
+
+    void TransformCoordsAVX2(State& state)  { TransformVectors<TransformCoords_AVX2, ReferenceCoord, IsaLevel::AVX2, 8>(state); }
+    void TransformNormalsAVX2(State& state) { TransformVectors<TransformNormals_AVX2, ReferenceNormal, IsaLevel::AVX2, 8>(state); }
+    void TransformBoundsAVX2(State& state)  { TransformBoxes<TransformBounds_AVX2, IsaLevel::AVX2>(state); }
+
+    void TransformCoordsAVX512(State& state)  { TransformVectors<TransformCoords_AVX512, ReferenceCoord, IsaLevel::AVX512, 8>(state); }
+    void TransformNormalsAVX512(State& state) { TransformVectors<TransformNormals_AVX512, ReferenceNormal, IsaLevel::AVX512, 8>(state); }
+    void TransformBoundsAVX512(State& state)  { TransformBoxes<TransformBounds_AVX512, IsaLevel::AVX512>(state); }
+#endif
+}
+
+//An odd count so the tails are covered
+CRX_BENCHMARK_ARGS(TransformCoordsScalar, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformNormalsScalar, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformBoundsScalar, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformCoordsDispatched, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformNormalsDispatched, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformBoundsDispatched, 1021, 65536);
+#if CRX_SIMD_X86
+CRX_BENCHMARK_ARGS(TransformCoordsSSE, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformNormalsSSE, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformBoundsSSE, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformCoordsAVX2, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformNormalsAVX2, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformBoundsAVX2, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformCoordsAVX512, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformNormalsAVX512, 1021, 65536);
+CRX_BENCHMARK_ARGS(TransformBoundsAVX512, 1021, 65536);
+#endif
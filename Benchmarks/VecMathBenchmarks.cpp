@@ -0,0 +1,402 @@
+#include "Benchmark.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include "MathChecks.h"
+#include "Core/Math/Math.h"
+#include "Core/Math/VecMath.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Cyrex;
+using namespace Cyrex::Benchmark;
+using namespace Cyrex::Math;
+
+namespace {
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    constexpr float NaN      = std::numeric_limits<float>::quiet_NaN();
+
+    //Every variant the CPU runs, so the dispatched benchmarks check the others as well
+    std::vector<const VecKernels::Table*> SupportedTables() {
+        std::vector<const VecKernels::Table*> tables = { &VecKernels::Scalar };
+#if CRX_SIMD_X86
+        const auto level = CpuDispatch::GetLevel();
+
+        if (level >= IsaLevel::SSE)    tables.push_back(&VecKernels::SSE);
+        if (level >= IsaLevel::AVX2)   tables.push_back(&VecKernels::AVX2);
+        if (level >= IsaLevel::AVX512) tables.push_back(&VecKernels::AVX512);
+#endif
+        return tables;
+    }
+
+    //2^low to 2^high with random mantissas, so every binade gets the same share
+    std::vector<float> MakeLogUniform(size_t count, float low, float high, bool isSigned, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> exponent(low, high);
+        std::uniform_int_distribution<int> sign(0, isSigned ? 1 : 0);
+
+        std::vector<float> values(count);
+        std::generate(values.begin(), values.end(), [&] { return std::exp2(exponent(rng)) * (sign(rng) ? -1.0f : 1.0f); });
+        return values;
+    }
+
+    std::vector<float> MakeUniform(size_t count, float low, float high, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(low, high);
+
+        std::vector<float> values(count);
+        std::generate(values.begin(), values.end(), [&] { return dist(rng); });
+        return values;
+    }
+
+    //The edge cases go first, the rest of the values stay random
+    std::vector<float> WithSpecials(std::vector<float> values, std::initializer_list<float> specials) {
+        std::copy(specials.begin(), specials.end(), values.begin());
+        return values;
+    }
+
+    //Within maxUlps of the correctly rounded result or absoluteError from the exact one, and
+    //NaN where the C library gives NaN
+    bool IsAccurate(float result, double exact, uint32_t maxUlps, double absoluteError) noexcept {
+        const auto rounded = static_cast<float>(exact);
+
+        if (std::isnan(rounded) || std::isnan(result)) {
+            return std::isnan(rounded) && std::isnan(result);
+        }
+        return UlpDistance(result, rounded) <= maxUlps || std::abs(result - exact) <= absoluteError;
+    }
+
+    struct UnaryCase {
+        std::vector<float> (*MakeInputs)(size_t count);
+        double (*Exact)(double x);
+        uint32_t MaxUlps;
+        double AbsoluteError;
+    };
+
+    std::vector<float> MakeAngles(size_t count) {
+        return WithSpecials(MakeLogUniform(count, -30.0f, 24.0f, true, 1), { 0.0f, -0.0f, Infinity, -Infinity, NaN, 16777215.0f });
+    }
+
+    std::vector<float> MakeFastAngles(size_t count) {
+        return WithSpecials(MakeUniform(count, -8192.0f, 8192.0f, 2), { 0.0f, -0.0f, Infinity, -Infinity, NaN, 1e-30f });
+    }
+
+    std::vector<float> MakeExponents(size_t count) {
+        return WithSpecials(MakeUniform(count, -104.0f, 89.0f, 3), { 0.0f, -0.0f, Infinity, -Infinity, NaN, 88.72f, -87.33f });
+    }
+
+    std::vector<float> MakeLogArguments(size_t count) {
+        return WithSpecials(MakeLogUniform(count, -149.0f, 128.0f, false, 4), { 0.0f, -0.0f, Infinity, -1.0f, NaN, 1.0f, 1e-45f });
+    }
+
+    std::vector<float> MakeRsqrtArguments(size_t count) {
+        return WithSpecials(MakeLogUniform(count, -126.0f, 128.0f, false, 5), { 0.0f, -0.0f, Infinity, -1.0f, NaN, 1.0f });
+    }
+
+    double ExactSin(double x)   { return std::sin(x); }
+    double ExactCos(double x)   { return std::cos(x); }
+    double ExactExp(double x)   { return std::exp(x); }
+    double ExactLog(double x)   { return std::log(x); }
+    double ExactRsqrt(double x) { return 1.0 / std::sqrt(x); }
+
+    //The errors VecMath.h documents
+    constexpr UnaryCase SinCase       { MakeAngles, ExactSin, 1, 0.0 };
+    constexpr UnaryCase SinFastCase   { MakeFastAngles, ExactSin, 2, 1e-7 };
+    constexpr UnaryCase CosCase       { MakeAngles, ExactCos, 1, 0.0 };
+    constexpr UnaryCase CosFastCase   { MakeFastAngles, ExactCos, 2, 1e-7 };
+    constexpr UnaryCase ExpCase       { MakeExponents, ExactExp, 1, 0.0 };
+    constexpr UnaryCase ExpFastCase   { MakeExponents, ExactExp, 1, 0.0 };
+    constexpr UnaryCase LogCase       { MakeLogArguments, ExactLog, 1, 0.0 };
+    constexpr UnaryCase LogFastCase   { MakeLogArguments, ExactLog, 1, 0.0 };
+    constexpr UnaryCase RsqrtCase     { MakeRsqrtArguments, ExactRsqrt, 1, 0.0 };
+    constexpr UnaryCase RsqrtFastCase { MakeRsqrtArguments, ExactRsqrt, 4, 0.0 };
+
+    using UnaryMember = VecKernels::Unary VecKernels::Table::*;
+
+    template<const UnaryCase& Case, UnaryMember Member, VecKernels::Unary Dispatched>
+    void VecUnary(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto in    = Case.MakeInputs(count);
+
+        std::vector<float> out(count);
+
+        for (const auto* table : SupportedTables()) {
+            (table->*Member)(in, out);
+
+            for (size_t i = 0; i < count; ++i) {
+                if (!state.Check(IsAccurate(out[i], Case.Exact(in[i]), Case.MaxUlps, Case.AbsoluteError), "within the documented error")) {
+                    return;
+                }
+            }
+        }
+
+        for (auto _ : state) {
+            Dispatched(in, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    template<const UnaryCase& Case, float(*Function)(float)>
+    void VecUnaryStd(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto in    = Case.MakeInputs(count);
+
+        std::vector<float> out(count);
+
+        for (auto _ : state) {
+            std::transform(in.begin(), in.end(), out.begin(), Function);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    float StdSin(float x)   { return std::sin(x); }
+    float StdExp(float x)   { return std::exp(x); }
+    float StdLog(float x)   { return std::log(x); }
+    float StdRsqrt(float x) { return 1.0f / std::sqrt(x); }
+
+    using DualMember = VecKernels::Dual VecKernels::Table::*;
+
+    template<const UnaryCase& Sin, const UnaryCase& Cos, DualMember Member, VecKernels::Dual Dispatched>
+    void VecSinCos(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto in    = Sin.MakeInputs(count);
+
+        std::vector<float> sin(count);
+        std::vector<float> cos(count);
+
+        for (const auto* table : SupportedTables()) {
+            (table->*Member)(in, sin, cos);
+
+            for (size_t i = 0; i < count; ++i) {
+                const bool isSinAccurate = IsAccurate(sin[i], Sin.Exact(in[i]), Sin.MaxUlps, Sin.AbsoluteError);
+                const bool isCosAccurate = IsAccurate(cos[i], Cos.Exact(in[i]), Cos.MaxUlps, Cos.AbsoluteError);
+
+                if (!state.Check(isSinAccurate && isCosAccurate, "within the documented error")) {
+                    return;
+                }
+            }
+        }
+
+        for (auto _ : state) {
+            Dispatched(in, sin, cos);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    //One instruction set at a time, to show how the precise variant scales with the width
+    template<const VecKernels::Table& Kernels, IsaLevel KernelIsa>
+    void VecSinCosKernel(State& state) {
+        if (SkipUnsupported(state, KernelIsa)) {
+            return;
+        }
+
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto in    = MakeAngles(count);
+
+        std::vector<float> sin(count);
+        std::vector<float> cos(count);
+
+        for (auto _ : state) {
+            Kernels.SinCos(in, sin, cos);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    void VecSinCosStd(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto in    = MakeAngles(count);
+
+        std::vector<float> sin(count);
+        std::vector<float> cos(count);
+
+        for (auto _ : state) {
+            for (size_t i = 0; i < count; ++i) {
+                sin[i] = std::sin(in[i]);
+                cos[i] = std::cos(in[i]);
+            }
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    struct BinaryCase {
+        std::vector<float> (*MakeA)(size_t count);
+        std::vector<float> (*MakeB)(size_t count);
+        double (*Exact)(double a, double b);
+        uint32_t (*MaxUlps)(float a, float b);
+    };
+
+    //Every pair of these comes first, so the edge cases meet each other
+    constexpr float EdgeCases[] = { 0.0f, -0.0f, Infinity, -Infinity, NaN, 1.0f, -1.0f, 0.5f, -0.5f, 2.0f, -2.0f, 3.0f, -3.0f, 1e-45f };
+    constexpr size_t EdgeCaseCount = std::size(EdgeCases);
+
+    std::vector<float> WithEdgeCasePairs(std::vector<float> values, bool isFirst) {
+        for (size_t i = 0; i < EdgeCaseCount * EdgeCaseCount; ++i) {
+            values[i] = isFirst ? EdgeCases[i / EdgeCaseCount] : EdgeCases[i % EdgeCaseCount];
+        }
+        return values;
+    }
+
+    //Negative bases only with integer exponents, the others are NaN
+    std::vector<float> MakeBases(size_t count) {
+        auto bases = MakeLogUniform(count, -20.0f, 20.0f, false, 6);
+
+        for (size_t i = 0; i < count; i += 4) {
+            bases[i] = -bases[i];
+        }
+        return WithEdgeCasePairs(std::move(bases), true);
+    }
+
+    std::vector<float> MakePowers(size_t count) {
+        auto powers = MakeUniform(count, -6.0f, 6.0f, 7);
+
+        for (size_t i = 0; i < count; i += 4) {
+            powers[i] = std::round(powers[i]);
+        }
+        return WithEdgeCasePairs(std::move(powers), false);
+    }
+
+    std::vector<float> MakePositiveBases(size_t count) { return MakeLogUniform(count, -20.0f, 20.0f, false, 6); }
+    std::vector<float> MakeFastPowers(size_t count)    { return MakeUniform(count, -6.0f, 6.0f, 7); }
+
+    std::vector<float> MakeAtan2Y(size_t count) { return WithEdgeCasePairs(MakeLogUniform(count, -30.0f, 30.0f, true, 8), true); }
+    std::vector<float> MakeAtan2X(size_t count) { return WithEdgeCasePairs(MakeLogUniform(count, -30.0f, 30.0f, true, 9), false); }
+
+    double ExactPow(double x, double y)   { return std::pow(x, y); }
+    double ExactAtan2(double y, double x) { return std::atan2(y, x); }
+
+    uint32_t OneUlp(float, float) { return 1; }
+    uint32_t ThreeUlps(float, float) { return 3; }
+
+    uint32_t PowFastUlps(float x, float y) {
+        return 2 + static_cast<uint32_t>(2.0f * std::abs(y * std::log(x)));
+    }
+
+    constexpr BinaryCase PowCase       { MakeBases, MakePowers, ExactPow, OneUlp };
+    constexpr BinaryCase PowFastCase   { MakePositiveBases, MakeFastPowers, ExactPow, PowFastUlps };
+    constexpr BinaryCase Atan2Case     { MakeAtan2Y, MakeAtan2X, ExactAtan2, OneUlp };
+    constexpr BinaryCase Atan2FastCase { MakeAtan2Y, MakeAtan2X, ExactAtan2, ThreeUlps };
+
+    using BinaryMember = VecKernels::Binary VecKernels::Table::*;
+
+    template<const BinaryCase& Case, BinaryMember Member, VecKernels::Binary Dispatched>
+    void VecBinary(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto a     = Case.MakeA(count);
+        const auto b     = Case.MakeB(count);
+
+        std::vector<float> out(count);
+
+        for (const auto* table : SupportedTables()) {
+            (table->*Member)(a, b, out);
+
+            for (size_t i = 0; i < count; ++i) {
+                if (!state.Check(IsAccurate(out[i], Case.Exact(a[i], b[i]), Case.MaxUlps(a[i], b[i]), 0.0), "within the documented error")) {
+                    return;
+                }
+            }
+        }
+
+        for (auto _ : state) {
+            Dispatched(a, b, out);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    template<const BinaryCase& Case, float(*Function)(float, float)>
+    void VecBinaryStd(State& state) {
+        const auto count = static_cast<size_t>(state.GetArg());
+        const auto a     = Case.MakeA(count);
+        const auto b     = Case.MakeB(count);
+
+        std::vector<float> out(count);
+
+        for (auto _ : state) {
+            std::transform(a.begin(), a.end(), b.begin(), out.begin(), Function);
+            ClobberMemory();
+        }
+
+        state.SetItemsPerIteration(count);
+    }
+
+    float StdPow(float x, float y)   { return std::pow(x, y); }
+    float StdAtan2(float y, float x) { return std::atan2(y, x); }
+
+    using VecKernels::Table;
+
+    void VecSinDispatched(State& state)       { VecUnary<SinCase, &Table::Sin, Vec::Sin>(state); }
+    void VecSinFastDispatched(State& state)   { VecUnary<SinFastCase, &Table::SinFast, Vec::SinFast>(state); }
+    void VecCosDispatched(State& state)       { VecUnary<CosCase, &Table::Cos, Vec::Cos>(state); }
+    void VecCosFastDispatched(State& state)   { VecUnary<CosFastCase, &Table::CosFast, Vec::CosFast>(state); }
+    void VecExpDispatched(State& state)       { VecUnary<ExpCase, &Table::Exp, Vec::Exp>(state); }
+    void VecExpFastDispatched(State& state)   { VecUnary<ExpFastCase, &Table::ExpFast, Vec::ExpFast>(state); }
+    void VecLogDispatched(State& state)       { VecUnary<LogCase, &Table::Log, Vec::Log>(state); }
+    void VecLogFastDispatched(State& state)   { VecUnary<LogFastCase, &Table::LogFast, Vec::LogFast>(state); }
+    void VecRsqrtDispatched(State& state)     { VecUnary<RsqrtCase, &Table::Rsqrt, Vec::Rsqrt>(state); }
+    void VecRsqrtFastDispatched(State& state) { VecUnary<RsqrtFastCase, &Table::RsqrtFast, Vec::RsqrtFast>(state); }
+
+    void VecSinCosDispatched(State& state)     { VecSinCos<SinCase, CosCase, &Table::SinCos, Vec::SinCos>(state); }
+    void VecSinCosFastDispatched(State& state) { VecSinCos<SinFastCase, CosFastCase, &Table::SinCosFast, Vec::SinCosFast>(state); }
+
+    void VecPowDispatched(State& state)       { VecBinary<PowCase, &Table::Pow, Vec::Pow>(state); }
+    void VecPowFastDispatched(State& state)   { VecBinary<PowFastCase, &Table::PowFast, Vec::PowFast>(state); }
+    void VecAtan2Dispatched(State& state)     { VecBinary<Atan2Case, &Table::Atan2, Vec::Atan2>(state); }
+    void VecAtan2FastDispatched(State& state) { VecBinary<Atan2FastCase, &Table::Atan2Fast, Vec::Atan2Fast>(state); }
+
+    void VecSinStd(State& state)   { VecUnaryStd<SinCase, StdSin>(state); }
+    void VecExpStd(State& state)   { VecUnaryStd<ExpCase, StdExp>(state); }
+    void VecLogStd(State& state)   { VecUnaryStd<LogCase, StdLog>(state); }
+    void VecRsqrtStd(State& state) { VecUnaryStd<RsqrtCase, StdRsqrt>(state); }
+    void VecPowStd(State& state)   { VecBinaryStd<PowCase, StdPow>(state); }
+    void VecAtan2Std(State& state) { VecBinaryStd<Atan2Case, StdAtan2>(state); }
+
+    void VecSinCosScalar(State& state) { VecSinCosKernel<VecKernels::Scalar, IsaLevel::Scalar>(state); }
+#if CRX_SIMD_X86
+    void VecSinCosSSE(State& state)    { VecSinCosKernel<VecKernels::SSE, IsaLevel::SSE>(state); }
+    void VecSinCosAVX2(State& state)   { VecSinCosKernel<VecKernels::AVX2, IsaLevel::AVX2>(state); }
+    void VecSinCosAVX512(State& state) { VecSinCosKernel<VecKernels::AVX512, IsaLevel::AVX512>(state); }
+#endif
+}
+
+//Odd counts, so the padded tails are covered
+CRX_BENCHMARK_ARGS(VecSinStd, 65531);
+CRX_BENCHMARK_ARGS(VecSinDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecSinFastDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecCosDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecCosFastDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecSinCosStd, 65531);
+CRX_BENCHMARK_ARGS(VecSinCosDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecSinCosFastDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecSinCosScalar, 65531);
+#if CRX_SIMD_X86
+CRX_BENCHMARK_ARGS(VecSinCosSSE, 65531);
+CRX_BENCHMARK_ARGS(VecSinCosAVX2, 65531);
+CRX_BENCHMARK_ARGS(VecSinCosAVX512, 65531);
+#endif
+CRX_BENCHMARK_ARGS(VecExpStd, 65531);
+CRX_BENCHMARK_ARGS(VecExpDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecExpFastDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecLogStd, 65531);
+CRX_BENCHMARK_ARGS(VecLogDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecLogFastDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecPowStd, 65531);
+CRX_BENCHMARK_ARGS(VecPowDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecPowFastDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecAtan2Std, 65531);
+CRX_BENCHMARK_ARGS(VecAtan2Dispatched, 65531);
+CRX_BENCHMARK_ARGS(VecAtan2FastDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecRsqrtStd, 65531);
+CRX_BENCHMARK_ARGS(VecRsqrtDispatched, 65531);
+CRX_BENCHMARK_ARGS(VecRsqrtFastDispatched, 65531);
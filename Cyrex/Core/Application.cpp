@@ -8,7 +8,12 @@
 #include "Graphics/API/DX12/Device.h"
 #include "Graphics/API/DX12/Adapter.h"
 #include "Graphics/API/DX12/Swapchain.h"
+#include "Jobs/JobSystem.h"
+#include "FrameArena.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
 #include <Core/InstructionSet/CpuInfo.h>
+#include <Core/InstructionSet/CpuDispatch.h>
 
 using namespace Cyrex;
 namespace wrl = Microsoft::WRL;
@@ -19,6 +24,7 @@ Cyrex::Application::Application() {
 	m_gfx    = std::make_unique<Graphics>();
 
 	SetThreadDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+	Profiler::Get().SetThreadName(std::this_thread::get_id(), "Main Thread");
 
 	if (Console::Instance()) {
 		Console::Show();
@@ -31,13 +37,19 @@ Cyrex::Application::Application() {
 		"CPU Vendor:          ", cpuInfo.InstructionSetFeatures.Vendor(),      Logger::NewLine(),
 		"CPU architecture:    ", cpuInfo.Architecture,                         Logger::NewLine(),
 		"Cores:               ", cpuInfo.NumCores,                             Logger::NewLine(),
-		"Logical processors:  ", cpuInfo.NumLogicalProcessors);
+		"Logical processors:  ", cpuInfo.NumLogicalProcessors,                 Logger::NewLine(),
+		"SIMD kernels:        ", CpuDispatch::ToString(CpuDispatch::GetLevel()));
+
+	//Leave one logical processor for the main thread
+	JobSystem::Create(static_cast<uint32_t>(std::max(1, cpuInfo.NumLogicalProcessors - 1)));
 
 	Initialize();
 }
 
 Cyrex::Application::~Application() {
 	AssimpLogger::Detach();
+	JobSystem::Destroy();
+	Logger::Get().Shutdown();
 	Console::Destroy();
 }
 
@@ -56,9 +68,14 @@ int Cyrex::Application::Run() {
 		else {
 			//Render/Graphics stuff
 			if (m_gfx && m_gfx->IsInitialized()) {
+				CRX_PROFILE_FRAME();
+				CRX_PROFILE_SCOPE("Frame");
+
 				HandleInput();
 				m_gfx->Update();
 				m_gfx->Render();
+				FrameArena::Get().Reset();
+				MemoryTracker::EndFrame();
 			}
 		}
 	}
@@ -107,6 +124,9 @@ void Cyrex::Application::KeyboardInput() noexcept {
 				m_window->m_mouse.DisableRawInput();
 			}
 			break;
+		case KeyCode::F9:
+			ToggleProfilerCapture();
+			break;
 		case KeyCode::F11:
 			crxlog::info("Toggled fullscreen mode");
 			m_window->ToggleFullScreen(!m_window->FullScreen());
@@ -124,6 +144,27 @@ void Cyrex::Application::KeyboardInput() noexcept {
 	m_gfx->KeyboardInput(m_window->Kbd);
 }
 
+void Cyrex::Application::ToggleProfilerCapture() noexcept {
+	auto& profiler = Profiler::Get();
+
+	if (!profiler.IsCapturing()) {
+		profiler.BeginCapture();
+		crxlog::info("Started profiler capture, press F9 again to stop it");
+		return;
+	}
+
+	profiler.EndCapture();
+
+	constexpr auto tracePath = "Cyrex.trace.json";
+
+	if (profiler.ExportChromeTrace(tracePath)) {
+		crxlog::info("Wrote profiler capture to ", tracePath);
+	}
+	else {
+		crxlog::err("Failed to write profiler capture to ", tracePath);
+	}
+}
+
 void Cyrex::Application::MouseInput() noexcept {
 	using mouseEvent = Mouse::Event::Type;
 
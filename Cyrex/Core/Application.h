@@ -29,6 +29,7 @@ namespace Cyrex {
         void HandleInput() noexcept;
         void KeyboardInput() noexcept;
         void MouseInput() noexcept;
+        void ToggleProfilerCapture() noexcept;
         std::optional<int> MessagePump() noexcept;
 
         std::unique_ptr<Window> m_window = nullptr;
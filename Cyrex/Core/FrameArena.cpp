@@ -0,0 +1,177 @@
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace Cyrex;
+
+namespace {
+    std::atomic_uint64_t s_nextArenaId{ 0 };
+
+    //The sub-arena this thread used last, arenas are told apart by id so a
+    //new arena at the address of a destroyed one is never mistaken for it
+    struct CachedSubArena {
+        uint64_t ArenaId{ ~0ull };
+        void* SubArena{ nullptr };
+    };
+
+    thread_local CachedSubArena t_cachedSubArena;
+}
+
+FrameArena::FrameArena(size_t blockSize)
+    :
+    m_blockSize(blockSize),
+    m_id(s_nextArenaId.fetch_add(1, std::memory_order_relaxed))
+{}
+
+FrameArena::~FrameArena() = default;
+
+FrameArena& FrameArena::Get() noexcept {
+    static FrameArena instance;
+    return instance;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    assert(alignment && (alignment & (alignment - 1)) == 0 && "Alignment must be a power of two");
+
+    auto& subArena = GetSubArena();
+    BeginFrame(subArena);
+
+    while (true) {
+        if (subArena.BlockIndex < subArena.Blocks.size()) {
+            const auto& block   = subArena.Blocks[subArena.BlockIndex];
+            const auto base     = reinterpret_cast<uintptr_t>(block.Data.get());
+            const auto current  = base + subArena.Offset;
+            const auto aligned  = (current + alignment - 1) & ~(alignment - 1);
+
+            if (aligned + size <= base + block.Size) [[likely]] {
+                subArena.Offset = aligned + size - base;
+                subArena.Used  += aligned + size - current;
+
+                if (subArena.Used > subArena.Peak) {
+                    subArena.Peak = subArena.Used;
+                    subArena.PublishedPeak.store(subArena.Peak, std::memory_order_relaxed);
+                }
+
+                return reinterpret_cast<void*>(aligned);
+            }
+
+            //The rest of this block is wasted until the sub-arena rewinds
+            subArena.BlockIndex++;
+            subArena.Offset = 0;
+            continue;
+        }
+
+        CRX_MEMORY_TAG(FrameArena);
+
+        const auto blockSize = std::max(m_blockSize, size + alignment);
+        subArena.Blocks.push_back({ std::make_unique<std::byte[]>(blockSize), blockSize });
+    }
+}
+
+void FrameArena::Reset() noexcept {
+    const auto frameIndex = m_frameIndex.load(std::memory_order_relaxed);
+
+    size_t framePeak = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_subArenaMutex);
+
+        for (const auto& subArena : m_subArenas) {
+            if (subArena->PublishedFrameIndex.load(std::memory_order_relaxed) == frameIndex) {
+                framePeak += subArena->PublishedPeak.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    m_lastFramePeak.store(framePeak, std::memory_order_relaxed);
+    m_peak.store(std::max(framePeak, m_peak.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+
+    m_frameIndex.store(frameIndex + 1, std::memory_order_release);
+}
+
+FrameArena::SubArena& FrameArena::GetSubArena() {
+    if (t_cachedSubArena.ArenaId == m_id) [[likely]] {
+        return *static_cast<SubArena*>(t_cachedSubArena.SubArena);
+    }
+
+    const auto threadId = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock(m_subArenaMutex);
+
+    auto it = std::find_if(m_subArenas.begin(), m_subArenas.end(), [threadId](const auto& subArena) {
+        return subArena->Owner == threadId;
+    });
+
+    if (it == m_subArenas.end()) {
+        auto& subArena      = m_subArenas.emplace_back(std::make_unique<SubArena>());
+        subArena->Owner      = threadId;
+        subArena->FrameIndex = m_frameIndex.load(std::memory_order_acquire);
+        subArena->PublishedFrameIndex.store(subArena->FrameIndex, std::memory_order_relaxed);
+
+        it = std::prev(m_subArenas.end());
+    }
+
+    t_cachedSubArena = { m_id, it->get() };
+    return **it;
+}
+
+void FrameArena::BeginFrame(SubArena& subArena) {
+    const auto frameIndex = m_frameIndex.load(std::memory_order_acquire);
+
+    if (subArena.FrameIndex == frameIndex) [[likely]] {
+        return;
+    }
+
+    //Memory of a scope that is still open stays alive and counts towards the new frame
+    if (subArena.ScopeDepth == 0) {
+        Rewind(subArena);
+    }
+
+    subArena.FrameIndex = frameIndex;
+    subArena.Peak       = subArena.Used;
+
+    subArena.PublishedPeak.store(subArena.Peak, std::memory_order_relaxed);
+    subArena.PublishedFrameIndex.store(frameIndex, std::memory_order_relaxed);
+}
+
+void FrameArena::Rewind(SubArena& subArena) {
+    //Merge the blocks a busy frame needed, so the next frame fits in a single block
+    if (subArena.Blocks.size() > 1) {
+        size_t totalSize = 0;
+        for (const auto& block : subArena.Blocks) {
+            totalSize += block.Size;
+        }
+
+        CRX_MEMORY_TAG(FrameArena);
+
+        subArena.Blocks.clear();
+        subArena.Blocks.push_back({ std::make_unique<std::byte[]>(totalSize), totalSize });
+    }
+
+    subArena.BlockIndex = 0;
+    subArena.Offset     = 0;
+    subArena.Used       = 0;
+}
+
+FrameArena::Scope::Scope(FrameArena& arena)
+    :
+    m_subArena(arena.GetSubArena())
+{
+    arena.BeginFrame(m_subArena);
+
+    m_blockIndex = m_subArena.BlockIndex;
+    m_offset     = m_subArena.Offset;
+    m_used       = m_subArena.Used;
+
+    m_subArena.ScopeDepth++;
+}
+
+FrameArena::Scope::~Scope() {
+    assert(m_subArena.ScopeDepth > 0);
+
+    m_subArena.BlockIndex = m_blockIndex;
+    m_subArena.Offset     = m_offset;
+    m_subArena.Used       = m_used;
+
+    m_subArena.ScopeDepth--;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cyrex {
+    //Bump allocator for data that does not outlive the frame it was allocated in.
+    //Every thread allocates from its own sub-arena, so allocating never takes a lock.
+    //Reset ends the frame, a sub-arena rewinds the next time its thread allocates
+    //outside of a Scope. Work that spans frames, such as loading, has to allocate
+    //inside a Scope so its memory is not rewound underneath it.
+    class FrameArena {
+    private:
+        struct SubArena;
+    public:
+        explicit FrameArena(size_t blockSize = ms_defaultBlockSize);
+        FrameArena(const FrameArena& rhs) = delete;
+        FrameArena& operator=(const FrameArena& rhs) = delete;
+        ~FrameArena();
+
+        //The arena the engine resets once per frame
+        static FrameArena& Get() noexcept;
+
+        [[nodiscard]] void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<class T>
+        [[nodiscard]] T* Allocate(size_t count) { return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T))); }
+
+        //Ends the frame, must not race with a thread that allocates outside of a Scope
+        void Reset() noexcept;
+
+        [[nodiscard]] uint64_t GetFrameIndex() const noexcept { return m_frameIndex.load(std::memory_order_relaxed); }
+        //Bytes allocated by all threads during the last finished frame
+        [[nodiscard]] size_t GetLastFramePeak() const noexcept { return m_lastFramePeak.load(std::memory_order_relaxed); }
+        //Largest frame so far
+        [[nodiscard]] size_t GetPeak() const noexcept { return m_peak.load(std::memory_order_relaxed); }
+
+        //Everything the calling thread allocates while the scope is alive is released when it ends.
+        //Scopes on the same thread have to end in the reverse order they were created in.
+        class Scope {
+        public:
+            explicit Scope(FrameArena& arena);
+            Scope(const Scope& rhs) = delete;
+            Scope& operator=(const Scope& rhs) = delete;
+            ~Scope();
+        private:
+            SubArena& m_subArena;
+            size_t m_blockIndex;
+            size_t m_offset;
+            size_t m_used;
+        };
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> Data;
+            size_t Size;
+        };
+
+        //Only ever touched by the thread that owns it, apart from the published statistics
+        struct SubArena {
+            std::thread::id Owner;
+            std::vector<Block> Blocks;
+            size_t BlockIndex{ 0 };
+            size_t Offset{ 0 };
+            size_t Used{ 0 };
+            size_t Peak{ 0 };
+            uint64_t FrameIndex{ 0 };
+            uint32_t ScopeDepth{ 0 };
+
+            std::atomic_uint64_t PublishedFrameIndex{ 0 };
+            std::atomic_size_t PublishedPeak{ 0 };
+        };
+
+        [[nodiscard]] SubArena& GetSubArena();
+        void BeginFrame(SubArena& subArena);
+        void Rewind(SubArena& subArena);
+
+        static constexpr size_t ms_defaultBlockSize = 256 * 1024;
+
+        const size_t m_blockSize;
+        const uint64_t m_id;
+
+        std::atomic_uint64_t m_frameIndex{ 0 };
+        std::atomic_size_t m_lastFramePeak{ 0 };
+        std::atomic_size_t m_peak{ 0 };
+
+        std::mutex m_subArenaMutex;
+        std::vector<std::unique_ptr<SubArena>> m_subArenas;
+    };
+
+    //STL allocator that allocates from a FrameArena, deallocation is a no-op
+    template<class T>
+    class FrameAllocator {
+    public:
+        using value_type = T;
+
+        FrameAllocator(FrameArena& arena = FrameArena::Get()) noexcept
+            :
+            m_arena(&arena)
+        {}
+
+        template<class U>
+        FrameAllocator(const FrameAllocator<U>& rhs) noexcept
+            :
+            m_arena(rhs.GetArena())
+        {}
+
+        [[nodiscard]] T* allocate(size_t count) { return m_arena->Allocate<T>(count); }
+        void deallocate(T*, size_t) noexcept {}
+
+        [[nodiscard]] FrameArena* GetArena() const noexcept { return m_arena; }
+
+        template<class U>
+        bool operator==(const FrameAllocator<U>& rhs) const noexcept { return m_arena == rhs.GetArena(); }
+    private:
+        FrameArena* m_arena;
+    };
+
+    template<class T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
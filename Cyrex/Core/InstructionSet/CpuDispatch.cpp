@@ -0,0 +1,133 @@
+#include "CpuDispatch.h"
+#include "InstructionSet.h"
+#include "Core/Math/SIMD.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <mutex>
+
+using namespace Cyrex;
+
+namespace {
+    IsaLevel DetectLevel() noexcept {
+#if CRX_SIMD_X86
+        const InstructionSet isa;
+
+        //The OS has to save the wider registers, else the instructions fault. Every CPU with AVX2
+        //has FMA and F16C as well, the AVX2 kernels may use all three.
+        if (isa.AVX2() && isa.FMA() && isa.F16C() && isa.OSSavesAVX()) {
+            return isa.AVX512F() && isa.OSSavesAVX512() ? IsaLevel::AVX512 : IsaLevel::AVX2;
+        }
+        return IsaLevel::SSE;
+#else
+        return IsaLevel::Scalar;
+#endif
+    }
+
+    struct DispatchState {
+        DispatchState() noexcept
+            :
+            Supported(DetectLevel()),
+            Level(Supported)
+        {
+            if (const char* forced = std::getenv("CRX_ISA")) {
+                if (const auto level = CpuDispatch::FromString(forced)) {
+                    Level = std::min(*level, Supported);
+                }
+            }
+            Default = Level;
+        }
+
+        static DispatchState& Get() noexcept {
+            static DispatchState state;
+            return state;
+        }
+
+        std::mutex Mutex;
+        IsaLevel Supported;
+        IsaLevel Level;
+        IsaLevel Default;
+
+        //Kernel modules register at static initialization, a fixed array keeps that allocation free
+        std::array<CpuDispatch::RebindCallback, 32> Callbacks{};
+        size_t NumCallbacks{ 0 };
+    };
+
+    void SetLevel(DispatchState& state, IsaLevel level) noexcept {
+        std::scoped_lock lock(state.Mutex);
+
+        if (state.Level == level) {
+            return;
+        }
+
+        state.Level = level;
+
+        for (size_t i = 0; i < state.NumCallbacks; ++i) {
+            state.Callbacks[i](level);
+        }
+    }
+}
+
+IsaLevel CpuDispatch::GetSupportedLevel() noexcept {
+    return DispatchState::Get().Supported;
+}
+
+IsaLevel CpuDispatch::GetLevel() noexcept {
+    auto& state = DispatchState::Get();
+    std::scoped_lock lock(state.Mutex);
+
+    return state.Level;
+}
+
+IsaLevel CpuDispatch::ForceLevel(IsaLevel level) noexcept {
+    auto& state = DispatchState::Get();
+    level = std::min(level, state.Supported);
+
+    SetLevel(state, level);
+    return level;
+}
+
+void CpuDispatch::ResetLevel() noexcept {
+    auto& state = DispatchState::Get();
+    SetLevel(state, state.Default);
+}
+
+void CpuDispatch::Register(RebindCallback rebind) noexcept {
+    auto& state = DispatchState::Get();
+    std::scoped_lock lock(state.Mutex);
+
+    assert(state.NumCallbacks < state.Callbacks.size() && "Too many kernel modules, raise the callback capacity");
+    if (state.NumCallbacks == state.Callbacks.size()) [[unlikely]] {
+        return;
+    }
+
+    state.Callbacks[state.NumCallbacks++] = rebind;
+    rebind(state.Level);
+}
+
+const char* CpuDispatch::ToString(IsaLevel level) noexcept {
+    switch (level) {
+    case IsaLevel::Scalar: return "Scalar";
+    case IsaLevel::SSE:    return "SSE";
+    case IsaLevel::AVX2:   return "AVX2";
+    case IsaLevel::AVX512: return "AVX512";
+    }
+    return "Unknown";
+}
+
+std::optional<IsaLevel> CpuDispatch::FromString(std::string_view name) noexcept {
+    for (const auto level : { IsaLevel::Scalar, IsaLevel::SSE, IsaLevel::AVX2, IsaLevel::AVX512 }) {
+        const std::string_view levelName = ToString(level);
+
+        const bool isEqual = std::equal(name.begin(), name.end(), levelName.begin(), levelName.end(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+
+        if (isEqual) {
+            return level;
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace Cyrex {
+    //Ordered, each level includes the ones below it. SSE is the x64 baseline.
+    enum class IsaLevel : uint8_t {
+        Scalar,
+        SSE,
+        AVX2,
+        AVX512
+    };
+
+    //Picks which variant of the SIMD kernels runs. Every variant is compiled into the binary
+    //with its own target attributes, and a kernel module registers a callback that points its
+    //function pointers at the variant for the current level. The level is the best one the CPU
+    //and the OS support, lowered by the CRX_ISA environment variable or ForceLevel.
+    class CpuDispatch {
+    public:
+        using RebindCallback = void(*)(IsaLevel level) noexcept;
+
+        [[nodiscard]] static IsaLevel GetSupportedLevel() noexcept;
+        [[nodiscard]] static IsaLevel GetLevel() noexcept;
+
+        //Clamped to the supported level, returns the level that was set. Rebinding is not
+        //synchronized with running kernels, so call it at startup or between tests.
+        static IsaLevel ForceLevel(IsaLevel level) noexcept;
+        static void ResetLevel() noexcept;
+
+        //Calls rebind with the current level right away and again whenever the level changes
+        static void Register(RebindCallback rebind) noexcept;
+
+        [[nodiscard]] static const char* ToString(IsaLevel level) noexcept;
+        [[nodiscard]] static std::optional<IsaLevel> FromString(std::string_view name) noexcept;
+    };
+}
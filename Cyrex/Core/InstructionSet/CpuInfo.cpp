@@ -3,18 +3,31 @@
 #include <algorithm>
 #include <ranges>
 
+#ifndef _WIN32
+#include <fstream>
+#include <set>
+#include <sys/utsname.h>
+#endif
+
 namespace views = std::ranges::views;
 
 using namespace Cyrex;
 
 CPUInfo::CPUInfo() {
+#ifdef _WIN32
     GetNativeSystemInfo(&m_sysInfo);
+#endif
 
     Info.Architecture           = GetArchitecture();
     Info.NumLogicalProcessors   = GetNumberOfLogicalProcessors();
     Info.NumCores               = GetNumberOfCores();
 }
 
+#ifdef _WIN32
+const std::string CPUInfo::GetArchitecture() const noexcept {
+    return m_architectures.at(m_sysInfo.wProcessorArchitecture);
+}
+
 const uint32_t CPUInfo::GetNumberOfCores() const noexcept {
     DWORD lengthInBytes{ 0 };
     uint32_t numCores{ 0 };
@@ -36,3 +49,43 @@ const uint32_t CPUInfo::GetNumberOfCores() const noexcept {
 
     return numCores;
 }
+#else
+const std::string CPUInfo::GetArchitecture() const noexcept {
+    utsname name{};
+
+    if (uname(&name) != 0) [[unlikely]] {
+        return "Unknown architecture.";
+    }
+
+    const auto it = m_architectures.find(name.machine);
+    return it != m_architectures.end() ? it->second : "Unknown architecture.";
+}
+
+//Counts the distinct (physical id, core id) pairs, hyperthreads share a pair
+const uint32_t CPUInfo::GetNumberOfCores() const noexcept {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::set<std::pair<std::string, std::string>> cores;
+
+    std::string line;
+    std::string physicalId;
+
+    while (std::getline(cpuinfo, line)) {
+        const auto separator = line.find(':');
+        if (separator == std::string::npos) {
+            continue;
+        }
+
+        const auto value = separator + 2 <= line.size() ? line.substr(separator + 2) : std::string{};
+
+        if (line.starts_with("physical id")) {
+            physicalId = value;
+        }
+        else if (line.starts_with("core id")) {
+            cores.emplace(physicalId, value);
+        }
+    }
+
+    //Some kernels and architectures don't report the topology
+    return cores.empty() ? GetNumberOfLogicalProcessors() : static_cast<uint32_t>(cores.size());
+}
+#endif
@@ -1,5 +1,7 @@
 #pragma once
+#ifdef _WIN32
 #include "Platform/Windows/CrxWindow.h"
+#endif
 #include <string>
 #include "InstructionSet.h"
 #include <array>
@@ -18,10 +20,11 @@ namespace Cyrex {
             InstructionSet InstructionSetFeatures;
         } Info;
     private:
-        [[nodiscard]] const std::string& GetArchitecture()          const noexcept { return m_architectures.at(m_sysInfo.wProcessorArchitecture); }
+        [[nodiscard]] const std::string GetArchitecture()           const noexcept;
         [[nodiscard]] const uint32_t GetNumberOfLogicalProcessors() const noexcept { return std::thread::hardware_concurrency(); }
         [[nodiscard]] const uint32_t GetNumberOfCores()             const noexcept;
 
+#ifdef _WIN32
         SYSTEM_INFO m_sysInfo;
         std::unordered_map<int, std::string> m_architectures{
             {9, "x86-64"},
@@ -31,5 +34,15 @@ namespace Cyrex {
             {0, "x86-32"},
             {0xFFFF, "Unknown architecture."}
         };
+#else
+        //Keyed by uname's machine field
+        std::unordered_map<std::string, std::string> m_architectures{
+            {"x86_64", "x86-64"},
+            {"armv7l", "ARM"},
+            {"aarch64", "ARM64"},
+            {"ia64", "Intel Itanium-based"},
+            {"i686", "x86-32"},
+        };
+#endif
     };
 }
@@ -1,10 +1,47 @@
 #include "InstructionSet.h"
+#include "Core/Math/SIMD.h"
+
+#if CRX_SIMD_X86 && defined(_MSC_VER)
 #include <intrin.h>
+#elif CRX_SIMD_X86
+#include <cpuid.h>
+#endif
 
 using namespace Cyrex;
 
+namespace {
+    void CpuId(Register32* registers, int function, int subFunction = 0) noexcept {
+#if CRX_SIMD_X86 && defined(_MSC_VER)
+        __cpuidex(registers, function, subFunction);
+#elif CRX_SIMD_X86
+        unsigned int eax, ebx, ecx, edx;
+        __cpuid_count(static_cast<unsigned int>(function), static_cast<unsigned int>(subFunction), eax, ebx, ecx, edx);
+
+        registers[0] = static_cast<Register32>(eax);
+        registers[1] = static_cast<Register32>(ebx);
+        registers[2] = static_cast<Register32>(ecx);
+        registers[3] = static_cast<Register32>(edx);
+#else
+        registers[0] = registers[1] = registers[2] = registers[3] = 0;
+#endif
+    }
+
+    //Only valid when OSXSAVE is set
+    uint64_t ReadXCR0() noexcept {
+#if CRX_SIMD_X86 && defined(_MSC_VER)
+        return _xgetbv(0);
+#elif CRX_SIMD_X86
+        uint32_t eax, edx;
+        asm volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+#else
+        return 0;
+#endif
+    }
+}
+
 InstructionSet::InstructionSet() noexcept {
-    __cpuid(*m_cpuData.Data32().data(), 0);
+    CpuId(*m_cpuData.Data32().data(), 0);
 
     m_ids = m_cpuData.Regs32().EAX;
 
@@ -12,7 +49,7 @@ InstructionSet::InstructionSet() noexcept {
     m_vendor = CaptureVendor();
 
     for (int i = 0; i <= m_ids; ++i) {
-        __cpuidex(*m_cpuData.Data32().data(), i, 0);
+        CpuId(*m_cpuData.Data32().data(), i);
         m_data.push_back(m_cpuData);
     }
 
@@ -29,20 +66,24 @@ InstructionSet::InstructionSet() noexcept {
         m_bitsetFlags[1] = m_data[1].Regs32().EDX;
     }
 
+    if (OSXSAVE()) {
+        m_xcr0 = ReadXCR0();
+    }
+
     // load bitset with flags for function 0x00000007
     if (m_ids >= 7) {
         m_bitsetFlags[2] = m_data[7].Regs32().EBX;
         m_bitsetFlags[3] = m_data[7].Regs32().ECX;
     }
 
-    __cpuid(*m_cpuData.Data32().data(), 0x80000000);
+    CpuId(*m_cpuData.Data32().data(), 0x80000000);
     m_exIds = m_cpuData.Regs32().EAX;
 
     //Capture the cpu BrandString 
     m_brandstring = CaptureBrandString();
 
     for (int i = 0x80000000; i <= m_exIds; ++i) {
-        __cpuidex(*m_cpuData.Data32().data(), i, 0);
+        CpuId(*m_cpuData.Data32().data(), i);
         m_extdata.push_back(m_cpuData);
     }
 
@@ -55,7 +96,7 @@ InstructionSet::InstructionSet() noexcept {
 
 
 //Returns the 12 character CPU vendor ID string stored in EBX, EDX, ECX (in that order) 
-const std::string InstructionSet::CaptureVendor() const noexcept {
+std::string InstructionSet::CaptureVendor() const noexcept {
     const auto& registers = m_cpuData.Regs8();
 
     return  std::string{}.append(registers.EBX.data(), registers.EBX.size())
@@ -66,7 +107,7 @@ const std::string InstructionSet::CaptureVendor() const noexcept {
 
 //Returns the 48 byte null terminated cpu brandstring stored in EAX, EBX, ECX and EDX
 //by calling the __cpuid intrinsic with EAX set to 0x80000002, 0x80000003 and 0x80000004
-const std::string InstructionSet::CaptureBrandString() const noexcept {
+std::string InstructionSet::CaptureBrandString() const noexcept {
     if (m_exIds < 0x80000004) [[unlikely]] {
         return "Unable to get CPU brand information";
     }
@@ -75,7 +116,7 @@ const std::string InstructionSet::CaptureBrandString() const noexcept {
     std::string brandString{};
 
     for (const auto& funcID : cpuIDBrandStringCalls) {
-        __cpuid(*m_cpuData.Data32().data(), funcID);
+        CpuId(*m_cpuData.Data32().data(), funcID);
         const auto& data8 = m_cpuData.Data8();
 
         brandString.append(*data8.data(), data8.size());
@@ -1,7 +1,11 @@
+#pragma once
 #include <vector>
 #include <array>
+#include <bit>
 #include <bitset>
+#include <cstdint>
 #include <map>
+#include <string>
 
 namespace Cyrex {
     struct Vendor {
@@ -135,11 +139,16 @@ namespace Cyrex {
         [[nodiscard]] constexpr bool _3DNOWEXT()   const noexcept { return m_isAMD && m_bitsetFlags[5][30]; }
         [[nodiscard]] constexpr bool _3DNOW()      const noexcept { return m_isAMD && m_bitsetFlags[5][31]; }
 
+        //Whether the OS saves the AVX and AVX-512 registers on context switches, from XCR0.
+        //Without it the instructions fault even when the CPU has them.
+        [[nodiscard]] constexpr bool OSSavesAVX()    const noexcept { return (m_xcr0 & 0x06) == 0x06; }
+        [[nodiscard]] constexpr bool OSSavesAVX512() const noexcept { return (m_xcr0 & 0xE6) == 0xE6; }
+
         [[nodiscard]] const std::string& Vendor()      const noexcept { return m_vendor;      }
         [[nodiscard]] const std::string& Brandstring() const noexcept { return m_brandstring; }
     private:
-        const [[nodiscard]] std::string CaptureVendor()      const noexcept;
-        const [[nodiscard]] std::string CaptureBrandString() const noexcept;
+        [[nodiscard]] std::string CaptureVendor()      const noexcept;
+        [[nodiscard]] std::string CaptureBrandString() const noexcept;
 
         int m_ids{};
         int m_exIds{};
@@ -147,6 +156,8 @@ namespace Cyrex {
         bool m_isIntel{};
         bool m_isAMD{};
 
+        uint64_t m_xcr0{};
+
         CpuData m_cpuData;
         std::array<std::bitset<32>, 6> m_bitsetFlags{};
 
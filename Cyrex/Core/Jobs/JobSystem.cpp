@@ -0,0 +1,233 @@
+#include "JobSystem.h"
+#include <cassert>
+#include <string>
+
+#ifdef _WIN32
+#include "Core/Utils/ThreadUtils.h"
+#endif
+
+using namespace Cyrex;
+
+namespace {
+    constexpr uint32_t InvalidWorkerIndex = ~0u;
+    thread_local uint32_t t_workerIndex   = InvalidWorkerIndex;
+}
+
+std::unique_ptr<JobSystem> JobSystem::ms_instance = nullptr;
+
+JobSystem::JobSystem(uint32_t numWorkers) {
+    numWorkers = std::max(1u, numWorkers);
+
+    m_workers.reserve(numWorkers);
+
+    for (uint32_t i = 0; i < numWorkers; ++i) {
+        m_workers.emplace_back(std::make_unique<Worker>());
+    }
+
+    //Start the threads after every deque exists since workers steal from each other
+    for (uint32_t i = 0; i < numWorkers; ++i) {
+        auto& thread = m_workers[i]->Thread;
+        thread = std::thread(&JobSystem::WorkerLoop, this, i);
+
+#ifdef _WIN32
+        const auto threadName = "Job Worker " + std::to_string(i);
+        ThreadUtils::SetThreadName(thread, threadName.c_str());
+#endif
+    }
+}
+
+JobSystem::~JobSystem() {
+    m_running = false;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker->Thread.joinable()) {
+            worker->Thread.join();
+        }
+    }
+
+    //Release anything that was scheduled but never got to run
+    for (auto& worker : m_workers) {
+        while (auto job = worker->Queue.Pop()) {
+            delete *job;
+        }
+    }
+
+    for (auto job : m_globalQueue) {
+        delete job;
+    }
+}
+
+void JobSystem::Create(uint32_t numWorkers) {
+    assert(!ms_instance && "The job system has already been created");
+    ms_instance.reset(new JobSystem(numWorkers));
+}
+
+void JobSystem::Destroy() noexcept {
+    ms_instance.reset();
+}
+
+JobSystem& JobSystem::Get() noexcept {
+    assert(ms_instance && "The job system has not been created");
+    return *ms_instance;
+}
+
+bool JobSystem::IsWorkerThread() noexcept {
+    return t_workerIndex != InvalidWorkerIndex;
+}
+
+void JobSystem::Run(std::function<void()> task, JobCounter* counter, JobCounter* dependency) {
+    if (counter) {
+        counter->m_count.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    auto job = new Job{ std::move(task), counter };
+
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->m_mutex);
+
+        if (dependency->m_count.load(std::memory_order_acquire) != 0) {
+            dependency->m_continuations.push_back(job);
+            return;
+        }
+    }
+
+    Enqueue(job);
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    while (!counter.IsDone()) {
+        if (auto job = FindJob(t_workerIndex)) {
+            Execute(job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    //The last decrement happens under this lock, taking it makes sure
+    //the worker that finished the counter has let go of it.
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::WorkerLoop(uint32_t workerIndex) noexcept {
+    t_workerIndex = workerIndex;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        if (auto job = FindJob(workerIndex)) {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+        m_sleepingWorkers.fetch_add(1);
+        m_wakeCondition.wait(lock, [this] {
+            return m_pendingJobs.load() > 0 || !m_running.load();
+        });
+        m_sleepingWorkers.fetch_sub(1);
+    }
+}
+
+void JobSystem::Enqueue(Job* job) {
+    const auto workerIndex = t_workerIndex;
+
+    //Count the job before publishing it so it can never be taken while uncounted
+    m_pendingJobs.fetch_add(1);
+
+    if (workerIndex == InvalidWorkerIndex || !m_workers[workerIndex]->Queue.Push(job)) {
+        std::lock_guard<std::mutex> lock(m_globalQueueMutex);
+        m_globalQueue.push_back(job);
+    }
+
+    //Pairs with the sleeping worker count being raised before the predicate check
+    if (m_sleepingWorkers.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wakeCondition.notify_one();
+    }
+}
+
+void JobSystem::Execute(Job* job) noexcept {
+    job->Task();
+
+    if (job->Counter) {
+        Decrement(*job->Counter);
+    }
+
+    delete job;
+}
+
+void JobSystem::Decrement(JobCounter& counter) {
+    auto value = counter.m_count.load(std::memory_order_relaxed);
+
+    //Fast path, we are not the last job on this counter
+    while (value > 1) {
+        if (counter.m_count.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+
+    std::vector<Job*> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+
+        if (counter.m_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            continuations.swap(counter.m_continuations);
+        }
+    }
+
+    for (auto continuation : continuations) {
+        Enqueue(continuation);
+    }
+}
+
+Job* JobSystem::FindJob(uint32_t workerIndex) noexcept {
+    const auto numWorkers = static_cast<uint32_t>(m_workers.size());
+
+    if (workerIndex != InvalidWorkerIndex) {
+        if (auto job = m_workers[workerIndex]->Queue.Pop()) {
+            m_pendingJobs.fetch_sub(1);
+            return *job;
+        }
+    }
+
+    //Nothing has been scheduled anywhere
+    if (m_pendingJobs.load() == 0) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_globalQueueMutex);
+
+        if (!m_globalQueue.empty()) {
+            auto job = m_globalQueue.front();
+            m_globalQueue.pop_front();
+
+            m_pendingJobs.fetch_sub(1);
+            return job;
+        }
+    }
+
+    //Start stealing from our neighbour so thieves spread out over the victims
+    const auto start = (workerIndex == InvalidWorkerIndex) ? 0 : workerIndex + 1;
+
+    for (uint32_t i = 0; i < numWorkers; ++i) {
+        const auto victim = (start + i) % numWorkers;
+
+        if (victim == workerIndex) {
+            continue;
+        }
+
+        if (auto job = m_workers[victim]->Queue.Steal()) {
+            m_pendingJobs.fetch_sub(1);
+            return *job;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include "WorkStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cyrex {
+    class JobCounter;
+
+    struct Job {
+        std::function<void()> Task;
+        JobCounter* Counter{ nullptr };
+    };
+
+    //Counts outstanding jobs. Jobs can be made to depend on a counter, they are
+    //scheduled once the counter reaches zero. Only JobSystem::Wait guarantees
+    //that the counter is no longer touched by a worker, so always Wait before
+    //destroying a counter that jobs were scheduled with.
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter& rhs) = delete;
+        JobCounter& operator=(const JobCounter& rhs) = delete;
+
+        [[nodiscard]] bool IsDone()       const noexcept { return m_count.load(std::memory_order_acquire) == 0; }
+        [[nodiscard]] uint32_t GetValue() const noexcept { return m_count.load(std::memory_order_acquire); }
+    private:
+        friend class JobSystem;
+
+        std::atomic_uint32_t m_count{ 0 };
+        std::mutex m_mutex;
+        std::vector<Job*> m_continuations;
+    };
+
+    class JobSystem {
+    public:
+        JobSystem(const JobSystem& rhs) = delete;
+        JobSystem& operator=(const JobSystem& rhs) = delete;
+        ~JobSystem();
+
+        static void Create(uint32_t numWorkers);
+        static void Destroy() noexcept;
+        [[nodiscard]] static JobSystem& Get() noexcept;
+
+        //Schedules a task. If counter is set it is incremented now and decremented
+        //when the task has finished. If dependency is set the task is not started
+        //before the dependency counter has reached zero.
+        void Run(std::function<void()> task, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+        //Blocks until the counter reaches zero. The calling thread executes
+        //pending jobs while it waits, so it is safe to call from inside a job.
+        void Wait(JobCounter& counter);
+
+        //Calls func(i) for every i in [0, count), split into batches of batchSize.
+        template<typename Func>
+        void ParallelFor(uint32_t count, uint32_t batchSize, Func&& func);
+
+        //Maps every i in [0, count) and reduces the results. Each batch is reduced
+        //locally and the partial results are combined in batch order, so the
+        //result is deterministic for a given batchSize.
+        template<typename T, typename Map, typename Reduce>
+        [[nodiscard]] T ParallelReduce(uint32_t count, uint32_t batchSize, T identity, Map&& map, Reduce&& reduce);
+
+        [[nodiscard]] uint32_t GetNumWorkers() const noexcept { return static_cast<uint32_t>(m_workers.size()); }
+        [[nodiscard]] static bool IsWorkerThread() noexcept;
+    private:
+        explicit JobSystem(uint32_t numWorkers);
+
+        struct Worker {
+            WorkStealingDeque<Job*> Queue;
+            std::thread Thread;
+        };
+
+        void WorkerLoop(uint32_t workerIndex) noexcept;
+        void Enqueue(Job* job);
+        void Execute(Job* job) noexcept;
+        void Decrement(JobCounter& counter);
+        [[nodiscard]] Job* FindJob(uint32_t workerIndex) noexcept;
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        //Jobs submitted from threads that do not own a deque
+        std::deque<Job*> m_globalQueue;
+        std::mutex m_globalQueueMutex;
+
+        std::atomic_uint32_t m_pendingJobs{ 0 };
+        std::atomic_uint32_t m_sleepingWorkers{ 0 };
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wakeCondition;
+        std::atomic_bool m_running{ true };
+
+        static std::unique_ptr<JobSystem> ms_instance;
+    };
+
+    template<typename Func>
+    inline void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, Func&& func) {
+        if (count == 0) {
+            return;
+        }
+
+        batchSize = std::max(1u, batchSize);
+
+        JobCounter counter;
+
+        for (uint32_t begin = 0; begin < count; begin += batchSize) {
+            const auto end = std::min(count, begin + batchSize);
+
+            Run([&func, begin, end] {
+                for (auto i = begin; i < end; ++i) {
+                    func(i);
+                }
+            }, &counter);
+        }
+
+        Wait(counter);
+    }
+
+    template<typename T, typename Map, typename Reduce>
+    inline T JobSystem::ParallelReduce(uint32_t count, uint32_t batchSize, T identity, Map&& map, Reduce&& reduce) {
+        if (count == 0) {
+            return identity;
+        }
+
+        batchSize = std::max(1u, batchSize);
+
+        const auto numBatches = (count + batchSize - 1) / batchSize;
+        std::vector<T> partials(numBatches, identity);
+
+        JobCounter counter;
+
+        for (uint32_t batch = 0; batch < numBatches; ++batch) {
+            Run([&, batch] {
+                const auto begin = batch * batchSize;
+                const auto end   = std::min(count, begin + batchSize);
+
+                T result = identity;
+                for (auto i = begin; i < end; ++i) {
+                    result = reduce(result, map(i));
+                }
+                partials[batch] = result;
+            }, &counter);
+        }
+
+        Wait(counter);
+
+        T result = identity;
+        for (const auto& partial : partials) {
+            result = reduce(result, partial);
+        }
+        return result;
+    }
+}
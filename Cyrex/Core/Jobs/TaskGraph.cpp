@@ -0,0 +1,128 @@
+#include "TaskGraph.h"
+#include "JobSystem.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+using namespace Cyrex;
+
+TaskGraph::TaskHandle TaskGraph::AddTask(std::string name, std::function<void()> task, std::initializer_list<TaskHandle> dependencies) {
+    const auto handle = static_cast<TaskHandle>(m_tasks.size());
+
+    auto& node    = m_tasks.emplace_back(std::make_unique<Task>());
+    node->Name     = std::move(name);
+    node->Function = std::move(task);
+
+    for (const auto dependency : dependencies) {
+        assert(dependency < handle && "A task can only depend on tasks added before it");
+
+        node->Dependencies.push_back(dependency);
+        m_tasks[dependency]->Successors.push_back(handle);
+    }
+
+    return handle;
+}
+
+void TaskGraph::Execute(JobSystem& jobSystem) {
+    for (auto& task : m_tasks) {
+        task->RemainingDependencies.store(static_cast<uint32_t>(task->Dependencies.size()), std::memory_order_relaxed);
+    }
+
+    JobCounter counter;
+
+    for (TaskHandle i = 0; i < m_tasks.size(); ++i) {
+        if (m_tasks[i]->Dependencies.empty()) {
+            Schedule(jobSystem, i, counter);
+        }
+    }
+
+    jobSystem.Wait(counter);
+
+    UpdateCriticalPath();
+}
+
+void TaskGraph::Schedule(JobSystem& jobSystem, TaskHandle handle, JobCounter& counter) {
+    jobSystem.Run([this, &jobSystem, &counter, handle] {
+        auto& task = *m_tasks[handle];
+
+        task.Start = Clock::now();
+        {
+            //Task names live as long as the graph, which outlives any capture
+            CRX_PROFILE_SCOPE(task.Name.c_str());
+            task.Function();
+        }
+        task.End   = Clock::now();
+
+        //Successors are scheduled before this job retires, so the counter can not reach zero early
+        for (const auto successor : task.Successors) {
+            if (m_tasks[successor]->RemainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Schedule(jobSystem, successor, counter);
+            }
+        }
+    }, &counter);
+}
+
+double TaskGraph::GetMilliseconds(TaskHandle handle) const noexcept {
+    const auto& task = *m_tasks[handle];
+    return std::chrono::duration<double, std::milli>(task.End - task.Start).count();
+}
+
+void TaskGraph::UpdateCriticalPath() {
+    const auto numTasks = m_tasks.size();
+
+    std::vector<double> pathMs(numTasks, 0.0);
+    std::vector<TaskHandle> predecessor(numTasks, static_cast<TaskHandle>(numTasks));
+
+    TaskHandle last = 0;
+
+    //Tasks are stored in topological order, so every dependency has already been visited
+    for (TaskHandle i = 0; i < numTasks; ++i) {
+        double longest = 0.0;
+
+        for (const auto dependency : m_tasks[i]->Dependencies) {
+            if (pathMs[dependency] > longest) {
+                longest        = pathMs[dependency];
+                predecessor[i] = dependency;
+            }
+        }
+
+        pathMs[i] = longest + GetMilliseconds(i);
+
+        if (pathMs[i] > pathMs[last]) {
+            last = i;
+        }
+    }
+
+    m_criticalPath.clear();
+
+    if (numTasks == 0) {
+        m_criticalPathMs = 0.0;
+        return;
+    }
+
+    m_criticalPathMs = pathMs[last];
+
+    for (auto task = last; task < numTasks; task = predecessor[task]) {
+        m_criticalPath.push_back(task);
+    }
+
+    std::reverse(m_criticalPath.begin(), m_criticalPath.end());
+}
+
+std::string TaskGraph::GetCriticalPathString() const {
+    std::string result;
+
+    for (const auto task : m_criticalPath) {
+        if (!result.empty()) {
+            result.append(" -> ");
+        }
+        result.append(m_tasks[task]->Name);
+    }
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), " (%.3f ms)", m_criticalPathMs);
+    result.append(buffer);
+
+    return result;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Cyrex {
+    class JobCounter;
+    class JobSystem;
+
+    //A graph of named tasks that is built once and executed every frame.
+    //A task only depends on tasks that were added before it, so the order
+    //tasks are added in is always a valid topological order.
+    class TaskGraph {
+    public:
+        using TaskHandle = uint32_t;
+
+        TaskGraph() = default;
+        TaskGraph(const TaskGraph& rhs) = delete;
+        TaskGraph& operator=(const TaskGraph& rhs) = delete;
+
+        TaskHandle AddTask(std::string name, std::function<void()> task, std::initializer_list<TaskHandle> dependencies = {});
+
+        //Runs every task once, respecting dependencies, and blocks until all have finished
+        void Execute(JobSystem& jobSystem);
+
+        [[nodiscard]] size_t GetNumTasks()                        const noexcept { return m_tasks.size(); }
+        [[nodiscard]] const std::string& GetName(TaskHandle task) const noexcept { return m_tasks[task]->Name; }
+        [[nodiscard]] double GetMilliseconds(TaskHandle task)     const noexcept;
+
+        //The chain of dependent tasks with the largest summed duration in the last execution
+        [[nodiscard]] const std::vector<TaskHandle>& GetCriticalPath() const noexcept { return m_criticalPath; }
+        [[nodiscard]] double GetCriticalPathMilliseconds()             const noexcept { return m_criticalPathMs; }
+        [[nodiscard]] std::string GetCriticalPathString() const;
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Task {
+            std::string Name;
+            std::function<void()> Function;
+            std::vector<TaskHandle> Dependencies;
+            std::vector<TaskHandle> Successors;
+            std::atomic_uint32_t RemainingDependencies{ 0 };
+            Clock::time_point Start;
+            Clock::time_point End;
+        };
+
+        void Schedule(JobSystem& jobSystem, TaskHandle task, JobCounter& counter);
+        void UpdateCriticalPath();
+
+        std::vector<std::unique_ptr<Task>> m_tasks;
+        std::vector<TaskHandle> m_criticalPath;
+        double m_criticalPathMs{ 0.0 };
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace Cyrex {
+    //Bounded Chase-Lev deque. Only the owning thread may call Push and Pop,
+    //any thread may call Steal. T must be trivially copyable (typically a pointer).
+    template<typename T, size_t Capacity = 4096>
+    class WorkStealingDeque {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>);
+    public:
+        WorkStealingDeque() = default;
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        bool Push(T item) noexcept {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed);
+            const auto top    = m_top.load(std::memory_order_acquire);
+
+            if (bottom - top >= static_cast<int64_t>(Capacity)) [[unlikely]] {
+                return false;
+            }
+
+            m_buffer[bottom & m_mask].store(item, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        std::optional<T> Pop() noexcept {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                //Deque was empty
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T item = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+
+            if (top == bottom) {
+                //Last item, race against thieves for it
+                const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+                if (!won) {
+                    return std::nullopt;
+                }
+            }
+            return item;
+        }
+
+        std::optional<T> Steal() noexcept {
+            auto top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) {
+                return std::nullopt;
+            }
+
+            T item = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+            return item;
+        }
+
+        [[nodiscard]] bool Empty() const noexcept {
+            return m_top.load(std::memory_order_acquire) >= m_bottom.load(std::memory_order_acquire);
+        }
+    private:
+        static constexpr int64_t m_mask = static_cast<int64_t>(Capacity) - 1;
+
+        alignas(64) std::atomic_int64_t m_top{ 0 };
+        alignas(64) std::atomic_int64_t m_bottom{ 0 };
+        alignas(64) std::array<std::atomic<T>, Capacity> m_buffer{};
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "Core/Math/Math.h"
+#include <cstddef>
+#include <new>
+
+namespace Cyrex {
+    //Hands out aligned offsets into a fixed size range front to back, e.g. an upload heap page.
+    //Only knows about offsets, the owner maps them to memory.
+    class LinearAllocator {
+    public:
+        explicit LinearAllocator(size_t size) noexcept
+            :
+            m_size(size)
+        {}
+
+        [[nodiscard]] bool HasSpace(size_t sizeInBytes, size_t alignment) const noexcept {
+            const size_t alignedSize   = Math::AlignUp(sizeInBytes, alignment);
+            const size_t alignedOffset = Math::AlignUp(m_offset, alignment);
+
+            return alignedOffset + alignedSize <= m_size;
+        }
+
+        //Returns the offset of the allocation, throws std::bad_alloc if it does not fit
+        [[nodiscard]] size_t Allocate(size_t sizeInBytes, size_t alignment) {
+            if (!HasSpace(sizeInBytes, alignment)) {
+                throw std::bad_alloc();
+            }
+
+            const size_t alignedSize = Math::AlignUp(sizeInBytes, alignment);
+            const size_t offset      = Math::AlignUp(m_offset, alignment);
+
+            m_offset = offset + alignedSize;
+
+            return offset;
+        }
+
+        void Reset() noexcept { m_offset = 0; }
+
+        [[nodiscard]] size_t GetSize() const noexcept { return m_size; }
+        [[nodiscard]] size_t GetOffset() const noexcept { return m_offset; }
+    private:
+        size_t m_size;
+        size_t m_offset{ 0 };
+    };
+}
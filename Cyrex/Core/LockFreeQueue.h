@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Cyrex {
+    namespace Detail {
+        inline constexpr size_t CacheLineSize = 64;
+
+        template<class T>
+        struct alignas(T) QueueStorage {
+            T* Get() noexcept { return std::launder(reinterpret_cast<T*>(Data)); }
+            std::byte Data[sizeof(T)];
+        };
+    }
+
+    //Bounded single-producer/single-consumer ring buffer.
+    //Capacity is rounded up to the next power of two.
+    template<class T>
+    class SPSCQueue {
+    public:
+        explicit SPSCQueue(size_t capacity);
+        SPSCQueue(const SPSCQueue& rhs) = delete;
+        SPSCQueue& operator=(const SPSCQueue& rhs) = delete;
+        ~SPSCQueue();
+
+        template<class... Args>
+        bool TryEmplace(Args&&... args);
+        bool TryPush(const T& value) { return TryEmplace(value); }
+        bool TryPush(T&& value)      { return TryEmplace(std::move(value)); }
+        bool TryPop(T& value);
+
+        //Moves as many elements as fit, returns the number of elements pushed
+        template<class It>
+        size_t TryPushBatch(It first, It last);
+        //Pops up to maxCount elements into out, returns the number of elements popped
+        template<class OutIt>
+        size_t TryPopBatch(OutIt out, size_t maxCount);
+
+        [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+        [[nodiscard]] size_t Size() const noexcept;
+        [[nodiscard]] size_t Capacity() const noexcept { return m_mask + 1; }
+    private:
+        const size_t m_mask;
+        std::unique_ptr<Detail::QueueStorage<T>[]> m_buffer;
+
+        alignas(Detail::CacheLineSize) std::atomic_size_t m_head{ 0 };
+        size_t m_cachedTail{ 0 };
+
+        alignas(Detail::CacheLineSize) std::atomic_size_t m_tail{ 0 };
+        size_t m_cachedHead{ 0 };
+    };
+
+    //Bounded multi-producer/multi-consumer ring buffer (Vyukov).
+    //Every cell carries a sequence number, producers and consumers only
+    //contend on the index they claim and never take a lock.
+    template<class T>
+    class MPMCQueue {
+    public:
+        explicit MPMCQueue(size_t capacity);
+        MPMCQueue(const MPMCQueue& rhs) = delete;
+        MPMCQueue& operator=(const MPMCQueue& rhs) = delete;
+        ~MPMCQueue();
+
+        template<class... Args>
+        bool TryEmplace(Args&&... args);
+        bool TryPush(const T& value) { return TryEmplace(value); }
+        bool TryPush(T&& value)      { return TryEmplace(std::move(value)); }
+        bool TryPop(T& value);
+
+        //Claims a run of free cells with a single CAS, returns the number of elements pushed
+        template<class It>
+        size_t TryPushBatch(It first, It last);
+        //Claims a run of full cells with a single CAS, returns the number of elements popped
+        template<class OutIt>
+        size_t TryPopBatch(OutIt out, size_t maxCount);
+
+        //Only a snapshot when other threads are using the queue
+        [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+        [[nodiscard]] size_t Size() const noexcept;
+        [[nodiscard]] size_t Capacity() const noexcept { return m_mask + 1; }
+    private:
+        struct Cell {
+            std::atomic_size_t Sequence;
+            Detail::QueueStorage<T> Storage;
+        };
+
+        const size_t m_mask;
+        std::unique_ptr<Cell[]> m_cells;
+
+        alignas(Detail::CacheLineSize) std::atomic_size_t m_enqueuePos{ 0 };
+        alignas(Detail::CacheLineSize) std::atomic_size_t m_dequeuePos{ 0 };
+    };
+
+    template<class T>
+    inline SPSCQueue<T>::SPSCQueue(size_t capacity)
+        :
+        m_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        m_buffer(std::make_unique<Detail::QueueStorage<T>[]>(m_mask + 1))
+    {}
+
+    template<class T>
+    inline SPSCQueue<T>::~SPSCQueue() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+
+            for (auto head = m_head.load(std::memory_order_relaxed); head != tail; ++head) {
+                m_buffer[head & m_mask].Get()->~T();
+            }
+        }
+    }
+
+    template<class T>
+    template<class... Args>
+    inline bool SPSCQueue<T>::TryEmplace(Args&&... args) {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+
+            if (tail - m_cachedHead > m_mask) {
+                return false;
+            }
+        }
+
+        ::new (m_buffer[tail & m_mask].Data) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template<class T>
+    inline bool SPSCQueue<T>::TryPop(T& value) {
+        const auto head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+
+        auto element = m_buffer[head & m_mask].Get();
+        value = std::move(*element);
+        element->~T();
+
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template<class T>
+    template<class It>
+    inline size_t SPSCQueue<T>::TryPushBatch(It first, It last) {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        m_cachedHead    = m_head.load(std::memory_order_acquire);
+
+        const auto available = Capacity() - (tail - m_cachedHead);
+
+        size_t count = 0;
+        for (; first != last && count < available; ++first, ++count) {
+            ::new (m_buffer[(tail + count) & m_mask].Data) T(std::move(*first));
+        }
+
+        m_tail.store(tail + count, std::memory_order_release);
+
+        return count;
+    }
+
+    template<class T>
+    template<class OutIt>
+    inline size_t SPSCQueue<T>::TryPopBatch(OutIt out, size_t maxCount) {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        m_cachedTail    = m_tail.load(std::memory_order_acquire);
+
+        const auto count = std::min(maxCount, m_cachedTail - head);
+
+        for (size_t i = 0; i < count; ++i) {
+            auto element = m_buffer[(head + i) & m_mask].Get();
+            *out++ = std::move(*element);
+            element->~T();
+        }
+
+        m_head.store(head + count, std::memory_order_release);
+
+        return count;
+    }
+
+    template<class T>
+    inline size_t SPSCQueue<T>::Size() const noexcept {
+        const auto head = m_head.load(std::memory_order_acquire);
+        const auto tail = m_tail.load(std::memory_order_acquire);
+
+        return tail - head;
+    }
+
+    template<class T>
+    inline MPMCQueue<T>::MPMCQueue(size_t capacity)
+        :
+        m_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        m_cells(std::make_unique<Cell[]>(m_mask + 1))
+    {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template<class T>
+    inline MPMCQueue<T>::~MPMCQueue() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const auto enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+
+            for (auto pos = m_dequeuePos.load(std::memory_order_relaxed); pos != enqueuePos; ++pos) {
+                m_cells[pos & m_mask].Storage.Get()->~T();
+            }
+        }
+    }
+
+    template<class T>
+    template<class... Args>
+    inline bool MPMCQueue<T>::TryEmplace(Args&&... args) {
+        auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            auto& cell          = m_cells[pos & m_mask];
+            const auto sequence = cell.Sequence.load(std::memory_order_acquire);
+            const auto diff     = static_cast<std::ptrdiff_t>(sequence - pos);
+
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    ::new (cell.Storage.Data) T(std::forward<Args>(args)...);
+                    cell.Sequence.store(pos + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                //The consumer has not released this cell yet, the queue is full
+                return false;
+            }
+            else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<class T>
+    inline bool MPMCQueue<T>::TryPop(T& value) {
+        auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            auto& cell          = m_cells[pos & m_mask];
+            const auto sequence = cell.Sequence.load(std::memory_order_acquire);
+            const auto diff     = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    auto element = cell.Storage.Get();
+                    value = std::move(*element);
+                    element->~T();
+
+                    cell.Sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<class T>
+    template<class It>
+    inline size_t MPMCQueue<T>::TryPushBatch(It first, It last) {
+        const auto requested = static_cast<size_t>(std::distance(first, last));
+
+        if (requested == 0) {
+            return 0;
+        }
+
+        auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            //Count how many consecutive cells starting at pos are free
+            size_t count = 0;
+
+            while (count < requested && count <= m_mask) {
+                const auto sequence = m_cells[(pos + count) & m_mask].Sequence.load(std::memory_order_acquire);
+
+                if (sequence != pos + count) {
+                    break;
+                }
+                ++count;
+            }
+
+            if (count == 0) {
+                const auto sequence = m_cells[pos & m_mask].Sequence.load(std::memory_order_acquire);
+
+                if (static_cast<std::ptrdiff_t>(sequence - pos) < 0) {
+                    return 0;
+                }
+
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < count; ++i, ++first) {
+                    auto& cell = m_cells[(pos + i) & m_mask];
+                    ::new (cell.Storage.Data) T(std::move(*first));
+                    cell.Sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                return count;
+            }
+        }
+    }
+
+    template<class T>
+    template<class OutIt>
+    inline size_t MPMCQueue<T>::TryPopBatch(OutIt out, size_t maxCount) {
+        if (maxCount == 0) {
+            return 0;
+        }
+
+        auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            //Count how many consecutive cells starting at pos have been published
+            size_t count = 0;
+
+            while (count < maxCount && count <= m_mask) {
+                const auto sequence = m_cells[(pos + count) & m_mask].Sequence.load(std::memory_order_acquire);
+
+                if (sequence != pos + count + 1) {
+                    break;
+                }
+                ++count;
+            }
+
+            if (count == 0) {
+                const auto sequence = m_cells[pos & m_mask].Sequence.load(std::memory_order_acquire);
+
+                if (static_cast<std::ptrdiff_t>(sequence - (pos + 1)) < 0) {
+                    return 0;
+                }
+
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < count; ++i) {
+                    auto& cell   = m_cells[(pos + i) & m_mask];
+                    auto element = cell.Storage.Get();
+
+                    *out++ = std::move(*element);
+                    element->~T();
+
+                    cell.Sequence.store(pos + i + m_mask + 1, std::memory_order_release);
+                }
+                return count;
+            }
+        }
+    }
+
+    template<class T>
+    inline size_t MPMCQueue<T>::Size() const noexcept {
+        const auto dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+        const auto enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+
+        return (enqueuePos > dequeuePos) ? enqueuePos - dequeuePos : 0;
+    }
+}
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <version>
+
+#include "LogFormat.h"
+
+namespace Cyrex {
+    //Single producer, single consumer ring of variable sized records.
+    //A record is always contiguous, one that does not fit in front of the end of
+    //the buffer is preceded by a padding block and starts over at the beginning.
+    class LogRingBuffer {
+    public:
+        //Capacity is rounded up to the next power of two
+        explicit LogRingBuffer(size_t capacity);
+        LogRingBuffer(const LogRingBuffer& rhs) = delete;
+        LogRingBuffer& operator=(const LogRingBuffer& rhs) = delete;
+
+        //Producer: returns size contiguous bytes or nullptr if the buffer is too full.
+        //The record becomes visible to the consumer once Commit is called.
+        [[nodiscard]] std::byte* TryReserve(size_t size) noexcept;
+        void Commit() noexcept;
+
+        //Consumer: calls func(const std::byte* data, size_t size) for every committed record
+        template<class Func>
+        size_t ConsumeAll(Func&& func);
+
+        [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+        [[nodiscard]] size_t Size() const noexcept;
+        [[nodiscard]] size_t Capacity() const noexcept { return m_mask + 1; }
+        //Larger records are never reserved, so a full buffer can always make progress
+        [[nodiscard]] size_t MaxRecordSize() const noexcept { return Capacity() / 4 - sizeof(BlockHeader); }
+    private:
+        struct BlockHeader {
+            uint32_t Size;
+            uint32_t IsPadding;
+        };
+
+        //Blocks are a multiple of the header size, so the gap in front of the end of the
+        //buffer is either empty or large enough to hold a padding header
+        static constexpr size_t Align(size_t size) noexcept { return (size + sizeof(BlockHeader) - 1) & ~(sizeof(BlockHeader) - 1); }
+
+        const size_t m_mask;
+        std::unique_ptr<std::byte[]> m_buffer;
+
+        alignas(64) std::atomic_uint64_t m_writePos{ 0 };
+        uint64_t m_reservedPos{ 0 };
+        uint64_t m_cachedReadPos{ 0 };
+
+        alignas(64) std::atomic_uint64_t m_readPos{ 0 };
+    };
+
+    inline LogRingBuffer::LogRingBuffer(size_t capacity)
+        :
+        m_mask(std::bit_ceil(std::max<size_t>(capacity, 256)) - 1),
+        m_buffer(std::make_unique<std::byte[]>(m_mask + 1))
+    {}
+
+    inline std::byte* LogRingBuffer::TryReserve(size_t size) noexcept {
+        if (size > MaxRecordSize()) [[unlikely]] {
+            return nullptr;
+        }
+
+        const auto writePos = m_writePos.load(std::memory_order_relaxed);
+        const auto offset   = writePos & m_mask;
+        const auto needed   = Align(sizeof(BlockHeader) + size);
+        const auto padding  = offset + needed > Capacity() ? Capacity() - offset : 0;
+
+        if (writePos + padding + needed - m_cachedReadPos > Capacity()) {
+            m_cachedReadPos = m_readPos.load(std::memory_order_acquire);
+
+            if (writePos + padding + needed - m_cachedReadPos > Capacity()) {
+                return nullptr;
+            }
+        }
+
+        if (padding) {
+            const BlockHeader pad{ static_cast<uint32_t>(padding - sizeof(BlockHeader)), 1 };
+            std::memcpy(m_buffer.get() + offset, &pad, sizeof(pad));
+        }
+
+        const auto recordOffset = (writePos + padding) & m_mask;
+        const BlockHeader header{ static_cast<uint32_t>(size), 0 };
+        std::memcpy(m_buffer.get() + recordOffset, &header, sizeof(header));
+
+        m_reservedPos = writePos + padding + needed;
+        return m_buffer.get() + recordOffset + sizeof(BlockHeader);
+    }
+
+    inline void LogRingBuffer::Commit() noexcept {
+        m_writePos.store(m_reservedPos, std::memory_order_release);
+    }
+
+    template<class Func>
+    inline size_t LogRingBuffer::ConsumeAll(Func&& func) {
+        const auto writePos = m_writePos.load(std::memory_order_acquire);
+        auto readPos        = m_readPos.load(std::memory_order_relaxed);
+
+        size_t numRecords = 0;
+
+        while (readPos != writePos) {
+            const auto block = m_buffer.get() + (readPos & m_mask);
+
+            BlockHeader header;
+            std::memcpy(&header, block, sizeof(header));
+
+            if (!header.IsPadding) {
+                func(static_cast<const std::byte*>(block + sizeof(BlockHeader)), static_cast<size_t>(header.Size));
+                numRecords++;
+            }
+
+            readPos += Align(sizeof(BlockHeader) + header.Size);
+        }
+
+        m_readPos.store(readPos, std::memory_order_release);
+        return numRecords;
+    }
+
+    inline size_t LogRingBuffer::Size() const noexcept {
+        return static_cast<size_t>(m_writePos.load(std::memory_order_acquire) - m_readPos.load(std::memory_order_acquire));
+    }
+
+    //Log arguments are copied into a record as a type tag followed by their value,
+    //formatting them into text is left to whoever consumes the record.
+    namespace LogRecord {
+        enum class ArgType : uint8_t {
+            Bool,
+            Char,
+            WChar,
+            Int,
+            UInt,
+            Float,
+            Double,
+            Pointer,
+            String,
+            WString,
+            Manipulator,
+            WManipulator,
+            Format
+        };
+
+        using Manipulator  = std::ostream& (*)(std::ostream&);
+        using WManipulator = std::wostream& (*)(std::wostream&);
+
+        //Leads the arguments of a record that is formatted from a format string
+        struct FormatCall {
+            using Formatter = void(*)(std::string& out, std::string_view format, const std::byte* args);
+
+            Formatter Format;
+            const char* Text;
+            size_t Length;
+        };
+
+        //Maps an argument onto one of the types a record can hold. Anything else is
+        //formatted through its stream operator here, which is the only path that allocates.
+        template<class T>
+        auto ToArg(const T& value) {
+            using Type = std::decay_t<T>;
+
+            if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, char> || std::is_same_v<Type, wchar_t>) {
+                return value;
+            }
+            else if constexpr (std::is_same_v<Type, float> || std::is_same_v<Type, FormatCall>) {
+                return value;
+            }
+            else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+                return static_cast<int64_t>(value);
+            }
+            else if constexpr (std::is_integral_v<Type>) {
+                return static_cast<uint64_t>(value);
+            }
+            else if constexpr (std::is_floating_point_v<Type>) {
+                return static_cast<double>(value);
+            }
+            else if constexpr (std::is_same_v<Type, Manipulator> || std::is_same_v<Type, WManipulator>) {
+                return value;
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                return std::string_view(value);
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::wstring_view>) {
+                return std::wstring_view(value);
+            }
+            else if constexpr (std::is_pointer_v<Type>) {
+                return static_cast<const void*>(value);
+            }
+            else if constexpr (requires(std::ostream& os) { os << value; }) {
+                std::ostringstream ss;
+                ss << value;
+                return ss.str();
+            }
+#ifdef __cpp_lib_format
+            else {
+                return std::format("{}", value);
+            }
+#endif
+        }
+
+        template<class T>
+        constexpr ArgType TypeOf() noexcept {
+            if constexpr (std::is_same_v<T, bool>)                return ArgType::Bool;
+            else if constexpr (std::is_same_v<T, char>)           return ArgType::Char;
+            else if constexpr (std::is_same_v<T, wchar_t>)        return ArgType::WChar;
+            else if constexpr (std::is_same_v<T, int64_t>)        return ArgType::Int;
+            else if constexpr (std::is_same_v<T, uint64_t>)       return ArgType::UInt;
+            else if constexpr (std::is_same_v<T, float>)          return ArgType::Float;
+            else if constexpr (std::is_same_v<T, double>)         return ArgType::Double;
+            else if constexpr (std::is_same_v<T, const void*>)    return ArgType::Pointer;
+            else if constexpr (std::is_same_v<T, Manipulator>)    return ArgType::Manipulator;
+            else if constexpr (std::is_same_v<T, WManipulator>)   return ArgType::WManipulator;
+            else if constexpr (std::is_same_v<T, FormatCall>)     return ArgType::Format;
+            else if constexpr (std::is_same_v<T, std::wstring_view>) return ArgType::WString;
+            else                                                  return ArgType::String;
+        }
+
+        template<class T>
+        constexpr size_t EncodedSize(const T& arg) noexcept {
+            if constexpr (TypeOf<T>() == ArgType::String || TypeOf<T>() == ArgType::WString) {
+                return sizeof(ArgType) + sizeof(uint32_t) + arg.size() * sizeof(typename T::value_type);
+            }
+            else {
+                return sizeof(ArgType) + sizeof(T);
+            }
+        }
+
+        template<class T>
+        std::byte* Encode(std::byte* dst, const T& arg) noexcept {
+            constexpr auto type = TypeOf<T>();
+            std::memcpy(dst, &type, sizeof(type));
+            dst += sizeof(type);
+
+            if constexpr (type == ArgType::String || type == ArgType::WString) {
+                const auto length = static_cast<uint32_t>(arg.size());
+                std::memcpy(dst, &length, sizeof(length));
+                dst += sizeof(length);
+
+                const auto numBytes = arg.size() * sizeof(typename T::value_type);
+                std::memcpy(dst, arg.data(), numBytes);
+                return dst + numBytes;
+            }
+            else {
+                std::memcpy(dst, &arg, sizeof(arg));
+                return dst + sizeof(arg);
+            }
+        }
+
+        //Leads every record, level is whatever the writer uses to pick the output
+        template<class Level>
+        struct Header {
+            Level Lvl;
+            std::time_t Time;
+        };
+
+        //Encodes header and args into the size bytes reserve(size) returns, false if it returned nullptr.
+        //Publishing the record is left to the caller.
+        template<class Reserve, class Level, class... Args>
+        bool EncodeRecord(Reserve&& reserve, const Header<Level>& header, const Args& ...args) noexcept {
+            const auto encodedArgs = std::make_tuple(ToArg(args)...);
+
+            const auto size = std::apply([](const auto& ...encoded) {
+                return (sizeof(header) + ... + EncodedSize(encoded));
+            }, encodedArgs);
+
+            std::byte* data = reserve(size);
+
+            if (!data) [[unlikely]] {
+                return false;
+            }
+
+            std::memcpy(data, &header, sizeof(header));
+            data += sizeof(header);
+
+            std::apply([&data](const auto& ...encoded) {
+                ((data = Encode(data, encoded)), ...);
+            }, encodedArgs);
+
+            return true;
+        }
+
+        namespace Detail {
+            template<class T>
+            T Read(const std::byte*& src) noexcept {
+                T value;
+                std::memcpy(&value, src, sizeof(value));
+                src += sizeof(value);
+                return value;
+            }
+
+            //Text of the other character width is converted character by character,
+            //anything outside of ASCII does not survive narrowing.
+            template<class CharT, class SrcCharT>
+            void WriteText(std::basic_ostream<CharT>& os, const std::byte*& src, uint32_t length) {
+                if constexpr (std::is_same_v<CharT, char> && std::is_same_v<SrcCharT, char>) {
+                    os.write(reinterpret_cast<const char*>(src), length);
+                    src += length;
+                }
+                else {
+                    for (uint32_t i = 0; i < length; ++i) {
+                        const auto c = Read<SrcCharT>(src);
+                        if constexpr (std::is_same_v<CharT, SrcCharT>) {
+                            os.put(c);
+                        }
+                        else if constexpr (sizeof(CharT) > sizeof(SrcCharT)) {
+                            os.put(os.widen(c));
+                        }
+                        else {
+                            os.put(static_cast<uint32_t>(c) < 0x80 ? static_cast<CharT>(c) : CharT('?'));
+                        }
+                    }
+                }
+            }
+        }
+
+        namespace Detail {
+            template<class T>
+            auto ReadArg(const std::byte*& src) noexcept {
+                src += sizeof(ArgType);
+
+                if constexpr (TypeOf<T>() == ArgType::String) {
+                    const auto length = Read<uint32_t>(src);
+                    const std::string_view text(reinterpret_cast<const char*>(src), length);
+                    src += length;
+                    return text;
+                }
+                else {
+                    return Read<T>(src);
+                }
+            }
+
+            template<class... Args>
+            void FormatArgs(std::string& out, std::string_view format, const std::byte* src) {
+                //Braced initialization reads the arguments in order
+                const std::tuple<decltype(ReadArg<Args>(src))...> args{ ReadArg<Args>(src)... };
+
+                std::apply([&](const auto& ...values) {
+                    FormatTo(out, format, values...);
+                }, args);
+            }
+        }
+
+        //Returns the leading argument of a record formatted from format, the arguments
+        //themselves are encoded after it and formatted by whoever consumes the record.
+        template<class... Args>
+        FormatCall MakeFormatCall(std::string_view format) noexcept {
+            return { &Detail::FormatArgs<Args...>, format.data(), format.size() };
+        }
+
+        //Formats every argument of an encoded record into os
+        template<class CharT>
+        void Decode(std::basic_ostream<CharT>& os, const std::byte* src, const std::byte* end) {
+            using namespace Detail;
+
+            while (src < end) {
+                switch (Read<ArgType>(src)) {
+                case ArgType::Bool:    os << Read<bool>(src);     break;
+                case ArgType::Char:    os << os.widen(Read<char>(src)); break;
+                case ArgType::WChar: {
+                    const auto c = Read<wchar_t>(src);
+                    if constexpr (std::is_same_v<CharT, wchar_t>) {
+                        os.put(c);
+                    }
+                    else {
+                        os.put(static_cast<uint32_t>(c) < 0x80 ? static_cast<char>(c) : '?');
+                    }
+                    break;
+                }
+                case ArgType::Int:     os << Read<int64_t>(src);     break;
+                case ArgType::UInt:    os << Read<uint64_t>(src);    break;
+                case ArgType::Float:   os << Read<float>(src);       break;
+                case ArgType::Double:  os << Read<double>(src);      break;
+                case ArgType::Pointer: os << Read<const void*>(src); break;
+                case ArgType::String: {
+                    const auto length = Read<uint32_t>(src);
+                    WriteText<CharT, char>(os, src, length);
+                    break;
+                }
+                case ArgType::WString: {
+                    const auto length = Read<uint32_t>(src);
+                    WriteText<CharT, wchar_t>(os, src, length);
+                    break;
+                }
+                case ArgType::Manipulator: {
+                    const auto manipulator = Read<Manipulator>(src);
+                    if constexpr (std::is_same_v<CharT, char>) {
+                        //Flushing is left to whoever writes the record
+                        if (manipulator == static_cast<Manipulator>(std::endl)) {
+                            os.put('\n');
+                        }
+                        else {
+                            os << manipulator;
+                        }
+                    }
+                    break;
+                }
+                case ArgType::WManipulator: {
+                    const auto manipulator = Read<WManipulator>(src);
+                    if constexpr (std::is_same_v<CharT, wchar_t>) {
+                        if (manipulator == static_cast<WManipulator>(std::endl)) {
+                            os.put(L'\n');
+                        }
+                        else {
+                            os << manipulator;
+                        }
+                    }
+                    break;
+                }
+                case ArgType::Format: {
+                    //The formatter consumes every argument that follows
+                    const auto call = Read<FormatCall>(src);
+
+                    thread_local std::string text;
+                    text.clear();
+                    call.Format(text, std::string_view(call.Text, call.Length), src);
+                    text.push_back('\n');
+
+                    auto data = reinterpret_cast<const std::byte*>(text.data());
+                    WriteText<CharT, char>(os, data, static_cast<uint32_t>(text.size()));
+                    return;
+                }
+                default:
+                    return;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <version>
+
+#ifdef __cpp_lib_format
+#include <format>
+#include <iterator>
+#else
+#include <array>
+#include <charconv>
+#include <cstdint>
+#endif
+
+//Format strings of crxlog::fmt. With <format> they are std::format_string and std::vformat_to,
+//without it a subset of the std::format syntax is checked and formatted here:
+//{[index][:[[fill]align][0][width][.precision][type]]} with the types b, c, d, o, x, X, e, E,
+//f, F, g, G, s and p. Format strings that need more than that do not compile.
+namespace Cyrex::LogRecord {
+#ifdef __cpp_lib_format
+    template<class... Args>
+    using FormatString = std::format_string<Args...>;
+
+    template<class... Values>
+    void FormatTo(std::string& out, std::string_view format, const Values& ...values) {
+        std::vformat_to(std::back_inserter(out), format, std::make_format_args(values...));
+    }
+#else
+    namespace Detail {
+        struct FormatSpec {
+            size_t Index    = 0;
+            char Fill       = ' ';
+            char Align      = 0;
+            bool ZeroPad    = false;
+            int Width       = 0;
+            int Precision   = -1;
+            char Type       = 0;
+        };
+
+        constexpr bool IsDigit(char c) noexcept {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr bool IsAlign(char c) noexcept {
+            return c == '<' || c == '>' || c == '^';
+        }
+
+        constexpr int ParseNumber(std::string_view format, size_t& pos) noexcept {
+            int number = 0;
+
+            while (pos < format.size() && IsDigit(format[pos])) {
+                number = number * 10 + (format[pos++] - '0');
+            }
+            return number;
+        }
+
+        //Parses the replacement field that starts after the '{' at pos and moves pos past its '}'.
+        //Auto and manual indexing cannot be mixed, nextIndex is -1 once a field had an index.
+        constexpr bool ParseField(std::string_view format, size_t& pos, int& nextIndex, FormatSpec& spec) noexcept {
+            if (pos < format.size() && IsDigit(format[pos])) {
+                if (nextIndex > 0) {
+                    return false;
+                }
+                spec.Index = static_cast<size_t>(ParseNumber(format, pos));
+                nextIndex  = -1;
+            }
+            else {
+                if (nextIndex < 0) {
+                    return false;
+                }
+                spec.Index = static_cast<size_t>(nextIndex++);
+            }
+
+            if (pos < format.size() && format[pos] == ':') {
+                pos++;
+
+                if (pos + 1 < format.size() && IsAlign(format[pos + 1]) && format[pos] != '{' && format[pos] != '}') {
+                    spec.Fill  = format[pos];
+                    spec.Align = format[pos + 1];
+                    pos += 2;
+                }
+                else if (pos < format.size() && IsAlign(format[pos])) {
+                    spec.Align = format[pos++];
+                }
+
+                if (pos < format.size() && format[pos] == '0') {
+                    spec.ZeroPad = true;
+                    pos++;
+                }
+
+                spec.Width = ParseNumber(format, pos);
+
+                if (pos < format.size() && format[pos] == '.') {
+                    pos++;
+                    if (pos == format.size() || !IsDigit(format[pos])) {
+                        return false;
+                    }
+                    spec.Precision = ParseNumber(format, pos);
+                }
+
+                if (pos < format.size() && std::string_view("bcdoxXeEfFgGsp").find(format[pos]) != std::string_view::npos) {
+                    spec.Type = format[pos++];
+                }
+            }
+
+            if (pos == format.size() || format[pos] != '}') {
+                return false;
+            }
+
+            pos++;
+            return true;
+        }
+
+        //Calls onText for the literal text and onField for every replacement field, false if format is malformed
+        template<class OnText, class OnField>
+        constexpr bool ParseFormat(std::string_view format, OnText&& onText, OnField&& onField) {
+            int nextIndex = 0;
+            size_t pos    = 0;
+
+            while (pos < format.size()) {
+                const auto brace = format.find_first_of("{}", pos);
+
+                if (brace == std::string_view::npos) {
+                    onText(format.substr(pos));
+                    break;
+                }
+
+                onText(format.substr(pos, brace - pos));
+                pos = brace + 1;
+
+                //Escaped braces
+                if (pos < format.size() && format[pos] == format[brace]) {
+                    onText(format.substr(brace, 1));
+                    pos++;
+                    continue;
+                }
+
+                FormatSpec spec;
+                if (format[brace] == '}' || !ParseField(format, pos, nextIndex, spec)) {
+                    return false;
+                }
+                if (!onField(spec)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template<class... Args>
+        constexpr bool IsValidFormat(std::string_view format) {
+            return ParseFormat(format, [](std::string_view) {}, [](const FormatSpec& spec) {
+                return spec.Index < sizeof...(Args);
+            });
+        }
+
+        //Inserts the padding for spec.Width, numbers are right aligned and zero padded after their sign and prefix
+        inline void Pad(std::string& out, size_t start, const FormatSpec& spec, bool isNumber, size_t prefixLength) {
+            const auto length = out.size() - start;
+
+            if (spec.Width <= 0 || length >= static_cast<size_t>(spec.Width)) {
+                return;
+            }
+
+            const auto padding = static_cast<size_t>(spec.Width) - length;
+
+            if (spec.ZeroPad && isNumber && !spec.Align) {
+                out.insert(start + prefixLength, padding, '0');
+                return;
+            }
+
+            const auto align = spec.Align ? spec.Align : (isNumber ? '>' : '<');
+            const auto left  = align == '>' ? padding : (align == '^' ? padding / 2 : 0);
+
+            out.insert(start, left, spec.Fill);
+            out.append(padding - left, spec.Fill);
+        }
+
+        template<class T>
+        void WriteValue(std::string& out, const FormatSpec& spec, const T& value) {
+            static_assert(!std::is_same_v<T, wchar_t> && !std::is_same_v<T, std::wstring_view>, "wide text cannot be formatted into a narrow format string");
+
+            const auto start    = out.size();
+            bool isNumber       = true;
+            size_t prefixLength = 0;
+
+            std::array<char, 400> buffer;
+            auto last = buffer.data();
+
+            const auto toChars = [&](auto&& ...args) {
+                const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), args...);
+                last = result.ec == std::errc() ? result.ptr : buffer.data();
+            };
+
+            if constexpr (std::is_same_v<T, bool>) {
+                if (spec.Type && spec.Type != 's') {
+                    toChars(static_cast<int>(value));
+                }
+                else {
+                    out += value ? "true" : "false";
+                    isNumber = false;
+                }
+            }
+            else if constexpr (std::is_same_v<T, char>) {
+                if (spec.Type && spec.Type != 'c') {
+                    toChars(static_cast<int>(value), spec.Type == 'x' || spec.Type == 'X' ? 16 : 10);
+                }
+                else {
+                    out += value;
+                    isNumber = false;
+                }
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                const auto base = spec.Type == 'x' || spec.Type == 'X' ? 16 : (spec.Type == 'o' ? 8 : (spec.Type == 'b' ? 2 : 10));
+                toChars(value, base);
+                prefixLength = value < 0 ? 1 : 0;
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+                const auto format = spec.Type == 'f' || spec.Type == 'F' ? std::chars_format::fixed :
+                                   (spec.Type == 'e' || spec.Type == 'E' ? std::chars_format::scientific : std::chars_format::general);
+
+                if (spec.Precision >= 0) {
+                    toChars(value, format, spec.Precision);
+                }
+                else if (spec.Type) {
+                    toChars(value, format, 6);
+                }
+                else {
+                    toChars(value);
+                }
+                prefixLength = value < 0 ? 1 : 0;
+            }
+            else if constexpr (std::is_pointer_v<T>) {
+                out += "0x";
+                toChars(reinterpret_cast<uintptr_t>(value), 16);
+                prefixLength = 2;
+            }
+            else {
+                auto text = std::string_view(value);
+                if (spec.Precision >= 0 && text.size() > static_cast<size_t>(spec.Precision)) {
+                    text = text.substr(0, static_cast<size_t>(spec.Precision));
+                }
+                out += text;
+                isNumber = false;
+            }
+
+            const auto numberStart = out.size();
+            out.append(buffer.data(), last);
+
+            if (spec.Type == 'X' || spec.Type == 'E' || spec.Type == 'F' || spec.Type == 'G') {
+                for (auto i = numberStart; i < out.size(); ++i) {
+                    if (out[i] >= 'a' && out[i] <= 'z') {
+                        out[i] = static_cast<char>(out[i] - 'a' + 'A');
+                    }
+                }
+            }
+
+            Pad(out, start, spec, isNumber, prefixLength);
+        }
+    }
+
+    //Checks the format string against the arguments when it is constructed at compile time
+    template<class... Args>
+    class BasicFormatString {
+    public:
+        template<class T> requires std::is_convertible_v<const T&, std::string_view>
+        consteval BasicFormatString(const T& format)
+            :
+            m_format(format)
+        {
+            if (!Detail::IsValidFormat<Args...>(m_format)) {
+                throw "the format string is malformed or refers to a missing argument";
+            }
+        }
+
+        [[nodiscard]] constexpr std::string_view get() const noexcept { return m_format; }
+    private:
+        std::string_view m_format;
+    };
+
+    template<class... Args>
+    using FormatString = BasicFormatString<std::type_identity_t<Args>...>;
+
+    template<class... Values>
+    void FormatTo(std::string& out, std::string_view format, const Values& ...values) {
+        Detail::ParseFormat(format, [&](std::string_view text) { out += text; }, [&](const Detail::FormatSpec& spec) {
+            size_t index = 0;
+            ((index++ == spec.Index ? (Detail::WriteValue(out, spec, values), true) : false) || ...);
+            return true;
+        });
+    }
+#endif
+}
@@ -1,11 +1,218 @@
 #include "Logger.h"
-#include "Time/Time.h"
+#include "MemoryTracker.h"
+#include <ctime>
+
+#ifdef _WIN32
+#include "Utils/ThreadUtils.h"
+#endif
+
+namespace {
+    struct ThreadLogState {
+        std::shared_ptr<Cyrex::LogRingBuffer> Buffer;
+        //Records that are written on the calling thread are encoded here
+        std::vector<std::byte> Scratch;
+        bool IsSynchronous{ false };
+    };
+
+    thread_local ThreadLogState t_logState;
+}
 
 Cyrex::Logger& Cyrex::Logger::Get() noexcept {
     static Logger instance;
     return instance;
 }
 
+Cyrex::Logger::Logger() {
+    m_thread = std::thread(&Logger::BackgroundLoop, this);
+
+#ifdef _WIN32
+    ThreadUtils::SetThreadName(m_thread, "Logger");
+#endif
+}
+
+Cyrex::Logger::~Logger() {
+    Shutdown();
+}
+
+void Cyrex::Logger::Flush() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    //Without the background thread every message has already been written
+    if (!m_running) {
+        return;
+    }
+
+    const auto ticket = ++m_flushRequested;
+    m_wakeUp.notify_one();
+    m_flushed.wait(lock, [&] { return m_flushCompleted >= ticket; });
+}
+
+void Cyrex::Logger::Shutdown() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+    }
+
+    m_isAsync.store(false, std::memory_order_release);
+    m_wakeUp.notify_one();
+    m_thread.join();
+
+    //Pick up messages from threads that were already past the check when logging went synchronous
+    Drain();
+}
+
+std::byte* Cyrex::Logger::BeginRecord(size_t size) noexcept {
+    auto& state = t_logState;
+
+    if (m_isAsync.load(std::memory_order_acquire)) [[likely]] {
+        if (!state.Buffer) [[unlikely]] {
+            CRX_MEMORY_TAG(Logging);
+            state.Buffer = std::make_shared<LogRingBuffer>(ms_threadBufferSize);
+
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            m_threadBuffers.push_back(state.Buffer);
+        }
+
+        if (size <= state.Buffer->MaxRecordSize()) [[likely]] {
+            while (m_isAsync.load(std::memory_order_acquire)) {
+                if (auto data = state.Buffer->TryReserve(size)) [[likely]] {
+                    state.IsSynchronous = false;
+                    return data;
+                }
+
+                if (GetOverflowPolicy() == OverflowPolicy::Drop) {
+                    m_numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                m_wakeUp.notify_one();
+                std::this_thread::yield();
+            }
+        }
+        else {
+            //Keep the order of this thread's messages before writing around the ring buffer
+            Flush();
+        }
+    }
+
+    state.Scratch.resize(size);
+    state.IsSynchronous = true;
+    return state.Scratch.data();
+}
+
+void Cyrex::Logger::EndRecord(Level lvl) noexcept {
+    auto& state = t_logState;
+
+    if (state.IsSynchronous) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        Write(state.Scratch.data(), state.Scratch.size());
+        SetTextColor(ConsoleColor::White);
+        FlushStreams();
+        return;
+    }
+
+    state.Buffer->Commit();
+
+    //Critical messages are often the last thing a process gets to log
+    if (lvl == Level::crx_critical || lvl == Level::crx_wcritical) {
+        Flush();
+    }
+    else if (state.Buffer->Size() > state.Buffer->Capacity() / 2) {
+        m_wakeUp.notify_one();
+    }
+}
+
+void Cyrex::Logger::BackgroundLoop() noexcept {
+    MemoryTracker::SetThreadTag(MemoryTag::Logging);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        if (m_running && m_flushRequested == m_flushCompleted) {
+            m_wakeUp.wait_for(lock, ms_flushInterval);
+        }
+
+        const auto flushTarget = m_flushRequested;
+        const bool running     = m_running;
+
+        lock.unlock();
+        Drain();
+        lock.lock();
+
+        m_flushCompleted = flushTarget;
+        m_flushed.notify_all();
+
+        if (!running) {
+            return;
+        }
+    }
+}
+
+void Cyrex::Logger::Drain() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+
+        //A ring that is only referenced from here belongs to a thread that has exited
+        std::erase_if(m_threadBuffers, [](const auto& buffer) {
+            return buffer.use_count() == 1 && buffer->Empty();
+        });
+
+        m_drainList.assign(m_threadBuffers.begin(), m_threadBuffers.end());
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+    size_t numWritten = 0;
+
+    for (const auto& buffer : m_drainList) {
+        numWritten += buffer->ConsumeAll([this](const std::byte* record, size_t size) {
+            Write(record, size);
+        });
+    }
+
+    m_drainList.clear();
+
+    if (const auto numDropped = GetNumDroppedMessages(); numDropped != m_numReportedDrops) {
+        SetLevel(Level::crx_warn, std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+
+        auto& ostream = dynamic_cast<std::ostream&>(*m_stream);
+        ostream << m_prefix << numDropped - m_numReportedDrops << " log messages were dropped" << NewLine();
+
+        m_numReportedDrops = numDropped;
+        numWritten++;
+    }
+
+    if (numWritten) {
+        SetTextColor(ConsoleColor::White);
+        FlushStreams();
+    }
+}
+
+void Cyrex::Logger::Write(const std::byte* record, size_t size) noexcept {
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+
+    SetLevel(header.Lvl, header.Time);
+
+    const auto args = record + sizeof(header);
+    const auto end  = record + size;
+
+    if (header.Lvl >= Level::crx_wdefault) {
+        auto& ostream = dynamic_cast<std::wostream&>(*m_stream);
+        ostream << m_wprefix;
+        LogRecord::Decode(ostream, args, end);
+    }
+    else {
+        auto& ostream = dynamic_cast<std::ostream&>(*m_stream);
+        ostream << m_prefix;
+        LogRecord::Decode(ostream, args, end);
+    }
+}
+
 void Cyrex::Logger::SetOutputStream(OutputStream ostream) noexcept {
     switch (ostream) {
     case OutputStream::crx_console_standard:
@@ -26,58 +233,88 @@ void Cyrex::Logger::SetOutputStream(OutputStream ostream) noexcept {
 }
 
 void Cyrex::Logger::Reset() noexcept {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
     m_prefix.clear();
     Console::SetTextColor(ConsoleColor::White);
+    m_textColor = ConsoleColor::White;
+}
+
+void Cyrex::Logger::SetTextColor(ConsoleColor clr) noexcept {
+    if (clr != m_textColor) {
+        Console::SetTextColor(clr);
+        m_textColor = clr;
+    }
+}
+
+void Cyrex::Logger::FlushStreams() noexcept {
+    Console::GetStandardStream()->flush();
+    Console::GetErrorStream()->flush();
+    Console::GetWideStandardStream()->flush();
+    Console::GetWideErrorStream()->flush();
+}
+
+void Cyrex::Logger::UpdateTimeString(std::time_t time) noexcept {
+    if (time == m_cachedTime) {
+        return;
+    }
+
+    m_cachedTime = time;
+
+    char buffer[32];
+    const auto length = std::strftime(buffer, sizeof(buffer), "%X", std::localtime(&time));
+
+    m_timeString.assign(buffer, length);
+    m_wideTimeString.assign(buffer, buffer + length);
 }
 
-void Cyrex::Logger::SetLevel(Level lvl) noexcept {
+void Cyrex::Logger::SetLevel(Level lvl, std::time_t time) noexcept {
     switch (lvl) {
     case Level::crx_default: {
-        SetLevel(OutputStream::crx_console_standard, ConsoleColor::White, "");
+        SetLevel(OutputStream::crx_console_standard, ConsoleColor::White, time, "");
         break;
     }
     case Level::crx_error: {
-        SetLevel(OutputStream::crx_console_err, ConsoleColor::Red, "<ERROR> ");
+        SetLevel(OutputStream::crx_console_err, ConsoleColor::Red, time, "<ERROR> ");
         break;
     }
     case Level::crx_warn: {
-        SetLevel(OutputStream::crx_console_standard, ConsoleColor::Yellow, "<WARNING> ");
+        SetLevel(OutputStream::crx_console_standard, ConsoleColor::Yellow, time, "<WARNING> ");
         break;
     } 
     case Level::crx_info: {
-        SetLevel(OutputStream::crx_console_standard, ConsoleColor::Yellow, "<INFO> ");
+        SetLevel(OutputStream::crx_console_standard, ConsoleColor::Yellow, time, "<INFO> ");
         break;
     }
     case Level::crx_critical: {
-        SetLevel(OutputStream::crx_console_err, ConsoleColor::Red, "<CRITICAL> ");
+        SetLevel(OutputStream::crx_console_err, ConsoleColor::Red, time, "<CRITICAL> ");
         break;
     }
     case Level::crx_debug: {
-        SetLevel(OutputStream::crx_console_standard, ConsoleColor::Green, "[DEBUG] ");
+        SetLevel(OutputStream::crx_console_standard, ConsoleColor::Green, time, "[DEBUG] ");
         break;
     }
     case Level::crx_wdefault: {
-        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::White, L"");
+        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::White, time, L"");
         break;
     }
     case Level::crx_werror: {
-        SetLevel(OutputStream::crx_console_werr, ConsoleColor::Red, L"<ERROR> ");
+        SetLevel(OutputStream::crx_console_werr, ConsoleColor::Red, time, L"<ERROR> ");
         break;
     }
     case Level::crx_wwarn: {
-        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::Yellow, L"<WARNING> ");
+        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::Yellow, time, L"<WARNING> ");
         break;
     }
     case Level::crx_winfo: {
-        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::Yellow, L"<INFO> ");
+        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::Yellow, time, L"<INFO> ");
         break;
     }
     case Level::crx_wcritical: {
-        SetLevel(OutputStream::crx_console_werr, ConsoleColor::Red, L"<CRITICAL> ");
+        SetLevel(OutputStream::crx_console_werr, ConsoleColor::Red, time, L"<CRITICAL> ");
         break;
     }
     case Level::crx_wdebug: {
-        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::Green, L"[DEBUG] ");
+        SetLevel(OutputStream::crx_console_wstandard, ConsoleColor::Green, time, L"[DEBUG] ");
         break;
     }
     default:
@@ -85,16 +322,18 @@ void Cyrex::Logger::SetLevel(Level lvl) noexcept {
     }
 }
 
-void Cyrex::Logger::SetLevel(OutputStream ostream, ConsoleColor clr, std::string_view attribute) noexcept {
+void Cyrex::Logger::SetLevel(OutputStream ostream, ConsoleColor clr, std::time_t time, std::string_view attribute) noexcept {
     SetOutputStream(ostream);
-    Console::SetTextColor(clr);
+    SetTextColor(clr);
+    UpdateTimeString(time);
     m_prefix.clear();
-    m_prefix.append("[").append(crxtime::GetCurrentTimeAsFormatedString()).append("] ").append(attribute);
+    m_prefix.append("[").append(m_timeString).append("] ").append(attribute);
 }
 
-void Cyrex::Logger::SetLevel(OutputStream ostream, ConsoleColor clr, std::wstring_view attribute) noexcept {
+void Cyrex::Logger::SetLevel(OutputStream ostream, ConsoleColor clr, std::time_t time, std::wstring_view attribute) noexcept {
     SetOutputStream(ostream);
-    Console::SetTextColor(clr);
+    SetTextColor(clr);
+    UpdateTimeString(time);
     m_wprefix.clear();
-    m_wprefix.append(L"[").append(crxtime::GetCurrentTimeAsWideFormatedString()).append(L"] ").append(attribute);
+    m_wprefix.append(L"[").append(m_wideTimeString).append(L"] ").append(attribute);
 }
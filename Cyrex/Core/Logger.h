@@ -1,12 +1,35 @@
 #pragma once
 #include <string_view>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
 #include <mutex>
-#include <regex>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 #include "Console.h"
+#include "LogBuffer.h"
+
+#ifdef _WIN32
 #include "assimp/DefaultLogger.hpp"
+#endif
+
+//Messages below this severity are compiled out:
+//0 debug, 1 default, 2 info, 3 warning, 4 error, 5 critical
+#ifndef CRX_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define CRX_LOG_MIN_LEVEL 0
+#else
+#define CRX_LOG_MIN_LEVEL 1
+#endif
+#endif
 
 namespace Cyrex {
+    //Log calls copy their arguments into a ring buffer owned by the calling thread,
+    //a background thread formats and writes them to the console.
     class Logger {
     public:
         enum class OutputStream { 
@@ -31,11 +54,30 @@ namespace Cyrex {
             crx_wdebug
         };
 
+        //What a log call does when its thread's ring buffer is full
+        enum class OverflowPolicy {
+            Drop,
+            Block
+        };
+
         static Logger& Get() noexcept;
+        ~Logger();
+
+        static constexpr int GetSeverity(Level lvl) noexcept;
+        static constexpr bool IsEnabled(Level lvl) noexcept { return GetSeverity(lvl) >= CRX_LOG_MIN_LEVEL; }
 
         void SetOutputStream(OutputStream ostream) noexcept;
         void Reset() noexcept;
 
+        void SetOverflowPolicy(OverflowPolicy policy) noexcept { m_overflowPolicy.store(policy, std::memory_order_relaxed); }
+        [[nodiscard]] OverflowPolicy GetOverflowPolicy() const noexcept { return m_overflowPolicy.load(std::memory_order_relaxed); }
+        [[nodiscard]] uint64_t GetNumDroppedMessages() const noexcept { return m_numDroppedMessages.load(std::memory_order_relaxed); }
+
+        //Blocks until every message logged before the call has been written
+        void Flush() noexcept;
+        //Writes what is still queued and stops the background thread, later messages are written on the calling thread
+        void Shutdown() noexcept;
+
         static constexpr auto NewLine()  noexcept { return std::endl<char, std::char_traits<char>>; }
         static constexpr auto WNewLine() noexcept { return std::endl<wchar_t, std::char_traits<wchar_t>>; }
 
@@ -47,97 +89,152 @@ namespace Cyrex {
         void DebugLog(Level lvl, Args&& ...args) noexcept;
         template<typename... Args>
         void WDebugLog(Level lvl, Args&& ...args) noexcept;
+
+        //format has to be checked against the arguments by the caller, see crxlog::fmt
+        void LogFormat(Level lvl, std::string_view format, const auto& ...args) noexcept;
     private:
-        Logger() = default;
+        using RecordHeader = LogRecord::Header<Level>;
 
-        void Log(auto&& ...args) const noexcept;
-        void WLog(auto&& ...args) const noexcept;
+        Logger();
 
-        void DebugLog(auto&& ...args) const noexcept;
-        void WDebugLog(auto&& ...args) const noexcept;
+        void Enqueue(Level lvl, const auto& ...args) noexcept;
+        [[nodiscard]] std::byte* BeginRecord(size_t size) noexcept;
+        void EndRecord(Level lvl) noexcept;
+
+        void BackgroundLoop() noexcept;
+        void Drain() noexcept;
+        void Write(const std::byte* record, size_t size) noexcept;
 
         void SetOutputStream(std::ios_base* stream) noexcept { m_stream = stream; }
-        void SetLevel(Level lvl) noexcept;
-        void SetLevel(OutputStream ostream, ConsoleColor clr, std::string_view attribute) noexcept;
-        void SetLevel(OutputStream ostream, ConsoleColor clr, std::wstring_view attribute) noexcept;
+        void SetTextColor(ConsoleColor clr) noexcept;
+        void FlushStreams() noexcept;
+        void UpdateTimeString(std::time_t time) noexcept;
+        void SetLevel(Level lvl, std::time_t time) noexcept;
+        void SetLevel(OutputStream ostream, ConsoleColor clr, std::time_t time, std::string_view attribute) noexcept;
+        void SetLevel(OutputStream ostream, ConsoleColor clr, std::time_t time, std::wstring_view attribute) noexcept;
+
+        static constexpr size_t ms_threadBufferSize = 64 * 1024;
+        static constexpr std::chrono::milliseconds ms_flushInterval{ 10 };
 
         std::ios_base* m_stream = Console::GetStandardStream();
         std::string m_prefix{};
         std::wstring m_wprefix{};
-
-        static inline std::mutex m_loggingMutex;
+        ConsoleColor m_textColor{ ConsoleColor::White };
+
+        //Lines are written in bursts, the time text is only rebuilt when the second changes
+        std::time_t m_cachedTime{ -1 };
+        std::string m_timeString{};
+        std::wstring m_wideTimeString{};
+
+        std::atomic<OverflowPolicy> m_overflowPolicy{ OverflowPolicy::Drop };
+        std::atomic_uint64_t m_numDroppedMessages{ 0 };
+        uint64_t m_numReportedDrops{ 0 };
+
+        //Rings of threads that have exited stay registered until they are drained
+        std::mutex m_registryMutex;
+        std::vector<std::shared_ptr<LogRingBuffer>> m_threadBuffers;
+        std::vector<std::shared_ptr<LogRingBuffer>> m_drainList;
+
+        //Serializes writes to the console
+        std::mutex m_writeMutex;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        std::condition_variable m_flushed;
+        uint64_t m_flushRequested{ 0 };
+        uint64_t m_flushCompleted{ 0 };
+        bool m_running{ true };
+        std::atomic_bool m_isAsync{ true };
+        std::thread m_thread;
     };
 
-    inline void Logger::Log(Level lvl, auto&& ...args) noexcept {
-        std::lock_guard<std::mutex> lock(Cyrex::Logger::m_loggingMutex);
-        SetLevel(lvl);
-        Log(args...);
-        SetLevel(Level::crx_default);
+    constexpr int Logger::GetSeverity(Level lvl) noexcept {
+        switch (lvl) {
+        case Level::crx_debug:
+        case Level::crx_wdebug:
+            return 0;
+        case Level::crx_info:
+        case Level::crx_winfo:
+            return 2;
+        case Level::crx_warn:
+        case Level::crx_wwarn:
+            return 3;
+        case Level::crx_error:
+        case Level::crx_werror:
+            return 4;
+        case Level::crx_critical:
+        case Level::crx_wcritical:
+            return 5;
+        default:
+            return 1;
+        }
     }
 
-    inline void Logger::Log(auto&& ...args) const noexcept {
-        auto& ostream = dynamic_cast<std::ostream&>(*m_stream);
-        ostream << m_prefix;
-        (ostream << ... << args);
+    inline void Logger::Log(Level lvl, auto&& ...args) noexcept {
+        Enqueue(lvl, args...);
     }
 
     inline void Logger::WLog(Level lvl, auto&& ...args) noexcept {
-        std::lock_guard<std::mutex> lock(Cyrex::Logger::m_loggingMutex);
-        SetLevel(lvl);
-        WLog(args...);
-        SetLevel(Level::crx_wdefault);
-    }
-
-    inline void Logger::WLog(auto&& ...args) const noexcept {
-        auto& ostream = dynamic_cast<std::wostream&>(*m_stream);
-        ostream << m_wprefix;
-        (ostream << ... << args);
+        Enqueue(lvl, args...);
     }
 
     inline void Logger::DebugLog(Level lvl, auto&& ...args) noexcept {
 #ifdef _DEBUG
-        std::lock_guard<std::mutex> lock(Cyrex::Logger::m_loggingMutex);
-        SetLevel(lvl);
-        DebugLog(args...);
-        SetLevel(Level::crx_default);
+        Enqueue(lvl, args...);
 #endif
     }
 
-    inline void Logger::DebugLog(auto&& ...args) const noexcept {
+    inline void Logger::WDebugLog(Level lvl, auto&& ...args) noexcept {
 #ifdef _DEBUG
-        auto& ostream = dynamic_cast<std::ostream&>(*m_stream);
-        ostream << m_prefix;
-        (ostream << ... << args);
+        Enqueue(lvl, args...);
 #endif
     }
 
-    inline void Logger::WDebugLog(Level lvl, auto&& ...args) noexcept {
-#ifdef _DEBUG
-        std::lock_guard<std::mutex> lock(Cyrex::Logger::m_loggingMutex);
-        SetLevel(lvl);
-        WDebugLog(args...);
-        SetLevel(Level::crx_wdefault);
-#endif
+    inline void Logger::LogFormat(Level lvl, std::string_view format, const auto& ...args) noexcept {
+        Enqueue(lvl, LogRecord::MakeFormatCall<decltype(LogRecord::ToArg(args))...>(format), args...);
     }
 
-    inline void Logger::WDebugLog(auto&& ...args) const noexcept {
-#ifdef _DEBUG
-        auto& ostream = dynamic_cast<std::wostream&>(*m_stream);
-        ostream << m_wprefix;
-        (ostream << ... << args);
-#endif
+    inline void Logger::Enqueue(Level lvl, const auto& ...args) noexcept {
+        if (!IsEnabled(lvl)) {
+            return;
+        }
+
+        const RecordHeader header{ lvl, std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) };
+
+        const bool isEncoded = LogRecord::EncodeRecord([this](size_t size) { return BeginRecord(size); }, header, args...);
+
+        if (isEncoded) [[likely]] {
+            EndRecord(lvl);
+        }
     }
 
+#ifdef _WIN32
     class AssimpLogger : public Assimp::LogStream {
     public:
+        //Assimp messages look like "Info,  T0: message\n", only the message itself is logged
         virtual void write(const char* message) noexcept override {
-            static const std::regex m_assimpLogRegex(R"((?:Debug|Info|Warn|Error),\s*(.*)\n)");
-            std::cmatch match;
-            std::regex_match(message, match, m_assimpLogRegex);
+            std::string_view text(message);
+
+            const auto severityEnd = text.find(',');
+
+            if (severityEnd == std::string_view::npos) {
+                return;
+            }
+
+            const auto severity = text.substr(0, severityEnd);
+
+            if (severity != "Debug" && severity != "Info" && severity != "Warn" && severity != "Error") {
+                return;
+            }
+
+            text.remove_prefix(severityEnd + 1);
+            text.remove_prefix(std::min(text.find_first_not_of(" \t"), text.size()));
 
-            if (match.size() > 1) {
-                Logger::Get().Log(m_level, match.str(1), Logger::NewLine());
+            if (!text.empty() && text.back() == '\n') {
+                text.remove_suffix(1);
             }
+
+            Logger::Get().Log(m_level, text, Logger::NewLine());
         }
         static void Attach() noexcept {
 #if defined( _DEBUG )
@@ -164,55 +261,126 @@ namespace Cyrex {
 
         Logger::Level m_level;
     };
+#endif
 }
 
 namespace Cyrex::crxlog {
     inline void info(auto&& ...args) noexcept {
-        Logger::Get().Log(Logger::Level::crx_info, args..., Logger::NewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_info)) {
+            Logger::Get().Log(Logger::Level::crx_info, args..., Logger::NewLine());
+        }
     }
 
     inline void err(auto&& ...args) noexcept {
-        Logger::Get().Log(Logger::Level::crx_error, args..., Logger::NewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_error)) {
+            Logger::Get().Log(Logger::Level::crx_error, args..., Logger::NewLine());
+        }
     }
 
     template<typename ...Args>
     inline void warn(auto&& ...args) noexcept {
-        Logger::Get().Log(Logger::Level::crx_warn, args..., Logger::NewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_warn)) {
+            Logger::Get().Log(Logger::Level::crx_warn, args..., Logger::NewLine());
+        }
     }
 
     inline void critical(auto&& ...args) noexcept {
-        Logger::Get().Log(Logger::Level::crx_critical, args..., Logger::NewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_critical)) {
+            Logger::Get().Log(Logger::Level::crx_critical, args..., Logger::NewLine());
+        }
     }
 
     inline void log(auto&& ...args) noexcept {
-        Logger::Get().Log(Logger::Level::crx_default, args..., Logger::NewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_default)) {
+            Logger::Get().Log(Logger::Level::crx_default, args..., Logger::NewLine());
+        }
     }
 
     inline void winfo(auto&& ...args) noexcept {
-        Logger::Get().WLog(Logger::Level::crx_winfo, args..., Logger::WNewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_winfo)) {
+            Logger::Get().WLog(Logger::Level::crx_winfo, args..., Logger::WNewLine());
+        }
     }
 
     inline void werr(auto&& ...args) noexcept {
-        Logger::Get().WLog(Logger::Level::crx_werror, args..., Logger::WNewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_werror)) {
+            Logger::Get().WLog(Logger::Level::crx_werror, args..., Logger::WNewLine());
+        }
     }
 
     inline void wwarn(auto&& ...args) noexcept {
-        Logger::Get().WLog(Logger::Level::crx_wwarn, args..., Logger::WNewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_wwarn)) {
+            Logger::Get().WLog(Logger::Level::crx_wwarn, args..., Logger::WNewLine());
+        }
     }
 
     inline void wcritical(auto&& ...args) noexcept {
-        Logger::Get().WLog(Logger::Level::crx_wcritical, args..., Logger::WNewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_wcritical)) {
+            Logger::Get().WLog(Logger::Level::crx_wcritical, args..., Logger::WNewLine());
+        }
     }
 
     inline void wlog(auto&& ...args) noexcept {
-        Logger::Get().WLog(Logger::Level::crx_wdefault, args..., Logger::WNewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_wdefault)) {
+            Logger::Get().WLog(Logger::Level::crx_wdefault, args..., Logger::WNewLine());
+        }
     }
 
     inline void debug(auto&& ...args) noexcept {
-        Logger::Get().DebugLog(Logger::Level::crx_debug, args..., Logger::NewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_debug)) {
+            Logger::Get().DebugLog(Logger::Level::crx_debug, args..., Logger::NewLine());
+        }
     }
 
     inline void wdebug(auto&& ...args) noexcept {
-        Logger::Get().WDebugLog(Logger::Level::crx_wdebug, args..., Logger::WNewLine());
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_wdebug)) {
+            Logger::Get().WDebugLog(Logger::Level::crx_wdebug, args..., Logger::WNewLine());
+        }
+    }
+}
+
+//Format string versions of the functions above, the format is checked at compile time
+//and the arguments are formatted on the logging thread. See LogFormat.h for the syntax.
+namespace Cyrex::crxlog::fmt {
+    template<typename ...Args>
+    inline void info(LogRecord::FormatString<Args...> format, Args&& ...args) noexcept {
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_info)) {
+            Logger::Get().LogFormat(Logger::Level::crx_info, format.get(), args...);
+        }
+    }
+
+    template<typename ...Args>
+    inline void err(LogRecord::FormatString<Args...> format, Args&& ...args) noexcept {
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_error)) {
+            Logger::Get().LogFormat(Logger::Level::crx_error, format.get(), args...);
+        }
+    }
+
+    template<typename ...Args>
+    inline void warn(LogRecord::FormatString<Args...> format, Args&& ...args) noexcept {
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_warn)) {
+            Logger::Get().LogFormat(Logger::Level::crx_warn, format.get(), args...);
+        }
+    }
+
+    template<typename ...Args>
+    inline void critical(LogRecord::FormatString<Args...> format, Args&& ...args) noexcept {
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_critical)) {
+            Logger::Get().LogFormat(Logger::Level::crx_critical, format.get(), args...);
+        }
+    }
+
+    template<typename ...Args>
+    inline void log(LogRecord::FormatString<Args...> format, Args&& ...args) noexcept {
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_default)) {
+            Logger::Get().LogFormat(Logger::Level::crx_default, format.get(), args...);
+        }
+    }
+
+    template<typename ...Args>
+    inline void debug(LogRecord::FormatString<Args...> format, Args&& ...args) noexcept {
+        if constexpr (Logger::IsEnabled(Logger::Level::crx_debug)) {
+            Logger::Get().LogFormat(Logger::Level::crx_debug, format.get(), args...);
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Vector3.h"
+#include <algorithm>
+
+namespace Cyrex::Math {
+    //Axis aligned box as a center and half extents, the layout of DirectX::BoundingBox and
+    //what Frustum::IntersectsBox takes
+    struct AABB {
+        Vector3 Center;
+        Vector3 Extents;
+
+        [[nodiscard]] static constexpr AABB FromMinMax(const Vector3& min, const Vector3& max) noexcept {
+            return { (min + max) * 0.5f, (max - min) * 0.5f };
+        }
+
+        //The smallest box containing both
+        [[nodiscard]] static constexpr AABB Merge(const AABB& a, const AABB& b) noexcept {
+            const auto aMin = a.GetMin();
+            const auto aMax = a.GetMax();
+            const auto bMin = b.GetMin();
+            const auto bMax = b.GetMax();
+
+            return FromMinMax(
+                { std::min(aMin.x, bMin.x), std::min(aMin.y, bMin.y), std::min(aMin.z, bMin.z) },
+                { std::max(aMax.x, bMax.x), std::max(aMax.y, bMax.y), std::max(aMax.z, bMax.z) });
+        }
+
+        [[nodiscard]] constexpr Vector3 GetMin() const noexcept { return Center - Extents; }
+        [[nodiscard]] constexpr Vector3 GetMax() const noexcept { return Center + Extents; }
+    };
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "MatrixKernels.h"
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+#include <type_traits>
+
+namespace Cyrex::Math {
+    //An affine transform in 48 bytes instead of Matrix's 64. The last column of an affine
+    //Matrix is always (0, 0, 0, 1), so only the first three columns are stored, each as a
+    //row of 4 floats:
+    //    | m00 m10 m20 m30 |
+    //    | m01 m11 m21 m31 |    (the mRC names of the Matrix it was made from)
+    //    | m02 m12 m22 m32 |
+    //This is HLSL's float3x4 and the layout of DXR instance transforms. Products compose in
+    //the same order as Matrix, lhs * rhs applies lhs first.
+    class alignas(16) Affine3x4 {
+    public:
+        constexpr Affine3x4() noexcept
+            :
+            m{ { 1.0f, 0.0f, 0.0f, 0.0f },
+               { 0.0f, 1.0f, 0.0f, 0.0f },
+               { 0.0f, 0.0f, 1.0f, 0.0f } }
+        {}
+
+        //Drops the last column, which has to be (0, 0, 0, 1)
+        constexpr explicit Affine3x4(const Matrix& matrix) noexcept
+            :
+            m{ { matrix.m00, matrix.m10, matrix.m20, matrix.m30 },
+               { matrix.m01, matrix.m11, matrix.m21, matrix.m31 },
+               { matrix.m02, matrix.m12, matrix.m22, matrix.m32 } }
+        {}
+
+        constexpr Affine3x4(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) noexcept
+            :
+            Affine3x4(Matrix(translation, rotation, scale))
+        {}
+
+        constexpr Affine3x4(const Affine3x4& rhs) noexcept = default;
+        constexpr Affine3x4& operator=(const Affine3x4& rhs) noexcept = default;
+
+        //For the GPU upload, everything else stays affine
+        [[nodiscard]] constexpr Matrix ToMatrix() const noexcept {
+            return Matrix(
+                m[0][0], m[1][0], m[2][0], 0.0f,
+                m[0][1], m[1][1], m[2][1], 0.0f,
+                m[0][2], m[1][2], m[2][2], 0.0f,
+                m[0][3], m[1][3], m[2][3], 1.0f
+            );
+        }
+
+        [[nodiscard]] constexpr Vector3 GetTranslation() const noexcept { return Vector3(m[0][3], m[1][3], m[2][3]); }
+
+        [[nodiscard]] constexpr Vector3 TransformCoord(const Vector3& vec3) const noexcept {
+            return Vector3(
+                m[0][0] * vec3.x + m[0][1] * vec3.y + m[0][2] * vec3.z + m[0][3],
+                m[1][0] * vec3.x + m[1][1] * vec3.y + m[1][2] * vec3.z + m[1][3],
+                m[2][0] * vec3.x + m[2][1] * vec3.y + m[2][2] * vec3.z + m[2][3]
+            );
+        }
+
+        [[nodiscard]] constexpr Vector3 TransformNormal(const Vector3& vec3) const noexcept {
+            return Vector3(
+                m[0][0] * vec3.x + m[0][1] * vec3.y + m[0][2] * vec3.z,
+                m[1][0] * vec3.x + m[1][1] * vec3.y + m[1][2] * vec3.z,
+                m[2][0] * vec3.x + m[2][1] * vec3.y + m[2][2] * vec3.z
+            );
+        }
+
+        //36 multiplies against the 64 of a Matrix product
+        [[nodiscard]] constexpr Affine3x4 operator*(const Affine3x4& rhs) const noexcept {
+            if (std::is_constant_evaluated()) {
+                return MultiplyScalar(*this, rhs);
+            }
+#if CRX_SIMD_X86
+            Affine3x4 result;
+            MatrixKernels::MultiplyAffine_SSE(Data(), rhs.Data(), result.Data());
+            return result;
+#else
+            return MultiplyScalar(*this, rhs);
+#endif
+        }
+
+        constexpr void operator*=(const Affine3x4& rhs) noexcept { (*this) = (*this) * rhs; }
+
+        [[nodiscard]] static constexpr Affine3x4 MultiplyScalar(const Affine3x4& lhs, const Affine3x4& rhs) noexcept {
+            Affine3x4 result;
+
+            for (int row = 0; row < 3; ++row) {
+                for (int column = 0; column < 4; ++column) {
+                    result.m[row][column] =
+                        rhs.m[row][0] * lhs.m[0][column] +
+                        rhs.m[row][1] * lhs.m[1][column] +
+                        rhs.m[row][2] * lhs.m[2][column] +
+                        (column == 3 ? rhs.m[row][3] : 0.0f);
+                }
+            }
+            return result;
+        }
+
+        //Inverts the 3x3 part through its cofactors and moves the translation back through it,
+        //no need for the general 4x4 inverse
+        [[nodiscard]] static constexpr Affine3x4 Inverse(const Affine3x4& affine) noexcept {
+            if (std::is_constant_evaluated()) {
+                return InverseScalar(affine);
+            }
+#if CRX_SIMD_X86
+            Affine3x4 result;
+            MatrixKernels::InverseAffine_SSE(affine.Data(), result.Data());
+            return result;
+#else
+            return InverseScalar(affine);
+#endif
+        }
+
+        [[nodiscard]] static constexpr Affine3x4 InverseScalar(const Affine3x4& affine) noexcept {
+            const Vector3 row0(affine.m[0][0], affine.m[0][1], affine.m[0][2]);
+            const Vector3 row1(affine.m[1][0], affine.m[1][1], affine.m[1][2]);
+            const Vector3 row2(affine.m[2][0], affine.m[2][1], affine.m[2][2]);
+
+            //The columns of the adjugate
+            const Vector3 cross12 = Vector3::Cross(row1, row2);
+            const Vector3 cross20 = Vector3::Cross(row2, row0);
+            const Vector3 cross01 = Vector3::Cross(row0, row1);
+
+            const float invDet = 1.0f / Vector3::Dot(row0, cross12);
+
+            const Vector3 inv0 = Vector3(cross12.x, cross20.x, cross01.x) * invDet;
+            const Vector3 inv1 = Vector3(cross12.y, cross20.y, cross01.y) * invDet;
+            const Vector3 inv2 = Vector3(cross12.z, cross20.z, cross01.z) * invDet;
+
+            const Vector3 translation = affine.GetTranslation();
+
+            Affine3x4 result;
+            result.SetRow(0, inv0, -Vector3::Dot(inv0, translation));
+            result.SetRow(1, inv1, -Vector3::Dot(inv1, translation));
+            result.SetRow(2, inv2, -Vector3::Dot(inv2, translation));
+            return result;
+        }
+
+        [[nodiscard]] constexpr Affine3x4 Inversed() const noexcept { return Inverse(*this); }
+
+        [[nodiscard]] constexpr bool operator==(const Affine3x4& rhs) const noexcept {
+            for (int row = 0; row < 3; ++row) {
+                for (int column = 0; column < 4; ++column) {
+                    if (m[row][column] != rhs.m[row][column]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        [[nodiscard]] constexpr bool operator!=(const Affine3x4& rhs) const noexcept { return !(*this == rhs); }
+
+        [[nodiscard]] const float* Data() const noexcept { return &m[0][0]; }
+        [[nodiscard]] float* Data() noexcept { return &m[0][0]; }
+
+        float m[3][4];
+
+        static const Affine3x4 Identity;
+    private:
+        constexpr void SetRow(int row, const Vector3& linear, float translation) noexcept {
+            m[row][0] = linear.x;
+            m[row][1] = linear.y;
+            m[row][2] = linear.z;
+            m[row][3] = translation;
+        }
+    };
+
+    static_assert(sizeof(Affine3x4) == 48);
+
+    inline constexpr Affine3x4 Affine3x4::Identity{};
+}
@@ -0,0 +1,303 @@
+#include "CullingKernels.h"
+#include "Frustum.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Cyrex::Math::CullingKernels {
+    namespace {
+        //Fills visible one word at a time. testVector returns the visibility bits of Width volumes
+        //from index i, testOne the visibility of one volume for the tail.
+        template<size_t Width, typename TestVector, typename TestOne>
+        inline void Cull(size_t count, uint64_t* visible, TestVector testVector, TestOne testOne) noexcept {
+            for (size_t word = 0; word < VisibilityWords(count); ++word) {
+                const size_t begin = word * 64;
+                const size_t end   = std::min(begin + 64, count);
+
+                uint64_t bits = 0;
+                size_t i = begin;
+
+                for (; i + Width <= end; i += Width) {
+                    bits |= static_cast<uint64_t>(testVector(i)) << (i - begin);
+                }
+                for (; i < end; ++i) {
+                    bits |= static_cast<uint64_t>(testOne(i)) << (i - begin);
+                }
+
+                visible[word] = bits;
+            }
+        }
+    }
+
+    void CullBoxes_Scalar(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept {
+        Cull<1>(centers.Count, visible,
+            [&](size_t i) { return frustum.IntersectsBox(centers.Get(i), extents.Get(i)); },
+            [&](size_t i) { return frustum.IntersectsBox(centers.Get(i), extents.Get(i)); });
+    }
+
+    void CullSpheres_Scalar(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept {
+        Cull<1>(centers.Count, visible,
+            [&](size_t i) { return frustum.IntersectsSphere(centers.Get(i), radii[i]); },
+            [&](size_t i) { return frustum.IntersectsSphere(centers.Get(i), radii[i]); });
+    }
+
+#if CRX_SIMD_X86
+    namespace {
+        //The planes as arrays of components, and the absolute normals the boxes need. Each ISA
+        //broadcasts the components as it uses them.
+        struct Planes {
+            explicit Planes(const Frustum& frustum) noexcept {
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    const auto& plane = frustum.GetPlane(p);
+
+                    X[p]    = plane.x;
+                    Y[p]    = plane.y;
+                    Z[p]    = plane.z;
+                    W[p]    = plane.w;
+                    AbsX[p] = std::abs(plane.x);
+                    AbsY[p] = std::abs(plane.y);
+                    AbsZ[p] = std::abs(plane.z);
+                }
+            }
+
+            float X[Frustum::PlaneCount];
+            float Y[Frustum::PlaneCount];
+            float Z[Frustum::PlaneCount];
+            float W[Frustum::PlaneCount];
+            float AbsX[Frustum::PlaneCount];
+            float AbsY[Frustum::PlaneCount];
+            float AbsZ[Frustum::PlaneCount];
+        };
+
+        //Same operation order as the Frustum tests
+        inline __m128 Distance_SSE(const Planes& planes, size_t p, __m128 x, __m128 y, __m128 z) noexcept {
+            const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.X[p]), x), _mm_mul_ps(_mm_set1_ps(planes.Y[p]), y));
+            return _mm_add_ps(_mm_add_ps(xy, _mm_mul_ps(_mm_set1_ps(planes.Z[p]), z)), _mm_set1_ps(planes.W[p]));
+        }
+    }
+
+    void CullBoxes_SSE(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept {
+        const Planes planes(frustum);
+
+        Cull<4>(centers.Count, visible,
+            [&](size_t i) {
+                const __m128 cx = _mm_loadu_ps(centers.X + i);
+                const __m128 cy = _mm_loadu_ps(centers.Y + i);
+                const __m128 cz = _mm_loadu_ps(centers.Z + i);
+                const __m128 ex = _mm_loadu_ps(extents.X + i);
+                const __m128 ey = _mm_loadu_ps(extents.Y + i);
+                const __m128 ez = _mm_loadu_ps(extents.Z + i);
+
+                __m128 outside = _mm_setzero_ps();
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    const __m128 distance = Distance_SSE(planes, p, cx, cy, cz);
+                    const __m128 radius   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.AbsX[p]), ex), _mm_mul_ps(_mm_set1_ps(planes.AbsY[p]), ey)), _mm_mul_ps(_mm_set1_ps(planes.AbsZ[p]), ez));
+
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+                }
+                return ~_mm_movemask_ps(outside) & 0xF;
+            },
+            [&](size_t i) { return frustum.IntersectsBox(centers.Get(i), extents.Get(i)); });
+    }
+
+    void CullSpheres_SSE(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept {
+        const Planes planes(frustum);
+
+        Cull<4>(centers.Count, visible,
+            [&](size_t i) {
+                const __m128 cx     = _mm_loadu_ps(centers.X + i);
+                const __m128 cy     = _mm_loadu_ps(centers.Y + i);
+                const __m128 cz     = _mm_loadu_ps(centers.Z + i);
+                const __m128 radius = _mm_loadu_ps(radii + i);
+
+                __m128 outside = _mm_setzero_ps();
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    const __m128 distance = Distance_SSE(planes, p, cx, cy, cz);
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+                }
+                return ~_mm_movemask_ps(outside) & 0xF;
+            },
+            [&](size_t i) { return frustum.IntersectsSphere(centers.Get(i), radii[i]); });
+    }
+
+    namespace {
+        CRX_TARGET_AVX2 inline __m256 Distance_AVX2(const Planes& planes, size_t p, __m256 x, __m256 y, __m256 z) noexcept {
+            const __m256 zw = _mm256_fmadd_ps(_mm256_set1_ps(planes.Z[p]), z, _mm256_set1_ps(planes.W[p]));
+            return _mm256_fmadd_ps(_mm256_set1_ps(planes.X[p]), x, _mm256_fmadd_ps(_mm256_set1_ps(planes.Y[p]), y, zw));
+        }
+    }
+
+    CRX_TARGET_AVX2 void CullBoxes_AVX2(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept {
+        const Planes planes(frustum);
+
+        Cull<8>(centers.Count, visible,
+            [&](size_t i) CRX_TARGET_AVX2 {
+                const __m256 cx = _mm256_loadu_ps(centers.X + i);
+                const __m256 cy = _mm256_loadu_ps(centers.Y + i);
+                const __m256 cz = _mm256_loadu_ps(centers.Z + i);
+                const __m256 ex = _mm256_loadu_ps(extents.X + i);
+                const __m256 ey = _mm256_loadu_ps(extents.Y + i);
+                const __m256 ez = _mm256_loadu_ps(extents.Z + i);
+
+                __m256 outside = _mm256_setzero_ps();
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    const __m256 distance = Distance_AVX2(planes, p, cx, cy, cz);
+                    const __m256 radius   = _mm256_fmadd_ps(_mm256_set1_ps(planes.AbsX[p]), ex, _mm256_fmadd_ps(_mm256_set1_ps(planes.AbsY[p]), ey, _mm256_mul_ps(_mm256_set1_ps(planes.AbsZ[p]), ez)));
+
+                    outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+                }
+                return ~_mm256_movemask_ps(outside) & 0xFF;
+            },
+            [&](size_t i) { return frustum.IntersectsBox(centers.Get(i), extents.Get(i)); });
+    }
+
+    CRX_TARGET_AVX2 void CullSpheres_AVX2(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept {
+        const Planes planes(frustum);
+
+        Cull<8>(centers.Count, visible,
+            [&](size_t i) CRX_TARGET_AVX2 {
+                const __m256 cx     = _mm256_loadu_ps(centers.X + i);
+                const __m256 cy     = _mm256_loadu_ps(centers.Y + i);
+                const __m256 cz     = _mm256_loadu_ps(centers.Z + i);
+                const __m256 radius = _mm256_loadu_ps(radii + i);
+
+                __m256 outside = _mm256_setzero_ps();
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    const __m256 distance = Distance_AVX2(planes, p, cx, cy, cz);
+                    outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+                }
+                return ~_mm256_movemask_ps(outside) & 0xFF;
+            },
+            [&](size_t i) { return frustum.IntersectsSphere(centers.Get(i), radii[i]); });
+    }
+
+    namespace {
+        CRX_TARGET_AVX512 inline __m512 Distance_AVX512(const Planes& planes, size_t p, __m512 x, __m512 y, __m512 z) noexcept {
+            const __m512 zw = _mm512_fmadd_ps(_mm512_set1_ps(planes.Z[p]), z, _mm512_set1_ps(planes.W[p]));
+            return _mm512_fmadd_ps(_mm512_set1_ps(planes.X[p]), x, _mm512_fmadd_ps(_mm512_set1_ps(planes.Y[p]), y, zw));
+        }
+
+        //Masked loads cover the tail, so there is no scalar loop
+        CRX_TARGET_AVX512 inline __mmask16 TailMask(size_t i, size_t count) noexcept {
+            const auto remaining = count - i;
+            return remaining >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << remaining) - 1);
+        }
+    }
+
+    CRX_TARGET_AVX512 void CullBoxes_AVX512(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept {
+        const Planes planes(frustum);
+
+        for (size_t word = 0; word < VisibilityWords(centers.Count); ++word) {
+            const size_t begin = word * 64;
+            const size_t end   = std::min(begin + 64, centers.Count);
+
+            uint64_t bits = 0;
+
+            for (size_t i = begin; i < end; i += 16) {
+                const __mmask16 mask = TailMask(i, centers.Count);
+
+                const __m512 cx = _mm512_maskz_loadu_ps(mask, centers.X + i);
+                const __m512 cy = _mm512_maskz_loadu_ps(mask, centers.Y + i);
+                const __m512 cz = _mm512_maskz_loadu_ps(mask, centers.Z + i);
+                const __m512 ex = _mm512_maskz_loadu_ps(mask, extents.X + i);
+                const __m512 ey = _mm512_maskz_loadu_ps(mask, extents.Y + i);
+                const __m512 ez = _mm512_maskz_loadu_ps(mask, extents.Z + i);
+
+                __mmask16 inside = mask;
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    const __m512 distance = Distance_AVX512(planes, p, cx, cy, cz);
+                    const __m512 radius   = _mm512_fmadd_ps(_mm512_set1_ps(planes.AbsX[p]), ex, _mm512_fmadd_ps(_mm512_set1_ps(planes.AbsY[p]), ey, _mm512_mul_ps(_mm512_set1_ps(planes.AbsZ[p]), ez)));
+
+                    inside = _mm512_mask_cmp_ps_mask(inside, _mm512_add_ps(distance, radius), _mm512_setzero_ps(), _CMP_GE_OQ);
+                }
+                bits |= static_cast<uint64_t>(inside) << (i - begin);
+            }
+
+            visible[word] = bits;
+        }
+    }
+
+    CRX_TARGET_AVX512 void CullSpheres_AVX512(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept {
+        const Planes planes(frustum);
+
+        for (size_t word = 0; word < VisibilityWords(centers.Count); ++word) {
+            const size_t begin = word * 64;
+            const size_t end   = std::min(begin + 64, centers.Count);
+
+            uint64_t bits = 0;
+
+            for (size_t i = begin; i < end; i += 16) {
+                const __mmask16 mask = TailMask(i, centers.Count);
+
+                const __m512 cx     = _mm512_maskz_loadu_ps(mask, centers.X + i);
+                const __m512 cy     = _mm512_maskz_loadu_ps(mask, centers.Y + i);
+                const __m512 cz     = _mm512_maskz_loadu_ps(mask, centers.Z + i);
+                const __m512 radius = _mm512_maskz_loadu_ps(mask, radii + i);
+
+                __mmask16 inside = mask;
+
+                for (size_t p = 0; p < Frustum::PlaneCount; ++p) {
+                    const __m512 distance = Distance_AVX512(planes, p, cx, cy, cz);
+                    inside = _mm512_mask_cmp_ps_mask(inside, _mm512_add_ps(distance, radius), _mm512_setzero_ps(), _CMP_GE_OQ);
+                }
+                bits |= static_cast<uint64_t>(inside) << (i - begin);
+            }
+
+            visible[word] = bits;
+        }
+    }
+#endif
+}
+
+namespace {
+    using namespace Cyrex;
+    using namespace Cyrex::Math;
+
+    using BoxKernel    = void(*)(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept;
+    using SphereKernel = void(*)(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept;
+
+    BoxKernel    g_cullBoxes   = CullingKernels::CullBoxes_Scalar;
+    SphereKernel g_cullSpheres = CullingKernels::CullSpheres_Scalar;
+
+    void Rebind(IsaLevel level) noexcept {
+        using namespace CullingKernels;
+
+        switch (level) {
+#if CRX_SIMD_X86
+        case IsaLevel::AVX512:
+            g_cullBoxes   = CullBoxes_AVX512;
+            g_cullSpheres = CullSpheres_AVX512;
+            break;
+        case IsaLevel::AVX2:
+            g_cullBoxes   = CullBoxes_AVX2;
+            g_cullSpheres = CullSpheres_AVX2;
+            break;
+        case IsaLevel::SSE:
+            g_cullBoxes   = CullBoxes_SSE;
+            g_cullSpheres = CullSpheres_SSE;
+            break;
+#endif
+        default:
+            g_cullBoxes   = CullBoxes_Scalar;
+            g_cullSpheres = CullSpheres_Scalar;
+            break;
+        }
+    }
+
+    const bool g_registered = (CpuDispatch::Register(Rebind), true);
+}
+
+namespace Cyrex::Math {
+    void CullBoxes(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept {
+        g_cullBoxes(frustum, centers, extents, visible);
+    }
+
+    void CullSpheres(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept {
+        g_cullSpheres(frustum, centers, radii, visible);
+    }
+}
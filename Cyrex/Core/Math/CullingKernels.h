@@ -0,0 +1,38 @@
+#pragma once
+#include "SIMD.h"
+#include "SoA.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Cyrex::Math {
+    class Frustum;
+
+    //Batch versions of Frustum::IntersectsBox and Frustum::IntersectsSphere over structure of
+    //arrays bounds, 4, 8 or 16 volumes per instruction. Bit i % 64 of visible[i / 64] is set
+    //when volume i may be visible, the bits past the count are cleared. Every variant gives
+    //the same bits as the Frustum tests, except for volumes touching a plane, where the fused
+    //multiply adds of the AVX variants may round the other way.
+    namespace CullingKernels {
+        [[nodiscard]] constexpr size_t VisibilityWords(size_t count) noexcept { return (count + 63) / 64; }
+
+        void CullBoxes_Scalar(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept;
+        void CullSpheres_Scalar(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept;
+
+#if CRX_SIMD_X86
+        void CullBoxes_SSE(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept;
+        void CullSpheres_SSE(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept;
+
+        //Need AVX2 and FMA
+        void CullBoxes_AVX2(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept;
+        void CullSpheres_AVX2(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept;
+
+        //Need AVX-512F
+        void CullBoxes_AVX512(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept;
+        void CullSpheres_AVX512(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept;
+#endif
+    }
+
+    //Run the variant CpuDispatch picked for this CPU
+    void CullBoxes(const Frustum& frustum, ConstVector3Span centers, ConstVector3Span extents, uint64_t* visible) noexcept;
+    void CullSpheres(const Frustum& frustum, ConstVector3Span centers, const float* radii, uint64_t* visible) noexcept;
+}
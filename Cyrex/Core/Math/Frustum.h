@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cmath>
+#include <cstddef>
+
+namespace Cyrex::Math {
+    //The six planes of a view projection, with normals pointing inwards. A point p is inside a
+    //plane (a, b, c, d) when a * p.x + b * p.y + c * p.z + d >= 0. Made from the world space view
+    //projection the planes are in world space, from a projection alone they are in view space.
+    //
+    //The tests are conservative, a volume is only culled when it is fully outside one plane, so
+    //some volumes near the frustum's corners pass even though they are outside.
+    class Frustum {
+    public:
+        enum Plane : size_t {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            PlaneCount
+        };
+
+        //Contains everything
+        constexpr Frustum() noexcept = default;
+
+        //Gribb and Hartmann's extraction, clip space is v * viewProjection with D3D's 0 <= z <= w
+        explicit Frustum(const Matrix& viewProjection) noexcept {
+            const auto& m = viewProjection;
+
+            //The columns of the matrix
+            const float x[4] = { m.m00, m.m10, m.m20, m.m30 };
+            const float y[4] = { m.m01, m.m11, m.m21, m.m31 };
+            const float z[4] = { m.m02, m.m12, m.m22, m.m32 };
+            const float w[4] = { m.m03, m.m13, m.m23, m.m33 };
+
+            m_planes[Left]   = Normalize(w[0] + x[0], w[1] + x[1], w[2] + x[2], w[3] + x[3]);
+            m_planes[Right]  = Normalize(w[0] - x[0], w[1] - x[1], w[2] - x[2], w[3] - x[3]);
+            m_planes[Bottom] = Normalize(w[0] + y[0], w[1] + y[1], w[2] + y[2], w[3] + y[3]);
+            m_planes[Top]    = Normalize(w[0] - y[0], w[1] - y[1], w[2] - y[2], w[3] - y[3]);
+            m_planes[Near]   = Normalize(z[0], z[1], z[2], z[3]);
+            m_planes[Far]    = Normalize(w[0] - z[0], w[1] - z[1], w[2] - z[2], w[3] - z[3]);
+        }
+
+        [[nodiscard]] constexpr const Vector4& GetPlane(size_t plane) const noexcept { return m_planes[plane]; }
+
+        [[nodiscard]] bool IntersectsBox(const Vector3& center, const Vector3& extents) const noexcept {
+            for (const auto& plane : m_planes) {
+                //The distance of the corner farthest along the normal
+                const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                const float radius   = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+
+                if (distance + radius < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool IntersectsSphere(const Vector3& center, float radius) const noexcept {
+            for (const auto& plane : m_planes) {
+                const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+
+                if (distance + radius < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    private:
+        [[nodiscard]] static Vector4 Normalize(float a, float b, float c, float d) noexcept {
+            const float length = std::sqrt(a * a + b * b + c * c);
+            return Vector4(a / length, b / length, c / length, d / length);
+        }
+
+        Vector4 m_planes[PlaneCount]{};
+    };
+}
@@ -1,9 +1,15 @@
 #pragma once
+#include <algorithm>
 #include <numbers>
-#include <DirectXMath.h>
+#include <cmath>
 #include <concepts>
 #include <limits>
 #include <bit>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <DirectXMath.h>
+#endif
 
 namespace Cyrex::Math {
     template<typename T>
@@ -22,10 +28,13 @@ namespace Cyrex::Math {
     concept Arithmethic = Divisble<T> || Subtractable<T> || Divisble<T> || Multipliable<T>;
 
     template<typename T>
-    concept Number = (std::signed_integral<T> || std::floating_point<T>) && Arithmethic<T> && std::_Boolean_testable<T>;
+    concept BooleanTestable = std::convertible_to<T, bool> && requires (T&& x) { { !static_cast<T&&>(x) } -> std::convertible_to<bool>; };
+
+    template<typename T>
+    concept Number = (std::signed_integral<T> || std::floating_point<T>) && Arithmethic<T> && BooleanTestable<T>;
 
     template<typename T>
-    concept Unsigned_Number = std::unsigned_integral<T> && Arithmethic<T> && std::_Boolean_testable<T>;
+    concept Unsigned_Number = std::unsigned_integral<T> && Arithmethic<T> && BooleanTestable<T>;
 
 
     struct MathConstants {
@@ -47,6 +56,22 @@ namespace Cyrex::Math {
         return lhs + error >= rhs && lhs - error <= rhs;
     }
 
+    //Number of representable floats between lhs and rhs, 0 when they compare equal
+    [[nodiscard]] inline constexpr uint32_t UlpDistance(float lhs, float rhs) noexcept {
+        if (lhs == rhs) {
+            return 0;
+        }
+
+        //Maps the sign magnitude bit patterns onto one ordered integer line
+        const auto toOrdered = [](float value) {
+            const auto bits = std::bit_cast<int32_t>(value);
+            return static_cast<int64_t>(bits < 0 ? std::numeric_limits<int32_t>::min() - bits : bits);
+        };
+
+        const auto distance = toOrdered(lhs) - toOrdered(rhs);
+        return static_cast<uint32_t>(std::min<int64_t>(distance < 0 ? -distance : distance, std::numeric_limits<uint32_t>::max()));
+    }
+
     template<typename T>
     [[nodiscard]] inline T AlignUpWithMask(T value, size_t mask) noexcept {
         return static_cast<T>((static_cast<size_t>(value + mask) & ~mask));
@@ -73,6 +98,7 @@ namespace Cyrex::Math {
         return (value + alignment - 1) / alignment;
     }
 
+#ifdef _WIN32
     [[nodiscard]] inline DirectX::XMVECTOR GetCircleTangent(size_t i, size_t tesselation) noexcept {
         float angle = (static_cast<float>(i) * MathConstants::PI_MUL2 / static_cast<float>(tesselation)) + MathConstants::PI_DIV2;
         float dx;
@@ -95,6 +121,7 @@ namespace Cyrex::Math {
 
         return vec;
     }
+#endif
 
     [[nodiscard]] inline constexpr Number auto ToDegrees(const Number auto rads) noexcept {
         return rads * MathConstants::TO_DEGREES;
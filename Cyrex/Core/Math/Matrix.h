@@ -1,28 +1,28 @@
 #pragma once
 
+#include "MatrixKernels.h"
 #include "Quaternion.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include <array>
+#include <bit>
+#include <type_traits>
 
 namespace Cyrex::Math {
     class Matrix {
     public:
-        Matrix() noexcept {
-            SetIdentity();
-        }
-        Matrix(const Matrix& rhs) noexcept 
+        constexpr Matrix() noexcept
             :
-            m00(rhs.m00), m01(rhs.m01), m02(rhs.m02), m03(rhs.m03),
-            m10(rhs.m10), m11(rhs.m11), m12(rhs.m12), m13(rhs.m13),
-            m20(rhs.m20), m21(rhs.m21), m22(rhs.m22), m23(rhs.m23),
-            m30(rhs.m30), m31(rhs.m31), m32(rhs.m32), m33(rhs.m33)
+            m00(1.0f), m11(1.0f), m22(1.0f), m33(1.0f)
         {}
+        constexpr Matrix(const Matrix& rhs) noexcept = default;
+        constexpr Matrix& operator=(const Matrix& rhs) noexcept = default;
 
-        Matrix(
+        constexpr Matrix(
             float m00, float m01, float m02, float m03,
             float m10, float m11, float m12, float m13,
             float m20, float m21, float m22, float m23,
-            float m30, float m31, float m32, float m33)
+            float m30, float m31, float m32, float m33) noexcept
             :
             m00(m00), m01(m01), m02(m02), m03(m03),
             m10(m10), m11(m11), m12(m12) ,m13(m13),
@@ -30,7 +30,7 @@ namespace Cyrex::Math {
             m30(m30), m31(m31), m32(m32), m33(m33)
         {}
 
-        Matrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) noexcept {
+        constexpr Matrix(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) noexcept {
             const Matrix mRotation = CreateRotation(rotation);
 
             m00 = scale.x * mRotation.m00;  m01 = scale.x * mRotation.m01;  m02 = scale.x * mRotation.m02;  m03 = 0.0f;
@@ -41,7 +41,7 @@ namespace Cyrex::Math {
 
         ~Matrix() = default;
 
-        [[nodiscard]] static inline Matrix CreateTranslation(const Vector3& translation) noexcept {
+        [[nodiscard]] static constexpr Matrix CreateTranslation(const Vector3& translation) noexcept {
             return Matrix(
                 1, 0, 0, 0,
                 0, 1, 0, 0,
@@ -50,7 +50,7 @@ namespace Cyrex::Math {
             );
         }
 
-        [[nodiscard]] static inline Matrix CreateRotation(const Quaternion& rotation) noexcept {
+        [[nodiscard]] static constexpr Matrix CreateRotation(const Quaternion& rotation) noexcept {
             const float num9 = rotation.x * rotation.x;
             const float num8 = rotation.y * rotation.y;
             const float num7 = rotation.z * rotation.z;
@@ -117,7 +117,7 @@ namespace Cyrex::Math {
             );
         }
 
-        [[nodiscard]] Vector3 GetTranslation() const noexcept { return Vector3(m30, m31, m32); }
+        [[nodiscard]] constexpr Vector3 GetTranslation() const noexcept { return Vector3(m30, m31, m32); }
 
         [[nodiscard]] Quaternion GetRotation() const noexcept {
             const Vector3 scale = GetScale();
@@ -200,9 +200,9 @@ namespace Cyrex::Math {
             );
         }
 
-        [[nodiscard]] static inline Matrix CreateScale(float scale) noexcept { return CreateScale(scale, scale, scale); }
-        [[nodiscard]] static inline Matrix CreateScale(const Vector3& scale) noexcept { return CreateScale(scale.x, scale.y, scale.z); }
-        [[nodiscard]] static inline Matrix CreateScale(float scaleX, float scaleY, float ScaleZ) noexcept {
+        [[nodiscard]] static constexpr Matrix CreateScale(float scale) noexcept { return CreateScale(scale, scale, scale); }
+        [[nodiscard]] static constexpr Matrix CreateScale(const Vector3& scale) noexcept { return CreateScale(scale.x, scale.y, scale.z); }
+        [[nodiscard]] static constexpr Matrix CreateScale(float scaleX, float scaleY, float ScaleZ) noexcept {
             return Matrix(
                 scaleX, 0,      0,      0,
                 0,      scaleY, 0,      0,
@@ -248,10 +248,24 @@ namespace Cyrex::Math {
             );
         }
 
-        [[nodiscard]] Matrix Transposed() const noexcept { return Transpose(*this); }
-        void Transpose() { *this = Transpose(*this); }
+        [[nodiscard]] constexpr Matrix Transposed() const noexcept { return Transpose(*this); }
+        constexpr void Transpose() noexcept { *this = Transpose(*this); }
+
+        //The SIMD kernels work on Data(), which constant evaluation doesn't allow
+        [[nodiscard]] static constexpr Matrix Transpose(const Matrix& matrix) noexcept {
+            if (std::is_constant_evaluated()) {
+                return TransposeScalar(matrix);
+            }
+#if CRX_SIMD_X86
+            Matrix result;
+            MatrixKernels::Transpose_SSE(matrix.Data(), result.Data());
+            return result;
+#else
+            return TransposeScalar(matrix);
+#endif
+        }
 
-        [[nodiscard]] static inline Matrix Transpose(const Matrix& matrix) noexcept {
+        [[nodiscard]] static constexpr Matrix TransposeScalar(const Matrix& matrix) noexcept {
             return Matrix(
                 matrix.m00, matrix.m10, matrix.m20, matrix.m30,
                 matrix.m01, matrix.m11, matrix.m21, matrix.m31,
@@ -260,9 +274,22 @@ namespace Cyrex::Math {
             );
         }
 
-        [[nodiscard]] Matrix Inversed() const noexcept { return Inverse(*this); }
+        [[nodiscard]] constexpr Matrix Inversed() const noexcept { return Inverse(*this); }
 
-        [[nodiscard]] static inline Matrix Inverse(const Matrix& matrix) noexcept {
+        [[nodiscard]] static constexpr Matrix Inverse(const Matrix& matrix) noexcept {
+            if (std::is_constant_evaluated()) {
+                return InverseScalar(matrix);
+            }
+#if CRX_SIMD_X86
+            Matrix result;
+            MatrixKernels::Inverse_SSE(matrix.Data(), result.Data());
+            return result;
+#else
+            return InverseScalar(matrix);
+#endif
+        }
+
+        [[nodiscard]] static constexpr Matrix InverseScalar(const Matrix& matrix) noexcept {
             float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
             float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
             float v2 = matrix.m20 * matrix.m33 - matrix.m23 * matrix.m30;
@@ -325,7 +352,7 @@ namespace Cyrex::Math {
             rotation    = GetRotation();
         }
 
-        void SetIdentity() noexcept
+        constexpr void SetIdentity() noexcept
         {
             m00 = 1; m01 = 0; m02 = 0; m03 = 0;
             m10 = 0; m11 = 1; m12 = 0; m13 = 0;
@@ -333,31 +360,43 @@ namespace Cyrex::Math {
             m30 = 0; m31 = 0; m32 = 0; m33 = 1;
         }
 
-        [[nodiscard]] Matrix operator*(const Matrix& rhs) const noexcept
-        {
+        [[nodiscard]] constexpr Matrix operator*(const Matrix& rhs) const noexcept {
+            if (std::is_constant_evaluated()) {
+                return MultiplyScalar(*this, rhs);
+            }
+#if CRX_SIMD_X86
+            Matrix result;
+            MatrixKernels::Multiply_SSE(Data(), rhs.Data(), result.Data());
+            return result;
+#else
+            return MultiplyScalar(*this, rhs);
+#endif
+        }
+
+        [[nodiscard]] static constexpr Matrix MultiplyScalar(const Matrix& lhs, const Matrix& rhs) noexcept {
             return Matrix(
-                m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30,
-                m00 * rhs.m01 + m01 * rhs.m11 + m02 * rhs.m21 + m03 * rhs.m31,
-                m00 * rhs.m02 + m01 * rhs.m12 + m02 * rhs.m22 + m03 * rhs.m32,
-                m00 * rhs.m03 + m01 * rhs.m13 + m02 * rhs.m23 + m03 * rhs.m33,
-                m10 * rhs.m00 + m11 * rhs.m10 + m12 * rhs.m20 + m13 * rhs.m30,
-                m10 * rhs.m01 + m11 * rhs.m11 + m12 * rhs.m21 + m13 * rhs.m31,
-                m10 * rhs.m02 + m11 * rhs.m12 + m12 * rhs.m22 + m13 * rhs.m32,
-                m10 * rhs.m03 + m11 * rhs.m13 + m12 * rhs.m23 + m13 * rhs.m33,
-                m20 * rhs.m00 + m21 * rhs.m10 + m22 * rhs.m20 + m23 * rhs.m30,
-                m20 * rhs.m01 + m21 * rhs.m11 + m22 * rhs.m21 + m23 * rhs.m31,
-                m20 * rhs.m02 + m21 * rhs.m12 + m22 * rhs.m22 + m23 * rhs.m32,
-                m20 * rhs.m03 + m21 * rhs.m13 + m22 * rhs.m23 + m23 * rhs.m33,
-                m30 * rhs.m00 + m31 * rhs.m10 + m32 * rhs.m20 + m33 * rhs.m30,
-                m30 * rhs.m01 + m31 * rhs.m11 + m32 * rhs.m21 + m33 * rhs.m31,
-                m30 * rhs.m02 + m31 * rhs.m12 + m32 * rhs.m22 + m33 * rhs.m32,
-                m30 * rhs.m03 + m31 * rhs.m13 + m32 * rhs.m23 + m33 * rhs.m33
+                lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20 + lhs.m03 * rhs.m30,
+                lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21 + lhs.m03 * rhs.m31,
+                lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22 + lhs.m03 * rhs.m32,
+                lhs.m00 * rhs.m03 + lhs.m01 * rhs.m13 + lhs.m02 * rhs.m23 + lhs.m03 * rhs.m33,
+                lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20 + lhs.m13 * rhs.m30,
+                lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21 + lhs.m13 * rhs.m31,
+                lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22 + lhs.m13 * rhs.m32,
+                lhs.m10 * rhs.m03 + lhs.m11 * rhs.m13 + lhs.m12 * rhs.m23 + lhs.m13 * rhs.m33,
+                lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20 + lhs.m23 * rhs.m30,
+                lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21 + lhs.m23 * rhs.m31,
+                lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22 + lhs.m23 * rhs.m32,
+                lhs.m20 * rhs.m03 + lhs.m21 * rhs.m13 + lhs.m22 * rhs.m23 + lhs.m23 * rhs.m33,
+                lhs.m30 * rhs.m00 + lhs.m31 * rhs.m10 + lhs.m32 * rhs.m20 + lhs.m33 * rhs.m30,
+                lhs.m30 * rhs.m01 + lhs.m31 * rhs.m11 + lhs.m32 * rhs.m21 + lhs.m33 * rhs.m31,
+                lhs.m30 * rhs.m02 + lhs.m31 * rhs.m12 + lhs.m32 * rhs.m22 + lhs.m33 * rhs.m32,
+                lhs.m30 * rhs.m03 + lhs.m31 * rhs.m13 + lhs.m32 * rhs.m23 + lhs.m33 * rhs.m33
             );
         }
 
-        void operator*=(const Matrix& rhs) { (*this) = (*this) * rhs; }
+        constexpr void operator*=(const Matrix& rhs) noexcept { (*this) = (*this) * rhs; }
 
-        [[nodiscard]] Vector3 operator*(const Vector3& rhs) const noexcept {
+        [[nodiscard]] constexpr Vector3 operator*(const Vector3& rhs) const noexcept {
             Vector4 vec4;
 
             vec4.x = (rhs.x * m00) + (rhs.y * m10) + (rhs.z * m20) + m30;
@@ -368,7 +407,7 @@ namespace Cyrex::Math {
             return Vector3(vec4.x * vec4.w, vec4.y * vec4.w, vec4.z * vec4.w);
         }
 
-        [[nodiscard]] Vector4 operator*(const Vector4& rhs) const noexcept {
+        [[nodiscard]] constexpr Vector4 operator*(const Vector4& rhs) const noexcept {
             return Vector4
             (
                 (rhs.x * m00) + (rhs.y * m10) + (rhs.z * m20) + (rhs.w * m30),
@@ -378,20 +417,11 @@ namespace Cyrex::Math {
             );
         }
        
-        [[nodiscard]] bool operator==(const Matrix& rhs) const noexcept {
-            const float* data_left = Data();
-            const float* data_right = rhs.Data();
-
-            for (unsigned i = 0; i < 16; ++i)
-            {
-                if (data_left[i] != data_right[i])
-                    return false;
-            }
-
-            return true;
+        [[nodiscard]] constexpr bool operator==(const Matrix& rhs) const noexcept {
+            return std::bit_cast<std::array<float, 16>>(*this) == std::bit_cast<std::array<float, 16>>(rhs);
         }
 
-        [[nodiscard]] bool operator!=(const Matrix& rhs) const { return !(*this == rhs); }
+        [[nodiscard]] constexpr bool operator!=(const Matrix& rhs) const noexcept { return !(*this == rhs); }
 
         // Test for equality with another matrix with epsilon.
         [[nodiscard]] bool Equals(const Matrix& rhs) {
@@ -407,10 +437,15 @@ namespace Cyrex::Math {
             return true;
         }
         [[nodiscard]] const float* Data() const noexcept { return &m00; }
+        [[nodiscard]] float* Data() noexcept { return &m00; }
 
         float m00 = 0.0f, m01 = 0.0f, m02 = 0.0f, m03 = 0.0f;
         float m10 = 0.0f, m11 = 0.0f, m12 = 0.0f, m13 = 0.0f;
         float m20 = 0.0f, m21 = 0.0f, m22 = 0.0f, m23 = 0.0f;
         float m30 = 0.0f, m31 = 0.0f, m32 = 0.0f, m33 = 0.0f;
+
+        static const Matrix Identity;
     };
+
+    inline constexpr Matrix Matrix::Identity{};
 }
\ No newline at end of file
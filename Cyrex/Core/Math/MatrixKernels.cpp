@@ -0,0 +1,37 @@
+#include "MatrixKernels.h"
+
+namespace Cyrex::Math::MatrixKernels {
+#if CRX_SIMD_X86
+    CRX_TARGET_AVX2 void Multiply_AVX2(const float* lhs, const float* rhs, float* out) noexcept {
+        //Every row of rhs in both 128 bit lanes
+        const __m128 rhs0 = _mm_loadu_ps(rhs);
+        const __m128 rhs1 = _mm_loadu_ps(rhs + 4);
+        const __m128 rhs2 = _mm_loadu_ps(rhs + 8);
+        const __m128 rhs3 = _mm_loadu_ps(rhs + 12);
+
+        const __m256 rhs00 = _mm256_set_m128(rhs0, rhs0);
+        const __m256 rhs11 = _mm256_set_m128(rhs1, rhs1);
+        const __m256 rhs22 = _mm256_set_m128(rhs2, rhs2);
+        const __m256 rhs33 = _mm256_set_m128(rhs3, rhs3);
+
+        //Rows 0 and 1, then rows 2 and 3 of lhs
+        const __m256 lhs01 = _mm256_loadu_ps(lhs);
+        const __m256 lhs23 = _mm256_loadu_ps(lhs + 8);
+
+        __m256 result01 = _mm256_mul_ps(_mm256_shuffle_ps(lhs01, lhs01, _MM_SHUFFLE(0, 0, 0, 0)), rhs00);
+        __m256 result23 = _mm256_mul_ps(_mm256_shuffle_ps(lhs23, lhs23, _MM_SHUFFLE(0, 0, 0, 0)), rhs00);
+
+        result01 = _mm256_fmadd_ps(_mm256_shuffle_ps(lhs01, lhs01, _MM_SHUFFLE(1, 1, 1, 1)), rhs11, result01);
+        result23 = _mm256_fmadd_ps(_mm256_shuffle_ps(lhs23, lhs23, _MM_SHUFFLE(1, 1, 1, 1)), rhs11, result23);
+
+        result01 = _mm256_fmadd_ps(_mm256_shuffle_ps(lhs01, lhs01, _MM_SHUFFLE(2, 2, 2, 2)), rhs22, result01);
+        result23 = _mm256_fmadd_ps(_mm256_shuffle_ps(lhs23, lhs23, _MM_SHUFFLE(2, 2, 2, 2)), rhs22, result23);
+
+        result01 = _mm256_fmadd_ps(_mm256_shuffle_ps(lhs01, lhs01, _MM_SHUFFLE(3, 3, 3, 3)), rhs33, result01);
+        result23 = _mm256_fmadd_ps(_mm256_shuffle_ps(lhs23, lhs23, _MM_SHUFFLE(3, 3, 3, 3)), rhs33, result23);
+
+        _mm256_storeu_ps(out, result01);
+        _mm256_storeu_ps(out + 8, result23);
+    }
+#endif
+}
@@ -0,0 +1,194 @@
+#pragma once
+#include "SIMD.h"
+
+//SIMD versions of the Matrix operations on row major float[16] data. The output may alias
+//an input. The scalar code in Matrix is the reference every version is checked against.
+namespace Cyrex::Math::MatrixKernels {
+#if CRX_SIMD_X86
+    //SSE2 is part of x64, so these need no dispatch and stay inline for the per draw path
+    inline void Multiply_SSE(const float* lhs, const float* rhs, float* out) noexcept {
+        const __m128 rhs0 = _mm_loadu_ps(rhs);
+        const __m128 rhs1 = _mm_loadu_ps(rhs + 4);
+        const __m128 rhs2 = _mm_loadu_ps(rhs + 8);
+        const __m128 rhs3 = _mm_loadu_ps(rhs + 12);
+
+        for (int row = 0; row < 4; ++row) {
+            const __m128 lhsRow = _mm_loadu_ps(lhs + row * 4);
+
+            __m128 result = _mm_mul_ps(_mm_shuffle_ps(lhsRow, lhsRow, _MM_SHUFFLE(0, 0, 0, 0)), rhs0);
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(lhsRow, lhsRow, _MM_SHUFFLE(1, 1, 1, 1)), rhs1));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(lhsRow, lhsRow, _MM_SHUFFLE(2, 2, 2, 2)), rhs2));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(lhsRow, lhsRow, _MM_SHUFFLE(3, 3, 3, 3)), rhs3));
+
+            _mm_storeu_ps(out + row * 4, result);
+        }
+    }
+
+    inline void Transpose_SSE(const float* in, float* out) noexcept {
+        __m128 row0 = _mm_loadu_ps(in);
+        __m128 row1 = _mm_loadu_ps(in + 4);
+        __m128 row2 = _mm_loadu_ps(in + 8);
+        __m128 row3 = _mm_loadu_ps(in + 12);
+
+        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+        _mm_storeu_ps(out, row0);
+        _mm_storeu_ps(out + 4, row1);
+        _mm_storeu_ps(out + 8, row2);
+        _mm_storeu_ps(out + 12, row3);
+    }
+
+    namespace Detail {
+        //2x2 matrices stored as (m00, m01, m10, m11)
+
+        //lhs * rhs
+        inline __m128 Mat2Mul(__m128 lhs, __m128 rhs) noexcept {
+            return _mm_add_ps(
+                _mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 3, 0))),
+                _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        //adjugate(lhs) * rhs
+        inline __m128 Mat2AdjMul(__m128 lhs, __m128 rhs) noexcept {
+            return _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(0, 0, 3, 3)), rhs),
+                _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        //lhs * adjugate(rhs)
+        inline __m128 Mat2MulAdj(__m128 lhs, __m128 rhs) noexcept {
+            return _mm_sub_ps(
+                _mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 3, 0, 3))),
+                _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+    }
+
+    //General inverse through the 2x2 blocks of the matrix:
+    //    | A B |      1   | X Y |
+    //    | C D | ->  ---  | Z W |
+    //                |M|
+    inline void Inverse_SSE(const float* in, float* out) noexcept {
+        using namespace Detail;
+
+        const __m128 row0 = _mm_loadu_ps(in);
+        const __m128 row1 = _mm_loadu_ps(in + 4);
+        const __m128 row2 = _mm_loadu_ps(in + 8);
+        const __m128 row3 = _mm_loadu_ps(in + 12);
+
+        const __m128 A = _mm_movelh_ps(row0, row1);
+        const __m128 B = _mm_movehl_ps(row1, row0);
+        const __m128 C = _mm_movelh_ps(row2, row3);
+        const __m128 D = _mm_movehl_ps(row3, row2);
+
+        //(|A|, |B|, |C|, |D|)
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+        const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+        const __m128 adjDC = Mat2AdjMul(D, C);
+        const __m128 adjAB = Mat2AdjMul(A, B);
+
+        //Adjugates of the blocks of the inverse
+        __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, adjDC));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, adjAB));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, adjAB));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, adjDC));
+
+        //|M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        __m128 trace = _mm_mul_ps(adjAB, _mm_shuffle_ps(adjDC, adjDC, _MM_SHUFFLE(3, 1, 2, 0)));
+        trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+        trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+        //(1/|M|, -1/|M|, -1/|M|, 1/|M|) turns the adjugates back into the blocks
+        const __m128 rcpDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+
+        X = _mm_mul_ps(X, rcpDetM);
+        Y = _mm_mul_ps(Y, rcpDetM);
+        Z = _mm_mul_ps(Z, rcpDetM);
+        W = _mm_mul_ps(W, rcpDetM);
+
+        _mm_storeu_ps(out,      _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 4,  _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_storeu_ps(out + 8,  _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(out + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+    }
+
+    //Affine3x4 product on float[12] data, see Affine3x4 for the layout. The implicit
+    //(0, 0, 0, 1) row of rhs only adds its translation.
+    inline void MultiplyAffine_SSE(const float* lhs, const float* rhs, float* out) noexcept {
+        const __m128 lhs0 = _mm_loadu_ps(lhs);
+        const __m128 lhs1 = _mm_loadu_ps(lhs + 4);
+        const __m128 lhs2 = _mm_loadu_ps(lhs + 8);
+
+        const __m128 translationMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+        for (int row = 0; row < 3; ++row) {
+            const __m128 rhsRow = _mm_loadu_ps(rhs + row * 4);
+
+            __m128 result = _mm_and_ps(rhsRow, translationMask);
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(rhsRow, rhsRow, _MM_SHUFFLE(0, 0, 0, 0)), lhs0));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(rhsRow, rhsRow, _MM_SHUFFLE(1, 1, 1, 1)), lhs1));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(rhsRow, rhsRow, _MM_SHUFFLE(2, 2, 2, 2)), lhs2));
+
+            _mm_storeu_ps(out + row * 4, result);
+        }
+    }
+
+    namespace Detail {
+        inline __m128 Cross3(__m128 lhs, __m128 rhs) noexcept {
+            const __m128 lhsYZX = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 rhsYZX = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 result = _mm_sub_ps(_mm_mul_ps(lhs, rhsYZX), _mm_mul_ps(lhsYZX, rhs));
+
+            return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+    }
+
+    //Affine3x4 inverse. The cross products of the rows are the columns of the adjugate of the
+    //3x3 part, so one transpose gives the inverse with the moved translation in its last column.
+    inline void InverseAffine_SSE(const float* in, float* out) noexcept {
+        using namespace Detail;
+
+        const __m128 row0 = _mm_loadu_ps(in);
+        const __m128 row1 = _mm_loadu_ps(in + 4);
+        const __m128 row2 = _mm_loadu_ps(in + 8);
+
+        __m128 cross12 = Cross3(row1, row2);
+        __m128 cross20 = Cross3(row2, row0);
+        __m128 cross01 = Cross3(row0, row1);
+
+        //The w lanes of the crosses are 0, so a full dot product is the determinant
+        __m128 det = _mm_mul_ps(row0, cross12);
+        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        const __m128 rcpDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+        cross12 = _mm_mul_ps(cross12, rcpDet);
+        cross20 = _mm_mul_ps(cross20, rcpDet);
+        cross01 = _mm_mul_ps(cross01, rcpDet);
+
+        //-(translation * inverse 3x3), a column of the result
+        __m128 translation = _mm_mul_ps(cross12, _mm_shuffle_ps(row0, row0, _MM_SHUFFLE(3, 3, 3, 3)));
+        translation = _mm_add_ps(translation, _mm_mul_ps(cross20, _mm_shuffle_ps(row1, row1, _MM_SHUFFLE(3, 3, 3, 3))));
+        translation = _mm_add_ps(translation, _mm_mul_ps(cross01, _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(3, 3, 3, 3))));
+        translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+        _MM_TRANSPOSE4_PS(cross12, cross20, cross01, translation);
+
+        _mm_storeu_ps(out, cross12);
+        _mm_storeu_ps(out + 4, cross20);
+        _mm_storeu_ps(out + 8, cross01);
+    }
+
+    //Two rows per instruction with fused multiply adds. Needs AVX2 and FMA.
+    void Multiply_AVX2(const float* lhs, const float* rhs, float* out) noexcept;
+#endif
+}
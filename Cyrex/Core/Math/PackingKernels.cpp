@@ -0,0 +1,659 @@
+#include "PackingKernels.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include <bit>
+#include <cmath>
+
+namespace Cyrex::Math::PackingKernels {
+    namespace {
+        //The operand order of maxps and minps, a NaN in the first operand gives the second
+        constexpr float Max(float a, float b) noexcept { return a > b ? a : b; }
+        constexpr float Min(float a, float b) noexcept { return a < b ? a : b; }
+
+        //To nearest even, like cvtps2dq
+        inline int32_t Round(float value) noexcept { return static_cast<int32_t>(std::lrint(value)); }
+
+        constexpr uint32_t F32Infinity     = 255u << 23;
+        constexpr uint32_t F16Max          = (127u + 16u) << 23;
+        constexpr uint32_t F16MinNormal    = 113u << 23;
+        constexpr uint32_t DenormMagic     = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+        constexpr uint32_t ShiftedExponent = 0x7C00u << 13;
+
+        //Fabian Giesen's conversions. Subnormals are rounded and renormalized by float additions,
+        //so they need the default rounding mode and no flush to zero.
+        uint16_t FloatToHalf(float value) noexcept {
+            uint32_t bits = std::bit_cast<uint32_t>(value);
+            const uint32_t sign = bits & 0x80000000u;
+            bits ^= sign;
+
+            uint32_t half;
+
+            if (bits >= F16Max) {
+                half = bits > F32Infinity ? 0x7E00u : 0x7C00u;
+            }
+            else if (bits < F16MinNormal) {
+                half = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) + std::bit_cast<float>(DenormMagic)) - DenormMagic;
+            }
+            else {
+                //Rebias the exponent and round to nearest even on the 13 dropped bits
+                const uint32_t mantissaOdd = (bits >> 13) & 1u;
+                half = (bits + ((15u - 127u) << 23) + 0xFFFu + mantissaOdd) >> 13;
+            }
+            return static_cast<uint16_t>(half | (sign >> 16));
+        }
+
+        float HalfToFloat(uint16_t half) noexcept {
+            uint32_t bits = static_cast<uint32_t>(half & 0x7FFFu) << 13;
+            const uint32_t exponent = bits & ShiftedExponent;
+            bits += (127u - 15u) << 23;
+
+            if (exponent == ShiftedExponent) {
+                bits += (128u - 16u) << 23;
+            }
+            else if (exponent == 0) {
+                bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits + (1u << 23)) - std::bit_cast<float>(F16MinNormal));
+            }
+            return std::bit_cast<float>(bits | (static_cast<uint32_t>(half & 0x8000u) << 16));
+        }
+
+        int16_t FloatToSnorm16(float value) noexcept { return static_cast<int16_t>(Round(Min(Max(value, -1.0f), 1.0f) * 32767.0f)); }
+        float Snorm16ToFloat(int16_t value) noexcept { return Max(static_cast<float>(value) / 32767.0f, -1.0f); }
+
+        uint16_t FloatToUnorm16(float value) noexcept { return static_cast<uint16_t>(Round(Min(Max(value, 0.0f), 1.0f) * 65535.0f)); }
+        float Unorm16ToFloat(uint16_t value) noexcept { return static_cast<float>(value) / 65535.0f; }
+
+        uint32_t EncodeOctahedral(float x, float y, float z) noexcept {
+            const float sum = std::abs(x) + std::abs(y) + std::abs(z);
+
+            float u = x / sum;
+            float v = y / sum;
+
+            //The lower half folds over the diagonals onto the corners of the square
+            if (z < 0.0f) {
+                const float foldedU = (1.0f - std::abs(v)) * std::copysign(1.0f, u);
+                const float foldedV = (1.0f - std::abs(u)) * std::copysign(1.0f, v);
+
+                u = foldedU;
+                v = foldedV;
+            }
+            return static_cast<uint16_t>(FloatToSnorm16(u)) | (static_cast<uint32_t>(static_cast<uint16_t>(FloatToSnorm16(v))) << 16);
+        }
+
+        Vector3 DecodeOctahedral(uint32_t packed) noexcept {
+            float u = Snorm16ToFloat(static_cast<int16_t>(packed & 0xFFFFu));
+            float v = Snorm16ToFloat(static_cast<int16_t>(packed >> 16));
+
+            const float z = 1.0f - std::abs(u) - std::abs(v);
+            const float t = Max(-z, 0.0f);
+
+            u -= std::copysign(t, u);
+            v -= std::copysign(t, v);
+
+            const float length = std::sqrt(u * u + v * v + z * z);
+            return Vector3(u / length, v / length, z / length);
+        }
+
+        uint32_t PackUnorm1010102(float x, float y, float z, float w) noexcept {
+            const auto r = static_cast<uint32_t>(Round(Min(Max(x, 0.0f), 1.0f) * 1023.0f));
+            const auto g = static_cast<uint32_t>(Round(Min(Max(y, 0.0f), 1.0f) * 1023.0f));
+            const auto b = static_cast<uint32_t>(Round(Min(Max(z, 0.0f), 1.0f) * 1023.0f));
+            const auto a = static_cast<uint32_t>(Round(Min(Max(w, 0.0f), 1.0f) * 3.0f));
+
+            return r | (g << 10) | (b << 20) | (a << 30);
+        }
+
+        //Also the tails of the SIMD kernels
+        void FloatToHalf(std::span<const float> in, std::span<uint16_t> out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                out[i] = FloatToHalf(in[i]);
+            }
+        }
+
+        void HalfToFloat(std::span<const uint16_t> in, std::span<float> out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                out[i] = HalfToFloat(in[i]);
+            }
+        }
+
+        void FloatToSnorm16(std::span<const float> in, std::span<int16_t> out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                out[i] = FloatToSnorm16(in[i]);
+            }
+        }
+
+        void Snorm16ToFloat(std::span<const int16_t> in, std::span<float> out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                out[i] = Snorm16ToFloat(in[i]);
+            }
+        }
+
+        void FloatToUnorm16(std::span<const float> in, std::span<uint16_t> out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                out[i] = FloatToUnorm16(in[i]);
+            }
+        }
+
+        void Unorm16ToFloat(std::span<const uint16_t> in, std::span<float> out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                out[i] = Unorm16ToFloat(in[i]);
+            }
+        }
+
+        void EncodeOctahedral(ConstVector3Span normals, std::span<uint32_t> out, size_t begin) noexcept {
+            for (size_t i = begin; i < normals.Count; ++i) {
+                out[i] = EncodeOctahedral(normals.X[i], normals.Y[i], normals.Z[i]);
+            }
+        }
+
+        void DecodeOctahedral(std::span<const uint32_t> in, Vector3Span normals, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                normals.Set(i, DecodeOctahedral(in[i]));
+            }
+        }
+
+        void PackUnorm1010102(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out, size_t begin) noexcept {
+            for (size_t i = begin; i < xyz.Count; ++i) {
+                out[i] = PackUnorm1010102(xyz.X[i], xyz.Y[i], xyz.Z[i], w[i]);
+            }
+        }
+
+        void UnpackUnorm1010102(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w, size_t begin) noexcept {
+            for (size_t i = begin; i < in.size(); ++i) {
+                xyz.X[i] = static_cast<float>(in[i] & 0x3FFu) / 1023.0f;
+                xyz.Y[i] = static_cast<float>((in[i] >> 10) & 0x3FFu) / 1023.0f;
+                xyz.Z[i] = static_cast<float>((in[i] >> 20) & 0x3FFu) / 1023.0f;
+                w[i]     = static_cast<float>(in[i] >> 30) / 3.0f;
+            }
+        }
+    }
+
+    void FloatToHalf_Scalar(std::span<const float> in, std::span<uint16_t> out) noexcept { FloatToHalf(in, out, 0); }
+    void HalfToFloat_Scalar(std::span<const uint16_t> in, std::span<float> out) noexcept { HalfToFloat(in, out, 0); }
+    void FloatToSnorm16_Scalar(std::span<const float> in, std::span<int16_t> out) noexcept { FloatToSnorm16(in, out, 0); }
+    void Snorm16ToFloat_Scalar(std::span<const int16_t> in, std::span<float> out) noexcept { Snorm16ToFloat(in, out, 0); }
+    void FloatToUnorm16_Scalar(std::span<const float> in, std::span<uint16_t> out) noexcept { FloatToUnorm16(in, out, 0); }
+    void Unorm16ToFloat_Scalar(std::span<const uint16_t> in, std::span<float> out) noexcept { Unorm16ToFloat(in, out, 0); }
+    void EncodeOctahedral_Scalar(ConstVector3Span normals, std::span<uint32_t> out) noexcept { EncodeOctahedral(normals, out, 0); }
+    void DecodeOctahedral_Scalar(std::span<const uint32_t> in, Vector3Span normals) noexcept { DecodeOctahedral(in, normals, 0); }
+
+    void PackUnorm1010102_Scalar(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept {
+        PackUnorm1010102(xyz, w, out, 0);
+    }
+
+    void UnpackUnorm1010102_Scalar(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept {
+        UnpackUnorm1010102(in, xyz, w, 0);
+    }
+
+#if CRX_SIMD_X86
+    namespace {
+        inline __m128i Set1_SSE(uint32_t value) noexcept { return _mm_set1_epi32(static_cast<int>(value)); }
+
+        inline __m128i Select_SSE(__m128i mask, __m128i a, __m128i b) noexcept {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+
+        inline __m128i Clamp_SSE(__m128 value, float low, float high, float scale) noexcept {
+            return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(value, _mm_set1_ps(low)), _mm_set1_ps(high)), _mm_set1_ps(scale)));
+        }
+
+        //Keeps the low 16 bits of each lane, packs_epi32 saturates, so they are sign extended first
+        inline __m128i PackLow16_SSE(__m128i value) noexcept {
+            const __m128i extended = _mm_srai_epi32(_mm_slli_epi32(value, 16), 16);
+            return _mm_packs_epi32(extended, extended);
+        }
+
+        inline __m128i LoadUnsigned16_SSE(const uint16_t* in) noexcept {
+            return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)), _mm_setzero_si128());
+        }
+
+        inline __m128i LoadSigned16_SSE(const int16_t* in) noexcept {
+            const __m128i value = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+            return _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+        }
+
+        inline void Store16_SSE(void* out, __m128i packed) noexcept {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+        }
+
+        //Each lane holds a half in its low 16 bits
+        inline __m128i FloatToHalf_SSE(__m128 value) noexcept {
+            __m128i bits = _mm_castps_si128(value);
+            const __m128i sign = _mm_and_si128(bits, Set1_SSE(0x80000000u));
+            bits = _mm_xor_si128(bits, sign);
+
+            const __m128i isInfOrNaN = _mm_cmpgt_epi32(bits, Set1_SSE(F16Max - 1));
+            const __m128i isNaN      = _mm_cmpgt_epi32(bits, Set1_SSE(F32Infinity));
+            const __m128i infOrNaN   = _mm_or_si128(Set1_SSE(0x7C00u), _mm_and_si128(isNaN, Set1_SSE(0x0200u)));
+
+            const __m128i isSubnormal = _mm_cmplt_epi32(bits, Set1_SSE(F16MinNormal));
+            const __m128i subnormal   = _mm_sub_epi32(
+                _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits), _mm_castsi128_ps(Set1_SSE(DenormMagic)))),
+                Set1_SSE(DenormMagic));
+
+            const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(bits, 13), Set1_SSE(1u));
+            const __m128i normal      = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, Set1_SSE(((15u - 127u) << 23) + 0xFFFu)), mantissaOdd), 13);
+
+            const __m128i half = Select_SSE(isInfOrNaN, infOrNaN, Select_SSE(isSubnormal, subnormal, normal));
+            return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+        }
+
+        inline __m128 HalfToFloat_SSE(__m128i half) noexcept {
+            __m128i bits = _mm_slli_epi32(_mm_and_si128(half, Set1_SSE(0x7FFFu)), 13);
+            const __m128i exponent = _mm_and_si128(bits, Set1_SSE(ShiftedExponent));
+            bits = _mm_add_epi32(bits, Set1_SSE((127u - 15u) << 23));
+
+            const __m128i isInfOrNaN = _mm_cmpeq_epi32(exponent, Set1_SSE(ShiftedExponent));
+            bits = _mm_add_epi32(bits, _mm_and_si128(isInfOrNaN, Set1_SSE((128u - 16u) << 23)));
+
+            const __m128i isSubnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+            const __m128i subnormal   = _mm_castps_si128(_mm_sub_ps(
+                _mm_castsi128_ps(_mm_add_epi32(bits, Set1_SSE(1u << 23))),
+                _mm_castsi128_ps(Set1_SSE(F16MinNormal))));
+
+            bits = Select_SSE(isSubnormal, subnormal, bits);
+            return _mm_castsi128_ps(_mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(half, Set1_SSE(0x8000u)), 16)));
+        }
+
+        inline __m128 Snorm16ToFloat_SSE(__m128i value) noexcept {
+            return _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(32767.0f)), _mm_set1_ps(-1.0f));
+        }
+
+        inline __m128 Abs_SSE(__m128 value) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+
+        //copysign(magnitude, sign) for a magnitude without a sign bit
+        inline __m128 CopySign_SSE(__m128 magnitude, __m128 sign) noexcept {
+            return _mm_or_ps(magnitude, _mm_and_ps(sign, _mm_set1_ps(-0.0f)));
+        }
+    }
+
+    void FloatToHalf_SSE(std::span<const float> in, std::span<uint16_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            Store16_SSE(out.data() + i, PackLow16_SSE(FloatToHalf_SSE(_mm_loadu_ps(in.data() + i))));
+        }
+        FloatToHalf(in, out, i);
+    }
+
+    void HalfToFloat_SSE(std::span<const uint16_t> in, std::span<float> out) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            _mm_storeu_ps(out.data() + i, HalfToFloat_SSE(LoadUnsigned16_SSE(in.data() + i)));
+        }
+        HalfToFloat(in, out, i);
+    }
+
+    void FloatToSnorm16_SSE(std::span<const float> in, std::span<int16_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            const __m128i value = Clamp_SSE(_mm_loadu_ps(in.data() + i), -1.0f, 1.0f, 32767.0f);
+            Store16_SSE(out.data() + i, _mm_packs_epi32(value, value));
+        }
+        FloatToSnorm16(in, out, i);
+    }
+
+    void Snorm16ToFloat_SSE(std::span<const int16_t> in, std::span<float> out) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            _mm_storeu_ps(out.data() + i, Snorm16ToFloat_SSE(LoadSigned16_SSE(in.data() + i)));
+        }
+        Snorm16ToFloat(in, out, i);
+    }
+
+    void FloatToUnorm16_SSE(std::span<const float> in, std::span<uint16_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            Store16_SSE(out.data() + i, PackLow16_SSE(Clamp_SSE(_mm_loadu_ps(in.data() + i), 0.0f, 1.0f, 65535.0f)));
+        }
+        FloatToUnorm16(in, out, i);
+    }
+
+    void Unorm16ToFloat_SSE(std::span<const uint16_t> in, std::span<float> out) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            _mm_storeu_ps(out.data() + i, _mm_div_ps(_mm_cvtepi32_ps(LoadUnsigned16_SSE(in.data() + i)), _mm_set1_ps(65535.0f)));
+        }
+        Unorm16ToFloat(in, out, i);
+    }
+
+    void EncodeOctahedral_SSE(ConstVector3Span normals, std::span<uint32_t> out) noexcept {
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        size_t i = 0;
+        for (; i + 4 <= normals.Count; i += 4) {
+            const __m128 x = _mm_loadu_ps(normals.X + i);
+            const __m128 y = _mm_loadu_ps(normals.Y + i);
+            const __m128 z = _mm_loadu_ps(normals.Z + i);
+
+            const __m128 sum = _mm_add_ps(_mm_add_ps(Abs_SSE(x), Abs_SSE(y)), Abs_SSE(z));
+            const __m128 u   = _mm_div_ps(x, sum);
+            const __m128 v   = _mm_div_ps(y, sum);
+
+            const __m128 foldedU = _mm_mul_ps(_mm_sub_ps(one, Abs_SSE(v)), CopySign_SSE(one, u));
+            const __m128 foldedV = _mm_mul_ps(_mm_sub_ps(one, Abs_SSE(u)), CopySign_SSE(one, v));
+
+            const __m128 isLower = _mm_cmplt_ps(z, _mm_setzero_ps());
+            const __m128 finalU  = _mm_or_ps(_mm_and_ps(isLower, foldedU), _mm_andnot_ps(isLower, u));
+            const __m128 finalV  = _mm_or_ps(_mm_and_ps(isLower, foldedV), _mm_andnot_ps(isLower, v));
+
+            const __m128i snormU = _mm_and_si128(Clamp_SSE(finalU, -1.0f, 1.0f, 32767.0f), Set1_SSE(0xFFFFu));
+            const __m128i snormV = _mm_slli_epi32(Clamp_SSE(finalV, -1.0f, 1.0f, 32767.0f), 16);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), _mm_or_si128(snormU, snormV));
+        }
+        EncodeOctahedral(normals, out, i);
+    }
+
+    void DecodeOctahedral_SSE(std::span<const uint32_t> in, Vector3Span normals) noexcept {
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+
+            __m128 u = Snorm16ToFloat_SSE(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16));
+            __m128 v = Snorm16ToFloat_SSE(_mm_srai_epi32(packed, 16));
+
+            const __m128 z = _mm_sub_ps(_mm_sub_ps(one, Abs_SSE(u)), Abs_SSE(v));
+            const __m128 t = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+
+            u = _mm_sub_ps(u, CopySign_SSE(t, u));
+            v = _mm_sub_ps(v, CopySign_SSE(t, v));
+
+            const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v)), _mm_mul_ps(z, z)));
+
+            _mm_storeu_ps(normals.X + i, _mm_div_ps(u, length));
+            _mm_storeu_ps(normals.Y + i, _mm_div_ps(v, length));
+            _mm_storeu_ps(normals.Z + i, _mm_div_ps(z, length));
+        }
+        DecodeOctahedral(in, normals, i);
+    }
+
+    void PackUnorm1010102_SSE(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= xyz.Count; i += 4) {
+            const __m128i r = Clamp_SSE(_mm_loadu_ps(xyz.X + i), 0.0f, 1.0f, 1023.0f);
+            const __m128i g = Clamp_SSE(_mm_loadu_ps(xyz.Y + i), 0.0f, 1.0f, 1023.0f);
+            const __m128i b = Clamp_SSE(_mm_loadu_ps(xyz.Z + i), 0.0f, 1.0f, 1023.0f);
+            const __m128i a = Clamp_SSE(_mm_loadu_ps(w.data() + i), 0.0f, 1.0f, 3.0f);
+
+            const __m128i packed = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 10)), _mm_or_si128(_mm_slli_epi32(b, 20), _mm_slli_epi32(a, 30)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), packed);
+        }
+        PackUnorm1010102(xyz, w, out, i);
+    }
+
+    void UnpackUnorm1010102_SSE(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept {
+        const __m128i mask = Set1_SSE(0x3FFu);
+        const __m128 scale = _mm_set1_ps(1023.0f);
+
+        size_t i = 0;
+        for (; i + 4 <= in.size(); i += 4) {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+
+            _mm_storeu_ps(xyz.X + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, mask)), scale));
+            _mm_storeu_ps(xyz.Y + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 10), mask)), scale));
+            _mm_storeu_ps(xyz.Z + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 20), mask)), scale));
+            _mm_storeu_ps(w.data() + i, _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(packed, 30)), _mm_set1_ps(3.0f)));
+        }
+        UnpackUnorm1010102(in, xyz, w, i);
+    }
+
+    namespace {
+        CRX_TARGET_AVX2 inline __m256i Clamp_AVX2(__m256 value, float low, float high, float scale) noexcept {
+            return _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(low)), _mm256_set1_ps(high)), _mm256_set1_ps(scale)));
+        }
+
+        CRX_TARGET_AVX2 inline __m256 Snorm16ToFloat_AVX2(__m256i value) noexcept {
+            return _mm256_max_ps(_mm256_div_ps(_mm256_cvtepi32_ps(value), _mm256_set1_ps(32767.0f)), _mm256_set1_ps(-1.0f));
+        }
+
+        CRX_TARGET_AVX2 inline __m256 Abs_AVX2(__m256 value) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+
+        CRX_TARGET_AVX2 inline __m256 CopySign_AVX2(__m256 magnitude, __m256 sign) noexcept {
+            return _mm256_or_ps(magnitude, _mm256_and_ps(sign, _mm256_set1_ps(-0.0f)));
+        }
+
+        CRX_TARGET_AVX2 inline void Store16_AVX2(void* out, __m128i packed) noexcept {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+        }
+
+        CRX_TARGET_AVX2 inline __m128i Load16_AVX2(const void* in) noexcept {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        }
+    }
+
+    //F16C converts in hardware with the same rounding
+    CRX_TARGET_AVX2 void FloatToHalf_AVX2(std::span<const float> in, std::span<uint16_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            Store16_AVX2(out.data() + i, _mm256_cvtps_ph(_mm256_loadu_ps(in.data() + i), _MM_FROUND_TO_NEAREST_INT));
+        }
+        FloatToHalf(in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void HalfToFloat_AVX2(std::span<const uint16_t> in, std::span<float> out) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            _mm256_storeu_ps(out.data() + i, _mm256_cvtph_ps(Load16_AVX2(in.data() + i)));
+        }
+        HalfToFloat(in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void FloatToSnorm16_AVX2(std::span<const float> in, std::span<int16_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            const __m256i value = Clamp_AVX2(_mm256_loadu_ps(in.data() + i), -1.0f, 1.0f, 32767.0f);
+            Store16_AVX2(out.data() + i, _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1)));
+        }
+        FloatToSnorm16(in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void Snorm16ToFloat_AVX2(std::span<const int16_t> in, std::span<float> out) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            _mm256_storeu_ps(out.data() + i, Snorm16ToFloat_AVX2(_mm256_cvtepi16_epi32(Load16_AVX2(in.data() + i))));
+        }
+        Snorm16ToFloat(in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void FloatToUnorm16_AVX2(std::span<const float> in, std::span<uint16_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            const __m256i value = Clamp_AVX2(_mm256_loadu_ps(in.data() + i), 0.0f, 1.0f, 65535.0f);
+            Store16_AVX2(out.data() + i, _mm_packus_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1)));
+        }
+        FloatToUnorm16(in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void Unorm16ToFloat_AVX2(std::span<const uint16_t> in, std::span<float> out) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            const __m256 value = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(Load16_AVX2(in.data() + i)));
+            _mm256_storeu_ps(out.data() + i, _mm256_div_ps(value, _mm256_set1_ps(65535.0f)));
+        }
+        Unorm16ToFloat(in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void EncodeOctahedral_AVX2(ConstVector3Span normals, std::span<uint32_t> out) noexcept {
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= normals.Count; i += 8) {
+            const __m256 x = _mm256_loadu_ps(normals.X + i);
+            const __m256 y = _mm256_loadu_ps(normals.Y + i);
+            const __m256 z = _mm256_loadu_ps(normals.Z + i);
+
+            const __m256 sum = _mm256_add_ps(_mm256_add_ps(Abs_AVX2(x), Abs_AVX2(y)), Abs_AVX2(z));
+            const __m256 u   = _mm256_div_ps(x, sum);
+            const __m256 v   = _mm256_div_ps(y, sum);
+
+            const __m256 foldedU = _mm256_mul_ps(_mm256_sub_ps(one, Abs_AVX2(v)), CopySign_AVX2(one, u));
+            const __m256 foldedV = _mm256_mul_ps(_mm256_sub_ps(one, Abs_AVX2(u)), CopySign_AVX2(one, v));
+
+            const __m256 isLower = _mm256_cmp_ps(z, _mm256_setzero_ps(), _CMP_LT_OQ);
+            const __m256 finalU  = _mm256_blendv_ps(u, foldedU, isLower);
+            const __m256 finalV  = _mm256_blendv_ps(v, foldedV, isLower);
+
+            const __m256i snormU = _mm256_and_si256(Clamp_AVX2(finalU, -1.0f, 1.0f, 32767.0f), _mm256_set1_epi32(0xFFFF));
+            const __m256i snormV = _mm256_slli_epi32(Clamp_AVX2(finalV, -1.0f, 1.0f, 32767.0f), 16);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + i), _mm256_or_si256(snormU, snormV));
+        }
+        EncodeOctahedral(normals, out, i);
+    }
+
+    CRX_TARGET_AVX2 void DecodeOctahedral_AVX2(std::span<const uint32_t> in, Vector3Span normals) noexcept {
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + i));
+
+            __m256 u = Snorm16ToFloat_AVX2(_mm256_srai_epi32(_mm256_slli_epi32(packed, 16), 16));
+            __m256 v = Snorm16ToFloat_AVX2(_mm256_srai_epi32(packed, 16));
+
+            const __m256 z = _mm256_sub_ps(_mm256_sub_ps(one, Abs_AVX2(u)), Abs_AVX2(v));
+            const __m256 t = _mm256_max_ps(_mm256_sub_ps(_mm256_setzero_ps(), z), _mm256_setzero_ps());
+
+            u = _mm256_sub_ps(u, CopySign_AVX2(t, u));
+            v = _mm256_sub_ps(v, CopySign_AVX2(t, v));
+
+            const __m256 length = _mm256_sqrt_ps(_mm256_fmadd_ps(u, u, _mm256_fmadd_ps(v, v, _mm256_mul_ps(z, z))));
+
+            _mm256_storeu_ps(normals.X + i, _mm256_div_ps(u, length));
+            _mm256_storeu_ps(normals.Y + i, _mm256_div_ps(v, length));
+            _mm256_storeu_ps(normals.Z + i, _mm256_div_ps(z, length));
+        }
+        DecodeOctahedral(in, normals, i);
+    }
+
+    CRX_TARGET_AVX2 void PackUnorm1010102_AVX2(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= xyz.Count; i += 8) {
+            const __m256i r = Clamp_AVX2(_mm256_loadu_ps(xyz.X + i), 0.0f, 1.0f, 1023.0f);
+            const __m256i g = Clamp_AVX2(_mm256_loadu_ps(xyz.Y + i), 0.0f, 1.0f, 1023.0f);
+            const __m256i b = Clamp_AVX2(_mm256_loadu_ps(xyz.Z + i), 0.0f, 1.0f, 1023.0f);
+            const __m256i a = Clamp_AVX2(_mm256_loadu_ps(w.data() + i), 0.0f, 1.0f, 3.0f);
+
+            const __m256i packed = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 10)), _mm256_or_si256(_mm256_slli_epi32(b, 20), _mm256_slli_epi32(a, 30)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + i), packed);
+        }
+        PackUnorm1010102(xyz, w, out, i);
+    }
+
+    CRX_TARGET_AVX2 void UnpackUnorm1010102_AVX2(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept {
+        const __m256i mask = _mm256_set1_epi32(0x3FF);
+        const __m256 scale = _mm256_set1_ps(1023.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= in.size(); i += 8) {
+            const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + i));
+
+            _mm256_storeu_ps(xyz.X + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(packed, mask)), scale));
+            _mm256_storeu_ps(xyz.Y + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(packed, 10), mask)), scale));
+            _mm256_storeu_ps(xyz.Z + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(packed, 20), mask)), scale));
+            _mm256_storeu_ps(w.data() + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(packed, 30)), _mm256_set1_ps(3.0f)));
+        }
+        UnpackUnorm1010102(in, xyz, w, i);
+    }
+#endif
+}
+
+namespace {
+    using namespace Cyrex;
+    using namespace Cyrex::Math;
+
+    struct Kernels {
+        decltype(&PackingKernels::FloatToHalf_Scalar)        FloatToHalf;
+        decltype(&PackingKernels::HalfToFloat_Scalar)        HalfToFloat;
+        decltype(&PackingKernels::FloatToSnorm16_Scalar)     FloatToSnorm16;
+        decltype(&PackingKernels::Snorm16ToFloat_Scalar)     Snorm16ToFloat;
+        decltype(&PackingKernels::FloatToUnorm16_Scalar)     FloatToUnorm16;
+        decltype(&PackingKernels::Unorm16ToFloat_Scalar)     Unorm16ToFloat;
+        decltype(&PackingKernels::EncodeOctahedral_Scalar)   EncodeOctahedral;
+        decltype(&PackingKernels::DecodeOctahedral_Scalar)   DecodeOctahedral;
+        decltype(&PackingKernels::PackUnorm1010102_Scalar)   PackUnorm1010102;
+        decltype(&PackingKernels::UnpackUnorm1010102_Scalar) UnpackUnorm1010102;
+    };
+
+    constexpr Kernels ScalarKernels {
+        PackingKernels::FloatToHalf_Scalar,
+        PackingKernels::HalfToFloat_Scalar,
+        PackingKernels::FloatToSnorm16_Scalar,
+        PackingKernels::Snorm16ToFloat_Scalar,
+        PackingKernels::FloatToUnorm16_Scalar,
+        PackingKernels::Unorm16ToFloat_Scalar,
+        PackingKernels::EncodeOctahedral_Scalar,
+        PackingKernels::DecodeOctahedral_Scalar,
+        PackingKernels::PackUnorm1010102_Scalar,
+        PackingKernels::UnpackUnorm1010102_Scalar
+    };
+
+#if CRX_SIMD_X86
+    constexpr Kernels SSEKernels {
+        PackingKernels::FloatToHalf_SSE,
+        PackingKernels::HalfToFloat_SSE,
+        PackingKernels::FloatToSnorm16_SSE,
+        PackingKernels::Snorm16ToFloat_SSE,
+        PackingKernels::FloatToUnorm16_SSE,
+        PackingKernels::Unorm16ToFloat_SSE,
+        PackingKernels::EncodeOctahedral_SSE,
+        PackingKernels::DecodeOctahedral_SSE,
+        PackingKernels::PackUnorm1010102_SSE,
+        PackingKernels::UnpackUnorm1010102_SSE
+    };
+
+    constexpr Kernels AVX2Kernels {
+        PackingKernels::FloatToHalf_AVX2,
+        PackingKernels::HalfToFloat_AVX2,
+        PackingKernels::FloatToSnorm16_AVX2,
+        PackingKernels::Snorm16ToFloat_AVX2,
+        PackingKernels::FloatToUnorm16_AVX2,
+        PackingKernels::Unorm16ToFloat_AVX2,
+        PackingKernels::EncodeOctahedral_AVX2,
+        PackingKernels::DecodeOctahedral_AVX2,
+        PackingKernels::PackUnorm1010102_AVX2,
+        PackingKernels::UnpackUnorm1010102_AVX2
+    };
+#endif
+
+    Kernels g_kernels = ScalarKernels;
+
+    //AVX-512 has nothing to add to conversions this narrow
+    void Rebind(IsaLevel level) noexcept {
+        switch (level) {
+#if CRX_SIMD_X86
+        case IsaLevel::AVX512:
+        case IsaLevel::AVX2:
+            g_kernels = AVX2Kernels;
+            break;
+        case IsaLevel::SSE:
+            g_kernels = SSEKernels;
+            break;
+#endif
+        default:
+            g_kernels = ScalarKernels;
+            break;
+        }
+    }
+
+    const bool g_registered = (CpuDispatch::Register(Rebind), true);
+}
+
+namespace Cyrex::Math {
+    void FloatToHalf(std::span<const float> in, std::span<uint16_t> out) noexcept        { g_kernels.FloatToHalf(in, out); }
+    void HalfToFloat(std::span<const uint16_t> in, std::span<float> out) noexcept        { g_kernels.HalfToFloat(in, out); }
+    void FloatToSnorm16(std::span<const float> in, std::span<int16_t> out) noexcept      { g_kernels.FloatToSnorm16(in, out); }
+    void Snorm16ToFloat(std::span<const int16_t> in, std::span<float> out) noexcept      { g_kernels.Snorm16ToFloat(in, out); }
+    void FloatToUnorm16(std::span<const float> in, std::span<uint16_t> out) noexcept     { g_kernels.FloatToUnorm16(in, out); }
+    void Unorm16ToFloat(std::span<const uint16_t> in, std::span<float> out) noexcept     { g_kernels.Unorm16ToFloat(in, out); }
+    void EncodeOctahedral(ConstVector3Span normals, std::span<uint32_t> out) noexcept    { g_kernels.EncodeOctahedral(normals, out); }
+    void DecodeOctahedral(std::span<const uint32_t> in, Vector3Span normals) noexcept    { g_kernels.DecodeOctahedral(in, normals); }
+
+    void PackUnorm1010102(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept {
+        g_kernels.PackUnorm1010102(xyz, w, out);
+    }
+
+    void UnpackUnorm1010102(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept {
+        g_kernels.UnpackUnorm1010102(in, xyz, w);
+    }
+}
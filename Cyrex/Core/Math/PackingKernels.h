@@ -0,0 +1,74 @@
+#pragma once
+#include "SIMD.h"
+#include "SoA.h"
+#include <cstdint>
+#include <span>
+
+namespace Cyrex::Math {
+    //Conversions between float data and the smaller formats vertex and texture data is stored in,
+    //8 values per instruction. The in and out spans have the same size. Encoding rounds to
+    //nearest even and clamps to the format's range, NaNs encode as the lowest value except in
+    //half floats, where they stay NaN. Every variant gives the scalar variant's bits, except the
+    //NaN payloads of half floats and the normalization of the octahedral decode.
+    namespace PackingKernels {
+        //IEEE binary16, values past 65504 become infinity
+        void FloatToHalf_Scalar(std::span<const float> in, std::span<uint16_t> out) noexcept;
+        void HalfToFloat_Scalar(std::span<const uint16_t> in, std::span<float> out) noexcept;
+
+        //[-1, 1] as value * 32767, decoded as max(value / 32767, -1) like D3D does
+        void FloatToSnorm16_Scalar(std::span<const float> in, std::span<int16_t> out) noexcept;
+        void Snorm16ToFloat_Scalar(std::span<const int16_t> in, std::span<float> out) noexcept;
+
+        //[0, 1] as value * 65535
+        void FloatToUnorm16_Scalar(std::span<const float> in, std::span<uint16_t> out) noexcept;
+        void Unorm16ToFloat_Scalar(std::span<const uint16_t> in, std::span<float> out) noexcept;
+
+        //Unit vectors projected onto an octahedron and unfolded into a square, stored as two
+        //SNORM16 in the layout of R16G16_SNORM. The decoded vectors are normalized and within
+        //0.005 degrees of the encoded ones.
+        void EncodeOctahedral_Scalar(ConstVector3Span normals, std::span<uint32_t> out) noexcept;
+        void DecodeOctahedral_Scalar(std::span<const uint32_t> in, Vector3Span normals) noexcept;
+
+        //R10G10B10A2_UNORM, xyz in [0, 1] from the low bits up and w in [0, 1] in the top 2 bits
+        void PackUnorm1010102_Scalar(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept;
+        void UnpackUnorm1010102_Scalar(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept;
+
+#if CRX_SIMD_X86
+        //SSE2 only, half floats are converted with integer arithmetic
+        void FloatToHalf_SSE(std::span<const float> in, std::span<uint16_t> out) noexcept;
+        void HalfToFloat_SSE(std::span<const uint16_t> in, std::span<float> out) noexcept;
+        void FloatToSnorm16_SSE(std::span<const float> in, std::span<int16_t> out) noexcept;
+        void Snorm16ToFloat_SSE(std::span<const int16_t> in, std::span<float> out) noexcept;
+        void FloatToUnorm16_SSE(std::span<const float> in, std::span<uint16_t> out) noexcept;
+        void Unorm16ToFloat_SSE(std::span<const uint16_t> in, std::span<float> out) noexcept;
+        void EncodeOctahedral_SSE(ConstVector3Span normals, std::span<uint32_t> out) noexcept;
+        void DecodeOctahedral_SSE(std::span<const uint32_t> in, Vector3Span normals) noexcept;
+        void PackUnorm1010102_SSE(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept;
+        void UnpackUnorm1010102_SSE(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept;
+
+        //Need AVX2 and F16C. The AVX-512 level uses these as well.
+        void FloatToHalf_AVX2(std::span<const float> in, std::span<uint16_t> out) noexcept;
+        void HalfToFloat_AVX2(std::span<const uint16_t> in, std::span<float> out) noexcept;
+        void FloatToSnorm16_AVX2(std::span<const float> in, std::span<int16_t> out) noexcept;
+        void Snorm16ToFloat_AVX2(std::span<const int16_t> in, std::span<float> out) noexcept;
+        void FloatToUnorm16_AVX2(std::span<const float> in, std::span<uint16_t> out) noexcept;
+        void Unorm16ToFloat_AVX2(std::span<const uint16_t> in, std::span<float> out) noexcept;
+        void EncodeOctahedral_AVX2(ConstVector3Span normals, std::span<uint32_t> out) noexcept;
+        void DecodeOctahedral_AVX2(std::span<const uint32_t> in, Vector3Span normals) noexcept;
+        void PackUnorm1010102_AVX2(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept;
+        void UnpackUnorm1010102_AVX2(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept;
+#endif
+    }
+
+    //Run the variant CpuDispatch picked for this CPU
+    void FloatToHalf(std::span<const float> in, std::span<uint16_t> out) noexcept;
+    void HalfToFloat(std::span<const uint16_t> in, std::span<float> out) noexcept;
+    void FloatToSnorm16(std::span<const float> in, std::span<int16_t> out) noexcept;
+    void Snorm16ToFloat(std::span<const int16_t> in, std::span<float> out) noexcept;
+    void FloatToUnorm16(std::span<const float> in, std::span<uint16_t> out) noexcept;
+    void Unorm16ToFloat(std::span<const uint16_t> in, std::span<float> out) noexcept;
+    void EncodeOctahedral(ConstVector3Span normals, std::span<uint32_t> out) noexcept;
+    void DecodeOctahedral(std::span<const uint32_t> in, Vector3Span normals) noexcept;
+    void PackUnorm1010102(ConstVector3Span xyz, std::span<const float> w, std::span<uint32_t> out) noexcept;
+    void UnpackUnorm1010102(std::span<const uint32_t> in, Vector3Span xyz, std::span<float> w) noexcept;
+}
@@ -2,8 +2,6 @@
 #include "Matrix.h"
 
 namespace Cyrex::Math {
-    const Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
-
     void Quaternion::FromAxes(
         const Vector3& xAxis, 
         const Vector3& yAxis, 
@@ -5,7 +5,7 @@ namespace Cyrex::Math {
     class Matrix;
     class Quaternion {
     public:
-        Quaternion() noexcept
+        constexpr Quaternion() noexcept
             :
             x(0),
             y(0),
@@ -13,14 +13,15 @@ namespace Cyrex::Math {
             w(1)
         {}
 
-        Quaternion(float x, float y, float z, float w) noexcept
+        constexpr Quaternion(float x, float y, float z, float w) noexcept
             :
             x(x),
             y(y),
             z(z),
             w(w)
         {}
-        Quaternion& operator =(const Quaternion& rhs) = default;
+        constexpr Quaternion(const Quaternion& rhs) noexcept = default;
+        constexpr Quaternion& operator =(const Quaternion& rhs) noexcept = default;
 
         ~Quaternion() = default;
 
@@ -60,7 +61,7 @@ namespace Cyrex::Math {
             return FromPitchYawRoll(Math::ToRadians(rotationY), Math::ToRadians(rotationX), Math::ToRadians(rotationZ));
         }
 
-        static inline Quaternion Multiply(const Quaternion& q1, const Quaternion& q2) noexcept {
+        static constexpr Quaternion Multiply(const Quaternion& q1, const Quaternion& q2) noexcept {
             const float x     = q1.x;
             const float y     = q1.y;
             const float z     = q1.z;
@@ -84,8 +85,8 @@ namespace Cyrex::Math {
 
         void FromAxes(const Vector3& xAxis, const Vector3& yAxis, const Vector3& zAxis) noexcept;
 
-        const auto Conjugate() const noexcept     { return Quaternion(-x, -y, -z, w); }
-        const auto SquaredLength() const noexcept { return (x * x) + (y * y) + (z * z) + (w * w); }
+        constexpr Quaternion Conjugate() const noexcept { return Quaternion(-x, -y, -z, w); }
+        constexpr float SquaredLength() const noexcept  { return (x * x) + (y * y) + (z * z) + (w * w); }
 
         Vector3 ToEulerAngles() const noexcept {
             //Order of rotations: Z, X, Y
@@ -137,7 +138,7 @@ namespace Cyrex::Math {
             }
         }
 
-        const Quaternion Inverse() const noexcept {
+        constexpr Quaternion Inverse() const noexcept {
             const auto squaredLength = SquaredLength();
 
             if (squaredLength == 1.0f) {
@@ -149,17 +150,17 @@ namespace Cyrex::Math {
             return Identity;
         }
 
-        Quaternion operator*(const Quaternion& rhs) const noexcept
+        constexpr Quaternion operator*(const Quaternion& rhs) const noexcept
         {
             return Multiply(*this, rhs);
         }
 
-        void operator*=(const Quaternion& rhs)
+        constexpr void operator*=(const Quaternion& rhs)
         {
             *this = Multiply(*this, rhs);
         }
 
-        Vector3 operator*(const Vector3& rhs) const noexcept {
+        constexpr Vector3 operator*(const Vector3& rhs) const noexcept {
             const Vector3 v(x, y, z);
             const Vector3 cross1(v.Cross(rhs));
             const Vector3 cross2(v.Cross(cross1));
@@ -167,7 +168,7 @@ namespace Cyrex::Math {
             return rhs + 2.0f * (cross1 * w + cross2);
         }
 
-        Quaternion& operator *=(float rhs) noexcept {
+        constexpr Quaternion& operator *=(float rhs) noexcept {
             x *= rhs;
             y *= rhs;
             z *= rhs;
@@ -176,13 +177,13 @@ namespace Cyrex::Math {
             return *this;
         }
 
-        Quaternion operator *(float rhs) const noexcept { return Quaternion(x * rhs, y * rhs, z * rhs, w * rhs); }
+        constexpr Quaternion operator *(float rhs) const noexcept { return Quaternion(x * rhs, y * rhs, z * rhs, w * rhs); }
 
-        bool operator ==(const Quaternion& rhs) const noexcept {
+        constexpr bool operator ==(const Quaternion& rhs) const noexcept {
             return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w;
         }
 
-        bool operator!=(const Quaternion& rhs) const noexcept { return !(*this == rhs); }
+        constexpr bool operator!=(const Quaternion& rhs) const noexcept { return !(*this == rhs); }
 
         // Test for equality using epsilon
         bool Equals(const Quaternion& rhs) const noexcept
@@ -203,6 +204,8 @@ namespace Cyrex::Math {
         static const Quaternion Identity;
     };
 
-    inline Vector3 operator*(const Vector3& lhs, const Quaternion& rhs) noexcept { return rhs * lhs; }
-    inline Quaternion operator*(float lhs, const Quaternion& rhs) noexcept  { return rhs * lhs; }
+    constexpr Vector3 operator*(const Vector3& lhs, const Quaternion& rhs) noexcept { return rhs * lhs; }
+    constexpr Quaternion operator*(float lhs, const Quaternion& rhs) noexcept  { return rhs * lhs; }
+
+    inline constexpr Quaternion Quaternion::Identity(0.0f, 0.0f, 0.0f, 1.0f);
 }
\ No newline at end of file
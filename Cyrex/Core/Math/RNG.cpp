@@ -0,0 +1,414 @@
+#include "RNG.h"
+#include "Math.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Cyrex::Math::RngKernels {
+    namespace {
+        constexpr size_t Lanes = RngState::Lanes;
+
+        constexpr uint32_t Rotl(uint32_t x, int k) noexcept { return (x << k) | (x >> (32 - k)); }
+
+        //xoshiro128++ by Blackman and Vigna
+        inline uint32_t Next(uint32_t& s0, uint32_t& s1, uint32_t& s2, uint32_t& s3) noexcept {
+            const uint32_t result = Rotl(s0 + s3, 7) + s0;
+            const uint32_t t      = s1 << 9;
+
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3  = Rotl(s3, 11);
+
+            return result;
+        }
+
+        template<typename T, typename Convert>
+        void NextBlocks(RngState& state, T* out, size_t blocks, Convert convert) noexcept {
+            for (size_t lane = 0; lane < Lanes; ++lane) {
+                uint32_t s0 = state.S[0][lane];
+                uint32_t s1 = state.S[1][lane];
+                uint32_t s2 = state.S[2][lane];
+                uint32_t s3 = state.S[3][lane];
+
+                for (size_t block = 0; block < blocks; ++block) {
+                    out[block * Lanes + lane] = convert(Next(s0, s1, s2, s3));
+                }
+
+                state.S[0][lane] = s0;
+                state.S[1][lane] = s1;
+                state.S[2][lane] = s2;
+                state.S[3][lane] = s3;
+            }
+        }
+    }
+
+    void NextUInts_Scalar(RngState& state, uint32_t* out, size_t blocks) noexcept {
+        NextBlocks(state, out, blocks, [](uint32_t value) { return value; });
+    }
+
+    void NextFloats_Scalar(RngState& state, float* out, size_t blocks) noexcept {
+        NextBlocks(state, out, blocks, [](uint32_t value) { return static_cast<float>(value >> 8) * 0x1p-24f; });
+    }
+
+#if CRX_SIMD_X86
+    //Each group of lanes keeps its state in registers for all blocks, the stores of a group are
+    //one block apart
+    namespace {
+        template<int K>
+        __m128i Rotl_SSE(__m128i x) noexcept {
+            return _mm_or_si128(_mm_slli_epi32(x, K), _mm_srli_epi32(x, 32 - K));
+        }
+
+        template<typename Store>
+        void NextBlocks_SSE(RngState& state, size_t blocks, Store store) noexcept {
+            for (size_t lane = 0; lane < Lanes; lane += 4) {
+                __m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(state.S[0] + lane));
+                __m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(state.S[1] + lane));
+                __m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(state.S[2] + lane));
+                __m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(state.S[3] + lane));
+
+                for (size_t block = 0; block < blocks; ++block) {
+                    const __m128i result = _mm_add_epi32(Rotl_SSE<7>(_mm_add_epi32(s0, s3)), s0);
+                    const __m128i t      = _mm_slli_epi32(s1, 9);
+
+                    s2 = _mm_xor_si128(s2, s0);
+                    s3 = _mm_xor_si128(s3, s1);
+                    s1 = _mm_xor_si128(s1, s2);
+                    s0 = _mm_xor_si128(s0, s3);
+                    s2 = _mm_xor_si128(s2, t);
+                    s3 = Rotl_SSE<11>(s3);
+
+                    store(block * Lanes + lane, result);
+                }
+
+                _mm_store_si128(reinterpret_cast<__m128i*>(state.S[0] + lane), s0);
+                _mm_store_si128(reinterpret_cast<__m128i*>(state.S[1] + lane), s1);
+                _mm_store_si128(reinterpret_cast<__m128i*>(state.S[2] + lane), s2);
+                _mm_store_si128(reinterpret_cast<__m128i*>(state.S[3] + lane), s3);
+            }
+        }
+    }
+
+    void NextUInts_SSE(RngState& state, uint32_t* out, size_t blocks) noexcept {
+        NextBlocks_SSE(state, blocks, [out](size_t index, __m128i value) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + index), value);
+        });
+    }
+
+    void NextFloats_SSE(RngState& state, float* out, size_t blocks) noexcept {
+        const __m128 scale = _mm_set1_ps(0x1p-24f);
+
+        NextBlocks_SSE(state, blocks, [out, scale](size_t index, __m128i value) {
+            _mm_storeu_ps(out + index, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(value, 8)), scale));
+        });
+    }
+
+    namespace {
+        template<int K>
+        CRX_TARGET_AVX2 __m256i Rotl_AVX2(__m256i x) noexcept {
+            return _mm256_or_si256(_mm256_slli_epi32(x, K), _mm256_srli_epi32(x, 32 - K));
+        }
+
+        template<typename Store>
+        CRX_TARGET_AVX2 void NextBlocks_AVX2(RngState& state, size_t blocks, Store store) noexcept {
+            for (size_t lane = 0; lane < Lanes; lane += 8) {
+                __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.S[0] + lane));
+                __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.S[1] + lane));
+                __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.S[2] + lane));
+                __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.S[3] + lane));
+
+                for (size_t block = 0; block < blocks; ++block) {
+                    const __m256i result = _mm256_add_epi32(Rotl_AVX2<7>(_mm256_add_epi32(s0, s3)), s0);
+                    const __m256i t      = _mm256_slli_epi32(s1, 9);
+
+                    s2 = _mm256_xor_si256(s2, s0);
+                    s3 = _mm256_xor_si256(s3, s1);
+                    s1 = _mm256_xor_si256(s1, s2);
+                    s0 = _mm256_xor_si256(s0, s3);
+                    s2 = _mm256_xor_si256(s2, t);
+                    s3 = Rotl_AVX2<11>(s3);
+
+                    store(block * Lanes + lane, result);
+                }
+
+                _mm256_store_si256(reinterpret_cast<__m256i*>(state.S[0] + lane), s0);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(state.S[1] + lane), s1);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(state.S[2] + lane), s2);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(state.S[3] + lane), s3);
+            }
+        }
+    }
+
+    CRX_TARGET_AVX2 void NextUInts_AVX2(RngState& state, uint32_t* out, size_t blocks) noexcept {
+        NextBlocks_AVX2(state, blocks, [out](size_t index, __m256i value) CRX_TARGET_AVX2 {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + index), value);
+        });
+    }
+
+    CRX_TARGET_AVX2 void NextFloats_AVX2(RngState& state, float* out, size_t blocks) noexcept {
+        const __m256 scale = _mm256_set1_ps(0x1p-24f);
+
+        NextBlocks_AVX2(state, blocks, [out, scale](size_t index, __m256i value) CRX_TARGET_AVX2 {
+            _mm256_storeu_ps(out + index, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(value, 8)), scale));
+        });
+    }
+
+    namespace {
+        //One register holds all 16 lanes
+        template<typename Store>
+        CRX_TARGET_AVX512 void NextBlocks_AVX512(RngState& state, size_t blocks, Store store) noexcept {
+            __m512i s0 = _mm512_load_si512(state.S[0]);
+            __m512i s1 = _mm512_load_si512(state.S[1]);
+            __m512i s2 = _mm512_load_si512(state.S[2]);
+            __m512i s3 = _mm512_load_si512(state.S[3]);
+
+            for (size_t block = 0; block < blocks; ++block) {
+                const __m512i result = _mm512_add_epi32(_mm512_rol_epi32(_mm512_add_epi32(s0, s3), 7), s0);
+                const __m512i t      = _mm512_slli_epi32(s1, 9);
+
+                s2 = _mm512_xor_si512(s2, s0);
+                s3 = _mm512_xor_si512(s3, s1);
+                s1 = _mm512_xor_si512(s1, s2);
+                s0 = _mm512_xor_si512(s0, s3);
+                s2 = _mm512_xor_si512(s2, t);
+                s3 = _mm512_rol_epi32(s3, 11);
+
+                store(block * Lanes, result);
+            }
+
+            _mm512_store_si512(state.S[0], s0);
+            _mm512_store_si512(state.S[1], s1);
+            _mm512_store_si512(state.S[2], s2);
+            _mm512_store_si512(state.S[3], s3);
+        }
+    }
+
+    CRX_TARGET_AVX512 void NextUInts_AVX512(RngState& state, uint32_t* out, size_t blocks) noexcept {
+        NextBlocks_AVX512(state, blocks, [out](size_t index, __m512i value) CRX_TARGET_AVX512 {
+            _mm512_storeu_si512(out + index, value);
+        });
+    }
+
+    CRX_TARGET_AVX512 void NextFloats_AVX512(RngState& state, float* out, size_t blocks) noexcept {
+        const __m512 scale = _mm512_set1_ps(0x1p-24f);
+
+        NextBlocks_AVX512(state, blocks, [out, scale](size_t index, __m512i value) CRX_TARGET_AVX512 {
+            _mm512_storeu_ps(out + index, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(value, 8)), scale));
+        });
+    }
+#endif
+}
+
+namespace {
+    using namespace Cyrex;
+    using namespace Cyrex::Math;
+
+    using UIntKernel  = void(*)(RngState& state, uint32_t* out, size_t blocks) noexcept;
+    using FloatKernel = void(*)(RngState& state, float* out, size_t blocks) noexcept;
+
+    UIntKernel  g_nextUInts  = RngKernels::NextUInts_Scalar;
+    FloatKernel g_nextFloats = RngKernels::NextFloats_Scalar;
+
+    void Rebind(IsaLevel level) noexcept {
+        using namespace RngKernels;
+
+        switch (level) {
+#if CRX_SIMD_X86
+        case IsaLevel::AVX512:
+            g_nextUInts  = NextUInts_AVX512;
+            g_nextFloats = NextFloats_AVX512;
+            break;
+        case IsaLevel::AVX2:
+            g_nextUInts  = NextUInts_AVX2;
+            g_nextFloats = NextFloats_AVX2;
+            break;
+        case IsaLevel::SSE:
+            g_nextUInts  = NextUInts_SSE;
+            g_nextFloats = NextFloats_SSE;
+            break;
+#endif
+        default:
+            g_nextUInts  = NextUInts_Scalar;
+            g_nextFloats = NextFloats_Scalar;
+            break;
+        }
+    }
+
+    const bool g_registered = (CpuDispatch::Register(Rebind), true);
+
+    constexpr uint64_t SplitMix64(uint64_t& x) noexcept {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    //Unit sphere from two uniform numbers, z uniform in [-1, 1] gives uniform area
+    Vector3 SphereFromUniform(float u, float v) noexcept {
+        const float z   = 1.0f - 2.0f * u;
+        const float r   = std::sqrt(std::max(0.0f, 1.0f - z * z));
+        const float phi = MathConstants::PI_MUL2 * v;
+
+        return Vector3(r * std::cos(phi), r * std::sin(phi), z);
+    }
+
+    //The square root keeps the area density uniform
+    Vector2 DiskFromUniform(float u, float v) noexcept {
+        const float r     = std::sqrt(u);
+        const float theta = MathConstants::PI_MUL2 * v;
+
+        return Vector2(r * std::cos(theta), r * std::sin(theta));
+    }
+}
+
+namespace Cyrex::Math {
+    void Rng::Seed(uint64_t seed, uint64_t stream) noexcept {
+        uint64_t x = seed;
+        x = SplitMix64(x) ^ stream;
+
+        for (size_t lane = 0; lane < RngState::Lanes; ++lane) {
+            for (size_t word = 0; word < 4; word += 2) {
+                const uint64_t bits = SplitMix64(x);
+
+                m_state.S[word][lane]     = static_cast<uint32_t>(bits);
+                m_state.S[word + 1][lane] = static_cast<uint32_t>(bits >> 32);
+            }
+
+            //xoshiro never leaves the all zero state
+            if ((m_state.S[0][lane] | m_state.S[1][lane] | m_state.S[2][lane] | m_state.S[3][lane]) == 0) [[unlikely]] {
+                m_state.S[0][lane] = 1;
+            }
+        }
+
+        m_next = RngState::Lanes;
+    }
+
+    Rng& Rng::ThreadLocal() noexcept {
+        thread_local Rng rng(
+            (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}());
+        return rng;
+    }
+
+    void Rng::Refill() noexcept {
+        g_nextUInts(m_state, m_buffer, 1);
+        m_next = 0;
+    }
+
+    //Hands out what is left of the buffer first, so the fills continue the single draw sequence
+    template<typename T>
+    size_t Rng::Drain(T* out, size_t count) noexcept {
+        const auto drained = std::min<size_t>(count, RngState::Lanes - m_next);
+
+        for (size_t i = 0; i < drained; ++i) {
+            if constexpr (std::same_as<T, float>) {
+                out[i] = ToFloat(m_buffer[m_next++]);
+            }
+            else {
+                out[i] = m_buffer[m_next++];
+            }
+        }
+        return drained;
+    }
+
+    void Rng::Fill(std::span<uint32_t> out) noexcept {
+        auto done = Drain(out.data(), out.size());
+
+        const auto blocks = (out.size() - done) / RngState::Lanes;
+        g_nextUInts(m_state, out.data() + done, blocks);
+        done += blocks * RngState::Lanes;
+
+        if (done < out.size()) {
+            Refill();
+            Drain(out.data() + done, out.size() - done);
+        }
+    }
+
+    void Rng::Fill(std::span<float> out) noexcept {
+        auto done = Drain(out.data(), out.size());
+
+        const auto blocks = (out.size() - done) / RngState::Lanes;
+        g_nextFloats(m_state, out.data() + done, blocks);
+        done += blocks * RngState::Lanes;
+
+        if (done < out.size()) {
+            Refill();
+            Drain(out.data() + done, out.size() - done);
+        }
+    }
+
+    void Rng::Fill(std::span<float> out, float low, float high) noexcept {
+        Fill(out);
+
+        const float range = high - low;
+
+        for (auto& value : out) {
+            value = low + value * range;
+        }
+    }
+
+    void Rng::Fill(std::span<int32_t> out, int32_t low, int32_t high) noexcept {
+        //The signed and unsigned types may alias
+        Fill(std::span<uint32_t>(reinterpret_cast<uint32_t*>(out.data()), out.size()));
+
+        const auto rangeSize = RangeSize(low, high);
+
+        for (auto& value : out) {
+            value = static_cast<int32_t>(MapToRange(static_cast<uint32_t>(value), low, rangeSize));
+        }
+    }
+
+    Vector3 Rng::OnUnitSphere() noexcept {
+        const float u = NextFloat();
+        const float v = NextFloat();
+
+        return SphereFromUniform(u, v);
+    }
+
+    Vector3 Rng::OnHemisphere(const Vector3& normal) noexcept {
+        const auto point = OnUnitSphere();
+        return Vector3::Dot(point, normal) < 0.0f ? point * -1.0f : point;
+    }
+
+    Vector2 Rng::InUnitDisk() noexcept {
+        const float u = NextFloat();
+        const float v = NextFloat();
+
+        return DiskFromUniform(u, v);
+    }
+
+    void Rng::FillOnUnitSphere(Vector3Span out) noexcept {
+        Fill(std::span<float>(out.X, out.Count));
+        Fill(std::span<float>(out.Y, out.Count));
+
+        for (size_t i = 0; i < out.Count; ++i) {
+            out.Set(i, SphereFromUniform(out.X[i], out.Y[i]));
+        }
+    }
+
+    void Rng::FillOnHemisphere(Vector3Span out, const Vector3& normal) noexcept {
+        FillOnUnitSphere(out);
+
+        for (size_t i = 0; i < out.Count; ++i) {
+            const auto point = out.Get(i);
+
+            if (Vector3::Dot(point, normal) < 0.0f) {
+                out.Set(i, point * -1.0f);
+            }
+        }
+    }
+
+    void Rng::FillInUnitDisk(std::span<float> outX, std::span<float> outY) noexcept {
+        Fill(outX);
+        Fill(outY);
+
+        for (size_t i = 0; i < outX.size(); ++i) {
+            const auto point = DiskFromUniform(outX[i], outY[i]);
+
+            outX[i] = point.x;
+            outY[i] = point.y;
+        }
+    }
+}
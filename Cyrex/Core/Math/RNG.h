@@ -1,34 +1,151 @@
 #pragma once
-#include <random>
+#include "SIMD.h"
+#include "SoA.h"
+#include "Vector2.h"
+#include "Vector3.h"
 #include <concepts>
-#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
 
 namespace Cyrex::Math {
+    //16 xoshiro128++ generators side by side, one per SIMD lane of the widest kernel. Step n of
+    //lane i is value 16 * n + i of the stream, so every kernel produces the same sequence.
+    struct RngState {
+        static constexpr size_t Lanes = 16;
+
+        alignas(64) uint32_t S[4][Lanes];
+    };
+
+    //Each call advances every lane by blocks steps and writes blocks * 16 values. Floats are the
+    //top 24 bits scaled to [0, 1), which is exact, so the float kernels match bit for bit too.
+    namespace RngKernels {
+        void NextUInts_Scalar(RngState& state, uint32_t* out, size_t blocks) noexcept;
+        void NextFloats_Scalar(RngState& state, float* out, size_t blocks) noexcept;
+
+#if CRX_SIMD_X86
+        void NextUInts_SSE(RngState& state, uint32_t* out, size_t blocks) noexcept;
+        void NextFloats_SSE(RngState& state, float* out, size_t blocks) noexcept;
+
+        //Need AVX2
+        void NextUInts_AVX2(RngState& state, uint32_t* out, size_t blocks) noexcept;
+        void NextFloats_AVX2(RngState& state, float* out, size_t blocks) noexcept;
+
+        //Need AVX-512F
+        void NextUInts_AVX512(RngState& state, uint32_t* out, size_t blocks) noexcept;
+        void NextFloats_AVX512(RngState& state, float* out, size_t blocks) noexcept;
+#endif
+    }
+
+    //Not thread safe, give every thread its own generator or use ThreadLocal. A seed and a stream
+    //fully determine the sequence, and the batch fills return the same values as the single draws
+    //would, so a replay only has to record the seeds.
     class Rng {
     public:
+        using result_type = uint32_t;
+
+        explicit Rng(uint64_t seed, uint64_t stream = 0) noexcept { Seed(seed, stream); }
+
+        //Streams of one seed are independent, e.g. one per job of a frame
+        void Seed(uint64_t seed, uint64_t stream = 0) noexcept;
+
+        //Seeded once per thread from std::random_device, reseed it for a deterministic run
+        [[nodiscard]] static Rng& ThreadLocal() noexcept;
+
+        [[nodiscard]] uint32_t NextUInt() noexcept {
+            if (m_next == RngState::Lanes) [[unlikely]] {
+                Refill();
+            }
+            return m_buffer[m_next++];
+        }
+
+        //[0, 1)
+        [[nodiscard]] float NextFloat() noexcept { return ToFloat(NextUInt()); }
+        [[nodiscard]] double NextDouble() noexcept {
+            const uint64_t high = NextUInt() >> 5;
+            const uint64_t low  = NextUInt() >> 6;
+            return static_cast<double>((high << 26) | low) * 0x1p-53;
+        }
+
+        //[low, high]. Up to 32 bits the range is mapped with a multiply and a shift, biased by
+        //less than range / 2^32, which is what the batch fill does too.
         template<typename T>
         requires std::integral<T>
-        [[nodiscard]] static constexpr inline auto Random(T low, T high) noexcept {
-            std::default_random_engine engine{ std::random_device{}() };
-
-            //This should never happen but we will support it anyway
-            if (high < low) [[unlikely]] {
-                std::swap(low, high);
+        [[nodiscard]] T Range(T low, T high) noexcept {
+            if constexpr (sizeof(T) <= sizeof(uint32_t)) {
+                return static_cast<T>(MapToRange(NextUInt(), low, RangeSize(low, high)));
+            }
+            else {
+                return std::uniform_int_distribution<T>{ low, high }(*this);
             }
+        }
 
-            return std::uniform_int_distribution<T>{ low, high}(engine);
+        //[low, high)
+        template<typename T>
+        requires std::floating_point<T>
+        [[nodiscard]] T Range(T low, T high) noexcept {
+            if constexpr (std::same_as<T, float>) {
+                return low + NextFloat() * (high - low);
+            }
+            else {
+                return low + static_cast<T>(NextDouble()) * (high - low);
+            }
         }
 
+        [[nodiscard]] Vector3 OnUnitSphere() noexcept;
+        //On the half of the unit sphere the normal points into
+        [[nodiscard]] Vector3 OnHemisphere(const Vector3& normal) noexcept;
+        [[nodiscard]] Vector2 InUnitDisk() noexcept;
+
+        void Fill(std::span<uint32_t> out) noexcept;
+        void Fill(std::span<float> out) noexcept;
+        void Fill(std::span<float> out, float low, float high) noexcept;
+        void Fill(std::span<int32_t> out, int32_t low, int32_t high) noexcept;
+
+        //Uniformly distributed, but not in the order the single draws would give
+        void FillOnUnitSphere(Vector3Span out) noexcept;
+        void FillOnHemisphere(Vector3Span out, const Vector3& normal) noexcept;
+        void FillInUnitDisk(std::span<float> outX, std::span<float> outY) noexcept;
+
+        //UniformRandomBitGenerator, for the standard distributions
+        [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+        [[nodiscard]] static constexpr result_type max() noexcept { return UINT32_MAX; }
+        result_type operator()() noexcept { return NextUInt(); }
+
+        //Kept for the existing callers, draws from the calling thread's generator
         template<typename T>
-        requires std::floating_point<T> 
-        [[nodiscard]] static constexpr inline auto Random(T low, T high) noexcept {
-            std::default_random_engine engine{ std::random_device{}() };
- 
+        requires std::integral<T> || std::floating_point<T>
+        [[nodiscard]] static T Random(T low, T high) noexcept {
             //This should never happen but we will support it anyway
             if (high < low) [[unlikely]] {
                 std::swap(low, high);
             }
-            return std::uniform_real_distribution<T>{ low, high}(engine);
+            return ThreadLocal().Range(low, high);
         }
+    private:
+        [[nodiscard]] static constexpr float ToFloat(uint32_t value) noexcept {
+            return static_cast<float>(value >> 8) * 0x1p-24f;
+        }
+
+        //Up to 2^32, which needs the 64 bits
+        template<typename T>
+        [[nodiscard]] static constexpr uint64_t RangeSize(T low, T high) noexcept {
+            return static_cast<uint64_t>(static_cast<int64_t>(high) - static_cast<int64_t>(low)) + 1;
+        }
+
+        template<typename T>
+        [[nodiscard]] static constexpr int64_t MapToRange(uint32_t value, T low, uint64_t rangeSize) noexcept {
+            return static_cast<int64_t>(low) + static_cast<int64_t>((value * rangeSize) >> 32);
+        }
+
+        void Refill() noexcept;
+        template<typename T>
+        size_t Drain(T* out, size_t count) noexcept;
+
+        RngState m_state;
+        alignas(64) uint32_t m_buffer[RngState::Lanes];
+        uint32_t m_next = RngState::Lanes;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CRX_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define CRX_SIMD_X86 0
+#endif
+
+//Compiles a single function for an instruction set above the baseline, so kernels for
+//several instruction sets can live in one binary. MSVC allows the intrinsics anywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define CRX_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CRX_TARGET(isa)
+#endif
+
+#define CRX_ISA_AVX2 "avx2,fma,f16c"
+#define CRX_ISA_AVX512 "avx512f,avx2,fma,f16c"
+
+#define CRX_TARGET_AVX2 CRX_TARGET(CRX_ISA_AVX2)
+#define CRX_TARGET_AVX512 CRX_TARGET(CRX_ISA_AVX512)
+
+//Compiles every function between the two, templates instantiated there included, for an
+//instruction set. Only for translation units holding a single variant, anything with external
+//linkage defined in between must not be defined anywhere else or the linker may pick it for
+//every caller.
+#define CRX_PRAGMA(text) _Pragma(#text)
+
+#if defined(__clang__)
+#define CRX_TARGET_BEGIN(isa) CRX_PRAGMA(clang attribute push(__attribute__((target(isa))), apply_to = function))
+#define CRX_TARGET_END CRX_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+#define CRX_TARGET_BEGIN(isa) CRX_PRAGMA(GCC push_options) CRX_PRAGMA(GCC target(isa))
+#define CRX_TARGET_END CRX_PRAGMA(GCC pop_options)
+#else
+#define CRX_TARGET_BEGIN(isa)
+#define CRX_TARGET_END
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+#include "Vector3.h"
+#include <cstddef>
+#include <vector>
+
+//Structure of arrays layouts for the batch kernels. One load fills a SIMD register with
+//the same component of consecutive vectors, so no shuffles are needed.
+namespace Cyrex::Math {
+    struct Vector3Span {
+        float* X;
+        float* Y;
+        float* Z;
+        size_t Count;
+
+        void Set(size_t index, const Vector3& vec3) noexcept {
+            X[index] = vec3.x;
+            Y[index] = vec3.y;
+            Z[index] = vec3.z;
+        }
+        [[nodiscard]] Vector3 Get(size_t index) const noexcept { return Vector3(X[index], Y[index], Z[index]); }
+    };
+
+    struct ConstVector3Span {
+        ConstVector3Span(const float* x, const float* y, const float* z, size_t count) noexcept
+            :
+            X(x), Y(y), Z(z), Count(count)
+        {}
+        ConstVector3Span(const Vector3Span& span) noexcept
+            :
+            X(span.X), Y(span.Y), Z(span.Z), Count(span.Count)
+        {}
+
+        [[nodiscard]] Vector3 Get(size_t index) const noexcept { return Vector3(X[index], Y[index], Z[index]); }
+
+        const float* X;
+        const float* Y;
+        const float* Z;
+        size_t Count;
+    };
+
+    class Vector3SoA {
+    public:
+        Vector3SoA() = default;
+        explicit Vector3SoA(size_t count) { Resize(count); }
+
+        void Resize(size_t count) {
+            m_x.resize(count);
+            m_y.resize(count);
+            m_z.resize(count);
+        }
+
+        void Set(size_t index, const Vector3& vec3) noexcept { GetSpan().Set(index, vec3); }
+        [[nodiscard]] Vector3 Get(size_t index) const noexcept { return GetConstSpan().Get(index); }
+
+        [[nodiscard]] size_t Size() const noexcept { return m_x.size(); }
+
+        [[nodiscard]] Vector3Span GetSpan() noexcept { return { m_x.data(), m_y.data(), m_z.data(), m_x.size() }; }
+        [[nodiscard]] ConstVector3Span GetConstSpan() const noexcept { return { m_x.data(), m_y.data(), m_z.data(), m_x.size() }; }
+
+        operator Vector3Span() noexcept { return GetSpan(); }
+        operator ConstVector3Span() const noexcept { return GetConstSpan(); }
+    private:
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_z;
+    };
+}
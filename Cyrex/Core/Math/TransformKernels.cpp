@@ -0,0 +1,433 @@
+#include "TransformKernels.h"
+#include "Matrix.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include <cmath>
+
+namespace Cyrex::Math::TransformKernels {
+    namespace {
+        //A perspective divide by w == 1 changes nothing, so affine matrices skip it
+        bool IsAffine(const Matrix& matrix) noexcept {
+            return matrix.m03 == 0.0f && matrix.m13 == 0.0f && matrix.m23 == 0.0f && matrix.m33 == 1.0f;
+        }
+
+        //Same operation order as Vector3::TransformCoord, also used for the tails of the SIMD kernels
+        void TransformCoords(const Matrix& m, ConstVector3Span in, Vector3Span out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.Count; ++i) {
+                const float x = in.X[i];
+                const float y = in.Y[i];
+                const float z = in.Z[i];
+
+                const float w = x * m.m03 + y * m.m13 + z * m.m23 + m.m33;
+
+                out.X[i] = (x * m.m00 + (y * m.m10 + (z * m.m20 + m.m30))) / w;
+                out.Y[i] = (x * m.m01 + (y * m.m11 + (z * m.m21 + m.m31))) / w;
+                out.Z[i] = (x * m.m02 + (y * m.m12 + (z * m.m22 + m.m32))) / w;
+            }
+        }
+
+        void TransformNormals(const Matrix& m, ConstVector3Span in, Vector3Span out, size_t begin) noexcept {
+            for (size_t i = begin; i < in.Count; ++i) {
+                const float x = in.X[i];
+                const float y = in.Y[i];
+                const float z = in.Z[i];
+
+                out.X[i] = x * m.m00 + (y * m.m10 + z * m.m20);
+                out.Y[i] = x * m.m01 + (y * m.m11 + z * m.m21);
+                out.Z[i] = x * m.m02 + (y * m.m12 + z * m.m22);
+            }
+        }
+
+        void TransformBounds(
+            const Matrix& m,
+            ConstVector3Span centers,
+            ConstVector3Span extents,
+            Vector3Span outCenters,
+            Vector3Span outExtents,
+            size_t begin) noexcept
+        {
+            for (size_t i = begin; i < centers.Count; ++i) {
+                const float cx = centers.X[i];
+                const float cy = centers.Y[i];
+                const float cz = centers.Z[i];
+
+                const float ex = extents.X[i];
+                const float ey = extents.Y[i];
+                const float ez = extents.Z[i];
+
+                outCenters.X[i] = cx * m.m00 + (cy * m.m10 + (cz * m.m20 + m.m30));
+                outCenters.Y[i] = cx * m.m01 + (cy * m.m11 + (cz * m.m21 + m.m31));
+                outCenters.Z[i] = cx * m.m02 + (cy * m.m12 + (cz * m.m22 + m.m32));
+
+                //Every corner is center +- extents, the farthest one along an axis takes the
+                //absolute value of each term
+                outExtents.X[i] = ex * std::abs(m.m00) + (ey * std::abs(m.m10) + ez * std::abs(m.m20));
+                outExtents.Y[i] = ex * std::abs(m.m01) + (ey * std::abs(m.m11) + ez * std::abs(m.m21));
+                outExtents.Z[i] = ex * std::abs(m.m02) + (ey * std::abs(m.m12) + ez * std::abs(m.m22));
+            }
+        }
+    }
+
+    void TransformCoords_Scalar(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept {
+        TransformCoords(matrix, in, out, 0);
+    }
+
+    void TransformNormals_Scalar(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept {
+        TransformNormals(matrix, in, out, 0);
+    }
+
+    void TransformBounds_Scalar(
+        const Matrix& matrix,
+        ConstVector3Span centers,
+        ConstVector3Span extents,
+        Vector3Span outCenters,
+        Vector3Span outExtents) noexcept
+    {
+        TransformBounds(matrix, centers, extents, outCenters, outExtents, 0);
+    }
+
+#if CRX_SIMD_X86
+    void TransformCoords_SSE(const Matrix& m, ConstVector3Span in, Vector3Span out) noexcept {
+        const bool isAffine = IsAffine(m);
+
+        const __m128 m00 = _mm_set1_ps(m.m00), m01 = _mm_set1_ps(m.m01), m02 = _mm_set1_ps(m.m02), m03 = _mm_set1_ps(m.m03);
+        const __m128 m10 = _mm_set1_ps(m.m10), m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12), m13 = _mm_set1_ps(m.m13);
+        const __m128 m20 = _mm_set1_ps(m.m20), m21 = _mm_set1_ps(m.m21), m22 = _mm_set1_ps(m.m22), m23 = _mm_set1_ps(m.m23);
+        const __m128 m30 = _mm_set1_ps(m.m30), m31 = _mm_set1_ps(m.m31), m32 = _mm_set1_ps(m.m32), m33 = _mm_set1_ps(m.m33);
+
+        size_t i = 0;
+
+        for (; i + 4 <= in.Count; i += 4) {
+            const __m128 x = _mm_loadu_ps(in.X + i);
+            const __m128 y = _mm_loadu_ps(in.Y + i);
+            const __m128 z = _mm_loadu_ps(in.Z + i);
+
+            __m128 rx = _mm_add_ps(_mm_mul_ps(x, m00), _mm_add_ps(_mm_mul_ps(y, m10), _mm_add_ps(_mm_mul_ps(z, m20), m30)));
+            __m128 ry = _mm_add_ps(_mm_mul_ps(x, m01), _mm_add_ps(_mm_mul_ps(y, m11), _mm_add_ps(_mm_mul_ps(z, m21), m31)));
+            __m128 rz = _mm_add_ps(_mm_mul_ps(x, m02), _mm_add_ps(_mm_mul_ps(y, m12), _mm_add_ps(_mm_mul_ps(z, m22), m32)));
+
+            if (!isAffine) {
+                const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m03), _mm_mul_ps(y, m13)), _mm_mul_ps(z, m23)), m33);
+
+                rx = _mm_div_ps(rx, w);
+                ry = _mm_div_ps(ry, w);
+                rz = _mm_div_ps(rz, w);
+            }
+
+            _mm_storeu_ps(out.X + i, rx);
+            _mm_storeu_ps(out.Y + i, ry);
+            _mm_storeu_ps(out.Z + i, rz);
+        }
+
+        TransformCoords(m, in, out, i);
+    }
+
+    void TransformNormals_SSE(const Matrix& m, ConstVector3Span in, Vector3Span out) noexcept {
+        const __m128 m00 = _mm_set1_ps(m.m00), m01 = _mm_set1_ps(m.m01), m02 = _mm_set1_ps(m.m02);
+        const __m128 m10 = _mm_set1_ps(m.m10), m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12);
+        const __m128 m20 = _mm_set1_ps(m.m20), m21 = _mm_set1_ps(m.m21), m22 = _mm_set1_ps(m.m22);
+
+        size_t i = 0;
+
+        for (; i + 4 <= in.Count; i += 4) {
+            const __m128 x = _mm_loadu_ps(in.X + i);
+            const __m128 y = _mm_loadu_ps(in.Y + i);
+            const __m128 z = _mm_loadu_ps(in.Z + i);
+
+            _mm_storeu_ps(out.X + i, _mm_add_ps(_mm_mul_ps(x, m00), _mm_add_ps(_mm_mul_ps(y, m10), _mm_mul_ps(z, m20))));
+            _mm_storeu_ps(out.Y + i, _mm_add_ps(_mm_mul_ps(x, m01), _mm_add_ps(_mm_mul_ps(y, m11), _mm_mul_ps(z, m21))));
+            _mm_storeu_ps(out.Z + i, _mm_add_ps(_mm_mul_ps(x, m02), _mm_add_ps(_mm_mul_ps(y, m12), _mm_mul_ps(z, m22))));
+        }
+
+        TransformNormals(m, in, out, i);
+    }
+
+    void TransformBounds_SSE(
+        const Matrix& m,
+        ConstVector3Span centers,
+        ConstVector3Span extents,
+        Vector3Span outCenters,
+        Vector3Span outExtents) noexcept
+    {
+        const __m128 m00 = _mm_set1_ps(m.m00), m01 = _mm_set1_ps(m.m01), m02 = _mm_set1_ps(m.m02);
+        const __m128 m10 = _mm_set1_ps(m.m10), m11 = _mm_set1_ps(m.m11), m12 = _mm_set1_ps(m.m12);
+        const __m128 m20 = _mm_set1_ps(m.m20), m21 = _mm_set1_ps(m.m21), m22 = _mm_set1_ps(m.m22);
+        const __m128 m30 = _mm_set1_ps(m.m30), m31 = _mm_set1_ps(m.m31), m32 = _mm_set1_ps(m.m32);
+
+        const __m128 a00 = _mm_set1_ps(std::abs(m.m00)), a01 = _mm_set1_ps(std::abs(m.m01)), a02 = _mm_set1_ps(std::abs(m.m02));
+        const __m128 a10 = _mm_set1_ps(std::abs(m.m10)), a11 = _mm_set1_ps(std::abs(m.m11)), a12 = _mm_set1_ps(std::abs(m.m12));
+        const __m128 a20 = _mm_set1_ps(std::abs(m.m20)), a21 = _mm_set1_ps(std::abs(m.m21)), a22 = _mm_set1_ps(std::abs(m.m22));
+
+        size_t i = 0;
+
+        for (; i + 4 <= centers.Count; i += 4) {
+            const __m128 cx = _mm_loadu_ps(centers.X + i);
+            const __m128 cy = _mm_loadu_ps(centers.Y + i);
+            const __m128 cz = _mm_loadu_ps(centers.Z + i);
+
+            const __m128 ex = _mm_loadu_ps(extents.X + i);
+            const __m128 ey = _mm_loadu_ps(extents.Y + i);
+            const __m128 ez = _mm_loadu_ps(extents.Z + i);
+
+            _mm_storeu_ps(outCenters.X + i, _mm_add_ps(_mm_mul_ps(cx, m00), _mm_add_ps(_mm_mul_ps(cy, m10), _mm_add_ps(_mm_mul_ps(cz, m20), m30))));
+            _mm_storeu_ps(outCenters.Y + i, _mm_add_ps(_mm_mul_ps(cx, m01), _mm_add_ps(_mm_mul_ps(cy, m11), _mm_add_ps(_mm_mul_ps(cz, m21), m31))));
+            _mm_storeu_ps(outCenters.Z + i, _mm_add_ps(_mm_mul_ps(cx, m02), _mm_add_ps(_mm_mul_ps(cy, m12), _mm_add_ps(_mm_mul_ps(cz, m22), m32))));
+
+            _mm_storeu_ps(outExtents.X + i, _mm_add_ps(_mm_mul_ps(ex, a00), _mm_add_ps(_mm_mul_ps(ey, a10), _mm_mul_ps(ez, a20))));
+            _mm_storeu_ps(outExtents.Y + i, _mm_add_ps(_mm_mul_ps(ex, a01), _mm_add_ps(_mm_mul_ps(ey, a11), _mm_mul_ps(ez, a21))));
+            _mm_storeu_ps(outExtents.Z + i, _mm_add_ps(_mm_mul_ps(ex, a02), _mm_add_ps(_mm_mul_ps(ey, a12), _mm_mul_ps(ez, a22))));
+        }
+
+        TransformBounds(m, centers, extents, outCenters, outExtents, i);
+    }
+
+    CRX_TARGET_AVX2 void TransformCoords_AVX2(const Matrix& m, ConstVector3Span in, Vector3Span out) noexcept {
+        const bool isAffine = IsAffine(m);
+
+        const __m256 m00 = _mm256_set1_ps(m.m00), m01 = _mm256_set1_ps(m.m01), m02 = _mm256_set1_ps(m.m02), m03 = _mm256_set1_ps(m.m03);
+        const __m256 m10 = _mm256_set1_ps(m.m10), m11 = _mm256_set1_ps(m.m11), m12 = _mm256_set1_ps(m.m12), m13 = _mm256_set1_ps(m.m13);
+        const __m256 m20 = _mm256_set1_ps(m.m20), m21 = _mm256_set1_ps(m.m21), m22 = _mm256_set1_ps(m.m22), m23 = _mm256_set1_ps(m.m23);
+        const __m256 m30 = _mm256_set1_ps(m.m30), m31 = _mm256_set1_ps(m.m31), m32 = _mm256_set1_ps(m.m32), m33 = _mm256_set1_ps(m.m33);
+
+        size_t i = 0;
+
+        for (; i + 8 <= in.Count; i += 8) {
+            const __m256 x = _mm256_loadu_ps(in.X + i);
+            const __m256 y = _mm256_loadu_ps(in.Y + i);
+            const __m256 z = _mm256_loadu_ps(in.Z + i);
+
+            __m256 rx = _mm256_fmadd_ps(x, m00, _mm256_fmadd_ps(y, m10, _mm256_fmadd_ps(z, m20, m30)));
+            __m256 ry = _mm256_fmadd_ps(x, m01, _mm256_fmadd_ps(y, m11, _mm256_fmadd_ps(z, m21, m31)));
+            __m256 rz = _mm256_fmadd_ps(x, m02, _mm256_fmadd_ps(y, m12, _mm256_fmadd_ps(z, m22, m32)));
+
+            if (!isAffine) {
+                const __m256 w = _mm256_fmadd_ps(x, m03, _mm256_fmadd_ps(y, m13, _mm256_fmadd_ps(z, m23, m33)));
+
+                rx = _mm256_div_ps(rx, w);
+                ry = _mm256_div_ps(ry, w);
+                rz = _mm256_div_ps(rz, w);
+            }
+
+            _mm256_storeu_ps(out.X + i, rx);
+            _mm256_storeu_ps(out.Y + i, ry);
+            _mm256_storeu_ps(out.Z + i, rz);
+        }
+
+        TransformCoords(m, in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void TransformNormals_AVX2(const Matrix& m, ConstVector3Span in, Vector3Span out) noexcept {
+        const __m256 m00 = _mm256_set1_ps(m.m00), m01 = _mm256_set1_ps(m.m01), m02 = _mm256_set1_ps(m.m02);
+        const __m256 m10 = _mm256_set1_ps(m.m10), m11 = _mm256_set1_ps(m.m11), m12 = _mm256_set1_ps(m.m12);
+        const __m256 m20 = _mm256_set1_ps(m.m20), m21 = _mm256_set1_ps(m.m21), m22 = _mm256_set1_ps(m.m22);
+
+        size_t i = 0;
+
+        for (; i + 8 <= in.Count; i += 8) {
+            const __m256 x = _mm256_loadu_ps(in.X + i);
+            const __m256 y = _mm256_loadu_ps(in.Y + i);
+            const __m256 z = _mm256_loadu_ps(in.Z + i);
+
+            _mm256_storeu_ps(out.X + i, _mm256_fmadd_ps(x, m00, _mm256_fmadd_ps(y, m10, _mm256_mul_ps(z, m20))));
+            _mm256_storeu_ps(out.Y + i, _mm256_fmadd_ps(x, m01, _mm256_fmadd_ps(y, m11, _mm256_mul_ps(z, m21))));
+            _mm256_storeu_ps(out.Z + i, _mm256_fmadd_ps(x, m02, _mm256_fmadd_ps(y, m12, _mm256_mul_ps(z, m22))));
+        }
+
+        TransformNormals(m, in, out, i);
+    }
+
+    CRX_TARGET_AVX2 void TransformBounds_AVX2(
+        const Matrix& m,
+        ConstVector3Span centers,
+        ConstVector3Span extents,
+        Vector3Span outCenters,
+        Vector3Span outExtents) noexcept
+    {
+        const __m256 m00 = _mm256_set1_ps(m.m00), m01 = _mm256_set1_ps(m.m01), m02 = _mm256_set1_ps(m.m02);
+        const __m256 m10 = _mm256_set1_ps(m.m10), m11 = _mm256_set1_ps(m.m11), m12 = _mm256_set1_ps(m.m12);
+        const __m256 m20 = _mm256_set1_ps(m.m20), m21 = _mm256_set1_ps(m.m21), m22 = _mm256_set1_ps(m.m22);
+        const __m256 m30 = _mm256_set1_ps(m.m30), m31 = _mm256_set1_ps(m.m31), m32 = _mm256_set1_ps(m.m32);
+
+        const __m256 a00 = _mm256_set1_ps(std::abs(m.m00)), a01 = _mm256_set1_ps(std::abs(m.m01)), a02 = _mm256_set1_ps(std::abs(m.m02));
+        const __m256 a10 = _mm256_set1_ps(std::abs(m.m10)), a11 = _mm256_set1_ps(std::abs(m.m11)), a12 = _mm256_set1_ps(std::abs(m.m12));
+        const __m256 a20 = _mm256_set1_ps(std::abs(m.m20)), a21 = _mm256_set1_ps(std::abs(m.m21)), a22 = _mm256_set1_ps(std::abs(m.m22));
+
+        size_t i = 0;
+
+        for (; i + 8 <= centers.Count; i += 8) {
+            const __m256 cx = _mm256_loadu_ps(centers.X + i);
+            const __m256 cy = _mm256_loadu_ps(centers.Y + i);
+            const __m256 cz = _mm256_loadu_ps(centers.Z + i);
+
+            const __m256 ex = _mm256_loadu_ps(extents.X + i);
+            const __m256 ey = _mm256_loadu_ps(extents.Y + i);
+            const __m256 ez = _mm256_loadu_ps(extents.Z + i);
+
+            _mm256_storeu_ps(outCenters.X + i, _mm256_fmadd_ps(cx, m00, _mm256_fmadd_ps(cy, m10, _mm256_fmadd_ps(cz, m20, m30))));
+            _mm256_storeu_ps(outCenters.Y + i, _mm256_fmadd_ps(cx, m01, _mm256_fmadd_ps(cy, m11, _mm256_fmadd_ps(cz, m21, m31))));
+            _mm256_storeu_ps(outCenters.Z + i, _mm256_fmadd_ps(cx, m02, _mm256_fmadd_ps(cy, m12, _mm256_fmadd_ps(cz, m22, m32))));
+
+            _mm256_storeu_ps(outExtents.X + i, _mm256_fmadd_ps(ex, a00, _mm256_fmadd_ps(ey, a10, _mm256_mul_ps(ez, a20))));
+            _mm256_storeu_ps(outExtents.Y + i, _mm256_fmadd_ps(ex, a01, _mm256_fmadd_ps(ey, a11, _mm256_mul_ps(ez, a21))));
+            _mm256_storeu_ps(outExtents.Z + i, _mm256_fmadd_ps(ex, a02, _mm256_fmadd_ps(ey, a12, _mm256_mul_ps(ez, a22))));
+        }
+
+        TransformBounds(m, centers, extents, outCenters, outExtents, i);
+    }
+
+    //The tail is handled with masked loads and stores instead of the scalar loop
+    CRX_TARGET_AVX512 void TransformCoords_AVX512(const Matrix& m, ConstVector3Span in, Vector3Span out) noexcept {
+        const bool isAffine = IsAffine(m);
+
+        const __m512 m00 = _mm512_set1_ps(m.m00), m01 = _mm512_set1_ps(m.m01), m02 = _mm512_set1_ps(m.m02), m03 = _mm512_set1_ps(m.m03);
+        const __m512 m10 = _mm512_set1_ps(m.m10), m11 = _mm512_set1_ps(m.m11), m12 = _mm512_set1_ps(m.m12), m13 = _mm512_set1_ps(m.m13);
+        const __m512 m20 = _mm512_set1_ps(m.m20), m21 = _mm512_set1_ps(m.m21), m22 = _mm512_set1_ps(m.m22), m23 = _mm512_set1_ps(m.m23);
+        const __m512 m30 = _mm512_set1_ps(m.m30), m31 = _mm512_set1_ps(m.m31), m32 = _mm512_set1_ps(m.m32), m33 = _mm512_set1_ps(m.m33);
+
+        for (size_t i = 0; i < in.Count; i += 16) {
+            const auto remaining = in.Count - i;
+            const __mmask16 mask = remaining >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << remaining) - 1);
+
+            const __m512 x = _mm512_maskz_loadu_ps(mask, in.X + i);
+            const __m512 y = _mm512_maskz_loadu_ps(mask, in.Y + i);
+            const __m512 z = _mm512_maskz_loadu_ps(mask, in.Z + i);
+
+            __m512 rx = _mm512_fmadd_ps(x, m00, _mm512_fmadd_ps(y, m10, _mm512_fmadd_ps(z, m20, m30)));
+            __m512 ry = _mm512_fmadd_ps(x, m01, _mm512_fmadd_ps(y, m11, _mm512_fmadd_ps(z, m21, m31)));
+            __m512 rz = _mm512_fmadd_ps(x, m02, _mm512_fmadd_ps(y, m12, _mm512_fmadd_ps(z, m22, m32)));
+
+            if (!isAffine) {
+                const __m512 w = _mm512_fmadd_ps(x, m03, _mm512_fmadd_ps(y, m13, _mm512_fmadd_ps(z, m23, m33)));
+
+                rx = _mm512_div_ps(rx, w);
+                ry = _mm512_div_ps(ry, w);
+                rz = _mm512_div_ps(rz, w);
+            }
+
+            _mm512_mask_storeu_ps(out.X + i, mask, rx);
+            _mm512_mask_storeu_ps(out.Y + i, mask, ry);
+            _mm512_mask_storeu_ps(out.Z + i, mask, rz);
+        }
+    }
+
+    CRX_TARGET_AVX512 void TransformNormals_AVX512(const Matrix& m, ConstVector3Span in, Vector3Span out) noexcept {
+        const __m512 m00 = _mm512_set1_ps(m.m00), m01 = _mm512_set1_ps(m.m01), m02 = _mm512_set1_ps(m.m02);
+        const __m512 m10 = _mm512_set1_ps(m.m10), m11 = _mm512_set1_ps(m.m11), m12 = _mm512_set1_ps(m.m12);
+        const __m512 m20 = _mm512_set1_ps(m.m20), m21 = _mm512_set1_ps(m.m21), m22 = _mm512_set1_ps(m.m22);
+
+        for (size_t i = 0; i < in.Count; i += 16) {
+            const auto remaining = in.Count - i;
+            const __mmask16 mask = remaining >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << remaining) - 1);
+
+            const __m512 x = _mm512_maskz_loadu_ps(mask, in.X + i);
+            const __m512 y = _mm512_maskz_loadu_ps(mask, in.Y + i);
+            const __m512 z = _mm512_maskz_loadu_ps(mask, in.Z + i);
+
+            _mm512_mask_storeu_ps(out.X + i, mask, _mm512_fmadd_ps(x, m00, _mm512_fmadd_ps(y, m10, _mm512_mul_ps(z, m20))));
+            _mm512_mask_storeu_ps(out.Y + i, mask, _mm512_fmadd_ps(x, m01, _mm512_fmadd_ps(y, m11, _mm512_mul_ps(z, m21))));
+            _mm512_mask_storeu_ps(out.Z + i, mask, _mm512_fmadd_ps(x, m02, _mm512_fmadd_ps(y, m12, _mm512_mul_ps(z, m22))));
+        }
+    }
+
+    CRX_TARGET_AVX512 void TransformBounds_AVX512(
+        const Matrix& m,
+        ConstVector3Span centers,
+        ConstVector3Span extents,
+        Vector3Span outCenters,
+        Vector3Span outExtents) noexcept
+    {
+        const __m512 m00 = _mm512_set1_ps(m.m00), m01 = _mm512_set1_ps(m.m01), m02 = _mm512_set1_ps(m.m02);
+        const __m512 m10 = _mm512_set1_ps(m.m10), m11 = _mm512_set1_ps(m.m11), m12 = _mm512_set1_ps(m.m12);
+        const __m512 m20 = _mm512_set1_ps(m.m20), m21 = _mm512_set1_ps(m.m21), m22 = _mm512_set1_ps(m.m22);
+        const __m512 m30 = _mm512_set1_ps(m.m30), m31 = _mm512_set1_ps(m.m31), m32 = _mm512_set1_ps(m.m32);
+
+        const __m512 a00 = _mm512_set1_ps(std::abs(m.m00)), a01 = _mm512_set1_ps(std::abs(m.m01)), a02 = _mm512_set1_ps(std::abs(m.m02));
+        const __m512 a10 = _mm512_set1_ps(std::abs(m.m10)), a11 = _mm512_set1_ps(std::abs(m.m11)), a12 = _mm512_set1_ps(std::abs(m.m12));
+        const __m512 a20 = _mm512_set1_ps(std::abs(m.m20)), a21 = _mm512_set1_ps(std::abs(m.m21)), a22 = _mm512_set1_ps(std::abs(m.m22));
+
+        for (size_t i = 0; i < centers.Count; i += 16) {
+            const auto remaining = centers.Count - i;
+            const __mmask16 mask = remaining >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << remaining) - 1);
+
+            const __m512 cx = _mm512_maskz_loadu_ps(mask, centers.X + i);
+            const __m512 cy = _mm512_maskz_loadu_ps(mask, centers.Y + i);
+            const __m512 cz = _mm512_maskz_loadu_ps(mask, centers.Z + i);
+
+            const __m512 ex = _mm512_maskz_loadu_ps(mask, extents.X + i);
+            const __m512 ey = _mm512_maskz_loadu_ps(mask, extents.Y + i);
+            const __m512 ez = _mm512_maskz_loadu_ps(mask, extents.Z + i);
+
+            _mm512_mask_storeu_ps(outCenters.X + i, mask, _mm512_fmadd_ps(cx, m00, _mm512_fmadd_ps(cy, m10, _mm512_fmadd_ps(cz, m20, m30))));
+            _mm512_mask_storeu_ps(outCenters.Y + i, mask, _mm512_fmadd_ps(cx, m01, _mm512_fmadd_ps(cy, m11, _mm512_fmadd_ps(cz, m21, m31))));
+            _mm512_mask_storeu_ps(outCenters.Z + i, mask, _mm512_fmadd_ps(cx, m02, _mm512_fmadd_ps(cy, m12, _mm512_fmadd_ps(cz, m22, m32))));
+
+            _mm512_mask_storeu_ps(outExtents.X + i, mask, _mm512_fmadd_ps(ex, a00, _mm512_fmadd_ps(ey, a10, _mm512_mul_ps(ez, a20))));
+            _mm512_mask_storeu_ps(outExtents.Y + i, mask, _mm512_fmadd_ps(ex, a01, _mm512_fmadd_ps(ey, a11, _mm512_mul_ps(ez, a21))));
+            _mm512_mask_storeu_ps(outExtents.Z + i, mask, _mm512_fmadd_ps(ex, a02, _mm512_fmadd_ps(ey, a12, _mm512_mul_ps(ez, a22))));
+        }
+    }
+#endif
+}
+
+namespace {
+    using namespace Cyrex;
+    using namespace Cyrex::Math;
+
+    using VectorKernel = void(*)(const Matrix&, ConstVector3Span, Vector3Span) noexcept;
+    using BoundsKernel = void(*)(const Matrix&, ConstVector3Span, ConstVector3Span, Vector3Span, Vector3Span) noexcept;
+
+    VectorKernel g_transformCoords  = TransformKernels::TransformCoords_Scalar;
+    VectorKernel g_transformNormals = TransformKernels::TransformNormals_Scalar;
+    BoundsKernel g_transformBounds  = TransformKernels::TransformBounds_Scalar;
+
+    void Rebind(IsaLevel level) noexcept {
+        using namespace TransformKernels;
+
+        switch (level) {
+#if CRX_SIMD_X86
+        case IsaLevel::AVX512:
+            g_transformCoords  = TransformCoords_AVX512;
+            g_transformNormals = TransformNormals_AVX512;
+            g_transformBounds  = TransformBounds_AVX512;
+            break;
+        case IsaLevel::AVX2:
+            g_transformCoords  = TransformCoords_AVX2;
+            g_transformNormals = TransformNormals_AVX2;
+            g_transformBounds  = TransformBounds_AVX2;
+            break;
+        case IsaLevel::SSE:
+            g_transformCoords  = TransformCoords_SSE;
+            g_transformNormals = TransformNormals_SSE;
+            g_transformBounds  = TransformBounds_SSE;
+            break;
+#endif
+        default:
+            g_transformCoords  = TransformCoords_Scalar;
+            g_transformNormals = TransformNormals_Scalar;
+            g_transformBounds  = TransformBounds_Scalar;
+            break;
+        }
+    }
+
+    //Binds the kernels before main, callers during static initialization get the scalar ones
+    const bool g_registered = (CpuDispatch::Register(Rebind), true);
+}
+
+namespace Cyrex::Math {
+    void TransformCoords(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept {
+        g_transformCoords(matrix, in, out);
+    }
+
+    void TransformNormals(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept {
+        g_transformNormals(matrix, in, out);
+    }
+
+    void TransformBounds(
+        const Matrix& matrix,
+        ConstVector3Span centers,
+        ConstVector3Span extents,
+        Vector3Span outCenters,
+        Vector3Span outExtents) noexcept
+    {
+        g_transformBounds(matrix, centers, extents, outCenters, outExtents);
+    }
+}
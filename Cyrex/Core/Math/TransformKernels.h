@@ -0,0 +1,64 @@
+#pragma once
+#include "SIMD.h"
+#include "SoA.h"
+
+namespace Cyrex::Math {
+    class Matrix;
+
+    //Batch versions of Vector3::TransformCoord and Vector3::TransformNormal over structure of
+    //arrays data, 4, 8 or 16 vectors per instruction. Boxes are transformed as center and
+    //extents, which gives the bounds of the 8 transformed corners without transforming them.
+    //The output may be the input span, but must not partially overlap it.
+    namespace TransformKernels {
+        void TransformCoords_Scalar(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        void TransformNormals_Scalar(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        //The matrix has to be affine
+        void TransformBounds_Scalar(
+            const Matrix& matrix,
+            ConstVector3Span centers,
+            ConstVector3Span extents,
+            Vector3Span outCenters,
+            Vector3Span outExtents) noexcept;
+
+#if CRX_SIMD_X86
+        void TransformCoords_SSE(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        void TransformNormals_SSE(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        void TransformBounds_SSE(
+            const Matrix& matrix,
+            ConstVector3Span centers,
+            ConstVector3Span extents,
+            Vector3Span outCenters,
+            Vector3Span outExtents) noexcept;
+
+        //Need AVX2 and FMA
+        void TransformCoords_AVX2(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        void TransformNormals_AVX2(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        void TransformBounds_AVX2(
+            const Matrix& matrix,
+            ConstVector3Span centers,
+            ConstVector3Span extents,
+            Vector3Span outCenters,
+            Vector3Span outExtents) noexcept;
+
+        //Need AVX-512F
+        void TransformCoords_AVX512(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        void TransformNormals_AVX512(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+        void TransformBounds_AVX512(
+            const Matrix& matrix,
+            ConstVector3Span centers,
+            ConstVector3Span extents,
+            Vector3Span outCenters,
+            Vector3Span outExtents) noexcept;
+#endif
+    }
+
+    //Run the variant CpuDispatch picked for this CPU
+    void TransformCoords(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+    void TransformNormals(const Matrix& matrix, ConstVector3Span in, Vector3Span out) noexcept;
+    void TransformBounds(
+        const Matrix& matrix,
+        ConstVector3Span centers,
+        ConstVector3Span extents,
+        Vector3Span outCenters,
+        Vector3Span outExtents) noexcept;
+}
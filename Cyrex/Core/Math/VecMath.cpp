@@ -0,0 +1,148 @@
+#include "VecMath.h"
+#include "Core/InstructionSet/CpuDispatch.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+namespace {
+    //A batch of one, the fallback and the reference for the other instruction sets
+    struct ScalarBatch {
+        using Float  = float;
+        using Int    = int32_t;
+        using Mask   = bool;
+        using Double = double;
+        using Bits   = uint64_t;
+
+        static constexpr size_t Width  = 1;
+        static constexpr size_t Halves = 1;
+
+        static Float Set(float value) noexcept { return value; }
+        static Float Load(const float* p) noexcept { return *p; }
+        static void Store(float* p, Float x) noexcept { *p = x; }
+
+        static Float Add(Float a, Float b) noexcept { return a + b; }
+        static Float Sub(Float a, Float b) noexcept { return a - b; }
+        static Float Mul(Float a, Float b) noexcept { return a * b; }
+        static Float Div(Float a, Float b) noexcept { return a / b; }
+        static Float MulAdd(Float a, Float b, Float c) noexcept { return a * b + c; }
+        static Float Sqrt(Float x) noexcept { return std::sqrt(x); }
+        static Float Min(Float a, Float b) noexcept { return a < b ? a : b; }
+        static Float Max(Float a, Float b) noexcept { return a > b ? a : b; }
+        static Float Abs(Float x) noexcept { return std::abs(x); }
+        static Float RsqrtEstimate(Float x) noexcept { return 1.0f / std::sqrt(x); }
+
+        //Like cvtps2dq, out of range gives INT32_MIN
+        static Int ToInt(Float x) noexcept {
+            return std::abs(x) < 2147483520.0f ? static_cast<Int>(std::lrint(x)) : std::numeric_limits<Int>::min();
+        }
+
+        static Float ToFloat(Int x) noexcept { return static_cast<Float>(x); }
+        static Int AsInt(Float x) noexcept { return std::bit_cast<Int>(x); }
+        static Float AsFloat(Int x) noexcept { return std::bit_cast<Float>(x); }
+
+        static Mask Equal(Float a, Float b) noexcept { return a == b; }
+        static Mask Less(Float a, Float b) noexcept { return a < b; }
+        static Mask Greater(Float a, Float b) noexcept { return a > b; }
+        static Mask GreaterEqual(Float a, Float b) noexcept { return a >= b; }
+        static Mask IsNaN(Float x) noexcept { return x != x; }
+        static Mask IsNegative(Float x) noexcept { return std::signbit(x); }
+        static Mask And(Mask a, Mask b) noexcept { return a && b; }
+        static Mask Or(Mask a, Mask b) noexcept { return a || b; }
+        static Mask AndNot(Mask a, Mask b) noexcept { return !a && b; }
+        static Float Select(Mask mask, Float a, Float b) noexcept { return mask ? a : b; }
+
+        static Int SetInt(int32_t value) noexcept { return value; }
+        static Int Add32(Int a, Int b) noexcept { return static_cast<Int>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b)); }
+        static Int Sub32(Int a, Int b) noexcept { return static_cast<Int>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b)); }
+        static Int And32(Int a, Int b) noexcept { return a & b; }
+        static Int Or32(Int a, Int b) noexcept { return a | b; }
+        static Int Xor32(Int a, Int b) noexcept { return a ^ b; }
+        static Int ShiftLeft32(Int x, int count) noexcept { return static_cast<Int>(static_cast<uint32_t>(x) << count); }
+        static Int ShiftRightArith32(Int x, int count) noexcept { return x >> count; }
+        static Mask EqualInt(Int a, Int b) noexcept { return a == b; }
+        static Int Select32(Mask mask, Int a, Int b) noexcept { return mask ? a : b; }
+
+        static void Widen(Float x, Double (&halves)[Halves]) noexcept { halves[0] = x; }
+        static Float Narrow(const Double (&halves)[Halves]) noexcept { return static_cast<Float>(halves[0]); }
+
+        static Double SetDouble(double value) noexcept { return value; }
+        static Double Add(Double a, Double b) noexcept { return a + b; }
+        static Double Sub(Double a, Double b) noexcept { return a - b; }
+        static Double Mul(Double a, Double b) noexcept { return a * b; }
+        static Double Div(Double a, Double b) noexcept { return a / b; }
+        static Double MulAdd(Double a, Double b, Double c) noexcept { return a * b + c; }
+        static Double Sqrt(Double x) noexcept { return std::sqrt(x); }
+        static Double Min(Double a, Double b) noexcept { return a < b ? a : b; }
+        static Double Max(Double a, Double b) noexcept { return a > b ? a : b; }
+
+        static Bits AsBits(Double x) noexcept { return std::bit_cast<Bits>(x); }
+        static Double AsDouble(Bits x) noexcept { return std::bit_cast<Double>(x); }
+        static Bits SetBits(uint64_t value) noexcept { return value; }
+        static Bits Add64(Bits a, Bits b) noexcept { return a + b; }
+        static Bits Sub64(Bits a, Bits b) noexcept { return a - b; }
+        static Bits Or64(Bits a, Bits b) noexcept { return a | b; }
+        static Bits ShiftLeft64(Bits x, int count) noexcept { return x << count; }
+        static Bits ShiftRight64(Bits x, int count) noexcept { return x >> count; }
+    };
+}
+
+#include "VecMathAlgorithms.h"
+
+namespace Cyrex::Math::VecKernels {
+    constinit const Table Scalar = VecAlgorithms::MakeTable<ScalarBatch>();
+}
+
+namespace {
+    using namespace Cyrex;
+    using namespace Cyrex::Math;
+
+    const VecKernels::Table* g_kernels = &VecKernels::Scalar;
+
+    void Rebind(IsaLevel level) noexcept {
+        switch (level) {
+#if CRX_SIMD_X86
+        case IsaLevel::AVX512:
+            g_kernels = &VecKernels::AVX512;
+            break;
+        case IsaLevel::AVX2:
+            g_kernels = &VecKernels::AVX2;
+            break;
+        case IsaLevel::SSE:
+            g_kernels = &VecKernels::SSE;
+            break;
+#endif
+        default:
+            g_kernels = &VecKernels::Scalar;
+            break;
+        }
+    }
+
+    const bool g_registered = (CpuDispatch::Register(Rebind), true);
+}
+
+namespace Cyrex::Math::Vec {
+    void Sin(std::span<const float> in, std::span<float> out) noexcept      { g_kernels->Sin(in, out); }
+    void SinFast(std::span<const float> in, std::span<float> out) noexcept  { g_kernels->SinFast(in, out); }
+    void Cos(std::span<const float> in, std::span<float> out) noexcept      { g_kernels->Cos(in, out); }
+    void CosFast(std::span<const float> in, std::span<float> out) noexcept  { g_kernels->CosFast(in, out); }
+
+    void SinCos(std::span<const float> in, std::span<float> sin, std::span<float> cos) noexcept     { g_kernels->SinCos(in, sin, cos); }
+    void SinCosFast(std::span<const float> in, std::span<float> sin, std::span<float> cos) noexcept { g_kernels->SinCosFast(in, sin, cos); }
+
+    void Exp(std::span<const float> in, std::span<float> out) noexcept      { g_kernels->Exp(in, out); }
+    void ExpFast(std::span<const float> in, std::span<float> out) noexcept  { g_kernels->ExpFast(in, out); }
+    void Log(std::span<const float> in, std::span<float> out) noexcept      { g_kernels->Log(in, out); }
+    void LogFast(std::span<const float> in, std::span<float> out) noexcept  { g_kernels->LogFast(in, out); }
+
+    void Pow(std::span<const float> x, std::span<const float> y, std::span<float> out) noexcept       { g_kernels->Pow(x, y, out); }
+    void PowFast(std::span<const float> x, std::span<const float> y, std::span<float> out) noexcept   { g_kernels->PowFast(x, y, out); }
+    void Atan2(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept     { g_kernels->Atan2(y, x, out); }
+    void Atan2Fast(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept { g_kernels->Atan2Fast(y, x, out); }
+
+    void Rsqrt(std::span<const float> in, std::span<float> out) noexcept     { g_kernels->Rsqrt(in, out); }
+    void RsqrtFast(std::span<const float> in, std::span<float> out) noexcept { g_kernels->RsqrtFast(in, out); }
+}
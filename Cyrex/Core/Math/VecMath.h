@@ -0,0 +1,83 @@
+#pragma once
+#include "SIMD.h"
+#include <span>
+
+namespace Cyrex::Math {
+    //Transcendental functions over spans of floats, 4, 8 or 16 values per instruction. The out
+    //span has the size of the in spans and may be one of them.
+    //
+    //The precise variants work in double precision and are within 1 ULP of the exact result
+    //everywhere, except Sin, Cos and SinCos past |x| = 2^24 where the argument reduction runs
+    //out of bits. The fast variants stay in single precision, their errors are listed with them.
+    //Every variant follows the C library for NaN, infinity and signed zero unless noted.
+    namespace Vec {
+        //Fast: 2 ULP for |x| <= 8192 as long as the result is above 2^-12, 1e-7 absolute otherwise.
+        //Past 8192 the results stay in [-1, 1] but lose accuracy.
+        void Sin(std::span<const float> in, std::span<float> out) noexcept;
+        void SinFast(std::span<const float> in, std::span<float> out) noexcept;
+        void Cos(std::span<const float> in, std::span<float> out) noexcept;
+        void CosFast(std::span<const float> in, std::span<float> out) noexcept;
+        void SinCos(std::span<const float> in, std::span<float> sin, std::span<float> cos) noexcept;
+        void SinCosFast(std::span<const float> in, std::span<float> sin, std::span<float> cos) noexcept;
+
+        //Fast: 1 ULP
+        void Exp(std::span<const float> in, std::span<float> out) noexcept;
+        void ExpFast(std::span<const float> in, std::span<float> out) noexcept;
+
+        //Fast: 1 ULP
+        void Log(std::span<const float> in, std::span<float> out) noexcept;
+        void LogFast(std::span<const float> in, std::span<float> out) noexcept;
+
+        //Fast: exp(y * log(x)) in single precision, the error grows with the size of the
+        //result's exponent, up to 2 + 2 * |y * log(x)| ULP. Negative bases give NaN.
+        void Pow(std::span<const float> x, std::span<const float> y, std::span<float> out) noexcept;
+        void PowFast(std::span<const float> x, std::span<const float> y, std::span<float> out) noexcept;
+
+        //Fast: 3 ULP
+        void Atan2(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept;
+        void Atan2Fast(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept;
+
+        //Fast: a refined estimate, 4 ULP, subnormals count as zero
+        void Rsqrt(std::span<const float> in, std::span<float> out) noexcept;
+        void RsqrtFast(std::span<const float> in, std::span<float> out) noexcept;
+    }
+
+    //Every variant of the functions in Vec. They stay within the same error bounds, but may
+    //differ from each other by an ULP where FMA is used.
+    namespace VecKernels {
+        using Unary  = void(*)(std::span<const float> in, std::span<float> out) noexcept;
+        using Binary = void(*)(std::span<const float> a, std::span<const float> b, std::span<float> out) noexcept;
+        using Dual   = void(*)(std::span<const float> in, std::span<float> a, std::span<float> b) noexcept;
+
+        struct Table {
+            Unary Sin;
+            Unary SinFast;
+            Unary Cos;
+            Unary CosFast;
+            Dual SinCos;
+            Dual SinCosFast;
+            Unary Exp;
+            Unary ExpFast;
+            Unary Log;
+            Unary LogFast;
+            Binary Pow;
+            Binary PowFast;
+            Binary Atan2;
+            Binary Atan2Fast;
+            Unary Rsqrt;
+            Unary RsqrtFast;
+        };
+
+        extern const Table Scalar;
+
+#if CRX_SIMD_X86
+        extern const Table SSE;
+
+        //Need AVX2 and FMA
+        extern const Table AVX2;
+
+        //Need AVX-512F
+        extern const Table AVX512;
+#endif
+    }
+}
@@ -0,0 +1,102 @@
+#include "VecMath.h"
+
+#if CRX_SIMD_X86
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+CRX_TARGET_BEGIN(CRX_ISA_AVX2)
+
+namespace {
+    struct AVX2Batch {
+        using Float  = __m256;
+        using Int    = __m256i;
+        using Mask   = __m256;
+        using Double = __m256d;
+        using Bits   = __m256i;
+
+        static constexpr size_t Width  = 8;
+        static constexpr size_t Halves = 2;
+
+        static Float Set(float value) noexcept { return _mm256_set1_ps(value); }
+        static Float Load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+        static void Store(float* p, Float x) noexcept { _mm256_storeu_ps(p, x); }
+
+        static Float Add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+        static Float Sub(Float a, Float b) noexcept { return _mm256_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+        static Float Div(Float a, Float b) noexcept { return _mm256_div_ps(a, b); }
+        static Float MulAdd(Float a, Float b, Float c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+        static Float Sqrt(Float x) noexcept { return _mm256_sqrt_ps(x); }
+        static Float Min(Float a, Float b) noexcept { return _mm256_min_ps(a, b); }
+        static Float Max(Float a, Float b) noexcept { return _mm256_max_ps(a, b); }
+        static Float Abs(Float x) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x); }
+        static Float RsqrtEstimate(Float x) noexcept { return _mm256_rsqrt_ps(x); }
+
+        static Int ToInt(Float x) noexcept { return _mm256_cvtps_epi32(x); }
+        static Float ToFloat(Int x) noexcept { return _mm256_cvtepi32_ps(x); }
+        static Int AsInt(Float x) noexcept { return _mm256_castps_si256(x); }
+        static Float AsFloat(Int x) noexcept { return _mm256_castsi256_ps(x); }
+
+        static Mask Equal(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        static Mask Less(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static Mask Greater(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static Mask GreaterEqual(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static Mask IsNaN(Float x) noexcept { return _mm256_cmp_ps(x, x, _CMP_UNORD_Q); }
+        static Mask IsNegative(Float x) noexcept { return _mm256_castsi256_ps(_mm256_srai_epi32(_mm256_castps_si256(x), 31)); }
+        static Mask And(Mask a, Mask b) noexcept { return _mm256_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) noexcept { return _mm256_or_ps(a, b); }
+        static Mask AndNot(Mask a, Mask b) noexcept { return _mm256_andnot_ps(a, b); }
+        static Float Select(Mask mask, Float a, Float b) noexcept { return _mm256_blendv_ps(b, a, mask); }
+
+        static Int SetInt(int32_t value) noexcept { return _mm256_set1_epi32(value); }
+        static Int Add32(Int a, Int b) noexcept { return _mm256_add_epi32(a, b); }
+        static Int Sub32(Int a, Int b) noexcept { return _mm256_sub_epi32(a, b); }
+        static Int And32(Int a, Int b) noexcept { return _mm256_and_si256(a, b); }
+        static Int Or32(Int a, Int b) noexcept { return _mm256_or_si256(a, b); }
+        static Int Xor32(Int a, Int b) noexcept { return _mm256_xor_si256(a, b); }
+        static Int ShiftLeft32(Int x, int count) noexcept { return _mm256_slli_epi32(x, count); }
+        static Int ShiftRightArith32(Int x, int count) noexcept { return _mm256_srai_epi32(x, count); }
+        static Mask EqualInt(Int a, Int b) noexcept { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+        static Int Select32(Mask mask, Int a, Int b) noexcept { return _mm256_blendv_epi8(b, a, _mm256_castps_si256(mask)); }
+
+        static void Widen(Float x, Double (&halves)[Halves]) noexcept {
+            halves[0] = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+            halves[1] = _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1));
+        }
+
+        static Float Narrow(const Double (&halves)[Halves]) noexcept {
+            return _mm256_set_m128(_mm256_cvtpd_ps(halves[1]), _mm256_cvtpd_ps(halves[0]));
+        }
+
+        static Double SetDouble(double value) noexcept { return _mm256_set1_pd(value); }
+        static Double Add(Double a, Double b) noexcept { return _mm256_add_pd(a, b); }
+        static Double Sub(Double a, Double b) noexcept { return _mm256_sub_pd(a, b); }
+        static Double Mul(Double a, Double b) noexcept { return _mm256_mul_pd(a, b); }
+        static Double Div(Double a, Double b) noexcept { return _mm256_div_pd(a, b); }
+        static Double MulAdd(Double a, Double b, Double c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+        static Double Sqrt(Double x) noexcept { return _mm256_sqrt_pd(x); }
+        static Double Min(Double a, Double b) noexcept { return _mm256_min_pd(a, b); }
+        static Double Max(Double a, Double b) noexcept { return _mm256_max_pd(a, b); }
+
+        static Bits AsBits(Double x) noexcept { return _mm256_castpd_si256(x); }
+        static Double AsDouble(Bits x) noexcept { return _mm256_castsi256_pd(x); }
+        static Bits SetBits(uint64_t value) noexcept { return _mm256_set1_epi64x(static_cast<int64_t>(value)); }
+        static Bits Add64(Bits a, Bits b) noexcept { return _mm256_add_epi64(a, b); }
+        static Bits Sub64(Bits a, Bits b) noexcept { return _mm256_sub_epi64(a, b); }
+        static Bits Or64(Bits a, Bits b) noexcept { return _mm256_or_si256(a, b); }
+        static Bits ShiftLeft64(Bits x, int count) noexcept { return _mm256_slli_epi64(x, count); }
+        static Bits ShiftRight64(Bits x, int count) noexcept { return _mm256_srli_epi64(x, count); }
+    };
+}
+
+#include "VecMathAlgorithms.h"
+
+namespace Cyrex::Math::VecKernels {
+    constinit const Table AVX2 = VecAlgorithms::MakeTable<AVX2Batch>();
+}
+
+CRX_TARGET_END
+#endif
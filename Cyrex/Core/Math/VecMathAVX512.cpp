@@ -0,0 +1,106 @@
+#include "VecMath.h"
+
+#if CRX_SIMD_X86
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+CRX_TARGET_BEGIN(CRX_ISA_AVX512)
+
+namespace {
+    //AVX-512F only, the halves are moved around as 256 bit lanes of doubles since splitting
+    //floats needs AVX-512DQ
+    struct AVX512Batch {
+        using Float  = __m512;
+        using Int    = __m512i;
+        using Mask   = __mmask16;
+        using Double = __m512d;
+        using Bits   = __m512i;
+
+        static constexpr size_t Width  = 16;
+        static constexpr size_t Halves = 2;
+
+        static Float Set(float value) noexcept { return _mm512_set1_ps(value); }
+        static Float Load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+        static void Store(float* p, Float x) noexcept { _mm512_storeu_ps(p, x); }
+
+        static Float Add(Float a, Float b) noexcept { return _mm512_add_ps(a, b); }
+        static Float Sub(Float a, Float b) noexcept { return _mm512_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) noexcept { return _mm512_mul_ps(a, b); }
+        static Float Div(Float a, Float b) noexcept { return _mm512_div_ps(a, b); }
+        static Float MulAdd(Float a, Float b, Float c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+        static Float Sqrt(Float x) noexcept { return _mm512_sqrt_ps(x); }
+        static Float Min(Float a, Float b) noexcept { return _mm512_min_ps(a, b); }
+        static Float Max(Float a, Float b) noexcept { return _mm512_max_ps(a, b); }
+        static Float Abs(Float x) noexcept { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(INT32_MAX))); }
+        static Float RsqrtEstimate(Float x) noexcept { return _mm512_rsqrt14_ps(x); }
+
+        static Int ToInt(Float x) noexcept { return _mm512_cvtps_epi32(x); }
+        static Float ToFloat(Int x) noexcept { return _mm512_cvtepi32_ps(x); }
+        static Int AsInt(Float x) noexcept { return _mm512_castps_si512(x); }
+        static Float AsFloat(Int x) noexcept { return _mm512_castsi512_ps(x); }
+
+        static Mask Equal(Float a, Float b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+        static Mask Less(Float a, Float b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+        static Mask Greater(Float a, Float b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+        static Mask GreaterEqual(Float a, Float b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+        static Mask IsNaN(Float x) noexcept { return _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q); }
+        static Mask IsNegative(Float x) noexcept { return _mm512_cmplt_epi32_mask(_mm512_castps_si512(x), _mm512_setzero_si512()); }
+        static Mask And(Mask a, Mask b) noexcept { return static_cast<Mask>(a & b); }
+        static Mask Or(Mask a, Mask b) noexcept { return static_cast<Mask>(a | b); }
+        static Mask AndNot(Mask a, Mask b) noexcept { return static_cast<Mask>(~a & b); }
+        static Float Select(Mask mask, Float a, Float b) noexcept { return _mm512_mask_blend_ps(mask, b, a); }
+
+        static Int SetInt(int32_t value) noexcept { return _mm512_set1_epi32(value); }
+        static Int Add32(Int a, Int b) noexcept { return _mm512_add_epi32(a, b); }
+        static Int Sub32(Int a, Int b) noexcept { return _mm512_sub_epi32(a, b); }
+        static Int And32(Int a, Int b) noexcept { return _mm512_and_si512(a, b); }
+        static Int Or32(Int a, Int b) noexcept { return _mm512_or_si512(a, b); }
+        static Int Xor32(Int a, Int b) noexcept { return _mm512_xor_si512(a, b); }
+        static Int ShiftLeft32(Int x, int count) noexcept { return _mm512_slli_epi32(x, static_cast<unsigned>(count)); }
+        static Int ShiftRightArith32(Int x, int count) noexcept { return _mm512_srai_epi32(x, static_cast<unsigned>(count)); }
+        static Mask EqualInt(Int a, Int b) noexcept { return _mm512_cmpeq_epi32_mask(a, b); }
+        static Int Select32(Mask mask, Int a, Int b) noexcept { return _mm512_mask_blend_epi32(mask, b, a); }
+
+        static void Widen(Float x, Double (&halves)[Halves]) noexcept {
+            halves[0] = _mm512_cvtps_pd(_mm512_castps512_ps256(x));
+            halves[1] = _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), 1)));
+        }
+
+        static Float Narrow(const Double (&halves)[Halves]) noexcept {
+            const auto low  = _mm512_castps_pd(_mm512_castps256_ps512(_mm512_cvtpd_ps(halves[0])));
+            const auto high = _mm256_castps_pd(_mm512_cvtpd_ps(halves[1]));
+            return _mm512_castpd_ps(_mm512_insertf64x4(low, high, 1));
+        }
+
+        static Double SetDouble(double value) noexcept { return _mm512_set1_pd(value); }
+        static Double Add(Double a, Double b) noexcept { return _mm512_add_pd(a, b); }
+        static Double Sub(Double a, Double b) noexcept { return _mm512_sub_pd(a, b); }
+        static Double Mul(Double a, Double b) noexcept { return _mm512_mul_pd(a, b); }
+        static Double Div(Double a, Double b) noexcept { return _mm512_div_pd(a, b); }
+        static Double MulAdd(Double a, Double b, Double c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+        static Double Sqrt(Double x) noexcept { return _mm512_sqrt_pd(x); }
+        static Double Min(Double a, Double b) noexcept { return _mm512_min_pd(a, b); }
+        static Double Max(Double a, Double b) noexcept { return _mm512_max_pd(a, b); }
+
+        static Bits AsBits(Double x) noexcept { return _mm512_castpd_si512(x); }
+        static Double AsDouble(Bits x) noexcept { return _mm512_castsi512_pd(x); }
+        static Bits SetBits(uint64_t value) noexcept { return _mm512_set1_epi64(static_cast<int64_t>(value)); }
+        static Bits Add64(Bits a, Bits b) noexcept { return _mm512_add_epi64(a, b); }
+        static Bits Sub64(Bits a, Bits b) noexcept { return _mm512_sub_epi64(a, b); }
+        static Bits Or64(Bits a, Bits b) noexcept { return _mm512_or_si512(a, b); }
+        static Bits ShiftLeft64(Bits x, int count) noexcept { return _mm512_slli_epi64(x, static_cast<unsigned>(count)); }
+        static Bits ShiftRight64(Bits x, int count) noexcept { return _mm512_srli_epi64(x, static_cast<unsigned>(count)); }
+    };
+}
+
+#include "VecMathAlgorithms.h"
+
+namespace Cyrex::Math::VecKernels {
+    constinit const Table AVX512 = VecAlgorithms::MakeTable<AVX512Batch>();
+}
+
+CRX_TARGET_END
+#endif
@@ -0,0 +1,578 @@
+#pragma once
+#include "VecMath.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+//The functions of Vec written once over a batch of floats B. Each instruction set compiles them
+//in its own translation unit between CRX_TARGET_BEGIN and CRX_TARGET_END, with B defined in an
+//anonymous namespace so every instantiation stays local to it. For the same reason this header
+//holds templates only, and the variant units include its headers before they set the target.
+//
+//B::Float, B::Int and B::Mask hold B::Width floats, 32 bit integers and comparison results.
+//B::Double holds half as many doubles, or one double in the scalar batch, and B::Bits their
+//64 bit patterns. B::Widen splits a Float into B::Halves Doubles and B::Narrow joins them.
+//Min and Max return the second operand when one of them is NaN, like minps and maxps.
+namespace Cyrex::Math::VecAlgorithms {
+    constexpr float PI      = 3.14159265358979323846f;
+    constexpr float PI_DIV2 = 1.57079632679489661923f;
+    constexpr float PI_DIV4 = 0.78539816339744830962f;
+
+    constexpr double PI_D      = 3.14159265358979323846;
+    constexpr double PI_DIV2_D = 1.57079632679489661923;
+    constexpr double LN2_D     = 0.69314718055994530942;
+    constexpr double LOG2E_D   = 1.44269504088896340736;
+
+    //Adding it rounds a double below 2^51 to an integer, which then sits in the low bits
+    constexpr double RoundingMagic = 6755399441055744.0;
+
+    template<typename B>
+    inline typename B::Float Infinity() noexcept { return B::Set(std::numeric_limits<float>::infinity()); }
+
+    template<typename B>
+    inline typename B::Float NaN() noexcept { return B::Set(std::numeric_limits<float>::quiet_NaN()); }
+
+    template<typename B>
+    inline typename B::Float Negate(typename B::Float x) noexcept { return B::AsFloat(B::Xor32(B::AsInt(x), B::SetInt(INT32_MIN))); }
+
+    template<typename B>
+    inline typename B::Float CopySign(typename B::Float magnitude, typename B::Float sign) noexcept {
+        const auto signBit = B::And32(B::AsInt(sign), B::SetInt(INT32_MIN));
+        return B::AsFloat(B::Or32(B::AsInt(B::Abs(magnitude)), signBit));
+    }
+
+    //Sin and cos of x - q * pi / 2 for |x - q * pi / 2| <= pi / 4, rotated into place by the
+    //quadrant q
+    template<typename B>
+    inline void SinCosFromQuadrant(typename B::Float x, typename B::Int q, typename B::Float sinR, typename B::Float cosR,
+                                   typename B::Float& sin, typename B::Float& cos) noexcept {
+        const auto swap = B::EqualInt(B::And32(q, B::SetInt(1)), B::SetInt(1));
+
+        const auto sinSign = B::ShiftLeft32(B::And32(q, B::SetInt(2)), 30);
+        const auto cosSign = B::ShiftLeft32(B::And32(B::Add32(q, B::SetInt(1)), B::SetInt(2)), 30);
+
+        sin = B::AsFloat(B::Xor32(B::AsInt(B::Select(swap, cosR, sinR)), sinSign));
+        cos = B::AsFloat(B::Xor32(B::AsInt(B::Select(swap, sinR, cosR)), cosSign));
+
+        //The polynomial loses the sign of zero
+        const auto isInfinite = B::Equal(B::Abs(x), Infinity<B>());
+        sin = B::Select(B::Equal(x, B::Set(0.0f)), x, B::Select(isInfinite, NaN<B>(), sin));
+        cos = B::Select(isInfinite, NaN<B>(), cos);
+    }
+
+    //Cody and Waite's reduction with pi / 2 in three parts, the first two short enough that
+    //their products with q are exact, and the polynomials of Cephes' sinf and cosf
+    template<typename B>
+    inline void SinCosFast(typename B::Float x, typename B::Float& sin, typename B::Float& cos) noexcept {
+        const auto q  = B::ToInt(B::Mul(x, B::Set(2.0f / PI)));
+        const auto qf = B::ToFloat(q);
+
+        auto r = B::MulAdd(qf, B::Set(-1.5703125f), x);
+        r = B::MulAdd(qf, B::Set(-4.837512969970703125e-4f), r);
+        r = B::MulAdd(qf, B::Set(-7.54978995489188216e-8f), r);
+
+        //q may be one off where x * 2 / pi rounds across a half, which takes r a little past
+        //pi / 4. The clamp only keeps out of range arguments from blowing up the polynomials.
+        r = B::Min(B::Set(1.0f), B::Max(B::Set(-1.0f), r));
+
+        const auto z = B::Mul(r, r);
+
+        auto s = B::MulAdd(z, B::Set(-1.9515295891e-4f), B::Set(8.3321608736e-3f));
+        s = B::MulAdd(s, z, B::Set(-1.6666654611e-1f));
+        s = B::MulAdd(B::Mul(s, z), r, r);
+
+        auto c = B::MulAdd(z, B::Set(2.443315711809948e-5f), B::Set(-1.388731625493765e-3f));
+        c = B::MulAdd(c, z, B::Set(4.166664568298827e-2f));
+        c = B::MulAdd(B::Mul(c, z), z, B::MulAdd(z, B::Set(-0.5f), B::Set(1.0f)));
+
+        SinCosFromQuadrant<B>(x, q, s, c, sin, cos);
+    }
+
+    //The same in double precision, pi / 2 in three parts of 28, 28 and 53 bits keeps the
+    //reduction exact while q < 2^25. The Taylor series are good to 1e-11 on [-pi / 4, pi / 4].
+    template<typename B>
+    inline void SinCos(typename B::Float x, typename B::Float& sin, typename B::Float& cos) noexcept {
+        typename B::Double halves[B::Halves];
+        typename B::Double sinHalves[B::Halves];
+        typename B::Double cosHalves[B::Halves];
+        typename B::Double quadrants[B::Halves];
+        B::Widen(x, halves);
+
+        for (size_t i = 0; i < B::Halves; ++i) {
+            const auto magic = B::MulAdd(halves[i], B::SetDouble(2.0 / PI_D), B::SetDouble(RoundingMagic));
+            const auto q     = B::Sub(magic, B::SetDouble(RoundingMagic));
+
+            auto r = B::MulAdd(q, B::SetDouble(-0x1.921fb54p+0), halves[i]);
+            r = B::MulAdd(q, B::SetDouble(-0x1.10b4612p-30), r);
+            r = B::MulAdd(q, B::SetDouble(0x1.676733ae8fe48p-60), r);
+            r = B::Min(B::SetDouble(1.0), B::Max(B::SetDouble(-1.0), r));
+
+            const auto z = B::Mul(r, r);
+
+            auto s = B::MulAdd(z, B::SetDouble(-1.0 / 39916800.0), B::SetDouble(1.0 / 362880.0));
+            s = B::MulAdd(s, z, B::SetDouble(-1.0 / 5040.0));
+            s = B::MulAdd(s, z, B::SetDouble(1.0 / 120.0));
+            s = B::MulAdd(s, z, B::SetDouble(-1.0 / 6.0));
+            sinHalves[i] = B::MulAdd(B::Mul(s, z), r, r);
+
+            auto c = B::MulAdd(z, B::SetDouble(1.0 / 479001600.0), B::SetDouble(-1.0 / 3628800.0));
+            c = B::MulAdd(c, z, B::SetDouble(1.0 / 40320.0));
+            c = B::MulAdd(c, z, B::SetDouble(-1.0 / 720.0));
+            c = B::MulAdd(c, z, B::SetDouble(1.0 / 24.0));
+            c = B::MulAdd(c, z, B::SetDouble(-0.5));
+            cosHalves[i] = B::MulAdd(c, z, B::SetDouble(1.0));
+
+            quadrants[i] = q;
+        }
+
+        //Only the low two bits of the quadrant matter, they survive the narrowing while q < 2^24
+        SinCosFromQuadrant<B>(x, B::ToInt(B::Narrow(quadrants)), B::Narrow(sinHalves), B::Narrow(cosHalves), sin, cos);
+    }
+
+    template<typename B>
+    inline typename B::Float Sin(typename B::Float x) noexcept {
+        typename B::Float sin, cos;
+        SinCos<B>(x, sin, cos);
+        return sin;
+    }
+
+    template<typename B>
+    inline typename B::Float SinFast(typename B::Float x) noexcept {
+        typename B::Float sin, cos;
+        SinCosFast<B>(x, sin, cos);
+        return sin;
+    }
+
+    template<typename B>
+    inline typename B::Float Cos(typename B::Float x) noexcept {
+        typename B::Float sin, cos;
+        SinCos<B>(x, sin, cos);
+        return cos;
+    }
+
+    template<typename B>
+    inline typename B::Float CosFast(typename B::Float x) noexcept {
+        typename B::Float sin, cos;
+        SinCosFast<B>(x, sin, cos);
+        return cos;
+    }
+
+    //2^z for |z| <= 512, 2^(z - n) as a Taylor series of e^u for |u| <= ln(2) / 2, good to
+    //3e-13, then n added to the exponent
+    template<typename B>
+    inline typename B::Double Exp2Double(typename B::Double z) noexcept {
+        const auto magic = B::Add(z, B::SetDouble(RoundingMagic));
+        const auto n     = B::Sub(magic, B::SetDouble(RoundingMagic));
+        const auto u     = B::Mul(B::Sub(z, n), B::SetDouble(LN2_D));
+
+        auto p = B::MulAdd(u, B::SetDouble(1.0 / 3628800.0), B::SetDouble(1.0 / 362880.0));
+        p = B::MulAdd(p, u, B::SetDouble(1.0 / 40320.0));
+        p = B::MulAdd(p, u, B::SetDouble(1.0 / 5040.0));
+        p = B::MulAdd(p, u, B::SetDouble(1.0 / 720.0));
+        p = B::MulAdd(p, u, B::SetDouble(1.0 / 120.0));
+        p = B::MulAdd(p, u, B::SetDouble(1.0 / 24.0));
+        p = B::MulAdd(p, u, B::SetDouble(1.0 / 6.0));
+        p = B::MulAdd(p, u, B::SetDouble(0.5));
+        p = B::MulAdd(p, u, B::SetDouble(1.0));
+        p = B::MulAdd(p, u, B::SetDouble(1.0));
+
+        const auto exponent = B::ShiftLeft64(B::Sub64(B::AsBits(magic), B::AsBits(B::SetDouble(RoundingMagic))), 52);
+        return B::AsDouble(B::Add64(B::AsBits(p), exponent));
+    }
+
+    //ln(x) for positive, finite, normal x, as e * ln(2) + ln(m) with m in [sqrt(0.5), sqrt(2)).
+    //ln(m) is 2 * atanh(t) with t = (m - 1) / (m + 1), |t| <= 0.172, as a series good to 1e-12.
+    template<typename B>
+    inline typename B::Double LogDouble(typename B::Double x) noexcept {
+        constexpr uint64_t SqrtHalfBits = 0x3FE6A09E667F3BCDull;
+        constexpr uint64_t TwoPow52Bits = 0x4330000000000000ull;
+
+        //e + 1024, the bias keeps the shifted difference positive
+        const auto bits     = B::AsBits(x);
+        const auto exponent = B::ShiftRight64(B::Add64(B::Sub64(bits, B::SetBits(SqrtHalfBits)), B::SetBits(1ull << 62)), 52);
+
+        const auto m = B::AsDouble(B::Sub64(bits, B::ShiftLeft64(B::Sub64(exponent, B::SetBits(1024)), 52)));
+        const auto e = B::Sub(B::AsDouble(B::Or64(exponent, B::SetBits(TwoPow52Bits))), B::SetDouble(4503599627370496.0 + 1024.0));
+
+        const auto t  = B::Div(B::Sub(m, B::SetDouble(1.0)), B::Add(m, B::SetDouble(1.0)));
+        const auto t2 = B::Mul(t, t);
+
+        auto s = B::MulAdd(t2, B::SetDouble(1.0 / 13.0), B::SetDouble(1.0 / 11.0));
+        s = B::MulAdd(s, t2, B::SetDouble(1.0 / 9.0));
+        s = B::MulAdd(s, t2, B::SetDouble(1.0 / 7.0));
+        s = B::MulAdd(s, t2, B::SetDouble(1.0 / 5.0));
+        s = B::MulAdd(s, t2, B::SetDouble(1.0 / 3.0));
+        s = B::Mul(s, t2);
+
+        const auto twoT = B::Add(t, t);
+        return B::MulAdd(e, B::SetDouble(LN2_D), B::MulAdd(twoT, s, twoT));
+    }
+
+    template<typename B>
+    inline typename B::Float Exp(typename B::Float x) noexcept {
+        typename B::Double halves[B::Halves];
+        B::Widen(x, halves);
+
+        //Past the clamp every result rounds to zero or infinity anyway
+        for (auto& half : halves) {
+            const auto z = B::Mul(half, B::SetDouble(LOG2E_D));
+            half = Exp2Double<B>(B::Max(B::SetDouble(-512.0), B::Min(B::SetDouble(512.0), z)));
+        }
+
+        return B::Select(B::IsNaN(x), x, B::Narrow(halves));
+    }
+
+    //Cephes' expf, the result scaled by 2^n in two steps so that it may turn subnormal
+    template<typename B>
+    inline typename B::Float ExpFast(typename B::Float x) noexcept {
+        const auto clamped = B::Max(B::Set(-104.0f), B::Min(B::Set(89.0f), x));
+
+        const auto n  = B::ToInt(B::Mul(clamped, B::Set(1.44269504088896341f)));
+        const auto nf = B::ToFloat(n);
+
+        auto r = B::MulAdd(nf, B::Set(-0.693359375f), clamped);
+        r = B::MulAdd(nf, B::Set(2.12194440e-4f), r);
+
+        const auto z = B::Mul(r, r);
+
+        auto p = B::MulAdd(r, B::Set(1.9875691500e-4f), B::Set(1.3981999507e-3f));
+        p = B::MulAdd(p, r, B::Set(8.3334519073e-3f));
+        p = B::MulAdd(p, r, B::Set(4.1665795894e-2f));
+        p = B::MulAdd(p, r, B::Set(1.6666665459e-1f));
+        p = B::MulAdd(p, r, B::Set(5.0000001201e-1f));
+        p = B::MulAdd(p, z, B::Add(r, B::Set(1.0f)));
+
+        //Two steps, 2^128 has no float. Tiny results round p * 2^(n + 149) to an integer instead,
+        //which is the bit pattern of the subnormal, multiplying into subnormals is slow.
+        const auto isTiny = B::Less(nf, B::Set(-125.0f));
+        const auto normal = B::Select32(isTiny, B::SetInt(-125), n);
+        const auto half   = B::ShiftRightArith32(normal, 1);
+        const auto first  = B::AsFloat(B::ShiftLeft32(B::Add32(half, B::SetInt(127)), 23));
+        const auto other  = B::AsFloat(B::ShiftLeft32(B::Add32(B::Sub32(normal, half), B::SetInt(127)), 23));
+
+        const auto tinyScale = B::AsFloat(B::ShiftLeft32(B::Add32(n, B::SetInt(149 + 127)), 23));
+        const auto tiny      = B::AsFloat(B::ToInt(B::Mul(p, B::Select(isTiny, tinyScale, B::Set(1.0f)))));
+
+        return B::Select(B::IsNaN(x), x, B::Select(isTiny, tiny, B::Mul(B::Mul(p, first), other)));
+    }
+
+    //NaN below zero, -infinity at zero and infinity at infinity
+    template<typename B>
+    inline typename B::Float LogSpecialCases(typename B::Float x, typename B::Float log) noexcept {
+        log = B::Select(B::Equal(x, Infinity<B>()), x, log);
+        log = B::Select(B::Equal(x, B::Set(0.0f)), Negate<B>(Infinity<B>()), log);
+        return B::Select(B::Or(B::Less(x, B::Set(0.0f)), B::IsNaN(x)), NaN<B>(), log);
+    }
+
+    template<typename B>
+    inline typename B::Float Log(typename B::Float x) noexcept {
+        typename B::Double halves[B::Halves];
+        B::Widen(x, halves);
+
+        //Subnormal floats are normal doubles
+        for (auto& half : halves) {
+            half = LogDouble<B>(half);
+        }
+
+        return LogSpecialCases<B>(x, B::Narrow(halves));
+    }
+
+    //Cephes' logf, subnormals are scaled up by 2^23 first
+    template<typename B>
+    inline typename B::Float LogFast(typename B::Float x) noexcept {
+        //The bits of a subnormal are x * 2^149 as an integer, converting them is exact and avoids
+        //the slow subnormal multiply
+        const auto isSubnormal = B::Less(x, B::Set(1.17549435e-38f));
+        const auto scaled      = B::Select(isSubnormal, B::ToFloat(B::AsInt(x)), x);
+
+        //The exponent and the mantissa in [0.5, 1)
+        auto e = B::Sub32(B::ShiftRightArith32(B::AsInt(scaled), 23), B::Select32(isSubnormal, B::SetInt(126 + 149), B::SetInt(126)));
+        auto m = B::AsFloat(B::Or32(B::And32(B::AsInt(scaled), B::SetInt(0x007FFFFF)), B::SetInt(0x3F000000)));
+
+        //Into [sqrt(0.5), sqrt(2)) as m - 1
+        const auto isSmall = B::Less(m, B::Set(0.707106781186547524f));
+        e = B::Sub32(e, B::Select32(isSmall, B::SetInt(1), B::SetInt(0)));
+        m = B::Sub(B::Add(m, B::Select(isSmall, m, B::Set(0.0f))), B::Set(1.0f));
+
+        const auto ef = B::ToFloat(e);
+        const auto z  = B::Mul(m, m);
+
+        auto p = B::MulAdd(m, B::Set(7.0376836292e-2f), B::Set(-1.1514610310e-1f));
+        p = B::MulAdd(p, m, B::Set(1.1676998740e-1f));
+        p = B::MulAdd(p, m, B::Set(-1.2420140846e-1f));
+        p = B::MulAdd(p, m, B::Set(1.4249322787e-1f));
+        p = B::MulAdd(p, m, B::Set(-1.6668057665e-1f));
+        p = B::MulAdd(p, m, B::Set(2.0000714765e-1f));
+        p = B::MulAdd(p, m, B::Set(-2.4999993993e-1f));
+        p = B::MulAdd(p, m, B::Set(3.3333331174e-1f));
+
+        auto y = B::Mul(B::Mul(p, m), z);
+        y = B::MulAdd(ef, B::Set(-2.12194440e-4f), y);
+        y = B::MulAdd(z, B::Set(-0.5f), y);
+
+        const auto log = B::MulAdd(ef, B::Set(0.693359375f), B::Add(m, y));
+        return LogSpecialCases<B>(x, log);
+    }
+
+    //The sign, the NaNs and the edge cases of the C library's pow around |x|^y
+    template<typename B>
+    inline typename B::Float PowSpecialCases(typename B::Float x, typename B::Float y, typename B::Float magnitude) noexcept {
+        const auto ax   = B::Abs(x);
+        const auto ay   = B::Abs(y);
+        const auto zero = B::Set(0.0f);
+        const auto one  = B::Set(1.0f);
+        const auto inf  = Infinity<B>();
+
+        const auto isNegativeY = B::Less(y, zero);
+        magnitude = B::Select(B::Equal(ax, zero), B::Select(isNegativeY, inf, zero), magnitude);
+        magnitude = B::Select(B::Equal(ax, inf), B::Select(isNegativeY, zero, inf), magnitude);
+
+        //From 2^24 on every float is an even integer
+        const auto isLarge   = B::GreaterEqual(ay, B::Set(16777216.0f));
+        const auto integer   = B::ToInt(B::Select(isLarge, zero, y));
+        const auto isInteger = B::Or(isLarge, B::Equal(B::ToFloat(integer), y));
+        const auto isOdd     = B::AndNot(isLarge, B::And(isInteger, B::EqualInt(B::And32(integer, B::SetInt(1)), B::SetInt(1))));
+
+        auto result = B::Select(B::And(B::IsNegative(x), isOdd), Negate<B>(magnitude), magnitude);
+
+        const auto isFiniteNegative = B::And(B::Less(x, zero), B::Greater(x, Negate<B>(inf)));
+        result = B::Select(B::AndNot(isInteger, isFiniteNegative), NaN<B>(), result);
+        result = B::Select(B::Or(B::IsNaN(x), B::IsNaN(y)), B::Add(x, y), result);
+
+        const auto isOne = B::Or(B::Or(B::Equal(y, zero), B::Equal(x, one)), B::And(B::Equal(ax, one), B::Equal(ay, inf)));
+        return B::Select(isOne, one, result);
+    }
+
+    //2^(y * log2(|x|)) in double precision, the product is exact enough for any y that keeps
+    //the result in range
+    template<typename B>
+    inline typename B::Float Pow(typename B::Float x, typename B::Float y) noexcept {
+        typename B::Double xHalves[B::Halves];
+        typename B::Double yHalves[B::Halves];
+        B::Widen(B::Abs(x), xHalves);
+        B::Widen(y, yHalves);
+
+        for (size_t i = 0; i < B::Halves; ++i) {
+            const auto z = B::Mul(yHalves[i], B::Mul(LogDouble<B>(xHalves[i]), B::SetDouble(LOG2E_D)));
+            xHalves[i] = Exp2Double<B>(B::Max(B::SetDouble(-512.0), B::Min(B::SetDouble(512.0), z)));
+        }
+
+        return PowSpecialCases<B>(x, y, B::Narrow(xHalves));
+    }
+
+    template<typename B>
+    inline typename B::Float PowFast(typename B::Float x, typename B::Float y) noexcept {
+        const auto result = ExpFast<B>(B::Mul(y, LogFast<B>(x)));
+        return B::Select(B::Equal(y, B::Set(0.0f)), B::Set(1.0f), result);
+    }
+
+    //atan2 from atan(t) of the ratio t = min(|x|, |y|) / max(|x|, |y|) in [0, 1]. Infinities
+    //and zeros turn into the ratios that give the C library's angles.
+    template<typename B>
+    struct Atan2Ratio {
+        typename B::Float Low;
+        typename B::Float High;
+        typename B::Mask IsSwapped;
+
+        Atan2Ratio(typename B::Float y, typename B::Float x) noexcept {
+            const auto ax  = B::Abs(x);
+            const auto ay  = B::Abs(y);
+            const auto inf = Infinity<B>();
+
+            Low       = B::Min(ax, ay);
+            High      = B::Max(ax, ay);
+            IsSwapped = B::Greater(ay, ax);
+
+            const auto isHighInfinite = B::Equal(High, inf);
+            Low  = B::Select(isHighInfinite, B::Select(B::Equal(Low, inf), B::Set(1.0f), B::Set(0.0f)), Low);
+            High = B::Select(B::Or(isHighInfinite, B::Equal(High, B::Set(0.0f))), B::Set(1.0f), High);
+        }
+    };
+
+    template<typename B>
+    inline typename B::Float Atan2Result(typename B::Float y, typename B::Float x, typename B::Float angle) noexcept {
+        return B::Select(B::Or(B::IsNaN(x), B::IsNaN(y)), B::Add(x, y), CopySign<B>(angle, y));
+    }
+
+    //atan(t) = 2 * atan(t / (1 + sqrt(1 + t^2))) twice takes t below tan(pi / 16) where the
+    //series is good to 1e-15. The quadrant is added in double precision as 0 or 1 factors.
+    template<typename B>
+    inline typename B::Float Atan2(typename B::Float y, typename B::Float x) noexcept {
+        const Atan2Ratio<B> ratio(y, x);
+
+        typename B::Double low[B::Halves];
+        typename B::Double high[B::Halves];
+        typename B::Double swapped[B::Halves];
+        typename B::Double negative[B::Halves];
+
+        B::Widen(ratio.Low, low);
+        B::Widen(ratio.High, high);
+        B::Widen(B::Select(ratio.IsSwapped, B::Set(1.0f), B::Set(0.0f)), swapped);
+        B::Widen(B::Select(B::IsNegative(x), B::Set(1.0f), B::Set(0.0f)), negative);
+
+        const auto one = B::SetDouble(1.0);
+
+        for (size_t i = 0; i < B::Halves; ++i) {
+            auto t = B::Div(low[i], high[i]);
+            t = B::Div(t, B::Add(one, B::Sqrt(B::MulAdd(t, t, one))));
+            t = B::Div(t, B::Add(one, B::Sqrt(B::MulAdd(t, t, one))));
+
+            const auto z = B::Mul(t, t);
+
+            auto s = B::MulAdd(z, B::SetDouble(1.0 / 17.0), B::SetDouble(-1.0 / 15.0));
+            s = B::MulAdd(s, z, B::SetDouble(1.0 / 13.0));
+            s = B::MulAdd(s, z, B::SetDouble(-1.0 / 11.0));
+            s = B::MulAdd(s, z, B::SetDouble(1.0 / 9.0));
+            s = B::MulAdd(s, z, B::SetDouble(-1.0 / 7.0));
+            s = B::MulAdd(s, z, B::SetDouble(1.0 / 5.0));
+            s = B::MulAdd(s, z, B::SetDouble(-1.0 / 3.0));
+
+            auto angle = B::Mul(B::MulAdd(B::Mul(s, z), t, t), B::SetDouble(4.0));
+
+            //pi / 2 - angle when swapped, then pi - angle when x is negative
+            angle = B::MulAdd(B::MulAdd(swapped[i], B::SetDouble(-2.0), one), angle, B::Mul(swapped[i], B::SetDouble(PI_DIV2_D)));
+            angle = B::MulAdd(B::MulAdd(negative[i], B::SetDouble(-2.0), one), angle, B::Mul(negative[i], B::SetDouble(PI_D)));
+
+            low[i] = angle;
+        }
+
+        return Atan2Result<B>(y, x, B::Narrow(low));
+    }
+
+    //Cephes' atanf on [0, 1], one reduction by tan(pi / 8)
+    template<typename B>
+    inline typename B::Float Atan2Fast(typename B::Float y, typename B::Float x) noexcept {
+        const Atan2Ratio<B> ratio(y, x);
+
+        const auto one = B::Set(1.0f);
+        const auto t   = B::Div(ratio.Low, ratio.High);
+
+        //(t - 1) / (t + 1) above tan(pi / 8), with a single division
+        const auto b       = B::Select(B::Greater(t, B::Set(0.414213562373095f)), one, B::Set(0.0f));
+        const auto reduced = B::Div(B::Sub(t, b), B::MulAdd(t, b, one));
+        const auto z       = B::Mul(reduced, reduced);
+
+        auto p = B::MulAdd(z, B::Set(8.05374449538e-2f), B::Set(-1.38776856032e-1f));
+        p = B::MulAdd(p, z, B::Set(1.99777106478e-1f));
+        p = B::MulAdd(p, z, B::Set(-3.33329491539e-1f));
+
+        auto angle = B::MulAdd(b, B::Set(PI_DIV4), B::MulAdd(B::Mul(p, z), reduced, reduced));
+        angle = B::Select(ratio.IsSwapped, B::Sub(B::Set(PI_DIV2), angle), angle);
+        angle = B::Select(B::IsNegative(x), B::Sub(B::Set(PI), angle), angle);
+
+        return Atan2Result<B>(y, x, angle);
+    }
+
+    template<typename B>
+    inline typename B::Float Rsqrt(typename B::Float x) noexcept {
+        typename B::Double halves[B::Halves];
+        B::Widen(x, halves);
+
+        for (auto& half : halves) {
+            half = B::Div(B::SetDouble(1.0), B::Sqrt(half));
+        }
+
+        return B::Narrow(halves);
+    }
+
+    //One Newton step on the estimate
+    template<typename B>
+    inline typename B::Float RsqrtFast(typename B::Float x) noexcept {
+        const auto estimate = B::RsqrtEstimate(x);
+        const auto halfX    = B::Mul(x, B::Set(0.5f));
+
+        auto result = B::Mul(estimate, B::MulAdd(B::Mul(halfX, estimate), Negate<B>(estimate), B::Set(1.5f)));
+        result = B::Select(B::Less(x, B::Set(1.17549435e-38f)), CopySign<B>(Infinity<B>(), x), result);
+        result = B::Select(B::Equal(x, Infinity<B>()), B::Set(0.0f), result);
+
+        return B::Select(B::Or(B::Less(x, B::Set(0.0f)), B::IsNaN(x)), NaN<B>(), result);
+    }
+
+    //The span loops, the tail goes through a padded batch so every element sees the same code.
+    //The functions are template arguments rather than lambdas, GCC compiles lambdas without the
+    //target of the enclosing function.
+    template<typename B, typename B::Float (*Function)(typename B::Float)>
+    void UnaryKernel(std::span<const float> in, std::span<float> out) noexcept {
+        size_t i = 0;
+
+        for (; i + B::Width <= in.size(); i += B::Width) {
+            B::Store(out.data() + i, Function(B::Load(in.data() + i)));
+        }
+
+        if (i < in.size()) {
+            alignas(64) float tail[B::Width]{};
+            std::memcpy(tail, in.data() + i, (in.size() - i) * sizeof(float));
+
+            B::Store(tail, Function(B::Load(tail)));
+            std::memcpy(out.data() + i, tail, (in.size() - i) * sizeof(float));
+        }
+    }
+
+    template<typename B, typename B::Float (*Function)(typename B::Float, typename B::Float)>
+    void BinaryKernel(std::span<const float> a, std::span<const float> b, std::span<float> out) noexcept {
+        size_t i = 0;
+
+        for (; i + B::Width <= a.size(); i += B::Width) {
+            B::Store(out.data() + i, Function(B::Load(a.data() + i), B::Load(b.data() + i)));
+        }
+
+        if (i < a.size()) {
+            alignas(64) float tailA[B::Width]{};
+            alignas(64) float tailB[B::Width]{};
+            std::memcpy(tailA, a.data() + i, (a.size() - i) * sizeof(float));
+            std::memcpy(tailB, b.data() + i, (a.size() - i) * sizeof(float));
+
+            B::Store(tailA, Function(B::Load(tailA), B::Load(tailB)));
+            std::memcpy(out.data() + i, tailA, (a.size() - i) * sizeof(float));
+        }
+    }
+
+    template<typename B, void (*Function)(typename B::Float, typename B::Float&, typename B::Float&)>
+    void DualKernel(std::span<const float> in, std::span<float> sinOut, std::span<float> cosOut) noexcept {
+        typename B::Float sin;
+        typename B::Float cos;
+        size_t i = 0;
+
+        for (; i + B::Width <= in.size(); i += B::Width) {
+            Function(B::Load(in.data() + i), sin, cos);
+            B::Store(sinOut.data() + i, sin);
+            B::Store(cosOut.data() + i, cos);
+        }
+
+        if (i < in.size()) {
+            alignas(64) float tailSin[B::Width]{};
+            alignas(64) float tailCos[B::Width]{};
+            std::memcpy(tailSin, in.data() + i, (in.size() - i) * sizeof(float));
+
+            Function(B::Load(tailSin), sin, cos);
+            B::Store(tailSin, sin);
+            B::Store(tailCos, cos);
+            std::memcpy(sinOut.data() + i, tailSin, (in.size() - i) * sizeof(float));
+            std::memcpy(cosOut.data() + i, tailCos, (in.size() - i) * sizeof(float));
+        }
+    }
+
+    template<typename B>
+    constexpr VecKernels::Table MakeTable() noexcept {
+        return VecKernels::Table {
+            UnaryKernel<B, Sin<B>>,
+            UnaryKernel<B, SinFast<B>>,
+            UnaryKernel<B, Cos<B>>,
+            UnaryKernel<B, CosFast<B>>,
+            DualKernel<B, SinCos<B>>,
+            DualKernel<B, SinCosFast<B>>,
+            UnaryKernel<B, Exp<B>>,
+            UnaryKernel<B, ExpFast<B>>,
+            UnaryKernel<B, Log<B>>,
+            UnaryKernel<B, LogFast<B>>,
+            BinaryKernel<B, Pow<B>>,
+            BinaryKernel<B, PowFast<B>>,
+            BinaryKernel<B, Atan2<B>>,
+            BinaryKernel<B, Atan2Fast<B>>,
+            UnaryKernel<B, Rsqrt<B>>,
+            UnaryKernel<B, RsqrtFast<B>>
+        };
+    }
+}
@@ -0,0 +1,105 @@
+#include "VecMath.h"
+
+#if CRX_SIMD_X86
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+namespace {
+    //SSE2 only, the x64 baseline, so no target is set. Selects are done with masks and there
+    //is no FMA.
+    struct SSEBatch {
+        using Float  = __m128;
+        using Int    = __m128i;
+        using Mask   = __m128;
+        using Double = __m128d;
+        using Bits   = __m128i;
+
+        static constexpr size_t Width  = 4;
+        static constexpr size_t Halves = 2;
+
+        static Float Set(float value) noexcept { return _mm_set1_ps(value); }
+        static Float Load(const float* p) noexcept { return _mm_loadu_ps(p); }
+        static void Store(float* p, Float x) noexcept { _mm_storeu_ps(p, x); }
+
+        static Float Add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+        static Float Sub(Float a, Float b) noexcept { return _mm_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+        static Float Div(Float a, Float b) noexcept { return _mm_div_ps(a, b); }
+        static Float MulAdd(Float a, Float b, Float c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static Float Sqrt(Float x) noexcept { return _mm_sqrt_ps(x); }
+        static Float Min(Float a, Float b) noexcept { return _mm_min_ps(a, b); }
+        static Float Max(Float a, Float b) noexcept { return _mm_max_ps(a, b); }
+        static Float Abs(Float x) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), x); }
+        static Float RsqrtEstimate(Float x) noexcept { return _mm_rsqrt_ps(x); }
+
+        static Int ToInt(Float x) noexcept { return _mm_cvtps_epi32(x); }
+        static Float ToFloat(Int x) noexcept { return _mm_cvtepi32_ps(x); }
+        static Int AsInt(Float x) noexcept { return _mm_castps_si128(x); }
+        static Float AsFloat(Int x) noexcept { return _mm_castsi128_ps(x); }
+
+        static Mask Equal(Float a, Float b) noexcept { return _mm_cmpeq_ps(a, b); }
+        static Mask Less(Float a, Float b) noexcept { return _mm_cmplt_ps(a, b); }
+        static Mask Greater(Float a, Float b) noexcept { return _mm_cmpgt_ps(a, b); }
+        static Mask GreaterEqual(Float a, Float b) noexcept { return _mm_cmpge_ps(a, b); }
+        static Mask IsNaN(Float x) noexcept { return _mm_cmpunord_ps(x, x); }
+        static Mask IsNegative(Float x) noexcept { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31)); }
+        static Mask And(Mask a, Mask b) noexcept { return _mm_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) noexcept { return _mm_or_ps(a, b); }
+        static Mask AndNot(Mask a, Mask b) noexcept { return _mm_andnot_ps(a, b); }
+        static Float Select(Mask mask, Float a, Float b) noexcept { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+        static Int SetInt(int32_t value) noexcept { return _mm_set1_epi32(value); }
+        static Int Add32(Int a, Int b) noexcept { return _mm_add_epi32(a, b); }
+        static Int Sub32(Int a, Int b) noexcept { return _mm_sub_epi32(a, b); }
+        static Int And32(Int a, Int b) noexcept { return _mm_and_si128(a, b); }
+        static Int Or32(Int a, Int b) noexcept { return _mm_or_si128(a, b); }
+        static Int Xor32(Int a, Int b) noexcept { return _mm_xor_si128(a, b); }
+        static Int ShiftLeft32(Int x, int count) noexcept { return _mm_slli_epi32(x, count); }
+        static Int ShiftRightArith32(Int x, int count) noexcept { return _mm_srai_epi32(x, count); }
+        static Mask EqualInt(Int a, Int b) noexcept { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+
+        static Int Select32(Mask mask, Int a, Int b) noexcept {
+            const auto bits = _mm_castps_si128(mask);
+            return _mm_or_si128(_mm_and_si128(bits, a), _mm_andnot_si128(bits, b));
+        }
+
+        static void Widen(Float x, Double (&halves)[Halves]) noexcept {
+            halves[0] = _mm_cvtps_pd(x);
+            halves[1] = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+        }
+
+        static Float Narrow(const Double (&halves)[Halves]) noexcept {
+            return _mm_movelh_ps(_mm_cvtpd_ps(halves[0]), _mm_cvtpd_ps(halves[1]));
+        }
+
+        static Double SetDouble(double value) noexcept { return _mm_set1_pd(value); }
+        static Double Add(Double a, Double b) noexcept { return _mm_add_pd(a, b); }
+        static Double Sub(Double a, Double b) noexcept { return _mm_sub_pd(a, b); }
+        static Double Mul(Double a, Double b) noexcept { return _mm_mul_pd(a, b); }
+        static Double Div(Double a, Double b) noexcept { return _mm_div_pd(a, b); }
+        static Double MulAdd(Double a, Double b, Double c) noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+        static Double Sqrt(Double x) noexcept { return _mm_sqrt_pd(x); }
+        static Double Min(Double a, Double b) noexcept { return _mm_min_pd(a, b); }
+        static Double Max(Double a, Double b) noexcept { return _mm_max_pd(a, b); }
+
+        static Bits AsBits(Double x) noexcept { return _mm_castpd_si128(x); }
+        static Double AsDouble(Bits x) noexcept { return _mm_castsi128_pd(x); }
+        static Bits SetBits(uint64_t value) noexcept { return _mm_set1_epi64x(static_cast<int64_t>(value)); }
+        static Bits Add64(Bits a, Bits b) noexcept { return _mm_add_epi64(a, b); }
+        static Bits Sub64(Bits a, Bits b) noexcept { return _mm_sub_epi64(a, b); }
+        static Bits Or64(Bits a, Bits b) noexcept { return _mm_or_si128(a, b); }
+        static Bits ShiftLeft64(Bits x, int count) noexcept { return _mm_slli_epi64(x, count); }
+        static Bits ShiftRight64(Bits x, int count) noexcept { return _mm_srli_epi64(x, count); }
+    };
+}
+
+#include "VecMathAlgorithms.h"
+
+namespace Cyrex::Math::VecKernels {
+    constinit const Table SSE = VecAlgorithms::MakeTable<SSEBatch>();
+}
+
+#endif
@@ -1,7 +0,0 @@
-#include "Vector2.h"
-
-namespace Cyrex::Math {
-    const Vector2 Vector2::Zero(0.0f, 0.0f);
-    const Vector2 Vector2::one(1.0f, 1.0f);
-}
-
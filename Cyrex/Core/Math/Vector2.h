@@ -1,49 +1,48 @@
 #pragma once
 #include <cmath>
+#include <cstdint>
 
 namespace Cyrex::Math {
     class Vector2 {
     public:
-        Vector2() noexcept : x(0), y(0) {}
-        Vector2(float x, float y) noexcept : x(x), y(y) {}
-        Vector2(int x, int y) noexcept : x(static_cast<float>(x)), y(static_cast<float>(y)) {}
-        Vector2(uint32_t x, uint32_t y) noexcept : x(static_cast<float>(x)), y(static_cast<float>(y)) {}
-        Vector2(float x) noexcept : x(x), y(x) {}
-        Vector2(const Vector2& rhs) noexcept {
-            x = rhs.x;
-            y = rhs.y;
-        }
+        constexpr Vector2() noexcept : x(0), y(0) {}
+        constexpr Vector2(float x, float y) noexcept : x(x), y(y) {}
+        constexpr Vector2(int x, int y) noexcept : x(static_cast<float>(x)), y(static_cast<float>(y)) {}
+        constexpr Vector2(uint32_t x, uint32_t y) noexcept : x(static_cast<float>(x)), y(static_cast<float>(y)) {}
+        constexpr Vector2(float x) noexcept : x(x), y(x) {}
+        constexpr Vector2(const Vector2& rhs) noexcept = default;
+        constexpr Vector2& operator=(const Vector2& rhs) noexcept = default;
         ~Vector2() = default;
 
-        [[nodiscard]] const Vector2 operator+(const Vector2& other) const noexcept { return Vector2(x + other.x, y + other.y); }
-        void operator+=(const Vector2& other) noexcept {
+        [[nodiscard]] constexpr Vector2 operator+(const Vector2& other) const noexcept { return Vector2(x + other.x, y + other.y); }
+        constexpr void operator+=(const Vector2& other) noexcept {
             x += other.x; 
             y += other.y; 
         }
 
-        [[nodiscard]] const Vector2 operator*(const Vector2& other) const noexcept { return Vector2(x * other.x, y * other.y); }
-        [[nodiscard]] const Vector2 operator*(const float value)    const noexcept { return Vector2(x * value, y * value); }
+        [[nodiscard]] constexpr Vector2 operator*(const Vector2& other) const noexcept { return Vector2(x * other.x, y * other.y); }
+        [[nodiscard]] constexpr Vector2 operator*(const float value)    const noexcept { return Vector2(x * value, y * value); }
 
-        void operator*=(const Vector2& other) {
+        constexpr void operator*=(const Vector2& other) {
             x *= other.x;
             y *= other.y;
         }
 
-        void operator*=(const float value) {
+        constexpr void operator*=(const float value) {
             x *= value;
             y *= value;
         }
-        [[nodiscard]] const Vector2 operator-(const Vector2 other) const noexcept { return Vector2(x - other.x, y - other.y); }
-        [[nodiscard]] const Vector2 operator-(const float value)   const noexcept { return Vector2(x - value, y - value); }
-        void operator-=(const Vector2 other) { 
+        [[nodiscard]] constexpr Vector2 operator-(const Vector2 other) const noexcept { return Vector2(x - other.x, y - other.y); }
+        [[nodiscard]] constexpr Vector2 operator-(const float value)   const noexcept { return Vector2(x - value, y - value); }
+        constexpr void operator-=(const Vector2 other) { 
             x -= other.x; 
             y -= other.y;
         }
 
-        [[nodiscard]] const Vector2 operator/(const Vector2& other) const noexcept { return Vector2(x / other.x, y / other.y); }
-        [[nodiscard]] const Vector2 operator/(const float value) const noexcept { return Vector2(x / value, y / value); }
+        [[nodiscard]] constexpr Vector2 operator/(const Vector2& other) const noexcept { return Vector2(x / other.x, y / other.y); }
+        [[nodiscard]] constexpr Vector2 operator/(const float value) const noexcept { return Vector2(x / value, y / value); }
 
-        void operator/=(const Vector2& other) noexcept {
+        constexpr void operator/=(const Vector2& other) noexcept {
             x /= other.x;
             y /= other.y;
         }
@@ -52,10 +51,10 @@ namespace Cyrex::Math {
         constexpr bool operator!=(const Vector2& other) const noexcept { return !(*this == other); }
 
         [[nodiscard]] const float Length() const noexcept { return std::sqrt(x * x + y * y); }
-        [[nodiscard]] const float SquaredLength() const noexcept { return x * x + y * y; }
+        [[nodiscard]] constexpr float SquaredLength() const noexcept { return x * x + y * y; }
 
         [[nodiscard]] static const inline float Distance(const Vector2& a, const Vector2& b) noexcept { return (b - a).Length(); }
-        [[nodiscard]] static const inline float SquaredDistance(const Vector2& a, const Vector2& b) noexcept { return (b - a).SquaredLength(); }
+        [[nodiscard]] static constexpr float SquaredDistance(const Vector2& a, const Vector2& b) noexcept { return (b - a).SquaredLength(); }
 
         float x;
         float y;
@@ -63,4 +62,8 @@ namespace Cyrex::Math {
         static const Vector2 Zero;
         static const Vector2 one;
     };
+
+    //Defined out of the class, inside it Vector2 is still incomplete
+    inline constexpr Vector2 Vector2::Zero(0.0f, 0.0f);
+    inline constexpr Vector2 Vector2::one(1.0f, 1.0f);
 }
\ No newline at end of file
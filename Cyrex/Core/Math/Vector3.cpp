@@ -5,8 +5,6 @@
 #include "Matrix.h"
 
 namespace Cyrex::Math {
-    constexpr auto infinity = std::numeric_limits<float>::infinity();
-
     Vector3::Vector3(const Vector4& rhs) noexcept 
         :
         x(rhs.x),
@@ -50,7 +48,7 @@ namespace Cyrex::Math {
         Vector3 row0{ mat.m00,mat.m01, mat.m02 };
         Vector3 row1{ mat.m10,mat.m11, mat.m12 };
         Vector3 row2{ mat.m20,mat.m21, mat.m22 };
-        Vector3 row3{ mat.m20,mat.m21, mat.m22 };
+        Vector3 row3{ mat.m30,mat.m31, mat.m32 };
 
         Vector3 X = Vector3(vec3.x);
         Vector3 Y = Vector3(vec3.y);
@@ -60,24 +58,7 @@ namespace Cyrex::Math {
         Result         = MultiplyAdd(Y, row1, Result);
         Result         = MultiplyAdd(X, row0, Result);
 
-        Vector3 W = Vector3(Result.z);
-        return Result /  W;
-    }
-
-    Vector3 Vector3::MultiplyAdd(const Vector3& first, const Vector3& second, const Vector3& third) noexcept {
-        return Vector3(first.x * second.x + third.x,
-                       first.y * second.y + third.y,
-                       first.z * second.z + third.z);
+        const float W = vec3.x * mat.m03 + vec3.y * mat.m13 + vec3.z * mat.m23 + mat.m33;
+        return Result / W;
     }
-
-    const Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
-    const Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
-    const Vector3 Vector3::Left(-1.0f, 0.0f, 0.0f);
-    const Vector3 Vector3::Right(1.0f, 0.0f, 0.0f);
-    const Vector3 Vector3::Up(0.0f, 1.0f, 0.0f);
-    const Vector3 Vector3::Down(0.0f, -1.0f, 0.0f);
-    const Vector3 Vector3::Forward(0.0f, 0.0f, 1.0f);
-    const Vector3 Vector3::Backward(0.0f, 0.0f, -1.0f);
-    const Vector3 Vector3::Infinity(infinity, infinity, infinity);
-    const Vector3 Vector3::InfinityNeg(-infinity, -infinity, -infinity);
 }
\ No newline at end of file
@@ -10,47 +10,40 @@ namespace Cyrex::Math {
     class Matrix;
     class Vector3 {
     public:
-        Vector3() noexcept : x(0), y(0), z(0) {}
-        Vector3(float x, float y, float z)  : x(x), y(y), z(0) {}
-        Vector3(float v) noexcept : x(v), y(v), z(v) {}
-        Vector3(const Vector3& rhs) noexcept {
-            x = rhs.x;
-            y = rhs.y;
-            z = rhs.z;
-        }
+        constexpr Vector3() noexcept : x(0), y(0), z(0) {}
+        constexpr Vector3(float x, float y, float z) noexcept : x(x), y(y), z(z) {}
+        constexpr Vector3(float v) noexcept : x(v), y(v), z(v) {}
+        constexpr Vector3(const Vector3& rhs) noexcept = default;
         Vector3(const Vector2& rhs) noexcept;
         Vector3(const Vector4& rhs) noexcept;
-        Vector3(float vec[3]) noexcept {
-            x = vec[0];
-            y = vec[1];
-            z = vec[2];
-        }
+        constexpr Vector3(const float vec[3]) noexcept : x(vec[0]), y(vec[1]), z(vec[2]) {}
+        constexpr Vector3& operator=(const Vector3& rhs) noexcept = default;
         ~Vector3() = default;
 
-        [[nodiscard]] const Vector3 operator+(const Vector3& rhs) const noexcept { 
+        [[nodiscard]] constexpr Vector3 operator+(const Vector3& rhs) const noexcept { 
             return Vector3(
                 x + rhs.x, 
                 y + rhs.y, 
                 z + rhs.z
             ); 
         }
-        [[nodiscard]] const Vector3 operator+(const float v) const noexcept { 
+        [[nodiscard]] constexpr Vector3 operator+(const float v) const noexcept { 
             return Vector3(x + v, y + v, z + v); 
         }
-        void operator+=(const Vector3& rhs) noexcept {
+        constexpr void operator+=(const Vector3& rhs) noexcept {
             x += rhs.x;
             y += rhs.y;
             z += rhs.z;
         }
 
-        [[nodiscard]] const Vector3 operator*(const Vector3& rhs) const noexcept { 
+        [[nodiscard]] constexpr Vector3 operator*(const Vector3& rhs) const noexcept { 
             return Vector3(
                 x * rhs.x,
                 y * rhs.y, 
                 z * rhs.z
             ); 
         }
-        [[nodiscard]] const Vector3 operator*(const float value) const  noexcept { 
+        [[nodiscard]] constexpr Vector3 operator*(const float value) const  noexcept { 
             return Vector3(
                 x * value,
                 y * value, 
@@ -58,55 +51,55 @@ namespace Cyrex::Math {
             ); 
         }
 
-        void operator*=(const Vector3& other) noexcept {
+        constexpr void operator*=(const Vector3& other) noexcept {
             x *= other.x;
             y *= other.y;
             z *= other.z;
         }
 
-        void operator*=(const float value) noexcept {
+        constexpr void operator*=(const float value) noexcept {
             x *= value;
             y *= value;
             z *= value;
         }
 
-        [[nodiscard]] const Vector3 operator-(const Vector3 rhs) const noexcept { 
+        [[nodiscard]] constexpr Vector3 operator-(const Vector3 rhs) const noexcept { 
             return Vector3(
                 x - rhs.x, 
                 y - rhs.y, 
                 z - rhs.z
             );
         }
-        [[nodiscard]] const Vector3 operator-(const float value) const noexcept {
+        [[nodiscard]] constexpr Vector3 operator-(const float value) const noexcept {
             return Vector3(
                 x - value, 
                 y - value, 
                 z - value
             ); 
         }
-        void operator-=(const Vector3 other) {
+        constexpr void operator-=(const Vector3 other) {
             x -= other.x;
             y -= other.y;
             z -= other.z;
         }
 
-        [[nodiscard]] const Vector3 operator/(const Vector3& rhs) const noexcept {
+        [[nodiscard]] constexpr Vector3 operator/(const Vector3& rhs) const noexcept {
             return Vector3(
                 x / rhs.x,
                 y / rhs.y,
                 z / rhs.z); 
         }
-        [[nodiscard]] const Vector3 operator/(const float value) const noexcept { 
+        [[nodiscard]] constexpr Vector3 operator/(const float value) const noexcept { 
             return Vector3(
                 x / value, 
                 y / value,
                 z / value); 
         }
 
-        void operator/=(const Vector3& other) noexcept {
+        constexpr void operator/=(const Vector3& other) noexcept {
             x /= other.x;
             y /= other.y;
-            z /= other.y;
+            z /= other.z;
         }
 
         constexpr bool operator==(const Vector3& rhs) const noexcept { return x == rhs.x && y == rhs.y && z == rhs.z; }
@@ -135,10 +128,10 @@ namespace Cyrex::Math {
         }
 
         [[nodiscard]] constexpr float Dot(const Vector3& rhs) const noexcept { return Dot(*this, rhs); }
-        [[nodiscard]] const Vector3 Cross(const Vector3& rhs) const noexcept { return Cross(*this, rhs); }
+        [[nodiscard]] constexpr Vector3 Cross(const Vector3& rhs) const noexcept { return Cross(*this, rhs); }
 
         [[nodiscard]] const float Length() const noexcept        { return std::sqrt(x * x + y * y + z * z); }
-        [[nodiscard]] const float SquaredLength() const noexcept { return x * x + y * y + z * z; }
+        [[nodiscard]] constexpr float SquaredLength() const noexcept { return x * x + y * y + z * z; }
 
         inline void ClampMagnitude(float maxLength) noexcept {
             const auto squaredMagnitude = SquaredLength();
@@ -165,26 +158,30 @@ namespace Cyrex::Math {
         [[nodiscard]] Vector3 Abs() const noexcept { return Vector3(std::abs(x), std::abs(y), std::abs(z)); }
 
         [[nodiscard]] const inline float Distance(const Vector3& rhs)        const noexcept { return (*this - rhs).Length(); }
-        [[nodiscard]] const inline float SquaredDistance(const Vector3& rhs) const noexcept { return (*this - rhs).SquaredLength(); }
+        [[nodiscard]] constexpr float SquaredDistance(const Vector3& rhs) const noexcept { return (*this - rhs).SquaredLength(); }
 
         [[nodiscard]] static constexpr inline float Dot(const Vector3& v1, const Vector3& v2) noexcept {
             return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
         }
-        [[nodiscard]] static const inline Vector3 Cross(const Vector3& v1, const Vector3& v2) noexcept {
+        [[nodiscard]] static constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) noexcept {
             return Vector3(
                 v1.y * v2.z - v2.y * v1.z,
                 -(v1.x * v2.z - v2.x * v1.z),
-                v1.x * v2.y - v2.x * v2.y
+                v1.x * v2.y - v2.x * v1.y
             );
         }
         [[nodiscard]] static const inline Vector3 Normalize(const Vector3& rhs) noexcept { return rhs.Normalized(); }
         [[nodiscard]] static const inline float Distance(const Vector3& a, const Vector3& b)        noexcept { return (b - a).Length(); }
-        [[nodiscard]] static const inline float SquaredDistance(const Vector3& a, const Vector3& b) noexcept { return (b - a).SquaredLength(); }
+        [[nodiscard]] static constexpr float SquaredDistance(const Vector3& a, const Vector3& b) noexcept { return (b - a).SquaredLength(); }
 
         [[nodiscard]] static Vector3 Rotate(const Vector3& vec3, const Quaternion& rotation) noexcept;
         [[nodiscard]] static Vector3 TransformNormal(const Vector3& vec3, const Matrix& mat) noexcept;
         [[nodiscard]] static Vector3 TransformCoord(const Vector3& vec3, const Matrix& mat) noexcept;
-        [[nodiscard]] static Vector3 MultiplyAdd(const Vector3& first, const Vector3& second, const Vector3& third) noexcept;
+        [[nodiscard]] static constexpr Vector3 MultiplyAdd(const Vector3& first, const Vector3& second, const Vector3& third) noexcept {
+            return Vector3(first.x * second.x + third.x,
+                           first.y * second.y + third.y,
+                           first.z * second.z + third.z);
+        }
 
         float x;
         float y;
@@ -202,5 +199,17 @@ namespace Cyrex::Math {
         static const Vector3 InfinityNeg;
     };
 
-    inline Vector3 operator*(float val, const Vector3& rhs) { return rhs * val; }
+    constexpr Vector3 operator*(float val, const Vector3& rhs) noexcept { return rhs * val; }
+
+    //Defined out of the class, inside it Vector3 is still incomplete
+    inline constexpr Vector3 Vector3::Zero(0.0f, 0.0f, 0.0f);
+    inline constexpr Vector3 Vector3::One(1.0f, 1.0f, 1.0f);
+    inline constexpr Vector3 Vector3::Left(-1.0f, 0.0f, 0.0f);
+    inline constexpr Vector3 Vector3::Right(1.0f, 0.0f, 0.0f);
+    inline constexpr Vector3 Vector3::Up(0.0f, 1.0f, 0.0f);
+    inline constexpr Vector3 Vector3::Down(0.0f, -1.0f, 0.0f);
+    inline constexpr Vector3 Vector3::Forward(0.0f, 0.0f, 1.0f);
+    inline constexpr Vector3 Vector3::Backward(0.0f, 0.0f, -1.0f);
+    inline constexpr Vector3 Vector3::Infinity(std::numeric_limits<float>::infinity());
+    inline constexpr Vector3 Vector3::InfinityNeg(-std::numeric_limits<float>::infinity());
 }
\ No newline at end of file
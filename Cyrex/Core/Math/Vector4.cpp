@@ -90,17 +90,4 @@ namespace Cyrex::Math {
         Vector4 W = Vector4(Result.w);
         return Result / W;
     }
-
-    Vector4 Vector4::MultiplyAdd(const Vector4& first, const Vector4& second, const Vector4& third) noexcept {
-        return Vector4(first.x  * second.x + third.x,
-                        first.y * second.y + third.y,
-                        first.z * second.z + third.z,
-                        first.w * second.w + third.w);
-    }
-    constexpr auto inf = std::numeric_limits<float>::infinity();
-
-    const Vector4 Vector4::One(1.0f, 1.0f, 1.0f, 1.0f);
-    const Vector4 Vector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
-    const Vector4 Vector4::Infinity(inf, inf, inf, inf);
-    const Vector4 Vector4::InfinityNeg(-inf, -inf, -inf, -inf);
 }
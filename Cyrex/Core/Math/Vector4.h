@@ -9,22 +9,22 @@ namespace Cyrex::Math {
     class Matrix;
     class Vector4 {
     public:
-        Vector4() noexcept : x(0), y(0), z(0), w(0) {}
-        Vector4(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
-        Vector4(float v) noexcept : x(v), y(v), z(v), w(v) {}
+        constexpr Vector4() noexcept : x(0), y(0), z(0), w(0) {}
+        constexpr Vector4(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+        constexpr Vector4(float v) noexcept : x(v), y(v), z(v), w(v) {}
         Vector4(const Vector3& vec3, float w);
         Vector4(const Vector3& vec3);
         Vector4(const Quaternion& quat);
         ~Vector4() = default;
 
-        [[nodiscard]] const bool operator ==(const Vector4 rhs) const noexcept {
+        [[nodiscard]] constexpr bool operator ==(const Vector4 rhs) const noexcept {
             return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w;
         }
-        [[nodiscard]] const bool operator !=(const Vector4 rhs) const noexcept {
+        [[nodiscard]] constexpr bool operator !=(const Vector4 rhs) const noexcept {
             return !(*this == rhs);
         }
 
-        [[nodiscard]] const Vector4 operator*(const float value) const noexcept {
+        [[nodiscard]] constexpr Vector4 operator*(const float value) const noexcept {
             return Vector4(
                 x * value,
                 y * value,
@@ -33,13 +33,13 @@ namespace Cyrex::Math {
             );
         }
 
-        void operator*=(const float value) noexcept {
+        constexpr void operator*=(const float value) noexcept {
             x *= value;
             y *= value;
             z *= value;
             w *= value;
         }
-        const Vector4 operator*(const float val) noexcept {
+        constexpr Vector4 operator*(const float val) noexcept {
             return Vector4(
                 x * val,
                 y * val,
@@ -48,7 +48,7 @@ namespace Cyrex::Math {
             );
         }
         
-        [[nodiscard]] const Vector4 operator*(const Vector4& rhs) const noexcept {
+        [[nodiscard]] constexpr Vector4 operator*(const Vector4& rhs) const noexcept {
             return Vector4(
                 x * rhs.x,
                 y * rhs.y,
@@ -56,45 +56,45 @@ namespace Cyrex::Math {
                 w * rhs.w
             );
         }
-        void operator*=(const Vector4& rhs) noexcept {
+        constexpr void operator*=(const Vector4& rhs) noexcept {
             x *= rhs.x;
             y *= rhs.y;
             z *= rhs.z;
             w *= rhs.w;
         }
 
-        [[nodiscard]] const Vector4 operator+(const float v) const noexcept {
+        [[nodiscard]] constexpr Vector4 operator+(const float v) const noexcept {
             return Vector4(x + v, y + v, z + v, w);
         }
 
-        [[nodiscard]] const Vector4 operator+(const Vector4& rhs) const noexcept {
+        [[nodiscard]] constexpr Vector4 operator+(const Vector4& rhs) const noexcept {
             return Vector4(x + rhs.x, y + rhs.y, z + rhs.z, w);
         }
-        void operator+=(const Vector4& rhs) noexcept {
+        constexpr void operator+=(const Vector4& rhs) noexcept {
             x += rhs.x;
             y += rhs.y;
             z += rhs.z;
         }
 
-        [[nodiscard]] const Vector4 operator/(const Vector4& rhs) const noexcept {
+        [[nodiscard]] constexpr Vector4 operator/(const Vector4& rhs) const noexcept {
             return Vector4(
                 x / rhs.x,
                 y / rhs.y,
                 z / rhs.z,
                 w / rhs.w);
         }
-        void operator/=(const Vector4& rhs) noexcept {
+        constexpr void operator/=(const Vector4& rhs) noexcept {
             x /= rhs.x;
             y /= rhs.y;
-            z /= rhs.y;
+            z /= rhs.z;
             w /= rhs.w;
         }
-        [[nodiscard]] const Vector4 operator /(const float val) const noexcept {
+        [[nodiscard]] constexpr Vector4 operator /(const float val) const noexcept {
             return Vector4(x / val, y / val, z / val, w / val);
         }
 
         [[nodiscard]] const float Length()        const noexcept { return std::sqrt(x * x + y * y + z * z + w * w); }
-        [[nodiscard]] const float SquaredLength() const noexcept { return x * x + y * y + z * z + w * w; }
+        [[nodiscard]] constexpr float SquaredLength() const noexcept { return x * x + y * y + z * z + w * w; }
 
         void Normalize() noexcept {
             const auto length_squared = SquaredLength();
@@ -119,12 +119,17 @@ namespace Cyrex::Math {
         }
 
         [[nodiscard]] static const Vector4 Normalize(const Vector4 rhs) noexcept { return rhs.Normalized(); };
-        [[nodiscard]] static const Vector4 Negate(const Vector4 vec4) noexcept { return Vector4(-vec4.x, -vec4.y, -vec4.z, vec4.w); }
+        [[nodiscard]] static constexpr Vector4 Negate(const Vector4 vec4) noexcept { return Vector4(-vec4.x, -vec4.y, -vec4.z, vec4.w); }
         [[nodiscard]] static Vector4 Rotate(const Vector4& vec4, const Quaternion& rotation) noexcept;
         [[nodiscard]] static Vector4 TransformNormal(const Vector4& vec4, const Matrix& mat) noexcept;
         [[nodiscard]] static Vector4 TransformCoord(const Vector4& vec4, const Matrix& mat) noexcept;
         [[nodiscard]] static Vector4 Transform(const Vector4& vec4, const Matrix& mat) noexcept;
-        [[nodiscard]] static Vector4 MultiplyAdd(const Vector4& first, const Vector4& second, const Vector4& third) noexcept;
+        [[nodiscard]] static constexpr Vector4 MultiplyAdd(const Vector4& first, const Vector4& second, const Vector4& third) noexcept {
+            return Vector4(first.x * second.x + third.x,
+                           first.y * second.y + third.y,
+                           first.z * second.z + third.z,
+                           first.w * second.w + third.w);
+        }
 
         float x;
         float y;
@@ -136,4 +141,10 @@ namespace Cyrex::Math {
         static const Vector4 Infinity;
         static const Vector4 InfinityNeg;
     };
+
+    //Defined out of the class, inside it Vector4 is still incomplete
+    inline constexpr Vector4 Vector4::One(1.0f, 1.0f, 1.0f, 1.0f);
+    inline constexpr Vector4 Vector4::Zero(0.0f, 0.0f, 0.0f, 0.0f);
+    inline constexpr Vector4 Vector4::Infinity(std::numeric_limits<float>::infinity());
+    inline constexpr Vector4 Vector4::InfinityNeg(-std::numeric_limits<float>::infinity());
 }
\ No newline at end of file
@@ -0,0 +1,440 @@
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include "Logger.h"
+#endif
+
+using namespace Cyrex;
+
+namespace {
+    //Threads keep their own counters and hand them to the shared ones once the live bytes of a tag
+    //moved this far, so an allocation costs no locked instruction. The peaks only see flushed bytes
+    //and can miss up to this much per thread and tag.
+    constexpr int64_t FlushThreshold = 64 * 1024;
+
+    //Every tag gets its own cache line so flushes of different tags do not contend
+    struct alignas(64) TagCounters {
+        std::atomic<int64_t> LiveBytes{ 0 };
+        std::atomic<int64_t> PeakBytes{ 0 };
+        std::atomic<int64_t> LiveAllocations{ 0 };
+        std::atomic<int64_t> TotalAllocations{ 0 };
+        std::atomic<int64_t> TotalBytes{ 0 };
+        std::atomic<size_t> Budget{ 0 };
+    };
+
+    //Only the owning thread writes these, TakeSnapshot reads them from any thread
+    struct PendingCounters {
+        std::atomic<int64_t> LiveBytes{ 0 };
+        std::atomic<int64_t> LiveAllocations{ 0 };
+        std::atomic<int64_t> TotalAllocations{ 0 };
+        std::atomic<int64_t> TotalBytes{ 0 };
+    };
+
+    struct ThreadCounters {
+        std::array<PendingCounters, MemorySnapshot::NumTags> Tags{};
+        ThreadCounters* Next = nullptr;
+        bool IsRegistered = false;
+
+        ~ThreadCounters();
+    };
+
+    //Constant initialized, allocations made before main are tracked as well
+    constinit std::array<TagCounters, MemorySnapshot::NumTags> s_counters{};
+    constinit thread_local MemoryTag t_memoryTag = MemoryTag::General;
+
+    //Guards the thread list and the flushes, a spin lock because it is taken from operator new
+    constinit std::atomic_flag s_threadsLock;
+    constinit ThreadCounters* s_threads = nullptr;
+
+    constinit thread_local ThreadCounters t_counters;
+    //Memory freed by later thread_local destructors goes straight to the shared counters
+    constinit thread_local bool t_countersDestroyed = false;
+
+    std::mutex s_frameMutex;
+    MemorySnapshot s_frameStart;
+    MemorySnapshot s_lastFrame;
+    std::array<bool, MemorySnapshot::NumTags> s_overBudget{};
+
+    class ThreadsLock {
+    public:
+        ThreadsLock() noexcept {
+            while (s_threadsLock.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        ThreadsLock(const ThreadsLock& rhs) = delete;
+        ThreadsLock& operator=(const ThreadsLock& rhs) = delete;
+
+        ~ThreadsLock() { s_threadsLock.clear(std::memory_order_release); }
+    };
+
+    TagCounters& GetCounters(MemoryTag tag) noexcept {
+        return s_counters[static_cast<size_t>(tag)];
+    }
+
+    void Add(std::atomic<int64_t>& counter, int64_t value) noexcept {
+        //A single writer, the load and store need no read-modify-write
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    //Moves the pending counters into the shared ones, the caller holds the threads lock
+    void FlushLocked(TagCounters& counters, PendingCounters& pending) noexcept {
+        const auto liveBytes = pending.LiveBytes.load(std::memory_order_relaxed);
+        const auto live      = counters.LiveBytes.fetch_add(liveBytes, std::memory_order_relaxed) + liveBytes;
+
+        counters.LiveAllocations.fetch_add(pending.LiveAllocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        counters.TotalAllocations.fetch_add(pending.TotalAllocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        counters.TotalBytes.fetch_add(pending.TotalBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        pending.LiveBytes.store(0, std::memory_order_relaxed);
+        pending.LiveAllocations.store(0, std::memory_order_relaxed);
+        pending.TotalAllocations.store(0, std::memory_order_relaxed);
+        pending.TotalBytes.store(0, std::memory_order_relaxed);
+
+        auto peak = counters.PeakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counters.PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    }
+
+    void Flush(MemoryTag tag, PendingCounters& pending) noexcept {
+        ThreadsLock lock;
+        FlushLocked(GetCounters(tag), pending);
+    }
+
+    //Null once the thread's counters are destroyed
+    ThreadCounters* GetThreadCounters() noexcept {
+        if (t_countersDestroyed) [[unlikely]] {
+            return nullptr;
+        }
+
+        if (!t_counters.IsRegistered) [[unlikely]] {
+            ThreadsLock lock;
+
+            t_counters.Next         = s_threads;
+            t_counters.IsRegistered = true;
+            s_threads               = &t_counters;
+        }
+
+        return &t_counters;
+    }
+
+    ThreadCounters::~ThreadCounters() {
+        if (IsRegistered) {
+            ThreadsLock lock;
+
+            for (size_t i = 0; i < MemorySnapshot::NumTags; ++i) {
+                FlushLocked(s_counters[i], Tags[i]);
+            }
+
+            auto link = &s_threads;
+            while (*link != this) {
+                link = &(*link)->Next;
+            }
+            *link = Next;
+        }
+
+        t_countersDestroyed = true;
+    }
+}
+
+const char* Cyrex::ToString(MemoryTag tag) noexcept {
+    switch (tag) {
+    case MemoryTag::General:     return "General";
+    case MemoryTag::Graphics:    return "Graphics";
+    case MemoryTag::SceneImport: return "SceneImport";
+    case MemoryTag::SceneGraph:  return "SceneGraph";
+    case MemoryTag::Textures:    return "Textures";
+    case MemoryTag::FrameArena:  return "FrameArena";
+    case MemoryTag::Logging:     return "Logging";
+    default:                     return "Unknown";
+    }
+}
+
+MemoryTagStats MemorySnapshot::GetTotal() const noexcept {
+    MemoryTagStats total;
+
+    for (const auto& stats : Tags) {
+        total.LiveBytes        += stats.LiveBytes;
+        total.PeakBytes        += stats.PeakBytes;
+        total.LiveAllocations  += stats.LiveAllocations;
+        total.TotalAllocations += stats.TotalAllocations;
+        total.TotalBytes       += stats.TotalBytes;
+    }
+
+    return total;
+}
+
+MemorySnapshot MemorySnapshot::operator-(const MemorySnapshot& earlier) const noexcept {
+    MemorySnapshot diff;
+
+    for (size_t i = 0; i < NumTags; ++i) {
+        diff.Tags[i].LiveBytes        = Tags[i].LiveBytes        - earlier.Tags[i].LiveBytes;
+        diff.Tags[i].PeakBytes        = Tags[i].PeakBytes;
+        diff.Tags[i].LiveAllocations  = Tags[i].LiveAllocations  - earlier.Tags[i].LiveAllocations;
+        diff.Tags[i].TotalAllocations = Tags[i].TotalAllocations - earlier.Tags[i].TotalAllocations;
+        diff.Tags[i].TotalBytes       = Tags[i].TotalBytes       - earlier.Tags[i].TotalBytes;
+    }
+
+    return diff;
+}
+
+void MemorySnapshot::WriteCsv(std::ostream& os) const {
+    os << "Tag,LiveBytes,PeakBytes,LiveAllocations,TotalAllocations,TotalBytes\n";
+
+    for (size_t i = 0; i < NumTags; ++i) {
+        const auto& stats = Tags[i];
+
+        os << Cyrex::ToString(static_cast<MemoryTag>(i)) << ','
+           << stats.LiveBytes << ',' << stats.PeakBytes << ',' << stats.LiveAllocations << ','
+           << stats.TotalAllocations << ',' << stats.TotalBytes << '\n';
+    }
+}
+
+std::string MemorySnapshot::ToString() const {
+    std::ostringstream oss;
+    WriteCsv(oss);
+    return oss.str();
+}
+
+void MemoryTracker::OnAllocate(MemoryTag tag, size_t size) noexcept {
+    const auto bytes = static_cast<int64_t>(size);
+
+    if (const auto threadCounters = GetThreadCounters()) [[likely]] {
+        auto& pending = threadCounters->Tags[static_cast<size_t>(tag)];
+
+        Add(pending.LiveBytes, bytes);
+        Add(pending.LiveAllocations, 1);
+        Add(pending.TotalAllocations, 1);
+        Add(pending.TotalBytes, bytes);
+
+        if (pending.LiveBytes.load(std::memory_order_relaxed) >= FlushThreshold) {
+            Flush(tag, pending);
+        }
+    }
+    else {
+        PendingCounters pending;
+        pending.LiveBytes        = bytes;
+        pending.LiveAllocations  = 1;
+        pending.TotalAllocations = 1;
+        pending.TotalBytes       = bytes;
+
+        Flush(tag, pending);
+    }
+}
+
+void MemoryTracker::OnDeallocate(MemoryTag tag, size_t size) noexcept {
+    const auto bytes = static_cast<int64_t>(size);
+
+    if (const auto threadCounters = GetThreadCounters()) [[likely]] {
+        auto& pending = threadCounters->Tags[static_cast<size_t>(tag)];
+
+        Add(pending.LiveBytes, -bytes);
+        Add(pending.LiveAllocations, -1);
+
+        //Memory freed by another thread than the one that allocated it drives these negative
+        if (pending.LiveBytes.load(std::memory_order_relaxed) <= -FlushThreshold) {
+            Flush(tag, pending);
+        }
+    }
+    else {
+        PendingCounters pending;
+        pending.LiveBytes       = -bytes;
+        pending.LiveAllocations = -1;
+
+        Flush(tag, pending);
+    }
+}
+
+MemoryTag MemoryTracker::GetThreadTag() noexcept {
+    return t_memoryTag;
+}
+
+MemoryTag MemoryTracker::SetThreadTag(MemoryTag tag) noexcept {
+    return std::exchange(t_memoryTag, tag);
+}
+
+MemorySnapshot MemoryTracker::TakeSnapshot() noexcept {
+    MemorySnapshot snapshot;
+
+    ThreadsLock lock;
+
+    for (size_t i = 0; i < MemorySnapshot::NumTags; ++i) {
+        const auto& counters = s_counters[i];
+        auto& stats          = snapshot.Tags[i];
+
+        stats.LiveBytes        = counters.LiveBytes.load(std::memory_order_relaxed);
+        stats.PeakBytes        = counters.PeakBytes.load(std::memory_order_relaxed);
+        stats.LiveAllocations  = counters.LiveAllocations.load(std::memory_order_relaxed);
+        stats.TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed);
+        stats.TotalBytes       = counters.TotalBytes.load(std::memory_order_relaxed);
+
+        //A thread that is allocating right now can be one allocation ahead in some of its counters
+        for (auto threadCounters = s_threads; threadCounters; threadCounters = threadCounters->Next) {
+            const auto& pending = threadCounters->Tags[i];
+
+            stats.LiveBytes        += pending.LiveBytes.load(std::memory_order_relaxed);
+            stats.LiveAllocations  += pending.LiveAllocations.load(std::memory_order_relaxed);
+            stats.TotalAllocations += pending.TotalAllocations.load(std::memory_order_relaxed);
+            stats.TotalBytes       += pending.TotalBytes.load(std::memory_order_relaxed);
+        }
+
+        stats.PeakBytes = std::max(stats.PeakBytes, stats.LiveBytes);
+    }
+
+    return snapshot;
+}
+
+void MemoryTracker::SetBudget(MemoryTag tag, size_t bytes) noexcept {
+    GetCounters(tag).Budget.store(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::GetBudget(MemoryTag tag) noexcept {
+    return GetCounters(tag).Budget.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::EndFrame() {
+    const auto snapshot = TakeSnapshot();
+
+    std::lock_guard<std::mutex> lock(s_frameMutex);
+
+    s_lastFrame  = snapshot - s_frameStart;
+    s_frameStart = snapshot;
+
+    for (size_t i = 0; i < MemorySnapshot::NumTags; ++i) {
+        const auto budget    = static_cast<int64_t>(s_counters[i].Budget.load(std::memory_order_relaxed));
+        const auto overBudget = budget != 0 && snapshot.Tags[i].LiveBytes > budget;
+
+        if (overBudget && !s_overBudget[i]) {
+#ifdef _WIN32
+            crxlog::warn("Memory tag ", Cyrex::ToString(static_cast<MemoryTag>(i)), " is over budget: ",
+                snapshot.Tags[i].LiveBytes / 1024, " KiB of ", budget / 1024, " KiB");
+#else
+            std::fprintf(stderr, "Memory tag %s is over budget: %lld KiB of %lld KiB\n", Cyrex::ToString(static_cast<MemoryTag>(i)),
+                static_cast<long long>(snapshot.Tags[i].LiveBytes / 1024), static_cast<long long>(budget / 1024));
+#endif
+        }
+
+        s_overBudget[i] = overBudget;
+    }
+}
+
+MemorySnapshot MemoryTracker::GetLastFrame() {
+    std::lock_guard<std::mutex> lock(s_frameMutex);
+    return s_lastFrame;
+}
+
+#if CRX_MEMORY_TRACKING
+namespace {
+    //Sits right in front of every tracked allocation, so delete knows what to give back
+    struct alignas(16) AllocationHeader {
+        size_t Size;
+        uint32_t Offset;
+        MemoryTag Tag;
+    };
+
+    static_assert(sizeof(AllocationHeader) == 16);
+
+    void* TrackedAllocate(size_t size, size_t alignment) noexcept {
+        const auto offset = std::max(sizeof(AllocationHeader), alignment);
+
+        void* block = nullptr;
+
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            block = std::malloc(size + offset);
+        }
+        else {
+#ifdef _WIN32
+            block = _aligned_malloc(size + offset, alignment);
+#else
+            block = std::aligned_alloc(alignment, (size + offset + alignment - 1) & ~(alignment - 1));
+#endif
+        }
+
+        if (!block) [[unlikely]] {
+            return nullptr;
+        }
+
+        const auto tag    = t_memoryTag;
+        const auto ptr    = static_cast<std::byte*>(block) + offset;
+        const auto header = reinterpret_cast<AllocationHeader*>(ptr) - 1;
+
+        header->Size   = size;
+        header->Offset = static_cast<uint32_t>(offset);
+        header->Tag    = tag;
+
+        MemoryTracker::OnAllocate(tag, size);
+        return ptr;
+    }
+
+    void TrackedDeallocate(void* ptr, bool aligned) noexcept {
+        if (!ptr) {
+            return;
+        }
+
+        const auto header = reinterpret_cast<AllocationHeader*>(ptr) - 1;
+        const auto block  = static_cast<std::byte*>(ptr) - header->Offset;
+
+        MemoryTracker::OnDeallocate(header->Tag, header->Size);
+
+        if (aligned) {
+#ifdef _WIN32
+            _aligned_free(block);
+#else
+            std::free(block);
+#endif
+        }
+        else {
+            std::free(block);
+        }
+    }
+
+    void* TrackedNew(size_t size, size_t alignment) {
+        while (true) {
+            if (const auto ptr = TrackedAllocate(size, alignment)) [[likely]] {
+                return ptr;
+            }
+
+            const auto handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    bool IsOverAligned(std::align_val_t alignment) noexcept {
+        return static_cast<size_t>(alignment) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    }
+}
+
+void* operator new(size_t size) { return TrackedNew(size, 0); }
+void* operator new[](size_t size) { return TrackedNew(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return TrackedNew(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return TrackedNew(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* ptr) noexcept { TrackedDeallocate(ptr, false); }
+void operator delete[](void* ptr) noexcept { TrackedDeallocate(ptr, false); }
+void operator delete(void* ptr, size_t) noexcept { TrackedDeallocate(ptr, false); }
+void operator delete[](void* ptr, size_t) noexcept { TrackedDeallocate(ptr, false); }
+void operator delete(void* ptr, std::align_val_t alignment) noexcept { TrackedDeallocate(ptr, IsOverAligned(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept { TrackedDeallocate(ptr, IsOverAligned(alignment)); }
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept { TrackedDeallocate(ptr, IsOverAligned(alignment)); }
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept { TrackedDeallocate(ptr, IsOverAligned(alignment)); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { TrackedDeallocate(ptr, false); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { TrackedDeallocate(ptr, false); }
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedDeallocate(ptr, IsOverAligned(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedDeallocate(ptr, IsOverAligned(alignment)); }
+#endif
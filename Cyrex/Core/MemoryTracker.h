@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+//Set to 0 to stop replacing the global operator new/delete
+#ifndef CRX_MEMORY_TRACKING
+#define CRX_MEMORY_TRACKING 1
+#endif
+
+namespace Cyrex {
+    //Every heap allocation is charged to the tag of the thread that made it
+    enum class MemoryTag : uint8_t {
+        General,
+        Graphics,
+        SceneImport,
+        SceneGraph,
+        Textures,
+        FrameArena,
+        Logging,
+        Count
+    };
+
+    [[nodiscard]] const char* ToString(MemoryTag tag) noexcept;
+
+    struct MemoryTagStats {
+        int64_t LiveBytes{ 0 };
+        int64_t PeakBytes{ 0 };
+        int64_t LiveAllocations{ 0 };
+        int64_t TotalAllocations{ 0 };
+        int64_t TotalBytes{ 0 };
+    };
+
+    struct MemorySnapshot {
+        static constexpr size_t NumTags = static_cast<size_t>(MemoryTag::Count);
+
+        std::array<MemoryTagStats, NumTags> Tags{};
+
+        [[nodiscard]] const MemoryTagStats& operator[](MemoryTag tag) const noexcept { return Tags[static_cast<size_t>(tag)]; }
+        [[nodiscard]] MemoryTagStats GetTotal() const noexcept;
+
+        //What happened since 'earlier', peaks are kept from this snapshot
+        [[nodiscard]] MemorySnapshot operator-(const MemorySnapshot& earlier) const noexcept;
+
+        void WriteCsv(std::ostream& os) const;
+        [[nodiscard]] std::string ToString() const;
+    };
+
+    class MemoryTracker {
+    public:
+        static void OnAllocate(MemoryTag tag, size_t size) noexcept;
+        static void OnDeallocate(MemoryTag tag, size_t size) noexcept;
+
+        [[nodiscard]] static MemoryTag GetThreadTag() noexcept;
+        //Returns the previous tag
+        static MemoryTag SetThreadTag(MemoryTag tag) noexcept;
+
+        //Sums the shared counters and the ones every running thread has not flushed yet
+        [[nodiscard]] static MemorySnapshot TakeSnapshot() noexcept;
+
+        //A budget of 0 disables the check, EndFrame warns once each time a tag goes over
+        static void SetBudget(MemoryTag tag, size_t bytes) noexcept;
+        [[nodiscard]] static size_t GetBudget(MemoryTag tag) noexcept;
+
+        //Computes the per-frame allocation rates and checks the budgets, called once per frame
+        static void EndFrame();
+        [[nodiscard]] static MemorySnapshot GetLastFrame();
+    };
+
+    class MemoryTagScope {
+    public:
+        explicit MemoryTagScope(MemoryTag tag) noexcept
+            :
+            m_previous(MemoryTracker::SetThreadTag(tag))
+        {}
+
+        MemoryTagScope(const MemoryTagScope& rhs) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope& rhs) = delete;
+
+        ~MemoryTagScope() { MemoryTracker::SetThreadTag(m_previous); }
+    private:
+        MemoryTag m_previous;
+    };
+}
+
+#define CRX_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define CRX_MEMORY_TAG_CONCAT(a, b) CRX_MEMORY_TAG_CONCAT_INNER(a, b)
+#define CRX_MEMORY_TAG(tag) ::Cyrex::MemoryTagScope CRX_MEMORY_TAG_CONCAT(crxMemoryTag, __LINE__)(::Cyrex::MemoryTag::tag)
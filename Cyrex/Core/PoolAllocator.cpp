@@ -0,0 +1,92 @@
+#include "PoolAllocator.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace Cyrex;
+
+namespace {
+    constexpr size_t AlignUp(size_t value, size_t alignment) noexcept {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+SlabPool::SlabPool(size_t slotSize, size_t slotAlignment, size_t slotsPerSlab)
+    :
+    m_slotSize(AlignUp(std::max(slotSize, sizeof(FreeSlot)), std::max(slotAlignment, alignof(FreeSlot)))),
+    m_slabAlignment(std::max({ slotAlignment, alignof(FreeSlot), CacheLineSize })),
+    m_slotsPerSlab(slotsPerSlab ? slotsPerSlab : std::max<size_t>(1, ms_defaultSlabSize / m_slotSize))
+{
+    assert((slotAlignment & (slotAlignment - 1)) == 0 && "Alignment must be a power of two");
+}
+
+SlabPool::~SlabPool() {
+    //Objects that outlive their pool keep their memory, it is leaked instead of pulled from under them
+    if (m_numAllocated != 0) {
+        return;
+    }
+
+    for (const auto slab : m_slabs) {
+        ::operator delete(slab, std::align_val_t(m_slabAlignment));
+    }
+}
+
+void* SlabPool::Allocate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_numAllocated++;
+
+    if (m_freeList) {
+        const auto slot = m_freeList;
+        m_freeList      = slot->Next;
+        return slot;
+    }
+
+    if (m_next == m_end) [[unlikely]] {
+        AddSlab();
+    }
+
+    const auto slot = m_next;
+    m_next += m_slotSize;
+    return slot;
+}
+
+void SlabPool::Deallocate(void* slot) noexcept {
+    if (!slot) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    assert(m_numAllocated > 0);
+    m_numAllocated--;
+
+    m_freeList = ::new (slot) FreeSlot{ m_freeList };
+}
+
+size_t SlabPool::GetNumSlabs() const noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slabs.size();
+}
+
+size_t SlabPool::GetNumAllocated() const noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numAllocated;
+}
+
+void SlabPool::AddSlab() {
+    const auto slabSize = m_slotSize * m_slotsPerSlab;
+    const auto slab     = static_cast<std::byte*>(::operator new(slabSize, std::align_val_t(m_slabAlignment)));
+
+    //Keep the bookkeeping consistent if pushing the slab throws
+    try {
+        m_slabs.push_back(slab);
+    }
+    catch (...) {
+        ::operator delete(slab, std::align_val_t(m_slabAlignment));
+        m_numAllocated--;
+        throw;
+    }
+
+    m_next = slab;
+    m_end  = slab + slabSize;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Cyrex {
+    //Hands out fixed-size slots carved from contiguous, cache-line aligned slabs.
+    //Slots freed earlier are reused first, otherwise slots are taken from the current
+    //slab in address order, so objects created together end up next to each other.
+    class SlabPool {
+    public:
+        static constexpr size_t CacheLineSize = 64;
+
+        SlabPool(size_t slotSize, size_t slotAlignment, size_t slotsPerSlab = 0);
+        SlabPool(const SlabPool& rhs) = delete;
+        SlabPool& operator=(const SlabPool& rhs) = delete;
+        ~SlabPool();
+
+        [[nodiscard]] void* Allocate();
+        void Deallocate(void* slot) noexcept;
+
+        [[nodiscard]] size_t GetSlotSize() const noexcept { return m_slotSize; }
+        [[nodiscard]] size_t GetNumSlabs() const noexcept;
+        [[nodiscard]] size_t GetNumAllocated() const noexcept;
+    private:
+        struct FreeSlot {
+            FreeSlot* Next;
+        };
+
+        void AddSlab();
+
+        static constexpr size_t ms_defaultSlabSize = 64 * 1024;
+
+        const size_t m_slotSize;
+        const size_t m_slabAlignment;
+        const size_t m_slotsPerSlab;
+
+        mutable std::mutex m_mutex;
+        std::vector<std::byte*> m_slabs;
+        FreeSlot* m_freeList{ nullptr };
+        std::byte* m_next{ nullptr };
+        std::byte* m_end{ nullptr };
+        size_t m_numAllocated{ 0 };
+    };
+
+    //One pool per type, shared by every PoolAllocator that allocates that type
+    template<class T>
+    SlabPool& GetSlabPool() {
+        static SlabPool pool(sizeof(T), alignof(T));
+        return pool;
+    }
+
+    //STL allocator for single objects, allocate_shared rebinds it to its control
+    //block so the reference counts and the object share one slot.
+    template<class T>
+    class PoolAllocator {
+    public:
+        using value_type = T;
+
+        PoolAllocator() noexcept = default;
+
+        template<class U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+        [[nodiscard]] T* allocate(size_t count) {
+            if (count == 1) [[likely]] {
+                return static_cast<T*>(GetSlabPool<T>().Allocate());
+            }
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        void deallocate(T* ptr, size_t count) noexcept {
+            if (count == 1) [[likely]] {
+                GetSlabPool<T>().Deallocate(ptr);
+                return;
+            }
+            ::operator delete(ptr, std::align_val_t(alignof(T)));
+        }
+
+        template<class U>
+        bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+    };
+
+    template<class T, class... Args>
+    [[nodiscard]] std::shared_ptr<T> MakePooled(Args&&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+    }
+}
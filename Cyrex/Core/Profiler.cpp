@@ -0,0 +1,223 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace Cyrex;
+
+namespace {
+    thread_local void* t_threadBuffer = nullptr;
+
+    void WriteEscaped(std::ofstream& file, std::string_view text) {
+        for (const auto c : text) {
+            switch (c) {
+            case '"':  file << "\\\""; break;
+            case '\\': file << "\\\\"; break;
+            case '\n': file << "\\n";  break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20) {
+                    file << c;
+                }
+                break;
+            }
+        }
+    }
+}
+
+Profiler& Profiler::Get() noexcept {
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::BeginCapture() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_frameMarkers.clear();
+    m_captureStartTime  = std::chrono::steady_clock::now();
+    m_captureStartTicks = Now();
+
+    //Every thread clears its own buffer the next time it records
+    m_generation.fetch_add(1, std::memory_order_relaxed);
+    m_capturing.store(true, std::memory_order_release);
+}
+
+void Profiler::EndCapture() noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_capturing.store(false, std::memory_order_release);
+
+    m_captureEndTicks = Now();
+    m_captureEndTime  = std::chrono::steady_clock::now();
+}
+
+void Profiler::SetThreadName(std::thread::id thread, std::string_view name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = std::find_if(m_threadNames.begin(), m_threadNames.end(), [thread](const auto& entry) {
+        return entry.first == thread;
+    });
+
+    if (it != m_threadNames.end()) {
+        it->second = name;
+    }
+    else {
+        m_threadNames.emplace_back(thread, name);
+    }
+}
+
+void Profiler::MarkFrame() noexcept {
+    const auto now = Now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_frameThread = std::this_thread::get_id();
+    m_frameIndex++;
+
+    if (IsCapturing()) {
+        m_frameMarkers.push_back({ now, m_frameIndex });
+    }
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end) noexcept {
+    auto& buffer = GetThreadBuffer();
+
+    if (buffer.Generation != m_generation.load(std::memory_order_relaxed)) [[unlikely]] {
+        BeginGeneration(buffer);
+    }
+
+    auto chunk       = buffer.Current;
+    const auto count = chunk->Count.load(std::memory_order_relaxed);
+
+    if (count == Chunk::Capacity) [[unlikely]] {
+        auto next = chunk->Next.load(std::memory_order_relaxed);
+
+        if (!next) {
+            next = buffer.Chunks.emplace_back(std::make_unique<Chunk>()).get();
+            chunk->Next.store(next, std::memory_order_release);
+        }
+
+        buffer.Current = next;
+        Record(name, start, end);
+        return;
+    }
+
+    chunk->Events[count] = { name, start, end };
+    chunk->Count.store(count + 1, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+    if (t_threadBuffer) [[likely]] {
+        return *static_cast<ThreadBuffer*>(t_threadBuffer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& buffer = m_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+    buffer->Owner      = std::this_thread::get_id();
+    buffer->Index      = static_cast<uint32_t>(m_threadBuffers.size());
+    buffer->Generation = m_generation.load(std::memory_order_relaxed);
+    buffer->Head       = buffer->Chunks.emplace_back(std::make_unique<Chunk>()).get();
+    buffer->Current    = buffer->Head;
+
+    t_threadBuffer = buffer.get();
+    return *buffer;
+}
+
+void Profiler::BeginGeneration(ThreadBuffer& buffer) noexcept {
+    for (auto chunk = buffer.Head; chunk; chunk = chunk->Next.load(std::memory_order_relaxed)) {
+        chunk->Count.store(0, std::memory_order_relaxed);
+    }
+
+    buffer.Current    = buffer.Head;
+    buffer.Generation = m_generation.load(std::memory_order_relaxed);
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto generation = m_generation.load(std::memory_order_relaxed);
+
+    const auto elapsedUs    = std::chrono::duration<double, std::micro>(m_captureEndTime - m_captureStartTime).count();
+    const auto elapsedTicks = static_cast<double>(m_captureEndTicks - m_captureStartTicks);
+    const auto ticksToUs    = elapsedTicks > 0.0 ? elapsedUs / elapsedTicks : 0.0;
+
+    const auto toUs = [&](uint64_t ticks) {
+        return static_cast<double>(ticks - m_captureStartTicks) * ticksToUs;
+    };
+
+    char number[128];
+    bool first = true;
+
+    const auto beginEvent = [&] {
+        file << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (const auto& buffer : m_threadBuffers) {
+        const auto name = std::find_if(m_threadNames.begin(), m_threadNames.end(), [&](const auto& entry) {
+            return entry.first == buffer->Owner;
+        });
+
+        beginEvent();
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->Index << ",\"args\":{\"name\":\"";
+
+        if (name != m_threadNames.end()) {
+            WriteEscaped(file, name->second);
+        }
+        else {
+            file << "Thread " << buffer->Index;
+        }
+        file << "\"}}";
+
+        //A thread that has not recorded since the capture began still holds an older capture
+        if (buffer->Generation != generation) {
+            continue;
+        }
+
+        for (auto chunk = buffer->Head; chunk; chunk = chunk->Next.load(std::memory_order_acquire)) {
+            const auto count = chunk->Count.load(std::memory_order_acquire);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const auto& event = chunk->Events[i];
+
+                if (event.Start < m_captureStartTicks || event.End > m_captureEndTicks) {
+                    continue;
+                }
+
+                beginEvent();
+                file << "{\"name\":\"";
+                WriteEscaped(file, event.Name);
+
+                std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    buffer->Index, toUs(event.Start), toUs(event.End) - toUs(event.Start));
+                file << number;
+            }
+        }
+    }
+
+    uint32_t frameThreadIndex = 0;
+
+    for (const auto& buffer : m_threadBuffers) {
+        if (buffer->Owner == m_frameThread) {
+            frameThreadIndex = buffer->Index;
+        }
+    }
+
+    for (const auto& marker : m_frameMarkers) {
+        beginEvent();
+        std::snprintf(number, sizeof(number), "{\"name\":\"Frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+            static_cast<unsigned long long>(marker.Frame), frameThreadIndex, toUs(marker.Time));
+        file << number;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+//Set to 0 to compile every profiling macro out
+#ifndef CRX_PROFILER_ENABLED
+#define CRX_PROFILER_ENABLED 1
+#endif
+
+namespace Cyrex {
+    //Records nested CPU zones into per-thread buffers while a capture is running
+    //and exports them as Chrome trace JSON (chrome://tracing, Perfetto).
+    class Profiler {
+    public:
+        struct Event {
+            const char* Name;
+            uint64_t Start;
+            uint64_t End;
+        };
+
+        static Profiler& Get() noexcept;
+
+        //Clears what the previous capture recorded and starts recording
+        void BeginCapture();
+        void EndCapture() noexcept;
+        [[nodiscard]] bool IsCapturing() const noexcept { return m_capturing.load(std::memory_order_relaxed); }
+
+        //Has to be called after EndCapture and before the next BeginCapture
+        bool ExportChromeTrace(const std::string& path) const;
+
+        void SetThreadName(std::thread::id thread, std::string_view name);
+        void MarkFrame() noexcept;
+
+        void Record(const char* name, uint64_t start, uint64_t end) noexcept;
+
+        [[nodiscard]] static uint64_t Now() noexcept {
+#if defined(_M_X64) || defined(__x86_64__)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+    private:
+        //Events are stored in chunks that never move, so the exporter can read
+        //a chunk while its owner appends to a later one
+        struct Chunk {
+            static constexpr uint32_t Capacity = 4096;
+
+            Event Events[Capacity];
+            std::atomic_uint32_t Count{ 0 };
+            std::atomic<Chunk*> Next{ nullptr };
+        };
+
+        struct ThreadBuffer {
+            std::thread::id Owner;
+            uint32_t Index;
+            uint64_t Generation{ 0 };
+            Chunk* Head;
+            Chunk* Current;
+            std::vector<std::unique_ptr<Chunk>> Chunks;
+        };
+
+        struct FrameMarker {
+            uint64_t Time;
+            uint64_t Frame;
+        };
+
+        Profiler() = default;
+
+        [[nodiscard]] ThreadBuffer& GetThreadBuffer();
+        void BeginGeneration(ThreadBuffer& buffer) noexcept;
+
+        std::atomic_bool m_capturing{ false };
+        std::atomic_uint64_t m_generation{ 0 };
+
+        //Both clocks are sampled at the start and end of a capture to convert ticks to microseconds
+        uint64_t m_captureStartTicks{ 0 };
+        uint64_t m_captureEndTicks{ 0 };
+        std::chrono::steady_clock::time_point m_captureStartTime;
+        std::chrono::steady_clock::time_point m_captureEndTime;
+
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+        std::vector<std::pair<std::thread::id, std::string>> m_threadNames;
+        std::vector<FrameMarker> m_frameMarkers;
+        std::thread::id m_frameThread;
+        uint64_t m_frameIndex{ 0 };
+    };
+
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name) noexcept
+            :
+            m_name(name),
+            m_start(Profiler::Get().IsCapturing() ? Profiler::Now() : 0)
+        {}
+
+        ProfileScope(const ProfileScope& rhs) = delete;
+        ProfileScope& operator=(const ProfileScope& rhs) = delete;
+
+        ~ProfileScope() {
+            if (m_start) {
+                Profiler::Get().Record(m_name, m_start, Profiler::Now());
+            }
+        }
+    private:
+        const char* m_name;
+        uint64_t m_start;
+    };
+}
+
+#if CRX_PROFILER_ENABLED
+#define CRX_PROFILE_CONCAT_INNER(a, b) a##b
+#define CRX_PROFILE_CONCAT(a, b) CRX_PROFILE_CONCAT_INNER(a, b)
+//name has to outlive the capture, string literals are the common case
+#define CRX_PROFILE_SCOPE(name) ::Cyrex::ProfileScope CRX_PROFILE_CONCAT(crxProfileScope, __LINE__)(name)
+#define CRX_PROFILE_FUNCTION() CRX_PROFILE_SCOPE(__FUNCTION__)
+#define CRX_PROFILE_FRAME() ::Cyrex::Profiler::Get().MarkFrame()
+#else
+#define CRX_PROFILE_SCOPE(name) ((void)0)
+#define CRX_PROFILE_FUNCTION() ((void)0)
+#define CRX_PROFILE_FRAME() ((void)0)
+#endif
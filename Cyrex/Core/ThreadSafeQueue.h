@@ -39,7 +39,7 @@ bool ThreadSafeQueue<T>::TryPop(T& value) {
     if (m_queue.empty()) {
         return false;
     }
-    value = m_queue.front();
+    value = std::move(m_queue.front());
     m_queue.pop();
 
     return true;
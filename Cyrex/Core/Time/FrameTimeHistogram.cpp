@@ -0,0 +1,85 @@
+#include "FrameTimeHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Cyrex;
+
+void FrameTimeHistogram::AddFrame(double milliseconds) noexcept {
+    milliseconds = std::max(milliseconds, 0.0);
+
+    //The oldest frame leaves the window once it is full
+    if (m_numFrames == WindowSize) {
+        const auto oldest = m_frames[m_nextFrame];
+
+        m_buckets[ToBucket(oldest)]--;
+        m_windowMilliseconds -= oldest;
+    }
+    else {
+        m_numFrames++;
+    }
+
+    m_frames[m_nextFrame] = static_cast<float>(milliseconds);
+    m_buckets[ToBucket(m_frames[m_nextFrame])]++;
+    m_windowMilliseconds += m_frames[m_nextFrame];
+
+    m_nextFrame = (m_nextFrame + 1) % WindowSize;
+}
+
+void FrameTimeHistogram::Clear() noexcept {
+    m_buckets.fill(0);
+    m_nextFrame          = 0;
+    m_numFrames          = 0;
+    m_windowMilliseconds = 0.0;
+}
+
+FrameTimeStats FrameTimeHistogram::GetStats() const noexcept {
+    FrameTimeStats stats;
+
+    if (m_numFrames == 0) {
+        return stats;
+    }
+
+    stats.NumFrames           = m_numFrames;
+    stats.P50Milliseconds     = GetPercentile(0.50);
+    stats.P95Milliseconds     = GetPercentile(0.95);
+    stats.P99Milliseconds     = GetPercentile(0.99);
+    stats.AverageMilliseconds = m_windowMilliseconds / m_numFrames;
+    stats.NumHitches          = CountAbove(stats.P50Milliseconds * 2.0);
+
+    //The exact maximum comes from the samples, the last bucket is open ended
+    stats.MaxMilliseconds = *std::max_element(m_frames.begin(), m_frames.begin() + m_numFrames);
+
+    return stats;
+}
+
+uint32_t FrameTimeHistogram::ToBucket(double milliseconds) noexcept {
+    const auto bucket = static_cast<uint32_t>(milliseconds / BucketWidthMilliseconds);
+    return std::min(bucket, NumBuckets - 1);
+}
+
+double FrameTimeHistogram::GetPercentile(double percentile) const noexcept {
+    const auto rank = static_cast<uint32_t>(std::ceil(percentile * m_numFrames));
+
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < NumBuckets; ++i) {
+        count += m_buckets[i];
+
+        if (count >= rank) {
+            //Report the upper edge so a percentile never reads lower than the frames in it
+            return (i + 1) * BucketWidthMilliseconds;
+        }
+    }
+
+    return NumBuckets * BucketWidthMilliseconds;
+}
+
+uint32_t FrameTimeHistogram::CountAbove(double milliseconds) const noexcept {
+    uint32_t count = 0;
+
+    for (uint32_t i = ToBucket(milliseconds) + 1; i < NumBuckets; ++i) {
+        count += m_buckets[i];
+    }
+
+    return count;
+}
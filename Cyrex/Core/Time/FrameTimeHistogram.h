@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace Cyrex {
+    struct FrameTimeStats {
+        double P50Milliseconds{ 0.0 };
+        double P95Milliseconds{ 0.0 };
+        double P99Milliseconds{ 0.0 };
+        double MaxMilliseconds{ 0.0 };
+        double AverageMilliseconds{ 0.0 };
+        //Frames that took more than twice the median
+        uint32_t NumHitches{ 0 };
+        uint32_t NumFrames{ 0 };
+    };
+
+    //Histogram over the last WindowSize frame times. Adding a frame is O(1), percentiles
+    //are read from the buckets, so they are accurate to the bucket width.
+    class FrameTimeHistogram {
+    public:
+        static constexpr uint32_t WindowSize           = 1024;
+        static constexpr double BucketWidthMilliseconds = 0.05;
+        //Frames slower than this all end up in the last bucket
+        static constexpr uint32_t NumBuckets           = 4000;
+
+        void AddFrame(double milliseconds) noexcept;
+        void Clear() noexcept;
+
+        [[nodiscard]] FrameTimeStats GetStats() const noexcept;
+        [[nodiscard]] uint32_t GetNumFrames() const noexcept { return m_numFrames; }
+    private:
+        [[nodiscard]] static uint32_t ToBucket(double milliseconds) noexcept;
+        [[nodiscard]] double GetPercentile(double percentile) const noexcept;
+        [[nodiscard]] uint32_t CountAbove(double milliseconds) const noexcept;
+
+        std::array<uint16_t, NumBuckets> m_buckets{};
+        std::array<float, WindowSize> m_frames{};
+        uint32_t m_nextFrame{ 0 };
+        uint32_t m_numFrames{ 0 };
+        double m_windowMilliseconds{ 0.0 };
+    };
+}
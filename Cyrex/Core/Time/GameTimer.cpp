@@ -1,5 +1,8 @@
 #include "GameTimer.h"
 
+#include <algorithm>
+#include <cassert>
+
 Cyrex::GameTimer::GameTimer() noexcept {
     m_oldTimePoint = std::chrono::high_resolution_clock::now();
 }
@@ -10,12 +13,19 @@ void Cyrex::GameTimer::Tick() noexcept {
     m_total += m_delta;
     m_elapsed += m_delta;
     m_oldTimePoint = newTimePoint;
+
+    m_accumulator += m_delta;
+    m_stepsThisFrame = 0;
+
+    m_frameTimes.AddFrame(GetDeltaMilliseconds());
 }
 
 void Cyrex::GameTimer::Reset() noexcept {
     m_oldTimePoint = std::chrono::high_resolution_clock::now();
     m_delta = std::chrono::high_resolution_clock::duration();
     m_total = std::chrono::high_resolution_clock::duration();
+    m_accumulator = std::chrono::high_resolution_clock::duration();
+    m_frameTimes.Clear();
 }
 
 void Cyrex::GameTimer::ResetElapsedTime() noexcept {
@@ -68,4 +78,37 @@ double Cyrex::GameTimer::GetElapsedMilliSeconds() const noexcept {
 
 double Cyrex::GameTimer::GetElapsedSeconds() const noexcept {
     return std::chrono::duration<double, std::ratio<1>>(m_elapsed).count();
-}
\ No newline at end of file
+}
+
+void Cyrex::GameTimer::SetFixedDeltaSeconds(double seconds) noexcept {
+    assert(seconds > 0.0 && "The fixed step must be positive");
+
+    //StepFixed divides by the step, so anything below one clock tick becomes one tick
+    const auto step = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(seconds));
+    m_fixedDelta    = std::max(step, std::chrono::high_resolution_clock::duration{ 1 });
+}
+
+double Cyrex::GameTimer::GetFixedDeltaSeconds() const noexcept {
+    return std::chrono::duration<double, std::ratio<1>>(m_fixedDelta).count();
+}
+
+bool Cyrex::GameTimer::StepFixed() noexcept {
+    if (m_accumulator < m_fixedDelta) {
+        return false;
+    }
+
+    if (m_stepsThisFrame == ms_maxStepsPerFrame) [[unlikely]] {
+        //Drop the time that is left instead of spiralling, the simulation falls behind the clock
+        m_numSkippedSteps += m_accumulator / m_fixedDelta;
+        m_accumulator %= m_fixedDelta;
+        return false;
+    }
+
+    m_accumulator -= m_fixedDelta;
+    m_stepsThisFrame++;
+    return true;
+}
+
+double Cyrex::GameTimer::GetInterpolationAlpha() const noexcept {
+    return std::chrono::duration<double>(m_accumulator) / std::chrono::duration<double>(m_fixedDelta);
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
+#include "FrameTimeHistogram.h"
 
 namespace Cyrex {
     class GameTimer {
@@ -24,10 +26,31 @@ namespace Cyrex {
         double GetElapsedMicroseconds() const noexcept;
         double GetElapsedMilliSeconds() const noexcept;
         double GetElapsedSeconds() const noexcept;
+    public:
+        //Simulation advances in steps of this size, run: while (timer.StepFixed()) { Simulate(timer.GetFixedDeltaSeconds()); }
+        void SetFixedDeltaSeconds(double seconds) noexcept;
+        double GetFixedDeltaSeconds() const noexcept;
+        bool StepFixed() noexcept;
+        //How far the frame is between the last two fixed steps, for blending their states
+        double GetInterpolationAlpha() const noexcept;
+        uint64_t GetNumSkippedSteps() const noexcept { return m_numSkippedSteps; }
+
+        const FrameTimeHistogram& GetFrameTimes() const noexcept { return m_frameTimes; }
+        FrameTimeStats GetFrameTimeStats() const noexcept { return m_frameTimes.GetStats(); }
     private:
         std::chrono::high_resolution_clock::time_point m_oldTimePoint;
         std::chrono::high_resolution_clock::duration m_delta{0};
         std::chrono::high_resolution_clock::duration m_total{0};
         std::chrono::high_resolution_clock::duration m_elapsed{0};
+
+        //A long stall would otherwise run the simulation for many steps in a single frame
+        static constexpr uint32_t ms_maxStepsPerFrame = 8;
+
+        std::chrono::high_resolution_clock::duration m_fixedDelta = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(1.0 / 60.0));
+        std::chrono::high_resolution_clock::duration m_accumulator{0};
+        uint32_t m_stepsThisFrame{0};
+        uint64_t m_numSkippedSteps{0};
+
+        FrameTimeHistogram m_frameTimes;
     };
 }
@@ -1,8 +1,12 @@
+#ifdef _WIN32
 #include "Platform/Windows/CrxWindow.h"
+#endif
+#include "Core/Profiler.h"
 #include <thread>
 
 namespace Cyrex {
     namespace ThreadUtils {
+#ifdef _WIN32
         const DWORD MS_VC_EXCEPTION = 0x406D1388;
 
 #pragma pack( push, 8 )
@@ -13,8 +17,12 @@ namespace Cyrex {
             DWORD  dwFlags;     // Reserved for future use, must be zero.
         } THREADNAME_INFO;
 #pragma pack( pop )
+#endif
 
         inline void SetThreadName(std::thread& thread, const char* threadName) {
+            Profiler::Get().SetThreadName(thread.get_id(), threadName);
+
+#ifdef _WIN32
             THREADNAME_INFO info;
             info.dwType = 0x1000;
             info.szName = threadName;
@@ -27,6 +35,7 @@ namespace Cyrex {
             __except (EXCEPTION_EXECUTE_HANDLER) {
 
             }
+#endif
         }
     }
 }
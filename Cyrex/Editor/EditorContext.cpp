@@ -2,6 +2,8 @@
 #include "EditorLayer.h"
 
 #include "Core/Logger.h"
+#include "Core/FrameArena.h"
+#include "Core/MemoryTracker.h"
 
 #include "Graphics/API/DX12/CommandList.h"
 #include "Graphics/Graphics.h"
@@ -68,16 +70,58 @@ void EditorContext::Render(const std::shared_ptr<EditorLayer>& editorLayer, Comm
             ImGui::EndMenu();
         }
 
+        if (ImGui::BeginMenu("Memory")) {
+            const auto snapshot  = MemoryTracker::TakeSnapshot();
+            const auto lastFrame = MemoryTracker::GetLastFrame();
+
+            ImGui::Text("%-12s %10s %10s %8s %10s", "Tag", "Live KiB", "Peak KiB", "Allocs", "Allocs/f");
+
+            for (size_t i = 0; i < MemorySnapshot::NumTags; ++i) {
+                const auto tag    = static_cast<MemoryTag>(i);
+                const auto budget = MemoryTracker::GetBudget(tag);
+
+                ImGui::Text("%-12s %10.1f %10.1f %8lld %10lld%s",
+                    ToString(tag),
+                    snapshot[tag].LiveBytes / 1024.0,
+                    snapshot[tag].PeakBytes / 1024.0,
+                    snapshot[tag].LiveAllocations,
+                    lastFrame[tag].TotalAllocations,
+                    budget != 0 && snapshot[tag].LiveBytes > static_cast<int64_t>(budget) ? "  over budget" : "");
+            }
+            ImGui::EndMenu();
+        }
+
         static constexpr auto BUFFER_SIZE = 256;
         const auto fps = m_gfx.GetFramesPerSecond();
 
+        const auto& frameGraph = m_gfx.GetFrameGraph();
+
         char buffer[BUFFER_SIZE];
-        sprintf_s(buffer, BUFFER_SIZE, "FPS: %.2f (%.2f ms)  ", fps, 1.0f / fps * 1000.0f);
+        sprintf_s(buffer, BUFFER_SIZE, "Update: %.2f ms  FPS: %.2f (%.2f ms)  ", 
+            frameGraph.GetCriticalPathMilliseconds(), fps, 1.0f / fps * 1000.0f);
 
         const auto fpsTextSize = ImGui::CalcTextSize(buffer);
         ImGui::SameLine(static_cast<float>(width) - fpsTextSize.x);
         ImGui::Text(buffer);
 
+        if (ImGui::IsItemHovered()) {
+            const auto& frameArena = FrameArena::Get();
+            const auto& frameTimes = m_gfx.GetFrameTimeStats();
+
+            ImGui::SetTooltip("Frame time over the last %u frames:\n"
+                              "p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms  hitches %u\n"
+                              "Critical path: %s\nFrame arena: %.1f KiB (peak %.1f KiB)",
+                frameTimes.NumFrames,
+                frameTimes.P50Milliseconds,
+                frameTimes.P95Milliseconds,
+                frameTimes.P99Milliseconds,
+                frameTimes.MaxMilliseconds,
+                frameTimes.NumHitches,
+                frameGraph.GetCriticalPathString().c_str(),
+                frameArena.GetLastFramePeak() / 1024.0,
+                frameArena.GetPeak() / 1024.0);
+        }
+
         ImGui::EndMainMenuBar();
     }
 
@@ -208,6 +208,10 @@ void Cyrex::CommandList::SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY primitiveTo
     m_d3d12CommandList->IASetPrimitiveTopology(primitiveTopology);
 }
 
+void Cyrex::CommandList::SetPrimitiveTopology(PrimitiveTopology primitiveTopology) {
+    SetPrimitiveTopology(static_cast<D3D_PRIMITIVE_TOPOLOGY>(primitiveTopology));
+}
+
 void Cyrex::CommandList::GenerateMips(const std::shared_ptr<Texture>& texture) {
     if (!texture) {
         return;
@@ -478,7 +482,7 @@ void Cyrex::CommandList::SetViewports(const Viewport const* viewports, const uin
         reinterpret_cast<const D3D12_VIEWPORT const*>(viewports));
 }
 
-void Cyrex::CommandList::SetScissorRect(const Math::Rectangle& scissorRect) const noexcept {
+void Cyrex::CommandList::SetScissorRect(const Math::Rectangle& scissorRect) noexcept {
     SetScissorRects(&scissorRect, 1);
 }
 
@@ -673,6 +677,22 @@ void Cyrex::CommandList::SetShaderResourceView(
         texture->GetShaderResourceView());
 }
 
+void Cyrex::CommandList::SetPixelShaderResource(
+    uint32_t rootParameterIndex,
+    uint32_t descriptorOffset,
+    const std::shared_ptr<Texture>& texture)
+{
+    SetShaderResourceView(rootParameterIndex, descriptorOffset, texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
+
+void Cyrex::CommandList::SetPixelShaderResource(
+    uint32_t rootParameterIndex,
+    uint32_t descriptorOffset,
+    const std::shared_ptr<ShaderResourceView>& srv)
+{
+    SetShaderResourceView(rootParameterIndex, descriptorOffset, srv, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
+
 void Cyrex::CommandList::SetUnorderedAccessView(
     uint32_t rootParameterIndex, 
     uint32_t descrptorOffset, 
@@ -13,6 +13,7 @@
 
 #include "Core/Math/Rectangle.h"
 #include "Graphics/Viewport.h"
+#include "Graphics/API/RenderBackend.h"
 
 namespace Cyrex {
     class Buffer;
@@ -36,7 +37,7 @@ namespace Cyrex {
     class UploadBuffer;
     class VertexBuffer;
 
-    class CommandList : public std::enable_shared_from_this<CommandList>{
+    class CommandList : public ICommandList, public std::enable_shared_from_this<CommandList> {
     public:
         D3D12_COMMAND_LIST_TYPE GetCommandListType() const noexcept { return m_d3d12CommandListType; }
         Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> GetD3D12CommandList() const noexcept { return m_d3d12CommandList; }
@@ -116,6 +117,7 @@ namespace Cyrex {
         }
 
         void SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY primitiveTopology);
+        void SetPrimitiveTopology(PrimitiveTopology primitiveTopology) override;
 
         void GenerateMips(const std::shared_ptr<Texture>& texture);
      
@@ -124,13 +126,13 @@ namespace Cyrex {
             uint32_t numSubresources, 
             D3D12_SUBRESOURCE_DATA* subresourceData);
 
-        void SetGraphicsDynamicConstantBuffer(uint32_t rootParameterIndex, size_t sizeInBytes, const void* bufferData);
+        void SetGraphicsDynamicConstantBuffer(uint32_t rootParameterIndex, size_t sizeInBytes, const void* bufferData) override;
         template<typename T>
         void SetGraphicsDynamicConstantBuffer(uint32_t rootParameterIndex, const T& data) {
             SetGraphicsDynamicConstantBuffer(rootParameterIndex, sizeof(T), &data);
         }
 
-        void SetGraphics32BitConstants(uint32_t rootParameterIndex, uint32_t numConstants, const void* constants);
+        void SetGraphics32BitConstants(uint32_t rootParameterIndex, uint32_t numConstants, const void* constants) override;
         template<typename T>
         void SetGraphics32BitConstants(uint32_t rootParameterIndex, const T& constants) {
             static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Size of type must be a multiple of 4 bytes");
@@ -144,7 +146,7 @@ namespace Cyrex {
             SetCompute32BitConstants(rootParameterIndex, sizeof(T) / sizeof(uint32_t), &constants);
         }
 
-        void SetVertexBuffer(uint32_t slot, const std::shared_ptr<VertexBuffer>& vertexBuff);
+        void SetVertexBuffer(uint32_t slot, const std::shared_ptr<VertexBuffer>& vertexBuff) override;
         void SetVertexBuffers(uint32_t startSlot, const std::vector<std::shared_ptr<VertexBuffer>>& vertexBuffers);
        
         void SetDynamicVertexBuffer(uint32_t slot, size_t numVertices, size_t vertexSize, const void* vertexBufferData);
@@ -153,7 +155,7 @@ namespace Cyrex {
             SetDynamicVertexBuffer(slot, vertexBufferData.size(), sizeof(T::value_type), vertexBufferData.data());
         }
 
-        void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer);
+        void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) override;
 
         void SetDynamicIndexBuffer(size_t numIndicies, DXGI_FORMAT indexFormat, const void* indexBufferData);
 
@@ -167,7 +169,7 @@ namespace Cyrex {
         }
 
         void SetGraphicsDynamicStructuredBuffer(uint32_t slot, size_t numElements, size_t elementSize,
-            const void* bufferData);
+            const void* bufferData) override;
 
         template<typename T>
         void SetGraphicsDynamicStructuredBuffer(uint32_t slot, const T& bufferData)
@@ -175,15 +177,15 @@ namespace Cyrex {
             SetGraphicsDynamicStructuredBuffer(slot, bufferData.size(), sizeof(T::value_type), bufferData.data());
         }
 
-        void SetViewport(const Cyrex::Viewport& viewport);
+        void SetViewport(const Cyrex::Viewport& viewport) override;
         void SetViewports(const Cyrex::Viewport const* viewports, const uint32_t viewportCount);
 
-        void SetScissorRect(const Cyrex::Math::Rectangle& scissorRect) const noexcept;
+        void SetScissorRect(const Cyrex::Math::Rectangle& scissorRect) noexcept override;
         void SetScissorRects(const Math::Rectangle const* scissorRects, const uint32_t scissorCount) const noexcept;
 
-        void SetPipelineState(const std::shared_ptr<PipelineStateObject>& pipelineState);
+        void SetPipelineState(const std::shared_ptr<PipelineStateObject>& pipelineState) override;
 
-        void SetGraphicsRootSignature(const std::shared_ptr<RootSignature>& rootSignature);
+        void SetGraphicsRootSignature(const std::shared_ptr<RootSignature>& rootSignature) override;
         void SetComputeRootSignature(const std::shared_ptr<RootSignature>& rootSignature);
 
         void SetConstantBufferView(uint32_t rootParameterIndex, 
@@ -230,6 +232,9 @@ namespace Cyrex {
             uint32_t firstSubresource = 0,
             uint32_t numSubresources = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
 
+        void SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t descriptorOffset, const std::shared_ptr<Texture>& texture) override;
+        void SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t descriptorOffset, const std::shared_ptr<ShaderResourceView>& srv) override;
+
         void SetUnorderedAccessView(
             uint32_t rootParameterIndex, 
             uint32_t descrptorOffset,
@@ -238,15 +243,15 @@ namespace Cyrex {
             uint32_t firstSubresource = 0,
             uint32_t numSubresources = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
 
-        void SetRenderTarget(const RenderTarget& renderTarget);
+        void SetRenderTarget(const RenderTarget& renderTarget) override;
 
-        void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t startVertex = 0, uint32_t startInstance = 0);
+        void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t startVertex = 0, uint32_t startInstance = 0) override;
         void DrawIndexed(
             uint32_t indexCount,
             uint32_t instanceCount = 1,
             uint32_t startIndex = 0,
             int32_t baseVertex = 0,
-            uint32_t startInstance = 0);
+            uint32_t startInstance = 0) override;
 
         void Dispatch(uint32_t numGroupsX, uint32_t numGroupsY = 1, uint32_t numGroupsZ = 1);
 
@@ -1,12 +1,13 @@
 #include "CommandQueue.h"
 #include "DXException.h"
 #include "CommandList.h"
+#include "D3D12Fence.h"
 #include "ResourceStateTracker.h"
 #include "Device.h"
+#include "Graphics/FenceCompletionService.h"
+#include "Core/FrameArena.h"
+#include "Core/Profiler.h"
 #include <cassert>
-#include <string>
-
-#include "Core/Utils/ThreadUtils.h"
 
 namespace wrl = Microsoft::WRL;
 
@@ -27,8 +28,6 @@ Cyrex::CommandQueue::CommandQueue(Device& device, D3D12_COMMAND_LIST_TYPE type)
     m_commandListType(type),
     m_fenceValue(0)
 {
-    using namespace std::string_literals;
-
     const auto d3d12Device = m_device.GetD3D12Device();
 
     D3D12_COMMAND_QUEUE_DESC desc = {};
@@ -38,34 +37,27 @@ Cyrex::CommandQueue::CommandQueue(Device& device, D3D12_COMMAND_LIST_TYPE type)
     desc.NodeMask                 = 0;
 
     ThrowIfFailed(d3d12Device->CreateCommandQueue(&desc, IID_PPV_ARGS(&m_d3d12CommandQueue)));
-    ThrowIfFailed(d3d12Device->CreateFence(m_fenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_d3d12Fence)));
-
-    auto threadname = "ProccessInFlightCommandLists "s;
+    m_fence = std::make_unique<D3D12Fence>(d3d12Device.Get(), m_fenceValue);
 
     switch (type) {
     case D3D12_COMMAND_LIST_TYPE_COPY :
         m_d3d12CommandQueue->SetName(L"Copy Command Queue");
-        threadname.append("(Copy)");
         break;
     case D3D12_COMMAND_LIST_TYPE_COMPUTE:
         m_d3d12CommandQueue->SetName(L"Compute Command Queue");
-        threadname.append("(Compute)");
         break;
     case D3D12_COMMAND_LIST_TYPE_DIRECT:
         m_d3d12CommandQueue->SetName(L"Direct Command Queue");
-        threadname.append("(Direct)");
         break;
     default:
         break;
     }
-
-    m_processInFlightCommandListsThread = std::thread(&CommandQueue::ProccessInFlightCommandLists, this);
-    ThreadUtils::SetThreadName(m_processInFlightCommandListsThread, threadname.c_str());
 }
 
 Cyrex::CommandQueue::~CommandQueue() {
-    m_processInFlightCommandListsBool = false;
-    m_processInFlightCommandListsThread.join();
+    //The recycle callbacks reference this queue, make sure they have all run
+    Flush();
+    m_device.GetFenceCompletionService().Unregister(*m_fence);
 }
 
 wrl::ComPtr<ID3D12CommandQueue> Cyrex::CommandQueue::GetD3D12CommandQueue() const
@@ -76,10 +68,7 @@ wrl::ComPtr<ID3D12CommandQueue> Cyrex::CommandQueue::GetD3D12CommandQueue() cons
 std::shared_ptr<Cyrex::CommandList> Cyrex::CommandQueue::GetCommandList() const {
     std::shared_ptr<CommandList> commandList;
 
-    if (!m_availableCommandLists.Empty()) {
-        m_availableCommandLists.TryPop(commandList);
-    }
-    else {
+    if (!m_availableCommandLists.TryPop(commandList)) {
         commandList = std::make_shared<MakeCommandList>(m_device, m_commandListType);
     }
 
@@ -87,19 +76,42 @@ std::shared_ptr<Cyrex::CommandList> Cyrex::CommandQueue::GetCommandList() const
 }
 
 uint64_t Cyrex::CommandQueue::ExecuteCommandList(std::shared_ptr<CommandList> commandList) {
-    return ExecuteCommandLists(std::vector<std::shared_ptr<CommandList>>({ commandList }));
+    return ExecuteCommandLists({ &commandList, 1 });
 }
 
-uint64_t Cyrex::CommandQueue::ExecuteCommandLists(const std::vector<std::shared_ptr<CommandList>>& commandLists) {
+std::shared_ptr<Cyrex::ICommandList> Cyrex::CommandQueue::AcquireCommandList() {
+    return GetCommandList();
+}
+
+uint64_t Cyrex::CommandQueue::Submit(std::span<const std::shared_ptr<ICommandList>> commandLists) {
+    FrameArena::Scope scope(FrameArena::Get());
+
+    //Every list came from AcquireCommandList, so it is a CommandList
+    FrameVector<std::shared_ptr<CommandList>> d3d12CommandLists;
+    d3d12CommandLists.reserve(commandLists.size());
+
+    for (const auto& commandList : commandLists) {
+        d3d12CommandLists.push_back(std::static_pointer_cast<CommandList>(commandList));
+    }
+
+    return ExecuteCommandLists(d3d12CommandLists);
+}
+
+uint64_t Cyrex::CommandQueue::ExecuteCommandLists(std::span<const std::shared_ptr<CommandList>> commandLists) {
+    CRX_PROFILE_FUNCTION();
+
     ResourceStateTracker::Lock();
 
+    //The recycle callback keeps this one alive, so it can not come from the frame arena
     std::vector<std::shared_ptr<CommandList>> toBeQueued;
     toBeQueued.reserve(commandLists.size() * 2); //2x since each command list will have a pending command list
 
-    std::vector<std::shared_ptr<CommandList>> generateMipsCommandLists;
+    FrameArena::Scope scope(FrameArena::Get());
+
+    FrameVector<std::shared_ptr<CommandList>> generateMipsCommandLists;
     generateMipsCommandLists.reserve(commandLists.size());
 
-    std::vector<ID3D12CommandList*> d3d12CommandLists;
+    FrameVector<ID3D12CommandList*> d3d12CommandLists;
     d3d12CommandLists.reserve(commandLists.size() * 2); // 2x since each command list will have a pending command list.
 
     for (const auto commandList : commandLists) {
@@ -129,11 +141,16 @@ uint64_t Cyrex::CommandQueue::ExecuteCommandLists(const std::vector<std::shared_
     m_d3d12CommandQueue->ExecuteCommandLists(numCommandLists, d3d12CommandLists.data());
     uint64_t fenceValue = Signal();
 
-    ResourceStateTracker::Unlock();
+    //Recycle the command lists once the GPU is done with them. This is done while
+    //the tracker is still locked so fence values reach the service in order.
+    m_device.GetFenceCompletionService().Enqueue(*m_fence, fenceValue, [this, commandLists = std::move(toBeQueued)] {
+        for (const auto& commandList : commandLists) {
+            commandList->Reset();
+            m_availableCommandLists.TryPush(commandList);
+        }
+    });
 
-    for (const auto commandList : toBeQueued) {
-        m_inFlightCommandLists.Push({ fenceValue,commandList });
-    }
+    ResourceStateTracker::Unlock();
 
     // If there are any command lists that generate mips then execute those
     // after the initial resource command lists have finished.
@@ -148,60 +165,26 @@ uint64_t Cyrex::CommandQueue::ExecuteCommandLists(const std::vector<std::shared_
 
 uint64_t Cyrex::CommandQueue::Signal() {
     uint64_t fenceValue = ++m_fenceValue;
-    m_d3d12CommandQueue->Signal(m_d3d12Fence.Get(), fenceValue);
+    m_d3d12CommandQueue->Signal(m_fence->GetD3D12Fence().Get(), fenceValue);
     return fenceValue;
 }
 
 void Cyrex::CommandQueue::WaitForFenceValue(uint64_t fenceValue) {
-    if (!IsFenceComplete(fenceValue)) {
-        auto event = CreateEvent(nullptr, false, false, nullptr);
-
-        if (event) {
-            m_d3d12Fence->SetEventOnCompletion(fenceValue, event);
-
-            WaitForSingleObject(event, std::numeric_limits<DWORD>::max());
-            CloseHandle(event);
-        }
-    }
+    CRX_PROFILE_FUNCTION();
+    m_fence->WaitForValue(fenceValue);
 }
 
 void Cyrex::CommandQueue::Flush() {
-    std::unique_lock<std::mutex> lock(m_processInFlightCommandListsThreadMutex);
-    m_processInFlightCommandListsThreadCV.wait(lock, [this] { return m_inFlightCommandLists.Empty(); });
+    const auto fenceValue = m_fenceValue.load();
 
-    WaitForFenceValue(m_fenceValue);
+    m_device.GetFenceCompletionService().WaitForCallbacks(*m_fence, fenceValue);
+    WaitForFenceValue(fenceValue);
 }
 
 bool Cyrex::CommandQueue::IsFenceComplete(uint64_t fenceValue) {
-    return m_d3d12Fence->GetCompletedValue() >= fenceValue;
+    return m_fence->IsComplete(fenceValue);
 }
 
 void Cyrex::CommandQueue::Wait(const CommandQueue& rhs) {
-    m_d3d12CommandQueue->Wait(rhs.m_d3d12Fence.Get(), rhs.m_fenceValue);
-}
-
-void Cyrex::CommandQueue::ProccessInFlightCommandLists() {
-    using namespace std::chrono_literals;
-
-    std::unique_lock<std::mutex> lock(m_processInFlightCommandListsThreadMutex, std::defer_lock);
-
-    while (m_processInFlightCommandListsBool) {
-        CommandListEntry cmdListEntry;
-
-        lock.lock();
-
-        while (m_inFlightCommandLists.TryPop(cmdListEntry)) {
-            auto [fenceValue, commandList] = cmdListEntry;
-
-            WaitForFenceValue(fenceValue);
-            commandList->Reset();
-
-            m_availableCommandLists.Push(commandList);
-        }
-
-        lock.unlock();
-        m_processInFlightCommandListsThreadCV.notify_one();
-
-        std::this_thread::yield();
-    }
+    m_d3d12CommandQueue->Wait(rhs.m_fence->GetD3D12Fence().Get(), rhs.m_fenceValue);
 }
@@ -1,28 +1,33 @@
 #pragma once
 #include <d3d12.h>
 #include <wrl.h>
-#include <queue>
 #include <memory>
 #include <atomic>
-#include <condition_variable>
-#include "Core/ThreadSafeQueue.h"
+#include <span>
+#include <vector>
+#include "Core/LockFreeQueue.h"
+#include "Graphics/API/RenderBackend.h"
 
 namespace Cyrex {
     class CommandList;
+    class D3D12Fence;
     class Device;
 
-    class CommandQueue {
+    class CommandQueue : public ICommandQueue {
     public:
         Microsoft::WRL::ComPtr<ID3D12CommandQueue> GetD3D12CommandQueue() const;
         std::shared_ptr<CommandList> GetCommandList() const;
 
        uint64_t ExecuteCommandList(std::shared_ptr<CommandList> commandList);
-       uint64_t ExecuteCommandLists(const std::vector<std::shared_ptr<CommandList>>& commandLists);
+       uint64_t ExecuteCommandLists(std::span<const std::shared_ptr<CommandList>> commandLists);
+
+        [[nodiscard]] std::shared_ptr<ICommandList> AcquireCommandList() override;
+        uint64_t Submit(std::span<const std::shared_ptr<ICommandList>> commandLists) override;
         
-        [[nodiscard]] uint64_t Signal();
-        void WaitForFenceValue(uint64_t fenceValue);
-        void Flush();
-        bool IsFenceComplete(uint64_t fenceValue);
+        [[nodiscard]] uint64_t Signal() override;
+        void WaitForFenceValue(uint64_t fenceValue) override;
+        void Flush() override;
+        bool IsFenceComplete(uint64_t fenceValue) override;
         void Wait(const CommandQueue& rhs);
     protected:
         friend class std::default_delete<CommandQueue>;
@@ -30,22 +35,14 @@ namespace Cyrex {
         CommandQueue(Device& device, D3D12_COMMAND_LIST_TYPE type);
         virtual ~CommandQueue();
     private:
-        void ProccessInFlightCommandLists();
-    private:
-        using CommandListEntry = std::tuple<uint64_t, std::shared_ptr<CommandList>>;
-
         Device& m_device;
         D3D12_COMMAND_LIST_TYPE m_commandListType;
         Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_d3d12CommandQueue;
-        Microsoft::WRL::ComPtr<ID3D12Fence> m_d3d12Fence;
+        std::unique_ptr<D3D12Fence> m_fence;
         std::atomic_uint64_t  m_fenceValue;
 
-        ThreadSafeQueue<CommandListEntry> m_inFlightCommandLists;
-        mutable ThreadSafeQueue<std::shared_ptr<CommandList>> m_availableCommandLists;
-
-        std::thread m_processInFlightCommandListsThread;
-        std::atomic_bool m_processInFlightCommandListsBool{ true };
-        std::mutex m_processInFlightCommandListsThreadMutex;
-        std::condition_variable m_processInFlightCommandListsThreadCV;
+        //Command lists beyond this are released instead of recycled
+        static constexpr size_t m_maxAvailableCommandLists = 128;
+        mutable MPMCQueue<std::shared_ptr<CommandList>> m_availableCommandLists{ m_maxAvailableCommandLists };
     };
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "D3D12Fence.h"
+#include "DXException.h"
+
+using namespace Cyrex;
+
+D3D12Fence::D3D12Fence(ID3D12Device* device, uint64_t initialValue) {
+    ThrowIfFailed(device->CreateFence(initialValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_d3d12Fence)));
+}
+
+uint64_t D3D12Fence::GetCompletedValue() const {
+    return m_d3d12Fence->GetCompletedValue();
+}
+
+void D3D12Fence::SetEventOnCompletion(uint64_t value, FenceEvent& event) {
+    ThrowIfFailed(m_d3d12Fence->SetEventOnCompletion(value, event.GetNativeHandle()));
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Graphics/Fence.h"
+#include <d3d12.h>
+#include <wrl.h>
+
+namespace Cyrex {
+    class D3D12Fence final : public Fence {
+    public:
+        D3D12Fence(ID3D12Device* device, uint64_t initialValue = 0);
+
+        [[nodiscard]] uint64_t GetCompletedValue() const override;
+        void SetEventOnCompletion(uint64_t value, FenceEvent& event) override;
+
+        [[nodiscard]] Microsoft::WRL::ComPtr<ID3D12Fence> GetD3D12Fence() const noexcept { return m_d3d12Fence; }
+    private:
+        Microsoft::WRL::ComPtr<ID3D12Fence> m_d3d12Fence;
+    };
+}
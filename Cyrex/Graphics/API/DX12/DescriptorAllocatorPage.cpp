@@ -8,54 +8,26 @@ D3D12_DESCRIPTOR_HEAP_TYPE Cyrex::DescriptorAllocatorPage::GetHeapType() const {
 }
 
 bool Cyrex::DescriptorAllocatorPage::HasSpace(uint32_t numDescriptors) const {
-    return m_freeListBySize.lower_bound(numDescriptors) != m_freeListBySize.end();
+    return m_freeList.HasSpace(numDescriptors);
 }
 
 uint32_t Cyrex::DescriptorAllocatorPage::NumFreeHandles() const {
-    return m_numFreeHandles;
+    return m_freeList.NumFreeHandles();
 }
 
 Cyrex::DescriptorAllocation Cyrex::DescriptorAllocatorPage::Allocate(uint32_t numDescriptors) {
     std::lock_guard<std::mutex> lock(m_allocationMutex);
 
-    // There are less than the requested number of descriptors left in the heap.
-    // Return a NULL descriptor and try another heap.
-    if (numDescriptors > m_numFreeHandles) {
-        return DescriptorAllocation();
-    }
+    const auto offset = m_freeList.Allocate(numDescriptors);
 
-    // Get the first block that is large enough to satisfy the request.
-    auto smallestBlockIt = m_freeListBySize.lower_bound(numDescriptors);
-    if (smallestBlockIt == m_freeListBySize.end()) {
-        // There was no free block that could satisfy the request.
+    // There was no free block that could satisfy the request.
+    // Return a NULL descriptor and try another heap.
+    if (!offset) {
         return DescriptorAllocation();
     }
 
-    // The size of the smallest block that satisfies the request.
-    auto blockSize = smallestBlockIt->first;
-    // The pointer to the same entry in the FreeListByOffset map.
-    auto offsetIt = smallestBlockIt->second;
-    // The offset in the descriptor heap.
-    auto offset = offsetIt->first;
-
-    // Remove the existing free block from the free list.
-    m_freeListBySize.erase(smallestBlockIt);
-    m_freeListByOffset.erase(offsetIt);
-
-    // Compute the new free block that results from splitting this block.
-    auto newOffset = offset + numDescriptors;
-    auto newSize = blockSize - numDescriptors;
-
-    if (newSize > 0) {
-        // If the allocation didn't exactly match the requested size,
-        // return the left-over to the free list.
-        AddNewBlock(newOffset, newSize);
-    }
-
-    m_numFreeHandles -= numDescriptors;
-
     return DescriptorAllocation(
-        CD3DX12_CPU_DESCRIPTOR_HANDLE(m_baseDescriptor, offset, m_descriptorHandleIncrementSize),
+        CD3DX12_CPU_DESCRIPTOR_HANDLE(m_baseDescriptor, *offset, m_descriptorHandleIncrementSize),
         numDescriptors, 
         m_descriptorHandleIncrementSize, 
         shared_from_this());
@@ -79,7 +51,7 @@ void Cyrex::DescriptorAllocatorPage::ReleaseStaleDescriptors() {
         auto offset         = staleDescriptor.Offset;
         auto numDescriptors = staleDescriptor.Size;
 
-        FreeBlock(offset, numDescriptors);
+        m_freeList.Free(offset, numDescriptors);
 
         m_staleDescriptors.pop();
     }
@@ -88,6 +60,7 @@ void Cyrex::DescriptorAllocatorPage::ReleaseStaleDescriptors() {
 Cyrex::DescriptorAllocatorPage::DescriptorAllocatorPage(Device& device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t numDescriptors)
     :
     m_device(device),
+    m_freeList(numDescriptors),
     m_heapType(type),
     m_numDescriptorsInHeap(numDescriptors)
 {
@@ -101,79 +74,8 @@ Cyrex::DescriptorAllocatorPage::DescriptorAllocatorPage(Device& device, D3D12_DE
 
     m_baseDescriptor                = m_d3d12DescriptorHeap->GetCPUDescriptorHandleForHeapStart();
     m_descriptorHandleIncrementSize = d3d12Device->GetDescriptorHandleIncrementSize(m_heapType);
-    m_numFreeHandles                = m_numDescriptorsInHeap;
-
-    // Initialize the free lists
-    AddNewBlock(0, m_numFreeHandles);
 }
 
 uint32_t Cyrex::DescriptorAllocatorPage::ComputeOffset(D3D12_CPU_DESCRIPTOR_HANDLE handle) {
     return static_cast<uint32_t>(handle.ptr - m_baseDescriptor.ptr) / m_descriptorHandleIncrementSize;
 }
-
-void Cyrex::DescriptorAllocatorPage::AddNewBlock(uint32_t offset, uint32_t numDescriptors) {
-    auto offsetIt = m_freeListByOffset.emplace(offset, numDescriptors);
-    auto sizeIt = m_freeListBySize.emplace(numDescriptors, offsetIt.first);
-
-    offsetIt.first->second.FreeListBySizeIt = sizeIt;
-}
-
-void Cyrex::DescriptorAllocatorPage::FreeBlock(uint32_t offset, uint32_t numDescriptors) {
-    // Find the first element whose offset is greater than the specified offset.
-    // This is the block that should appear after the block that is being freed.
-    auto nextBlockIt = m_freeListByOffset.upper_bound(offset);
-
-    // Find the block that appears before the block being freed.
-    auto prevBlockIt = nextBlockIt;
-
-    //If it's not the first block in the list.
-    if (prevBlockIt != m_freeListByOffset.begin()) {
-        // Go to the previous block in the list.
-        --prevBlockIt;
-    }
-    else {
-        // Otherwise, just set it to the end of the list to indicate that no
-        // block comes before the one being freed.
-        prevBlockIt = m_freeListByOffset.end();
-    }
-
-    // Add the number of free handles back to the heap.
-    // This needs to be done before merging any blocks since merging
-    // blocks modifies the numDescriptors variable.
-    m_numFreeHandles += numDescriptors;
-
-    if (prevBlockIt != m_freeListByOffset.end() and offset == prevBlockIt->first + prevBlockIt->second.Size) {
-        // The previous block is exactly behind the block that is to be freed.
-        //
-        // PrevBlock.Offset           Offset
-        // |                          |
-        // |<-----PrevBlock.Size----->|<------Size-------->|
-        //
-
-        // Increase the block size by the size of merging with the previous block.
-        offset = prevBlockIt->first;
-        numDescriptors += prevBlockIt->second.Size;
-
-        // Remove the previous block from the free list.
-        m_freeListBySize.erase(prevBlockIt->second.FreeListBySizeIt);
-        m_freeListByOffset.erase(prevBlockIt);
-    }
-
-    if (nextBlockIt != m_freeListByOffset.end() and offset + numDescriptors == nextBlockIt->first) {
-       // The next block is exactly in front of the block that is to be freed.
-       //
-       // Offset               NextBlock.Offset 
-       // |                    |
-       // |<------Size-------->|<-----NextBlock.Size----->|
-
-       // Increase the block size by the size of merging with the next block.
-        numDescriptors += nextBlockIt->second.Size;
-
-        // Remove the next block from the free list.
-        m_freeListBySize.erase(nextBlockIt->second.FreeListBySizeIt);
-        m_freeListByOffset.erase(nextBlockIt);
-    }
-
-    // Add the freed block to the free list.
-    AddNewBlock(offset, numDescriptors);
-}
@@ -1,8 +1,8 @@
 #pragma once
 #include "DescriptorAllocation.h"
+#include "DescriptorFreeList.h"
 #include "d3dx12.h"
 #include <wrl.h>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -22,27 +22,9 @@ namespace Cyrex {
         virtual ~DescriptorAllocatorPage() = default;
 
         uint32_t ComputeOffset(D3D12_CPU_DESCRIPTOR_HANDLE handle);
-        void AddNewBlock(uint32_t offset, uint32_t numDescriptors);
-        void FreeBlock(uint32_t offset, uint32_t numDescriptors);
     private:
-        using OffsetType = uint32_t;
-        using SizeType = uint32_t;
-
-        struct FreeBlockInfo;
-        using FreeListByOffset = std::map<OffsetType, FreeBlockInfo>;
-
-        // A map that lists the free blocks by size.
-        // Needs to be a multimap since multiple blocks can have the same size.
-        using FreeListBySize = std::multimap<SizeType, FreeListByOffset::iterator>;
-
-        struct FreeBlockInfo {
-            FreeBlockInfo(SizeType size)
-                :
-                Size(size)
-            {}
-            SizeType Size;
-            FreeListBySize::iterator FreeListBySizeIt;
-        };
+        using OffsetType = DescriptorFreeList::OffsetType;
+        using SizeType   = DescriptorFreeList::SizeType;
 
         struct StaleDescriptorInfo {
             StaleDescriptorInfo(OffsetType offset, SizeType size)
@@ -61,8 +43,7 @@ namespace Cyrex {
 
         using StaleDescriptorQueue = std::queue<StaleDescriptorInfo>;
 
-        FreeListByOffset m_freeListByOffset;
-        FreeListBySize m_freeListBySize;
+        DescriptorFreeList m_freeList;
         StaleDescriptorQueue m_staleDescriptors;
 
         Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_d3d12DescriptorHeap;
@@ -71,7 +52,6 @@ namespace Cyrex {
 
         uint32_t m_descriptorHandleIncrementSize;
         uint32_t m_numDescriptorsInHeap;
-        uint32_t m_numFreeHandles;
 
         std::mutex m_allocationMutex;
     };
@@ -0,0 +1,119 @@
+#include "DescriptorFreeList.h"
+
+Cyrex::DescriptorFreeList::DescriptorFreeList(SizeType numDescriptors)
+    :
+    m_numFreeHandles(numDescriptors)
+{
+    // Initialize the free lists
+    AddNewBlock(0, numDescriptors);
+}
+
+bool Cyrex::DescriptorFreeList::HasSpace(SizeType numDescriptors) const {
+    return m_freeListBySize.lower_bound(numDescriptors) != m_freeListBySize.end();
+}
+
+std::optional<Cyrex::DescriptorFreeList::OffsetType> Cyrex::DescriptorFreeList::Allocate(SizeType numDescriptors) {
+    // There are less than the requested number of descriptors left in the heap.
+    if (numDescriptors > m_numFreeHandles) {
+        return std::nullopt;
+    }
+
+    // Get the first block that is large enough to satisfy the request.
+    auto smallestBlockIt = m_freeListBySize.lower_bound(numDescriptors);
+    if (smallestBlockIt == m_freeListBySize.end()) {
+        // There was no free block that could satisfy the request.
+        return std::nullopt;
+    }
+
+    // The size of the smallest block that satisfies the request.
+    auto blockSize = smallestBlockIt->first;
+    // The pointer to the same entry in the FreeListByOffset map.
+    auto offsetIt = smallestBlockIt->second;
+    // The offset in the descriptor heap.
+    auto offset = offsetIt->first;
+
+    // Remove the existing free block from the free list.
+    m_freeListBySize.erase(smallestBlockIt);
+    m_freeListByOffset.erase(offsetIt);
+
+    // Compute the new free block that results from splitting this block.
+    auto newOffset = offset + numDescriptors;
+    auto newSize = blockSize - numDescriptors;
+
+    if (newSize > 0) {
+        // If the allocation didn't exactly match the requested size,
+        // return the left-over to the free list.
+        AddNewBlock(newOffset, newSize);
+    }
+
+    m_numFreeHandles -= numDescriptors;
+
+    return offset;
+}
+
+void Cyrex::DescriptorFreeList::Free(OffsetType offset, SizeType numDescriptors) {
+    // Find the first element whose offset is greater than the specified offset.
+    // This is the block that should appear after the block that is being freed.
+    auto nextBlockIt = m_freeListByOffset.upper_bound(offset);
+
+    // Find the block that appears before the block being freed.
+    auto prevBlockIt = nextBlockIt;
+
+    //If it's not the first block in the list.
+    if (prevBlockIt != m_freeListByOffset.begin()) {
+        // Go to the previous block in the list.
+        --prevBlockIt;
+    }
+    else {
+        // Otherwise, just set it to the end of the list to indicate that no
+        // block comes before the one being freed.
+        prevBlockIt = m_freeListByOffset.end();
+    }
+
+    // Add the number of free handles back to the heap.
+    // This needs to be done before merging any blocks since merging
+    // blocks modifies the numDescriptors variable.
+    m_numFreeHandles += numDescriptors;
+
+    if (prevBlockIt != m_freeListByOffset.end() and offset == prevBlockIt->first + prevBlockIt->second.Size) {
+        // The previous block is exactly behind the block that is to be freed.
+        //
+        // PrevBlock.Offset           Offset
+        // |                          |
+        // |<-----PrevBlock.Size----->|<------Size-------->|
+        //
+
+        // Increase the block size by the size of merging with the previous block.
+        offset = prevBlockIt->first;
+        numDescriptors += prevBlockIt->second.Size;
+
+        // Remove the previous block from the free list.
+        m_freeListBySize.erase(prevBlockIt->second.FreeListBySizeIt);
+        m_freeListByOffset.erase(prevBlockIt);
+    }
+
+    if (nextBlockIt != m_freeListByOffset.end() and offset + numDescriptors == nextBlockIt->first) {
+       // The next block is exactly in front of the block that is to be freed.
+       //
+       // Offset               NextBlock.Offset
+       // |                    |
+       // |<------Size-------->|<-----NextBlock.Size----->|
+
+       // Increase the block size by the size of merging with the next block.
+        numDescriptors += nextBlockIt->second.Size;
+
+        // Remove the next block from the free list.
+        m_freeListBySize.erase(nextBlockIt->second.FreeListBySizeIt);
+        m_freeListByOffset.erase(nextBlockIt);
+    }
+
+    // Add the freed block to the free list.
+    AddNewBlock(offset, numDescriptors);
+}
+
+void Cyrex::DescriptorFreeList::AddNewBlock(OffsetType offset, SizeType numDescriptors) {
+    auto offsetIt = m_freeListByOffset.emplace(offset, numDescriptors);
+    auto sizeIt = m_freeListBySize.emplace(numDescriptors, offsetIt.first);
+
+    offsetIt.first->second.FreeListBySizeIt = sizeIt;
+}
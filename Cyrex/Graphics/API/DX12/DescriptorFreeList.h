@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace Cyrex {
+    //Keeps track of the free ranges of a descriptor heap. Allocations take the
+    //smallest block that fits and freed blocks are merged with their neighbours.
+    //Has no knowledge of D3D12, DescriptorAllocatorPage maps offsets to handles.
+    class DescriptorFreeList {
+    public:
+        using OffsetType = uint32_t;
+        using SizeType   = uint32_t;
+
+        explicit DescriptorFreeList(SizeType numDescriptors);
+
+        [[nodiscard]] bool HasSpace(SizeType numDescriptors) const;
+        [[nodiscard]] SizeType NumFreeHandles() const noexcept { return m_numFreeHandles; }
+        [[nodiscard]] size_t NumFreeBlocks() const noexcept { return m_freeListByOffset.size(); }
+
+        //Returns the offset of the allocated range or nothing if no free block is large enough
+        [[nodiscard]] std::optional<OffsetType> Allocate(SizeType numDescriptors);
+        void Free(OffsetType offset, SizeType numDescriptors);
+    private:
+        void AddNewBlock(OffsetType offset, SizeType numDescriptors);
+
+        struct FreeBlockInfo;
+        using FreeListByOffset = std::map<OffsetType, FreeBlockInfo>;
+
+        // A map that lists the free blocks by size.
+        // Needs to be a multimap since multiple blocks can have the same size.
+        using FreeListBySize = std::multimap<SizeType, FreeListByOffset::iterator>;
+
+        struct FreeBlockInfo {
+            FreeBlockInfo(SizeType size)
+                :
+                Size(size)
+            {}
+            SizeType Size;
+            FreeListBySize::iterator FreeListBySizeIt;
+        };
+
+        FreeListByOffset m_freeListByOffset;
+        FreeListBySize m_freeListBySize;
+
+        SizeType m_numFreeHandles;
+    };
+}
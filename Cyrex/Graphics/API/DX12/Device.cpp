@@ -17,6 +17,7 @@
 #include "Texture.h"
 #include "UnorderedAccessView.h"
 #include "VertexBuffer.h"
+#include "Graphics/FenceCompletionService.h"
 
 #include "DXException.h"
 
@@ -232,6 +233,8 @@ Cyrex::Device::Device(std::shared_ptr<Adapter> adapter)
         ThrowIfFailed(pInfoQueue->PushStorageFilter(&newFilter));
     }
 
+    m_fenceCompletionService = std::make_unique<FenceCompletionService>();
+
     m_directCommandQueue  = std::make_unique<Context::MakeCommandQueue>(*this, D3D12_COMMAND_LIST_TYPE_DIRECT);
     m_computeCommandQueue = std::make_unique<Context::MakeCommandQueue>(*this, D3D12_COMMAND_LIST_TYPE_COMPUTE);
     m_copyCommandQueue    = std::make_unique<Context::MakeCommandQueue>(*this, D3D12_COMMAND_LIST_TYPE_COPY);
@@ -373,6 +376,17 @@ Cyrex::CommandQueue& Cyrex::Device::GetCommandQueue(D3D12_COMMAND_LIST_TYPE type
     return *cmdQueue;
 }
 
+Cyrex::ICommandQueue& Cyrex::Device::GetQueue(QueueType type) {
+    switch (type) {
+    case QueueType::Compute:
+        return *m_computeCommandQueue;
+    case QueueType::Copy:
+        return *m_copyCommandQueue;
+    default:
+        return *m_directCommandQueue;
+    }
+}
+
 Cyrex::DescriptorAllocation Cyrex::Device::AllocateDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t numDescriptors) {
     return m_descriptorAllocators[type]->Allocate(numDescriptors);
 }
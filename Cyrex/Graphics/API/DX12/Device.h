@@ -1,5 +1,6 @@
 #pragma once
 #include "DescriptorAllocation.h"
+#include "Graphics/API/RenderBackend.h"
 #include "d3dx12.h"
 #include <dxgi1_6.h>
 #include <wrl/client.h>
@@ -11,6 +12,7 @@ namespace Cyrex {
     class CommandQueue;
     class CommandList;
     class DescriptorAllocator;
+    class FenceCompletionService;
     class ConstantBuffer;
     class ConstantBufferView;
     class IndexBuffer;
@@ -25,7 +27,7 @@ namespace Cyrex {
     class UnorderedAccessView;
     class VertexBuffer;
 
-    class Device {
+    class Device : public IDevice {
     public:
         static void EnableDebugLayer();
         static void ReportLiveObjects();
@@ -33,6 +35,8 @@ namespace Cyrex {
 
         std::wstring GetDescription() const;
         CommandQueue& GetCommandQueue(D3D12_COMMAND_LIST_TYPE type);
+        ICommandQueue& GetQueue(QueueType type) override;
+        FenceCompletionService& GetFenceCompletionService() noexcept { return *m_fenceCompletionService; }
 
         Microsoft::WRL::ComPtr<ID3D12Device8> GetD3D12Device() const noexcept { return m_d3d12Device; }
         std::shared_ptr<Adapter> GetAdapter() const noexcept { return m_adapter; }
@@ -106,10 +110,10 @@ namespace Cyrex {
                 const std::shared_ptr<Resource>& counterResource = nullptr,
                 const D3D12_UNORDERED_ACCESS_VIEW_DESC* uav = nullptr);
 
-        void Flush();
+        void Flush() override;
 
         DescriptorAllocation AllocateDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t numDescriptors = 1);
-        void ReleaseStaleDescriptors();
+        void ReleaseStaleDescriptors() override;
     protected:
         explicit Device(std::shared_ptr<Adapter> adapter);
         virtual ~Device();
@@ -117,6 +121,9 @@ namespace Cyrex {
         Microsoft::WRL::ComPtr<ID3D12Device8> m_d3d12Device;
         std::shared_ptr<Adapter> m_adapter;
 
+        //Declared before the queues so it outlives them
+        std::unique_ptr<FenceCompletionService> m_fenceCompletionService;
+
         std::unique_ptr<CommandQueue> m_directCommandQueue;
         std::unique_ptr<CommandQueue> m_computeCommandQueue;
         std::unique_ptr<CommandQueue> m_copyCommandQueue;
@@ -56,7 +56,7 @@ Cyrex::UploadBuffer::Page::Page(Device& device, size_t sizeInBytes)
     :
     m_device(device),
     m_pageSize(sizeInBytes),
-    m_offset(0),
+    m_allocator(sizeInBytes),
     m_cpuPtr(nullptr),
     m_gpuPtr(D3D12_GPU_VIRTUAL_ADDRESS(0))
 {
@@ -87,29 +87,19 @@ Cyrex::UploadBuffer::Page::~Page() {
 }
 
 bool Cyrex::UploadBuffer::Page::HasSpace(size_t sizeInBytes, size_t alignment) const {
-    size_t alignedSize   = Math::AlignUp(sizeInBytes, alignment);
-    size_t alignedOffset = Math::AlignUp(m_offset, alignment);
-
-    return alignedOffset + alignedSize <= m_pageSize;
+    return m_allocator.HasSpace(sizeInBytes, alignment);
 }
 
 Cyrex::UploadBuffer::Allocation Cyrex::UploadBuffer::Page::Allocate(size_t sizeInBytes, size_t alignment) {
-    if (!HasSpace(sizeInBytes, alignment)) {
-        throw std::bad_alloc();
-    }
-
-    size_t alignedSize = Math::AlignUp(sizeInBytes, alignment);
-    m_offset           = Math::AlignUp(m_offset, alignment);
+    const auto offset = m_allocator.Allocate(sizeInBytes, alignment);
 
     Allocation alloc;
-    alloc.CPU = static_cast<uint8_t*>(m_cpuPtr) + m_offset;
-    alloc.GPU = m_gpuPtr + m_offset;
-
-    m_offset += alignedSize;
+    alloc.CPU = static_cast<uint8_t*>(m_cpuPtr) + offset;
+    alloc.GPU = m_gpuPtr + offset;
 
     return alloc;
 }
 
 void Cyrex::UploadBuffer::Page::Reset() {
-    m_offset = 0;
+    m_allocator.Reset();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/MemoryHelperFuncs.h"
+#include "Core/LinearAllocator.h"
 #include <wrl.h>
 #include <d3d12.h>
 #include <memory>
@@ -39,7 +40,7 @@ namespace Cyrex {
             D3D12_GPU_VIRTUAL_ADDRESS m_gpuPtr;
 
             size_t m_pageSize;
-            size_t m_offset;
+            LinearAllocator m_allocator;
         };
 
         std::shared_ptr<Page> RequestPage();
@@ -27,7 +27,7 @@ namespace Cyrex {
     public:
         VertexPositionNormalTangentBitangentTexture() = default;
 
-        explicit VertexPositionNormalTangentBitangentTexture(
+        explicit constexpr VertexPositionNormalTangentBitangentTexture(
             const Math::Vector3& position,
             const Math::Vector3& normal,
             const Math::Vector3& texCoord,
@@ -0,0 +1,210 @@
+#include "NullCommandList.h"
+#include <bit>
+#include <cstring>
+#include <new>
+
+using namespace Cyrex;
+
+namespace {
+    //D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT
+    constexpr size_t ConstantBufferAlignment = 256;
+}
+
+NullCommandListStats& NullCommandListStats::operator+=(const NullCommandListStats& rhs) noexcept {
+    NumDraws                     += rhs.NumDraws;
+    NumVertices                  += rhs.NumVertices;
+    NumInstances                 += rhs.NumInstances;
+    NumPipelineStateChanges      += rhs.NumPipelineStateChanges;
+    NumRootSignatureChanges      += rhs.NumRootSignatureChanges;
+    NumBufferBindings            += rhs.NumBufferBindings;
+    NumRedundantStateChanges     += rhs.NumRedundantStateChanges;
+    NumRootConstantUpdates       += rhs.NumRootConstantUpdates;
+    NumDescriptorsStaged         += rhs.NumDescriptorsStaged;
+    NumDescriptorTablesCommitted += rhs.NumDescriptorTablesCommitted;
+    NumUploads                   += rhs.NumUploads;
+    NumUploadedBytes             += rhs.NumUploadedBytes;
+
+    return *this;
+}
+
+NullCommandList::NullCommandList(size_t uploadPageSize)
+    :
+    m_uploadPageSize(uploadPageSize),
+    m_uploadAllocator(uploadPageSize)
+{}
+
+void NullCommandList::SetPipelineState(const std::shared_ptr<PipelineStateObject>& pipelineState) {
+    if (m_pipelineState != pipelineState.get()) {
+        m_pipelineState = pipelineState.get();
+        m_stats.NumPipelineStateChanges++;
+
+        TrackObject(pipelineState);
+    }
+    else {
+        m_stats.NumRedundantStateChanges++;
+    }
+}
+
+void NullCommandList::SetGraphicsRootSignature(const std::shared_ptr<RootSignature>& rootSignature) {
+    if (m_rootSignature != rootSignature.get()) {
+        m_rootSignature = rootSignature.get();
+        m_stats.NumRootSignatureChanges++;
+
+        //A new root signature invalidates every bound root argument
+        m_staleDescriptorTables = 0;
+
+        TrackObject(rootSignature);
+    }
+    else {
+        m_stats.NumRedundantStateChanges++;
+    }
+}
+
+void NullCommandList::SetViewport(const Viewport&) {}
+
+void NullCommandList::SetScissorRect(const Math::Rectangle&) noexcept {}
+
+void NullCommandList::SetRenderTarget(const RenderTarget& renderTarget) {
+    if (m_renderTarget == &renderTarget) {
+        m_stats.NumRedundantStateChanges++;
+    }
+    m_renderTarget = &renderTarget;
+}
+
+void NullCommandList::SetGraphicsDynamicConstantBuffer(uint32_t, size_t sizeInBytes, const void* bufferData) {
+    Upload(bufferData, sizeInBytes, ConstantBufferAlignment);
+}
+
+void NullCommandList::SetGraphics32BitConstants(uint32_t, uint32_t, const void*) {
+    m_stats.NumRootConstantUpdates++;
+}
+
+void NullCommandList::SetGraphicsDynamicStructuredBuffer(uint32_t, size_t numElements, size_t elementSize, const void* bufferData) {
+    Upload(bufferData, numElements * elementSize, elementSize);
+}
+
+void NullCommandList::SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t, const std::shared_ptr<Texture>& texture) {
+    TrackObject(texture);
+    StageDescriptor(rootParameterIndex);
+}
+
+void NullCommandList::SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t, const std::shared_ptr<ShaderResourceView>& srv) {
+    TrackObject(srv);
+    StageDescriptor(rootParameterIndex);
+}
+
+void NullCommandList::SetPrimitiveTopology(PrimitiveTopology primitiveTopology) {
+    if (m_primitiveTopology == primitiveTopology) {
+        m_stats.NumRedundantStateChanges++;
+    }
+    m_primitiveTopology = primitiveTopology;
+}
+
+void NullCommandList::SetVertexBuffer(uint32_t slot, const std::shared_ptr<VertexBuffer>& vertexBuffer) {
+    if (slot >= m_maxVertexBuffers || !vertexBuffer) {
+        return;
+    }
+
+    if (m_vertexBuffers[slot] == vertexBuffer.get()) {
+        m_stats.NumRedundantStateChanges++;
+    }
+
+    m_vertexBuffers[slot] = vertexBuffer.get();
+    m_stats.NumBufferBindings++;
+
+    TrackObject(vertexBuffer);
+}
+
+void NullCommandList::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) {
+    if (!indexBuffer) {
+        return;
+    }
+
+    if (m_indexBuffer == indexBuffer.get()) {
+        m_stats.NumRedundantStateChanges++;
+    }
+
+    m_indexBuffer = indexBuffer.get();
+    m_stats.NumBufferBindings++;
+
+    TrackObject(indexBuffer);
+}
+
+void NullCommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t, uint32_t) {
+    CommitStagedDescriptors();
+
+    m_stats.NumDraws++;
+    m_stats.NumVertices  += static_cast<uint64_t>(vertexCount) * instanceCount;
+    m_stats.NumInstances += instanceCount;
+}
+
+void NullCommandList::DrawIndexed(
+    uint32_t indexCount,
+    uint32_t instanceCount,
+    uint32_t,
+    int32_t,
+    uint32_t)
+{
+    CommitStagedDescriptors();
+
+    m_stats.NumDraws++;
+    m_stats.NumVertices  += static_cast<uint64_t>(indexCount) * instanceCount;
+    m_stats.NumInstances += instanceCount;
+}
+
+void NullCommandList::Reset() noexcept {
+    m_pipelineState     = nullptr;
+    m_rootSignature     = nullptr;
+    m_renderTarget      = nullptr;
+    m_indexBuffer       = nullptr;
+    m_primitiveTopology = PrimitiveTopology::Undefined;
+    m_vertexBuffers.fill(nullptr);
+
+    m_staleDescriptorTables = 0;
+    m_numUsedUploadPages    = 0;
+    m_uploadAllocator.Reset();
+
+    m_trackedObjects.clear();
+    m_stats = {};
+}
+
+void NullCommandList::TrackObject(std::shared_ptr<const void> object) {
+    if (object) {
+        m_trackedObjects.push_back(std::move(object));
+    }
+}
+
+void NullCommandList::StageDescriptor(uint32_t rootParameterIndex) noexcept {
+    if (rootParameterIndex < m_maxRootParameters) {
+        m_staleDescriptorTables |= uint64_t(1) << rootParameterIndex;
+    }
+    m_stats.NumDescriptorsStaged++;
+}
+
+void NullCommandList::CommitStagedDescriptors() noexcept {
+    m_stats.NumDescriptorTablesCommitted += std::popcount(m_staleDescriptorTables);
+    m_staleDescriptorTables = 0;
+}
+
+std::byte* NullCommandList::Upload(const void* data, size_t sizeInBytes, size_t alignment) {
+    if (sizeInBytes > m_uploadPageSize) {
+        throw std::bad_alloc();
+    }
+
+    if (m_numUsedUploadPages == 0 || !m_uploadAllocator.HasSpace(sizeInBytes, alignment)) {
+        if (m_numUsedUploadPages == m_uploadPages.size()) {
+            m_uploadPages.push_back(std::make_unique_for_overwrite<std::byte[]>(m_uploadPageSize));
+        }
+
+        m_numUsedUploadPages++;
+        m_uploadAllocator.Reset();
+    }
+
+    const auto cpu = m_uploadPages[m_numUsedUploadPages - 1].get() + m_uploadAllocator.Allocate(sizeInBytes, alignment);
+    std::memcpy(cpu, data, sizeInBytes);
+
+    m_stats.NumUploads++;
+    m_stats.NumUploadedBytes += sizeInBytes;
+
+    return cpu;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "Graphics/API/RenderBackend.h"
+#include "Core/LinearAllocator.h"
+#include "Core/MemoryHelperFuncs.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Cyrex {
+    //The work a null command list was given
+    struct NullCommandListStats {
+        uint64_t NumDraws{ 0 };
+        //Indices for indexed draws, summed over all instances
+        uint64_t NumVertices{ 0 };
+        uint64_t NumInstances{ 0 };
+
+        uint64_t NumPipelineStateChanges{ 0 };
+        uint64_t NumRootSignatureChanges{ 0 };
+        uint64_t NumBufferBindings{ 0 };
+        //State that was set to what was already bound
+        uint64_t NumRedundantStateChanges{ 0 };
+
+        uint64_t NumRootConstantUpdates{ 0 };
+        uint64_t NumDescriptorsStaged{ 0 };
+        uint64_t NumDescriptorTablesCommitted{ 0 };
+
+        uint64_t NumUploads{ 0 };
+        uint64_t NumUploadedBytes{ 0 };
+
+        NullCommandListStats& operator+=(const NullCommandListStats& rhs) noexcept;
+    };
+
+    //Accepts every command without a GPU. Bound state is tracked the way CommandList
+    //tracks it, dynamic data is copied into CPU upload pages and the work is counted.
+    class NullCommandList final : public ICommandList {
+    public:
+        explicit NullCommandList(size_t uploadPageSize = Cyrex::_2MB);
+        NullCommandList(const NullCommandList& rhs) = delete;
+        NullCommandList& operator=(const NullCommandList& rhs) = delete;
+        ~NullCommandList() = default;
+
+        void SetPipelineState(const std::shared_ptr<PipelineStateObject>& pipelineState) override;
+        void SetGraphicsRootSignature(const std::shared_ptr<RootSignature>& rootSignature) override;
+
+        void SetViewport(const Viewport& viewport) override;
+        void SetScissorRect(const Math::Rectangle& scissorRect) noexcept override;
+        void SetRenderTarget(const RenderTarget& renderTarget) override;
+
+        void SetGraphicsDynamicConstantBuffer(uint32_t rootParameterIndex, size_t sizeInBytes, const void* bufferData) override;
+        void SetGraphics32BitConstants(uint32_t rootParameterIndex, uint32_t numConstants, const void* constants) override;
+        void SetGraphicsDynamicStructuredBuffer(uint32_t slot, size_t numElements, size_t elementSize, const void* bufferData) override;
+
+        using ICommandList::SetGraphicsDynamicConstantBuffer;
+        using ICommandList::SetGraphics32BitConstants;
+        using ICommandList::SetGraphicsDynamicStructuredBuffer;
+
+        void SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t descriptorOffset, const std::shared_ptr<Texture>& texture) override;
+        void SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t descriptorOffset, const std::shared_ptr<ShaderResourceView>& srv) override;
+
+        void SetPrimitiveTopology(PrimitiveTopology primitiveTopology) override;
+        void SetVertexBuffer(uint32_t slot, const std::shared_ptr<VertexBuffer>& vertexBuffer) override;
+        void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) override;
+
+        void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t startVertex = 0, uint32_t startInstance = 0) override;
+        void DrawIndexed(
+            uint32_t indexCount,
+            uint32_t instanceCount = 1,
+            uint32_t startIndex = 0,
+            int32_t baseVertex = 0,
+            uint32_t startInstance = 0) override;
+
+        [[nodiscard]] const NullCommandListStats& GetStats() const noexcept { return m_stats; }
+
+        //Forgets the bound state, releases tracked objects and recycles the upload pages
+        void Reset() noexcept;
+    private:
+        void TrackObject(std::shared_ptr<const void> object);
+        void StageDescriptor(uint32_t rootParameterIndex) noexcept;
+        void CommitStagedDescriptors() noexcept;
+        std::byte* Upload(const void* data, size_t sizeInBytes, size_t alignment);
+
+        //D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT
+        static constexpr uint32_t m_maxVertexBuffers  = 32;
+        //Root signatures are limited to 64 DWORDs, so there are never more parameters
+        static constexpr uint32_t m_maxRootParameters = 64;
+
+        const PipelineStateObject* m_pipelineState{ nullptr };
+        const RootSignature* m_rootSignature{ nullptr };
+        const RenderTarget* m_renderTarget{ nullptr };
+        const IndexBuffer* m_indexBuffer{ nullptr };
+        std::array<const VertexBuffer*, m_maxVertexBuffers> m_vertexBuffers{};
+        PrimitiveTopology m_primitiveTopology{ PrimitiveTopology::Undefined };
+
+        //One bit per root parameter with descriptors staged since the last draw
+        uint64_t m_staleDescriptorTables{ 0 };
+
+        const size_t m_uploadPageSize;
+        std::vector<std::unique_ptr<std::byte[]>> m_uploadPages;
+        size_t m_numUsedUploadPages{ 0 };
+        LinearAllocator m_uploadAllocator;
+
+        std::vector<std::shared_ptr<const void>> m_trackedObjects;
+
+        NullCommandListStats m_stats;
+    };
+}
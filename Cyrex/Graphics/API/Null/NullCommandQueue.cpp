@@ -0,0 +1,97 @@
+#include "NullCommandQueue.h"
+#include "Graphics/FenceCompletionService.h"
+
+#include <vector>
+
+using namespace Cyrex;
+
+NullCommandQueue::NullCommandQueue(FenceCompletionService& fenceCompletionService) noexcept
+    :
+    m_fenceCompletionService(&fenceCompletionService)
+{}
+
+NullCommandQueue::~NullCommandQueue() {
+    if (m_fenceCompletionService) {
+        //The recycle callbacks reference this queue, make sure they have all run
+        Flush();
+        m_fenceCompletionService->Unregister(m_fence);
+    }
+}
+
+std::shared_ptr<ICommandList> NullCommandQueue::AcquireCommandList() {
+    std::shared_ptr<NullCommandList> commandList;
+
+    if (!m_availableCommandLists.TryPop(commandList)) {
+        commandList = std::make_shared<NullCommandList>();
+    }
+
+    return commandList;
+}
+
+uint64_t NullCommandQueue::Submit(std::span<const std::shared_ptr<ICommandList>> commandLists) {
+    NullCommandListStats stats;
+
+    //Every list came from AcquireCommandList, so it is a NullCommandList
+    std::vector<std::shared_ptr<NullCommandList>> toBeRecycled;
+    toBeRecycled.reserve(commandLists.size());
+
+    for (const auto& commandList : commandLists) {
+        auto nullCommandList = std::static_pointer_cast<NullCommandList>(commandList);
+
+        stats += nullCommandList->GetStats();
+        toBeRecycled.push_back(std::move(nullCommandList));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats += stats;
+    }
+
+    const auto recycle = [this, commandLists = std::move(toBeRecycled)] {
+        for (const auto& commandList : commandLists) {
+            commandList->Reset();
+            m_availableCommandLists.TryPush(commandList);
+        }
+    };
+
+    if (!m_fenceCompletionService) {
+        recycle();
+        return Signal();
+    }
+
+    std::lock_guard<std::mutex> lock(m_signalMutex);
+
+    m_fence.Signal(++m_fenceValue);
+    m_fenceCompletionService->Enqueue(m_fence, m_fenceValue, recycle);
+
+    return m_fenceValue;
+}
+
+uint64_t NullCommandQueue::Signal() {
+    std::lock_guard<std::mutex> lock(m_signalMutex);
+
+    m_fence.Signal(++m_fenceValue);
+    return m_fenceValue;
+}
+
+bool NullCommandQueue::IsFenceComplete(uint64_t fenceValue) {
+    return m_fence.IsComplete(fenceValue);
+}
+
+void NullCommandQueue::WaitForFenceValue(uint64_t) {}
+
+void NullCommandQueue::Flush() {
+    if (m_fenceCompletionService) {
+        m_fenceCompletionService->WaitForCallbacks(m_fence, m_fence.GetCompletedValue());
+    }
+}
+
+NullCommandListStats NullCommandQueue::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+void NullCommandQueue::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats = {};
+}
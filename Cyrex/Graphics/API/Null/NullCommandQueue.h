@@ -0,0 +1,52 @@
+#pragma once
+#include "NullCommandList.h"
+#include "Core/LockFreeQueue.h"
+#include "Graphics/Fence.h"
+
+#include <memory>
+#include <mutex>
+#include <span>
+
+namespace Cyrex {
+    class FenceCompletionService;
+
+    //Executes submitted command lists immediately, so every fence is complete as soon
+    //as it is signaled. Keeps the sum of the work of every submitted list.
+    class NullCommandQueue final : public ICommandQueue {
+    public:
+        NullCommandQueue() = default;
+        //Recycles the submitted lists once the service has seen their fence value, the way
+        //CommandQueue does, instead of right away
+        explicit NullCommandQueue(FenceCompletionService& fenceCompletionService) noexcept;
+        NullCommandQueue(const NullCommandQueue& rhs) = delete;
+        NullCommandQueue& operator=(const NullCommandQueue& rhs) = delete;
+        ~NullCommandQueue();
+
+        [[nodiscard]] std::shared_ptr<ICommandList> AcquireCommandList() override;
+        uint64_t Submit(std::span<const std::shared_ptr<ICommandList>> commandLists) override;
+
+        [[nodiscard]] uint64_t Signal() override;
+        bool IsFenceComplete(uint64_t fenceValue) override;
+        void WaitForFenceValue(uint64_t fenceValue) override;
+        void Flush() override;
+
+        [[nodiscard]] NullCommandListStats GetStats() const;
+        void ResetStats();
+
+        [[nodiscard]] const Fence& GetFence() const noexcept { return m_fence; }
+    private:
+        FenceCompletionService* m_fenceCompletionService{ nullptr };
+
+        //Signaled together with the values being enqueued, so they reach the service in order
+        std::mutex m_signalMutex;
+        uint64_t m_fenceValue{ 0 };
+        CpuFence m_fence;
+
+        mutable std::mutex m_statsMutex;
+        NullCommandListStats m_stats;
+
+        //Same limit as CommandQueue
+        static constexpr size_t m_maxAvailableCommandLists = 128;
+        MPMCQueue<std::shared_ptr<NullCommandList>> m_availableCommandLists{ m_maxAvailableCommandLists };
+    };
+}
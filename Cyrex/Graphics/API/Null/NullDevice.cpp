@@ -0,0 +1,20 @@
+#include "NullDevice.h"
+
+using namespace Cyrex;
+
+NullCommandQueue& NullDevice::GetNullQueue(QueueType type) noexcept {
+    switch (type) {
+    case QueueType::Compute:
+        return m_computeCommandQueue;
+    case QueueType::Copy:
+        return m_copyCommandQueue;
+    default:
+        return m_directCommandQueue;
+    }
+}
+
+void NullDevice::Flush() {
+    m_directCommandQueue.Flush();
+    m_computeCommandQueue.Flush();
+    m_copyCommandQueue.Flush();
+}
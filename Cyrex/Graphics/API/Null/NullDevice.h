@@ -0,0 +1,23 @@
+#pragma once
+#include "NullCommandQueue.h"
+
+namespace Cyrex {
+    //A device without a GPU, for running the CPU side of rendering headless
+    class NullDevice final : public IDevice {
+    public:
+        NullDevice() = default;
+        NullDevice(const NullDevice& rhs) = delete;
+        NullDevice& operator=(const NullDevice& rhs) = delete;
+        ~NullDevice() = default;
+
+        ICommandQueue& GetQueue(QueueType type) override { return GetNullQueue(type); }
+        [[nodiscard]] NullCommandQueue& GetNullQueue(QueueType type) noexcept;
+
+        void Flush() override;
+        void ReleaseStaleDescriptors() override {}
+    private:
+        NullCommandQueue m_directCommandQueue;
+        NullCommandQueue m_computeCommandQueue;
+        NullCommandQueue m_copyCommandQueue;
+    };
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+//The calls the CPU side of the renderer makes, without any D3D12 types, so the same
+//recording code can run against the D3D12 backend or the null backend.
+namespace Cyrex {
+    class IndexBuffer;
+    class PipelineStateObject;
+    class RenderTarget;
+    class RootSignature;
+    class ShaderResourceView;
+    class Texture;
+    class VertexBuffer;
+    class Viewport;
+
+    namespace Math { class Rectangle; }
+
+    //Same values as D3D_PRIMITIVE_TOPOLOGY
+    enum class PrimitiveTopology : uint32_t {
+        Undefined     = 0,
+        PointList     = 1,
+        LineList      = 2,
+        LineStrip     = 3,
+        TriangleList  = 4,
+        TriangleStrip = 5
+    };
+
+    enum class QueueType { Direct, Compute, Copy };
+
+    class ICommandList {
+    public:
+        virtual void SetPipelineState(const std::shared_ptr<PipelineStateObject>& pipelineState) = 0;
+        virtual void SetGraphicsRootSignature(const std::shared_ptr<RootSignature>& rootSignature) = 0;
+
+        virtual void SetViewport(const Viewport& viewport) = 0;
+        virtual void SetScissorRect(const Math::Rectangle& scissorRect) noexcept = 0;
+        virtual void SetRenderTarget(const RenderTarget& renderTarget) = 0;
+
+        virtual void SetGraphicsDynamicConstantBuffer(uint32_t rootParameterIndex, size_t sizeInBytes, const void* bufferData) = 0;
+        template<typename T>
+        void SetGraphicsDynamicConstantBuffer(uint32_t rootParameterIndex, const T& data) {
+            SetGraphicsDynamicConstantBuffer(rootParameterIndex, sizeof(T), &data);
+        }
+
+        virtual void SetGraphics32BitConstants(uint32_t rootParameterIndex, uint32_t numConstants, const void* constants) = 0;
+        template<typename T>
+        void SetGraphics32BitConstants(uint32_t rootParameterIndex, const T& constants) {
+            static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Size of type must be a multiple of 4 bytes");
+            SetGraphics32BitConstants(rootParameterIndex, sizeof(T) / sizeof(uint32_t), &constants);
+        }
+
+        virtual void SetGraphicsDynamicStructuredBuffer(uint32_t slot, size_t numElements, size_t elementSize, const void* bufferData) = 0;
+        template<typename T>
+        void SetGraphicsDynamicStructuredBuffer(uint32_t slot, const T& bufferData) {
+            SetGraphicsDynamicStructuredBuffer(slot, bufferData.size(), sizeof(typename T::value_type), bufferData.data());
+        }
+
+        //Binds a texture or view for the pixel shader into a descriptor table
+        virtual void SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t descriptorOffset, const std::shared_ptr<Texture>& texture) = 0;
+        virtual void SetPixelShaderResource(uint32_t rootParameterIndex, uint32_t descriptorOffset, const std::shared_ptr<ShaderResourceView>& srv) = 0;
+
+        virtual void SetPrimitiveTopology(PrimitiveTopology primitiveTopology) = 0;
+        virtual void SetVertexBuffer(uint32_t slot, const std::shared_ptr<VertexBuffer>& vertexBuffer) = 0;
+        virtual void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) = 0;
+
+        virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t startVertex = 0, uint32_t startInstance = 0) = 0;
+        virtual void DrawIndexed(
+            uint32_t indexCount,
+            uint32_t instanceCount = 1,
+            uint32_t startIndex = 0,
+            int32_t baseVertex = 0,
+            uint32_t startInstance = 0) = 0;
+    protected:
+        ~ICommandList() = default;
+    };
+
+    class ICommandQueue {
+    public:
+        //Command lists handed out by a queue may only be submitted to that queue
+        [[nodiscard]] virtual std::shared_ptr<ICommandList> AcquireCommandList() = 0;
+        virtual uint64_t Submit(std::span<const std::shared_ptr<ICommandList>> commandLists) = 0;
+
+        [[nodiscard]] virtual uint64_t Signal() = 0;
+        virtual bool IsFenceComplete(uint64_t fenceValue) = 0;
+        virtual void WaitForFenceValue(uint64_t fenceValue) = 0;
+        virtual void Flush() = 0;
+    protected:
+        ~ICommandQueue() = default;
+    };
+
+    class IDevice {
+    public:
+        virtual ICommandQueue& GetQueue(QueueType type) = 0;
+        virtual void Flush() = 0;
+        virtual void ReleaseStaleDescriptors() = 0;
+    protected:
+        ~IDevice() = default;
+    };
+}
@@ -21,6 +21,7 @@ void Camera::SetLookAt(Vector4 eye, Vector4 target, Vector4 up) {
 
     m_invViewDirty = true;
     m_viewDirty    = false;
+    m_frustumDirty = true;
 }
 
 Matrix Camera::GetView() const {
@@ -32,8 +33,7 @@ Matrix Camera::GetView() const {
 
 Matrix Camera::GetInverseView() const {
     if (m_invViewDirty) {
-        m_invView      = Matrix::Inverse(m_invView);
-        m_invViewDirty = false;
+        UpdateInverseViewMatrix();
     }
     return m_invView;
 }
@@ -46,6 +46,7 @@ void Camera::SetProj(float vfov, float aspectRatio, float zNear, float zFar) {
 
     m_projDirty = true;
     m_invProjDirty = true;
+    m_frustumDirty = true;
 }
 
 Matrix Camera::GetProj() const {
@@ -67,12 +68,15 @@ void Camera::SetFov(float vFov) noexcept {
         m_vFov = vFov;
         m_projDirty    = true;
         m_invProjDirty = true;
+        m_frustumDirty = true;
     }
 }
 
 void Camera::SetTranslation(Vector4 translation) {
-    m_translation = translation;
-    m_viewDirty   = true;
+    m_translation  = translation;
+    m_viewDirty    = true;
+    m_invViewDirty = true;
+    m_frustumDirty = true;
 }
 
 Vector4 Camera::GetTranslation() const {
@@ -80,7 +84,10 @@ Vector4 Camera::GetTranslation() const {
 }
 
 void Camera::SetRotation(Quaternion rotation) {
-    m_rotation = rotation;
+    m_rotation     = rotation;
+    m_viewDirty    = true;
+    m_invViewDirty = true;
+    m_frustumDirty = true;
 }
 
 Quaternion Camera::GetRotation() const {
@@ -103,6 +110,7 @@ void Camera::Translate(Vector4 translation, Space space) {
 
     m_viewDirty    = true;
     m_invViewDirty = true;
+    m_frustumDirty = true;
 }
 
 void Camera::Rotate(Quaternion quaternion) {
@@ -110,6 +118,7 @@ void Camera::Rotate(Quaternion quaternion) {
 
     m_viewDirty    = true;
     m_invViewDirty = true;
+    m_frustumDirty = true;
 }
 
 void Camera::UpdateViewMatrix() const {
@@ -145,3 +154,15 @@ void Camera::UpdateInverseProjectionMatrix() const {
     m_invProj = Matrix::Inverse(m_proj);
     m_invProjDirty = false;
 }
+
+const Frustum& Camera::GetFrustum() const {
+    if (m_frustumDirty) {
+        UpdateFrustum();
+    }
+    return m_frustum;
+}
+
+void Camera::UpdateFrustum() const {
+    m_frustum      = Frustum(GetView() * GetProj());
+    m_frustumDirty = false;
+}
@@ -2,6 +2,7 @@
 
 #include <DirectXMath.h>
 #include "Core/Math/Common.h"
+#include "Core/Math/Frustum.h"
 
 enum class Space {
     Local,
@@ -22,6 +23,9 @@ namespace Cyrex {
         Math::Matrix GetProj() const;
         Math::Matrix GetInverseProj() const;
 
+        //In world space, rebuilt when the view or the projection changed
+        const Math::Frustum& GetFrustum() const;
+
         void SetFov(float vFov) noexcept;
         float GetFov() const noexcept { return m_vFov; }
 
@@ -38,17 +42,20 @@ namespace Cyrex {
         void UpdateInverseViewMatrix() const;
         void UpdateProjectionMatrix() const;
         void UpdateInverseProjectionMatrix() const;
+        void UpdateFrustum() const;
 
         float m_vFov{ 45 };
         float m_aspectRatio{ 1.0f };
         float m_nearZ{ 0.1f };
         float m_farZ{ 100.0f };
 
-        mutable bool m_viewDirty;
-        mutable bool m_invViewDirty;
+        mutable bool m_viewDirty{ true };
+        mutable bool m_invViewDirty{ true };
+
+        mutable bool m_projDirty{ true };
+        mutable bool m_invProjDirty{ true };
 
-        mutable bool m_projDirty;
-        mutable bool m_invProjDirty;
+        mutable bool m_frustumDirty{ true };
 
         Math::Vector4 m_translation;
         Math::Quaternion m_rotation;
@@ -58,5 +65,7 @@ namespace Cyrex {
 
         mutable Math::Matrix m_proj;
         mutable Math::Matrix m_invProj;
+
+        mutable Math::Frustum m_frustum;
     };
 }
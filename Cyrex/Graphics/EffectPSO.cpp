@@ -1,34 +1,48 @@
 #include "EffectPSO.h"
+#include "API/RenderBackend.h"
+#include "Material.h"
+
+#ifdef _WIN32
 #include "API/DX12/CommandList.h"
 #include "API/DX12/Device.h"
 #include "API/DX12/PipelineStateObject.h"
 #include "API/DX12/RootSignature.h"
 #include "API/DX12/VertexTypes.h"
 #include "API/DX12/DXException.h"
-#include "Material.h"
 
 #include <d3dcompiler.h>
 #include "API/DX12/d3dx12.h"
 
 namespace wrl = Microsoft::WRL;
 namespace dx  = DirectX;
+#endif
 
 using namespace Cyrex;
 using namespace Cyrex::Math;
 
+EffectPSO::EffectPSO(
+    std::shared_ptr<RootSignature> rootSignature, 
+    std::shared_ptr<PipelineStateObject> pipelineStateObject, 
+    std::shared_ptr<ShaderResourceView> defaultSRV) noexcept
+    :
+    m_rootSignature(std::move(rootSignature)),
+    m_pipelineStateObject(std::move(pipelineStateObject)),
+    m_defaultSRV(std::move(defaultSRV))
+{}
+
+#ifdef _WIN32
 EffectPSO::EffectPSO(Device& device, EnableLighting enableLighting, EnableDecal enableDecal)
     :
-    m_device(device),
     m_enableLighting(static_cast<bool>(enableLighting)),
     m_enableDecal(static_cast<bool>(enableDecal))
 {
-    CreateRootSignature();
-    CreatePSO();
+    CreateRootSignature(device);
+    CreatePSO(device);
     //Create an SRV that can be used to pad unused texture slots.
-    CreateSRV();
+    CreateSRV(device);
 }
 
-void EffectPSO::CreateRootSignature() noexcept {
+void EffectPSO::CreateRootSignature(Device& device) noexcept {
     D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT |
                                                     D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS       |
                                                     D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS     |
@@ -53,10 +67,10 @@ void EffectPSO::CreateRootSignature() noexcept {
     CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDescription;
     rootSignatureDescription.Init_1_1(RootParameters::NumRootParameters, rootParameters, 1, &anisotropicSampler, rootSignatureFlags);
 
-    m_rootSignature = std::make_shared<RootSignature>(m_device, rootSignatureDescription.Desc_1_1);
+    m_rootSignature = std::make_shared<RootSignature>(device, rootSignatureDescription.Desc_1_1);
 }
 
-void EffectPSO::CreatePSO() noexcept {
+void EffectPSO::CreatePSO(Device& device) noexcept {
     //Load the shaders
     wrl::ComPtr<ID3DBlob> vertexShaderBlob;
     ThrowIfFailed(D3DReadFileToBlob(L"Graphics/Shaders/Compiled/VertexShader.cso", &vertexShaderBlob));
@@ -92,7 +106,7 @@ void EffectPSO::CreatePSO() noexcept {
     auto backBufferFormat  = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
     auto depthBufferFormat = DXGI_FORMAT_D32_FLOAT;
 
-    auto sampleDesc = m_device.GetMultisampleQualityLevels(backBufferFormat);
+    auto sampleDesc = device.GetMultisampleQualityLevels(backBufferFormat);
 
     D3D12_RT_FORMAT_ARRAY rtvFormats = {};
     rtvFormats.NumRenderTargets      = 1;
@@ -116,12 +130,12 @@ void EffectPSO::CreatePSO() noexcept {
     pipelineStateStream.SampleDesc            = sampleDesc;
 
     m_pipelineStateObject = std::make_shared<PipelineStateObject>(
-        m_device, 
+        device, 
         D3D12_PIPELINE_STATE_STREAM_DESC{ sizeof(pipelineStateStream), 
         &pipelineStateStream });
 }
 
-void EffectPSO::CreateSRV() noexcept {
+void EffectPSO::CreateSRV(Device& device) noexcept {
     D3D12_SHADER_RESOURCE_VIEW_DESC defaultSRV = {};
     defaultSRV.Format                          = DXGI_FORMAT_R8G8B8A8_UNORM;
     defaultSRV.ViewDimension                   = D3D12_SRV_DIMENSION_TEXTURE2D;
@@ -131,27 +145,26 @@ void EffectPSO::CreateSRV() noexcept {
     defaultSRV.Texture2D.ResourceMinLODClamp   = 0;
     defaultSRV.Shader4ComponentMapping         = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 
-    m_defaultSRV = m_device.CreateShaderResourceView(nullptr, &defaultSRV);
+    m_defaultSRV = device.CreateShaderResourceView(nullptr, &defaultSRV);
 }
+#endif
 
-inline void EffectPSO::BindTexture(CommandList& commandList, uint32_t offset, const std::shared_ptr<Texture>& texture) {
+inline void EffectPSO::BindTexture(ICommandList& commandList, uint32_t offset, const std::shared_ptr<Texture>& texture) {
     if (texture) {
-        commandList.SetShaderResourceView(
-            RootParameters::Textures,
-            offset,
-            texture,
-            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        commandList.SetPixelShaderResource(RootParameters::Textures, offset, texture);
     }
     else {
-        commandList.SetShaderResourceView(
-            RootParameters::Textures,
-            offset,
-            m_defaultSRV,
-            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        commandList.SetPixelShaderResource(RootParameters::Textures, offset, m_defaultSRV);
     }
 }
 
-void EffectPSO::Apply(CommandList& commandList) {
+void EffectPSO::Apply(ICommandList& commandList) {
+    //Root arguments do not carry over between command lists
+    if (&commandList != m_pPreviousCommandList) {
+        m_dirtyFlags           = DF_All;
+        m_pPreviousCommandList = &commandList;
+    }
+
     commandList.SetPipelineState(m_pipelineStateObject);
     commandList.SetGraphicsRootSignature(m_rootSignature);
 
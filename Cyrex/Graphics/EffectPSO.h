@@ -1,7 +1,6 @@
 #pragma once
 
 #include "Lights.h"
-#include <DirectXMath.h>
 #include <memory>
 #include <vector>
 #include "Core/Math/Matrix.h"
@@ -10,8 +9,8 @@ namespace Cyrex {
     enum class EnableLighting : bool { True = true, False = false };
     enum class EnableDecal    : bool { True = true, False = false };
 
-    class CommandList;
     class Device;
+    class ICommandList;
     class Material;
     class RootSignature;
     class PipelineStateObject;
@@ -58,6 +57,11 @@ namespace Cyrex {
         };
 
         EffectPSO(Device& device, EnableLighting enableLighting, EnableDecal enableDecal);
+        //Uses objects that were created elsewhere, the null backend passes stand-ins
+        EffectPSO(
+            std::shared_ptr<RootSignature> rootSignature, 
+            std::shared_ptr<PipelineStateObject> pipelineStateObject, 
+            std::shared_ptr<ShaderResourceView> defaultSRV) noexcept;
 
         [[nodiscard]] const std::vector<PointLight>& GetPointLights() const noexcept { return m_pointLights; }
         void SetPointLights(const std::vector<PointLight>& pointLights) noexcept {
@@ -86,24 +90,24 @@ namespace Cyrex {
         }
 
         [[nodiscard]] Cyrex::Math::Matrix GetWorldMatrix() const noexcept { return m_MVP.World; }
-        void XM_CALLCONV SetWorldMatrix(Cyrex::Math::Matrix worldMatrix)  noexcept {
+        void SetWorldMatrix(Cyrex::Math::Matrix worldMatrix)  noexcept {
             m_MVP.World = worldMatrix;
             m_dirtyFlags |= DF_Matrices;
         }
        
         [[nodiscard]] Cyrex::Math::Matrix GetViewMatrix() const noexcept { return m_MVP.View; }
-        void XM_CALLCONV SetViewMatrix(Cyrex::Math::Matrix viewMatrix) noexcept {
+        void SetViewMatrix(Cyrex::Math::Matrix viewMatrix) noexcept {
             m_MVP.View = viewMatrix;
             m_dirtyFlags |= DF_Matrices;
         }
        
         [[nodiscard]] Cyrex::Math::Matrix GetProjectionMatrix() const noexcept  { return m_MVP.Projection; }
-        void XM_CALLCONV SetProjectionMatrix(Cyrex::Math::Matrix projectionMatrix) noexcept {
+        void SetProjectionMatrix(Cyrex::Math::Matrix projectionMatrix) noexcept {
             m_MVP.Projection = projectionMatrix;
             m_dirtyFlags |= DF_Matrices;
         }
 
-        void Apply(CommandList& commandList);
+        void Apply(ICommandList& commandList);
     private:
         enum DirtyFlags {
             DF_None              = 0,
@@ -121,13 +125,12 @@ namespace Cyrex {
             Cyrex::Math::Matrix Projection;
         };
 
-        void CreateRootSignature() noexcept;
-        void CreatePSO() noexcept;
-        void CreateSRV() noexcept;
+        void CreateRootSignature(Device& device) noexcept;
+        void CreatePSO(Device& device) noexcept;
+        void CreateSRV(Device& device) noexcept;
 
-        inline void BindTexture(CommandList& commandList, uint32_t offset, const std::shared_ptr<Texture>& texture);
+        inline void BindTexture(ICommandList& commandList, uint32_t offset, const std::shared_ptr<Texture>& texture);
 
-        Device& m_device;
         std::shared_ptr<RootSignature> m_rootSignature;
         std::shared_ptr<PipelineStateObject> m_pipelineStateObject;
 
@@ -139,11 +142,11 @@ namespace Cyrex {
         std::shared_ptr<ShaderResourceView> m_defaultSRV;
 
         MVP m_MVP;
-        CommandList* m_pPreviousCommandList{ nullptr };
+        ICommandList* m_pPreviousCommandList{ nullptr };
 
         uint32_t m_dirtyFlags{ DF_All };
 
-        bool m_enableLighting;
-        bool m_enableDecal;
+        bool m_enableLighting{ true };
+        bool m_enableDecal{ false };
     };
 }
\ No newline at end of file
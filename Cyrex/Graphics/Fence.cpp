@@ -0,0 +1,93 @@
+#include "Fence.h"
+#include <algorithm>
+#include <limits>
+#include <new>
+
+using namespace Cyrex;
+
+#ifdef _WIN32
+FenceEvent::FenceEvent()
+    :
+    m_handle(CreateEvent(nullptr, false, false, nullptr))
+{
+    if (!m_handle) {
+        throw std::bad_alloc();
+    }
+}
+
+FenceEvent::~FenceEvent() {
+    CloseHandle(m_handle);
+}
+
+void FenceEvent::Set() noexcept {
+    SetEvent(m_handle);
+}
+
+void FenceEvent::Wait() noexcept {
+    WaitForSingleObject(m_handle, std::numeric_limits<DWORD>::max());
+}
+#else
+FenceEvent::FenceEvent() = default;
+FenceEvent::~FenceEvent() = default;
+
+void FenceEvent::Set() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_signaled = true;
+    }
+    m_condition.notify_one();
+}
+
+void FenceEvent::Wait() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_signaled; });
+    m_signaled = false;
+}
+#endif
+
+void Fence::WaitForValue(uint64_t value) {
+    if (IsComplete(value)) {
+        return;
+    }
+
+    thread_local FenceEvent event;
+
+    SetEventOnCompletion(value, event);
+    event.Wait();
+}
+
+CpuFence::CpuFence(uint64_t initialValue) noexcept
+    :
+    m_completedValue(initialValue)
+{}
+
+uint64_t CpuFence::GetCompletedValue() const {
+    return m_completedValue.load(std::memory_order_acquire);
+}
+
+void CpuFence::SetEventOnCompletion(uint64_t value, FenceEvent& event) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_completedValue.load(std::memory_order_acquire) >= value) {
+        event.Set();
+        return;
+    }
+
+    m_waiters.emplace_back(value, &event);
+}
+
+void CpuFence::Signal(uint64_t value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_completedValue.store(value, std::memory_order_release);
+
+    const auto reached = std::partition(m_waiters.begin(), m_waiters.end(), [value](const auto& waiter) {
+        return waiter.first > value;
+    });
+
+    for (auto it = reached; it != m_waiters.end(); ++it) {
+        it->second->Set();
+    }
+
+    m_waiters.erase(reached, m_waiters.end());
+}
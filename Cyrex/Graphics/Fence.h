@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include "Platform/Windows/CrxWindow.h"
+#else
+#include <condition_variable>
+#endif
+
+namespace Cyrex {
+    //Auto-reset event that fences signal when they reach a value
+    class FenceEvent {
+    public:
+        FenceEvent();
+        FenceEvent(const FenceEvent& rhs) = delete;
+        FenceEvent& operator=(const FenceEvent& rhs) = delete;
+        ~FenceEvent();
+
+        void Set() noexcept;
+        void Wait() noexcept;
+
+#ifdef _WIN32
+        [[nodiscard]] HANDLE GetNativeHandle() const noexcept { return m_handle; }
+#endif
+    private:
+#ifdef _WIN32
+        HANDLE m_handle;
+#else
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_signaled{ false };
+#endif
+    };
+
+    class Fence {
+    public:
+        virtual ~Fence() = default;
+
+        [[nodiscard]] virtual uint64_t GetCompletedValue() const = 0;
+        //Sets the event once the fence has reached value, right away if it already has
+        virtual void SetEventOnCompletion(uint64_t value, FenceEvent& event) = 0;
+
+        [[nodiscard]] bool IsComplete(uint64_t value) const { return GetCompletedValue() >= value; }
+        void WaitForValue(uint64_t value);
+    };
+
+    //Fence that is completed from the CPU, used where no GPU is available
+    class CpuFence final : public Fence {
+    public:
+        explicit CpuFence(uint64_t initialValue = 0) noexcept;
+
+        [[nodiscard]] uint64_t GetCompletedValue() const override;
+        void SetEventOnCompletion(uint64_t value, FenceEvent& event) override;
+
+        void Signal(uint64_t value);
+    private:
+        std::atomic_uint64_t m_completedValue;
+        std::mutex m_mutex;
+        std::vector<std::pair<uint64_t, FenceEvent*>> m_waiters;
+    };
+}
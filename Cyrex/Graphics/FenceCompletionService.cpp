@@ -0,0 +1,176 @@
+#include "FenceCompletionService.h"
+#include <cassert>
+
+#ifdef _WIN32
+#include "Core/Utils/ThreadUtils.h"
+#endif
+
+using namespace Cyrex;
+
+FenceCompletionService::FenceCompletionService() {
+    m_thread = std::thread(&FenceCompletionService::ServiceLoop, this);
+
+#ifdef _WIN32
+    ThreadUtils::SetThreadName(m_thread, "Fence Completion Service");
+#endif
+}
+
+FenceCompletionService::~FenceCompletionService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_event.Set();
+    m_thread.join();
+}
+
+void FenceCompletionService::Enqueue(Fence& fence, uint64_t value, std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto tracked = Find(fence);
+
+    if (!tracked) {
+        tracked = &m_fences.emplace_back(TrackedFence{ &fence });
+    }
+
+    assert((tracked->Pending.empty() || tracked->Pending.back().Value <= value) && "Fence values must be enqueued in order");
+
+    tracked->Pending.push_back({ value, std::move(callback) });
+
+    if (tracked->Pending.size() == 1) {
+        Arm(*tracked);
+    }
+}
+
+void FenceCompletionService::WaitForCallbacks(const Fence& fence, uint64_t value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_callbacksDone.wait(lock, [&] {
+        const auto tracked = Find(fence);
+
+        if (!tracked) {
+            return true;
+        }
+
+        const bool nothingPending = tracked->Pending.empty() || tracked->Pending.front().Value > value;
+        return nothingPending && tracked->NumExecuting == 0;
+    });
+}
+
+void FenceCompletionService::Unregister(const Fence& fence) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_callbacksDone.wait(lock, [&] {
+        const auto tracked = Find(fence);
+        return !tracked || (tracked->Pending.empty() && tracked->NumExecuting == 0);
+    });
+
+    std::erase_if(m_fences, [&](const TrackedFence& tracked) { return tracked.Target == &fence; });
+}
+
+size_t FenceCompletionService::GetNumPendingCallbacks() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t count = 0;
+    for (const auto& tracked : m_fences) {
+        count += tracked.Pending.size() + tracked.NumExecuting;
+    }
+    return count;
+}
+
+void FenceCompletionService::ServiceLoop() {
+    struct ReadyCallback {
+        Fence* Target;
+        std::function<void()> Callback;
+    };
+
+    std::vector<ReadyCallback> ready;
+
+    while (true) {
+        m_event.Wait();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            bool anyPending = false;
+
+            for (auto& tracked : m_fences) {
+                //Only fences with work are asked, querying a fence can be a driver call
+                if (tracked.Pending.empty()) {
+                    continue;
+                }
+
+                const auto completedValue = tracked.Target->GetCompletedValue();
+
+                while (!tracked.Pending.empty() && tracked.Pending.front().Value <= completedValue) {
+                    ready.push_back({ tracked.Target, std::move(tracked.Pending.front().Callback) });
+                    tracked.Pending.pop_front();
+                    tracked.NumExecuting++;
+                }
+
+                //The next value enqueued may equal the one armed last, it has to be armed again
+                if (tracked.Pending.empty()) {
+                    tracked.ArmedValue = NotArmed;
+                }
+
+                anyPending |= !tracked.Pending.empty();
+            }
+
+            //Drain everything that is still in flight before shutting down
+            if (!m_running && !anyPending && ready.empty()) {
+                return;
+            }
+        }
+
+        for (auto& callback : ready) {
+            callback.Callback();
+            //Release whatever the callback captured outside the lock
+            callback.Callback = nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (const auto& callback : ready) {
+                Find(*callback.Target)->NumExecuting--;
+            }
+
+            bool anyPending = false;
+
+            for (auto& tracked : m_fences) {
+                if (!tracked.Pending.empty()) {
+                    Arm(tracked);
+                    anyPending = true;
+                }
+            }
+
+            ready.clear();
+
+            if (!m_running && !anyPending) {
+                m_callbacksDone.notify_all();
+                return;
+            }
+        }
+
+        m_callbacksDone.notify_all();
+    }
+}
+
+FenceCompletionService::TrackedFence* FenceCompletionService::Find(const Fence& fence) noexcept {
+    for (auto& tracked : m_fences) {
+        if (tracked.Target == &fence) {
+            return &tracked;
+        }
+    }
+    return nullptr;
+}
+
+void FenceCompletionService::Arm(TrackedFence& tracked) {
+    const auto value = tracked.Pending.front().Value;
+
+    //A fence keeps every registration alive, so only register each value once
+    if (tracked.ArmedValue != value) {
+        tracked.ArmedValue = value;
+        tracked.Target->SetEventOnCompletion(value, m_event);
+    }
+}
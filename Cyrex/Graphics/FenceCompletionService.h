@@ -0,0 +1,61 @@
+#pragma once
+#include "Fence.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cyrex {
+    //Runs callbacks once a fence reaches a given value. One thread serves every
+    //registered fence: all fences signal the same event, so the thread sleeps in
+    //a single wait until any of them makes progress or new work is enqueued.
+    class FenceCompletionService {
+    public:
+        FenceCompletionService();
+        FenceCompletionService(const FenceCompletionService& rhs) = delete;
+        FenceCompletionService& operator=(const FenceCompletionService& rhs) = delete;
+        //Waits for every pending callback, so every fence with pending work must still be signaled
+        ~FenceCompletionService();
+
+        //Callbacks for the same fence run in the order of their values,
+        //values must therefore be enqueued in non-decreasing order per fence.
+        void Enqueue(Fence& fence, uint64_t value, std::function<void()> callback);
+        //Blocks until every callback enqueued for fence with a value <= value has run
+        void WaitForCallbacks(const Fence& fence, uint64_t value);
+        //Waits for every callback enqueued for fence and stops tracking it, so the fence can
+        //be destroyed before the service. Every value enqueued must therefore be reached.
+        void Unregister(const Fence& fence);
+
+        [[nodiscard]] size_t GetNumPendingCallbacks() const;
+    private:
+        struct PendingCallback {
+            uint64_t Value;
+            std::function<void()> Callback;
+        };
+
+        static constexpr uint64_t NotArmed = ~0ull;
+
+        struct TrackedFence {
+            Fence* Target;
+            std::deque<PendingCallback> Pending;
+            //The value the fence sets m_event at, cleared once nothing is pending
+            uint64_t ArmedValue{ NotArmed };
+            uint32_t NumExecuting{ 0 };
+        };
+
+        void ServiceLoop();
+        [[nodiscard]] TrackedFence* Find(const Fence& fence) noexcept;
+        void Arm(TrackedFence& tracked);
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_callbacksDone;
+        std::vector<TrackedFence> m_fences;
+        FenceEvent m_event;
+        bool m_running{ true };
+        std::thread m_thread;
+    };
+}
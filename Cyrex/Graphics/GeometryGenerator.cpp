@@ -7,17 +7,100 @@
 #include <algorithm>
 #include "Graphics/API/DX12/VertexTypes.h"
 #include "Core/Math/Common.h"
+#include "Core/Math/VecMath.h"
 #include <Core/Math/Matrix.h>
 
 namespace cx = Cyrex;
 using namespace Cyrex;
 using namespace Cyrex::Math;
 
-using VertexCollection = std::vector<VertexPositionNormalTangentBitangentTexture>;
+using Vertex           = VertexPositionNormalTangentBitangentTexture;
+using VertexCollection = std::vector<Vertex>;
 using IndexCollection  = std::vector<uint16_t>;
 
 enum class CylinderCap {Top, Bottom};
 
+//The sin and cos of segments + 1 angles, start + i * step, in one batch
+void SinCosRing(size_t segments, float start, float step, std::vector<float>& sin, std::vector<float>& cos)
+{
+    std::vector<float> angles(segments + 1);
+
+    for (size_t i = 0; i <= segments; i++) {
+        angles[i] = start + i * step;
+    }
+
+    sin.resize(angles.size());
+    cos.resize(angles.size());
+
+    Vec::SinCos(angles, sin, cos);
+}
+
+template<size_t NumVertices, size_t NumIndices>
+struct MeshTable {
+    std::array<Vertex, NumVertices> Vertices;
+    std::array<uint16_t, NumIndices> Indices;
+};
+
+//Cube of size 1 centered at 0,0,0, built at compile time. CreateCube only scales the positions.
+constexpr auto UnitCube = [] {
+    constexpr Vector3 v[8] = { { 0.5f, 0.5f, -0.5f },  { 0.5f, 0.5f, 0.5f },   { 0.5f, -0.5f, 0.5f },   { 0.5f, -0.5f, -0.5f },
+                               { -0.5f, 0.5f, 0.5f },  { -0.5f, 0.5f, -0.5f }, { -0.5f, -0.5f, -0.5f }, { -0.5f, -0.5f, 0.5f } };
+    // 6 face normals
+    constexpr Vector3 n[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    // 4 unique texture coordinates
+    constexpr Vector3 uv[4] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } };
+
+    constexpr uint16_t i[24] = {
+       0, 1, 2, 3,  // +X
+       4, 5, 6, 7,  // -X
+       4, 1, 0, 5,  // +Y
+       2, 7, 6, 3,  // -Y
+       1, 4, 7, 2,  // +Z
+       5, 0, 3, 6   // -Z
+    };
+
+    MeshTable<24, 36> cube{};
+
+    for (uint16_t faces = 0; faces < 6; faces++) {
+        // Four vertices per face.
+        for (uint16_t corner = 0; corner < 4; corner++) {
+            cube.Vertices[faces * 4 + corner] = Vertex(v[i[faces * 4 + corner]], n[faces], uv[corner]);
+        }
+
+        // First triangle.
+        cube.Indices[faces * 6 + 0] = faces * 4 + 0;
+        cube.Indices[faces * 6 + 1] = faces * 4 + 1;
+        cube.Indices[faces * 6 + 2] = faces * 4 + 2;
+
+        // Second triangle
+        cube.Indices[faces * 6 + 3] = faces * 4 + 2;
+        cube.Indices[faces * 6 + 4] = faces * 4 + 3;
+        cube.Indices[faces * 6 + 5] = faces * 4 + 0;
+    }
+    return cube;
+}();
+
+//Plane of width and height 1 in the XZ plane, facing +Y
+constexpr MeshTable<4, 6> UnitPlane = {
+    {
+        Vertex(Vector3(-0.5f, 0.0f,  0.5f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f)),
+        Vertex(Vector3(0.5f,  0.0f,  0.5f), Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)),
+        Vertex(Vector3(0.5f,  0.0f, -0.5f), Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 1.0f, 0.0f)),
+        Vertex(Vector3(-0.5f, 0.0f, -0.5f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)),
+    },
+    { 1, 3, 0, 2, 3, 1 }
+};
+
+template<size_t NumVertices, size_t NumIndices>
+void CopyMeshTable(const MeshTable<NumVertices, NumIndices>& table, const Vector3& scale, VertexCollection& vertices, IndexCollection& indices) {
+    vertices.assign(table.Vertices.begin(), table.Vertices.end());
+    indices.assign(table.Indices.begin(), table.Indices.end());
+
+    for (auto& vertex : vertices) {
+        vertex.Position *= scale;
+    }
+}
+
 inline void ReverseWinding(IndexCollection& indices, VertexCollection& vertices) {
     assert((indices.size() % 3) == 0);
 
@@ -48,9 +131,13 @@ void BuildCylinderCap(
     Vector4 normal  = (cap == CylinderCap::Top) ? Vector4(0,1,0,0) : Vector4(0, -1, 0,0);
     Vector4 tangent = { 1,0,0,0 };
 
+    std::vector<float> sin;
+    std::vector<float> cos;
+    SinCosRing(numSlices, 0.0f, dTheta, sin, cos);
+
     for (uint32_t i = 0; i <= numSlices; i++) {
-        const float x = topRadius * std::cos(i * dTheta);
-        const float z = topRadius * std::sin(i * dTheta);
+        const float x = topRadius * cos[i];
+        const float z = topRadius * sin[i];
         const float u = x / height + 0.5f;
         const float v = z / height + 0.5f;
 
@@ -83,43 +170,7 @@ std::shared_ptr<Scene> GeometryGenerator::CreateCube(
     VertexCollection vertices;
     IndexCollection indices;
 
-    // Cube is centered at 0,0,0.
-    float s = size * 0.5f;
-
-    Vector4 v[8] = { { s, s, -s,0 }, { s, s, s ,0, }, { s, -s, s,0 },   { s, -s, -s,0 },
-                     { -s, s, s ,0}, { -s, s, -s ,0}, { -s, -s, -s ,0}, { -s, -s, s ,0} };
-    // 6 face normals
-    Vector4 n[6] = { { 1, 0, 0,0}, { -1, 0, 0,0 }, { 0, 1, 0 ,0}, { 0, -1, 0 ,0}, { 0, 0, 1 ,0}, { 0, 0, -1 ,0} };
-    // 4 unique texture coordinates
-    Vector2 uv[4] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
-
-    uint16_t i[24] = {
-       0, 1, 2, 3,  // +X
-       4, 5, 6, 7,  // -X
-       4, 1, 0, 5,  // +Y
-       2, 7, 6, 3,  // -Y
-       1, 4, 7, 2,  // +Z
-       5, 0, 3, 6   // -Z
-    };
-
-    for (uint16_t faces = 0; faces < 6; faces++)
-    {
-        // Four vertices per face.
-        vertices.emplace_back(v[i[faces * 4 + 0]], n[faces], uv[0]);
-        vertices.emplace_back(v[i[faces * 4 + 1]], n[faces], uv[1]);
-        vertices.emplace_back(v[i[faces * 4 + 2]], n[faces], uv[2]);
-        vertices.emplace_back(v[i[faces * 4 + 3]], n[faces], uv[3]);
-
-        // First triangle.
-        indices.emplace_back(faces * 4 + 0);
-        indices.emplace_back(faces * 4 + 1);
-        indices.emplace_back(faces * 4 + 2);
-
-        // Second triangle
-        indices.emplace_back(faces * 4 + 2);
-        indices.emplace_back(faces * 4 + 3);
-        indices.emplace_back(faces * 4 + 0);
-    }
+    CopyMeshTable(UnitCube, Vector3(size), vertices, indices);
 
     if (reverseWinding) {
         ReverseWinding(indices, vertices);
@@ -149,20 +200,26 @@ std::shared_ptr<Scene> GeometryGenerator::CreateSphere(
     const size_t verticalSegments   = tessellation;
     const size_t horizontalSegments = tessellation * 2;
 
+    std::vector<float> latitudeSin;
+    std::vector<float> latitudeCos;
+    SinCosRing(verticalSegments, -MathConstants::PI_DIV2, MathConstants::PI / verticalSegments, latitudeSin, latitudeCos);
+
+    std::vector<float> longitudeSin;
+    std::vector<float> longitudeCos;
+    SinCosRing(horizontalSegments, 0.0f, MathConstants::PI_MUL2 / horizontalSegments, longitudeSin, longitudeCos);
+
     for (size_t i = 0; i <= verticalSegments; i++) {
-        float v        = static_cast<float>(i) / verticalSegments;
-        float latidude = (i * MathConstants::PI / verticalSegments) - MathConstants::PI_DIV2;
+        float v = static_cast<float>(i) / verticalSegments;
 
-        float dy  = std::sin(latidude);
-        float dxz = std::cos(latidude);
+        float dy  = latitudeSin[i];
+        float dxz = latitudeCos[i];
 
         // Create a single ring of vertices at this latitude.
         for (size_t j = 0; j <= horizontalSegments; j++) {
-            float u         = static_cast<float>(j) / horizontalSegments;
-            float longitude = j * MathConstants::PI_MUL2 / horizontalSegments;
+            float u = static_cast<float>(j) / horizontalSegments;
 
-            float dx = std::sin(longitude);
-            float dz = std::cos(longitude);
+            float dx = longitudeSin[j];
+            float dz = longitudeCos[j];
 
             dx *= dxz;
             dz *= dxz;
@@ -216,15 +273,20 @@ std::shared_ptr<Scene> GeometryGenerator::CreateCylinder(
     const float stackHeight = height / numStacks;
     const float radiusStep  = (topRadius - bottomRadius) / numStacks;
     const float ringCount   = static_cast<float>(numStacks + 1);
+    const float dTheta      = 2.0f * MathConstants::PI / numSlices;
+
+    //Every ring has the same angles
+    std::vector<float> sin;
+    std::vector<float> cos;
+    SinCosRing(numSlices, 0.0f, dTheta, sin, cos);
 
     for (uint32_t i = 0; i < ringCount; i++) {
-        const float y      = -0.5f * height + i * stackHeight;
-        const float r      = bottomRadius + i * radiusStep;
-        const float dTheta = 2.0f * MathConstants::PI / numSlices;
+        const float y = -0.5f * height + i * stackHeight;
+        const float r = bottomRadius + i * radiusStep;
 
         for (uint32_t j = 0; j <= numSlices; j++) {
-            const float c = std::cos(j * dTheta);
-            const float s = std::sin(j * dTheta);
+            const float c = cos[j];
+            const float s = sin[j];
 
             Vector4 pos      = { r * c, y, r * s,0 };
             Vector2 texcoord = { static_cast<float>(j) / numSlices, 1.0f - static_cast<float>(i) / numStacks};
@@ -291,6 +353,10 @@ std::shared_ptr<Scene> GeometryGenerator::CreateTorus(
 
    const size_t stride = static_cast<size_t>(tessellation) + 1;
 
+    std::vector<float> innerSin;
+    std::vector<float> innerCos;
+    SinCosRing(tessellation, MathConstants::PI_FLOAT, MathConstants::PI_MUL2 / tessellation, innerSin, innerCos);
+
     //loop around the main ring of the torus
     for (size_t i = 0; i <= tessellation; i++) {
         const float u           = static_cast<float>(i) / tessellation;
@@ -300,11 +366,10 @@ std::shared_ptr<Scene> GeometryGenerator::CreateTorus(
 
         //loop along the other axis
         for (size_t j = 0; j <= tessellation; j++) {
-            const float v          = 1 - static_cast<float>(j) / tessellation;
-            const float innerAngle = j * MathConstants::PI_MUL2 / tessellation + MathConstants::PI_FLOAT;
+            const float v = 1 - static_cast<float>(j) / tessellation;
 
-            const float dx = std::cos(innerAngle);
-            const float dy = std::sin(innerAngle);
+            const float dx = innerCos[j];
+            const float dy = innerSin[j];
 
             //Create a vertex
             Vector4 normal = { dx, dy, 0, 0 };
@@ -345,17 +410,10 @@ std::shared_ptr<Scene> GeometryGenerator::CreatePlane(
 {
     assert(commandList);
 
-    using namespace DirectX;
-    using Vertex = VertexPositionNormalTangentBitangentTexture;
-
-    VertexCollection vertices = {
-        Vertex(Vector4(-0.5f * width, 0.0f,  0.5f * height,0), Vector4(0.0f, 1.0f, 0.0f,0), Vector2(0.0f, 0.0f)),
-        Vertex(Vector4(0.5f  * width, 0.0f,  0.5f * height,0), Vector4(0.0f, 1.0f, 0.0f,0), Vector2(1.0f, 0.0f)),
-        Vertex(Vector4(0.5f  * width, 0.0f, -0.5f * height,0), Vector4(0.0f, 1.0f, 0.0f,0), Vector2(1.0f, 1.0f)),
-        Vertex(Vector4(-0.5f * width, 0.0f, -0.5f * height,0), Vector4(0.0f, 1.0f, 0.0f,0), Vector2(0.0f, 1.0f)),
-    };
+    VertexCollection vertices;
+    IndexCollection indices;
 
-    IndexCollection indices = { 1, 3, 0, 2, 3, 1 };
+    CopyMeshTable(UnitPlane, Vector3(width, 1.0f, height), vertices, indices);
 
     if (reverseWinding) {
         ReverseWinding(indices, vertices);
@@ -13,6 +13,8 @@
 #include "Editor/LightsEditorPanel.h"
 
 #include "Core/Logger.h"
+#include "Core/Profiler.h"
+#include "Core/MemoryTracker.h"
 #include "Core/Input/Keyboard.h"
 #include "Core/Input/Mouse.h"
 #include "Core/Math/Math.h"
@@ -35,6 +37,7 @@
 #include <cstdlib>
 
 #include <ShObjIdl.h>
+#include <DirectXCollision.h>
 
 import StringUtils;
 
@@ -114,6 +117,8 @@ Graphics::Graphics()
 Graphics::~Graphics() { }
 
 void Graphics::Initialize(uint32_t width, uint32_t height) {
+    CRX_MEMORY_TAG(Graphics);
+
     //Check for DirectX Math suport
     if (!DirectX::XMVerifyCPUSupport()) {
         crxlog::err("No support for DirectX Math found");
@@ -138,34 +143,51 @@ void Graphics::Initialize(uint32_t width, uint32_t height) {
 
     LoadContent();
     Resize(width, height);
+    BuildFrameGraph();
 
     m_isIntialized = true;
 }
 
 void Graphics::Update() noexcept {
-    using namespace DirectX;
+    CRX_PROFILE_FUNCTION();
+    m_frameGraph.Execute(JobSystem::Get());
+}
+
+void Graphics::BuildFrameGraph() {
+    const auto timer      = m_frameGraph.AddTask("UpdateTimer", [this] { UpdateTimer(); });
+    //Wait for the swapchain before updating the camera in order to reduce input lag
+    const auto swapChain  = m_frameGraph.AddTask("WaitForSwapChain", [this] { m_swapChain->WaitForSwapChain(); }, { timer });
+    const auto camera     = m_frameGraph.AddTask("UpdateCamera", [this] { UpdateCamera(); }, { swapChain });
+
+    //The scene traversal does not read the camera, it only has to see this frame's transforms
+    m_frameGraph.AddTask("UpdateScene", [this] { UpdateScene(); }, { swapChain });
+
+    //The lights only need the view matrix, so they can be updated side by side
+    const auto pointLights       = m_frameGraph.AddTask("UpdatePointLights", [this] { UpdatePointLights(); }, { camera });
+    const auto spotLights        = m_frameGraph.AddTask("UpdateSpotLights", [this] { UpdateSpotLights(); }, { camera });
+    const auto directionalLights = m_frameGraph.AddTask("UpdateDirectionalLights", [this] { UpdateDirectionalLights(); }, { camera });
+
+    m_frameGraph.AddTask("PackLights", [this] { PackLights(); }, { pointLights, spotLights, directionalLights });
+}
 
+void Graphics::UpdateTimer() noexcept {
     static uint64_t frameCount = 0;
 
     m_timer.Tick();
     frameCount++;  
 
     if (m_timer.GetElapsedSeconds() > 1.0) {
-        m_fps = frameCount / m_timer.GetElapsedSeconds();
+        m_fps            = frameCount / m_timer.GetElapsedSeconds();
+        m_frameTimeStats = m_timer.GetFrameTimeStats();
 
         frameCount = 0;
         m_timer.ResetElapsedTime();
     }
-     //Wait for the swapchain before updating the camera in order to reduce input lag
-    m_swapChain->WaitForSwapChain();
-
-    UpdateCamera();
-    UpdateLights();
 }
 
 void Graphics::LoadContent() {
     //Load the scene asynchronously
-    m_loadingTask = std::async(std::launch::async, [&]() -> bool { return LoadScene(m_testScene); });
+    m_loadingTask = std::async(std::launch::async, [this] { return LoadScene(m_testScene); });
 
     auto& commandQueue = m_device->GetCommandQueue(D3D12_COMMAND_LIST_TYPE_COPY);
     auto  commandList  = commandQueue.GetCommandList();
@@ -234,13 +256,19 @@ void Graphics::LoadContent() {
 }
 
 void Graphics::UnLoadContent() noexcept { 
-    m_loadingTask.get();
+    if (m_loadingTask.valid()) {
+        m_loadingTask.wait();
+    }
     m_editorLayer->Detach();
 }
 
 bool Graphics::LoadScene(const std::string& sceneFile) {
+    CRX_MEMORY_TAG(SceneImport);
+
     m_isLoading     = true;
 
+    const auto memoryBefore = MemoryTracker::TakeSnapshot();
+
     auto& commandQueue = m_device->GetCommandQueue(D3D12_COMMAND_LIST_TYPE_COPY);
     auto commandList   = commandQueue.GetCommandList();
 
@@ -252,8 +280,12 @@ bool Graphics::LoadScene(const std::string& sceneFile) {
         });
 
     if (scene) [[likely]] {
+        const auto aabb = scene->GetAABB();
+
         BoundingSphere boudningSphere;
-        BoundingSphere::CreateFromBoundingBox(boudningSphere, scene->GetAABB());
+        BoundingSphere::CreateFromBoundingBox(boudningSphere, BoundingBox(
+            { aabb.Center.x, aabb.Center.y, aabb.Center.z },
+            { aabb.Extents.x, aabb.Extents.y, aabb.Extents.z }));
 
         auto scale = 50.0f / (boudningSphere.Radius * 2.0f);
         boudningSphere.Radius *= scale;
@@ -281,6 +313,9 @@ bool Graphics::LoadScene(const std::string& sceneFile) {
 
     m_isLoading = false;
 
+    //Peaks are process wide, the rest is what loading this scene allocated and kept
+    crxlog::info("Memory used by loading ", sceneFile, ":\n", (MemoryTracker::TakeSnapshot() - memoryBefore).ToString());
+
     return scene != nullptr;
 }
 
@@ -296,11 +331,14 @@ void Cyrex::Graphics::SetViewPortSize(float x, float y) noexcept {
 }
 
 void Graphics::Render() {
+    CRX_PROFILE_FUNCTION();
     using namespace DirectX;
 
     auto& commandQueue = m_device->GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
     auto commandList   = commandQueue.GetCommandList();
 
+    std::vector<std::shared_ptr<CommandList>> commandLists{ commandList };
+
     const auto& renderTarget = m_isLoading ? m_swapChain->GetRenderTarget() : m_renderTarget;
 
     //If we are still loading the scene, just clear the screen with a blue color.
@@ -308,11 +346,6 @@ void Graphics::Render() {
         TextureManager::ClearTexture(*commandList, renderTarget.GetTexture(AttachmentPoint::Color0), Colors::LightSteelBlue);
     }
     else {
-        //Create the scene visitors
-        SceneVisitor opaquePass(*commandList, m_camera, *m_lightingPSO, RenderPass::Opaque);
-        SceneVisitor transparentPass(*commandList, m_camera, *m_decalPSO, RenderPass::Transparent);
-        SceneVisitor unlitPass(*commandList, m_camera, *m_unlitPSO, RenderPass::Opaque);
-
         // Clear the render targets.
         TextureManager::ClearTexture(
             *commandList,
@@ -324,16 +357,18 @@ void Graphics::Render() {
             renderTarget.GetTexture(AttachmentPoint::DepthStencil),
             D3D12_CLEAR_FLAG_DEPTH);
 
+        //Render the scene, the chunks are recorded in parallel into their own command lists
+        RecordScene(commandQueue, commandLists);
+
+        //Everything after the scene goes into a final command list
+        commandList = commandQueue.GetCommandList();
+        commandLists.push_back(commandList);
+
         commandList->SetViewport(m_viewport);
         commandList->SetScissorRect(m_scissorRect);
         commandList->SetRenderTarget(m_renderTarget);
 
-        //render the scene
-        if (m_scene) {
-            m_scene->Accept(opaquePass);
-            m_scene->Accept(transparentPass);
-        }
-       
+        SceneVisitor unlitPass(*commandList, m_camera, *m_unlitPSO, RenderPass::Opaque);
 
         MaterialProperties lightMaterial = Material::Black;
         for (const auto& l : m_pointLights) {
@@ -364,12 +399,68 @@ void Graphics::Render() {
 
     ////Render the UI
     m_editorContext->Render(m_editorLayer, *commandList);
-    //Execute the recorded commands
-    commandQueue.ExecuteCommandList(commandList);
+    //Execute the recorded commands, in the order they were added
+    commandQueue.ExecuteCommandLists(commandLists);
     //Present the final rendered image to the screen
     m_swapChain->Present();
 }
 
+void Graphics::UpdateScene() {
+    CRX_PROFILE_FUNCTION();
+    m_renderList.Clear();
+
+    if (m_isLoading || !m_scene) {
+        return;
+    }
+
+    m_scene->UpdateTransforms(JobSystem::Get());
+
+    RenderListBuilder renderListBuilder(m_renderList);
+    m_scene->Accept(renderListBuilder);
+}
+
+void Graphics::RecordScene(CommandQueue& commandQueue, std::vector<std::shared_ptr<CommandList>>& commandLists) {
+    CRX_PROFILE_FUNCTION();
+
+    //The render list was built by the UpdateScene task of the frame graph
+    if (m_renderList.Opaque.empty() && m_renderList.Transparent.empty()) {
+        return;
+    }
+
+    //Resolve the cached camera matrices before any worker reads them
+    m_lightingPSO->SetViewMatrix(m_camera.GetView());
+    m_lightingPSO->SetProjectionMatrix(m_camera.GetProj());
+    m_decalPSO->SetViewMatrix(m_camera.GetView());
+    m_decalPSO->SetProjectionMatrix(m_camera.GetProj());
+
+    auto& jobSystem      = JobSystem::Get();
+    const auto maxChunks = jobSystem.GetNumWorkers() + 1;
+
+    const auto recordPass = [&](const std::vector<RenderItem>& renderItems, const EffectPSO& pso) {
+        const auto chunks = SplitIntoChunks(renderItems.size(), m_minDrawsPerCommandList, maxChunks);
+
+        auto chunkCommandLists = RecordChunks<std::shared_ptr<CommandList>>(jobSystem, chunks,
+            [&](uint32_t) { return commandQueue.GetCommandList(); },
+            [&](CommandList& chunkCommandList, const RenderChunk& chunk) {
+                RecordRenderItems(chunkCommandList, pso, std::span(renderItems).subspan(chunk.Begin, chunk.Size()));
+            });
+
+        commandLists.insert(commandLists.end(), chunkCommandLists.begin(), chunkCommandLists.end());
+    };
+
+    //Opaque geometry has to be submitted before the transparent geometry
+    recordPass(m_renderList.Opaque, *m_lightingPSO);
+    recordPass(m_renderList.Transparent, *m_decalPSO);
+}
+
+void Graphics::RecordRenderItems(ICommandList& commandList, const EffectPSO& pso, std::span<const RenderItem> renderItems) const {
+    commandList.SetViewport(m_viewport);
+    commandList.SetScissorRect(m_scissorRect);
+    commandList.SetRenderTarget(m_renderTarget);
+
+    DrawRenderItems(commandList, pso, renderItems);
+}
+
 void Graphics::Resize(uint32_t width, uint32_t height) {
     m_clientWidth  = std::max(1u, width);
     m_clientHeight = std::max(1u, height);
@@ -396,7 +487,7 @@ void Graphics::SetVsync(VSync vSync) noexcept {
 
 void Graphics::UpdateCamera() noexcept {
     const float speedFactor = m_cameraControls.Sneak ? 4.0f : 16.0f;
-    const float dt          = static_cast<float>(m_timer.GetDeltaSeconds());
+    const float dt          = static_cast<float>(m_timer.GetFixedDeltaSeconds());
 
     Vector4 translate = Vector4(
         m_cameraControls.Right   - m_cameraControls.Left,
@@ -404,7 +495,25 @@ void Graphics::UpdateCamera() noexcept {
         m_cameraControls.Forward - m_cameraControls.Backward,
         1.0f ) * speedFactor * dt;
 
-    m_camera.Translate(translate);
+    //The camera was moved from outside the simulation, e.g. by loading a scene
+    if (m_camera.GetTranslation() != m_cameraSimulation.Rendered) {
+        m_cameraSimulation.Previous = m_camera.GetTranslation();
+        m_cameraSimulation.Current  = m_camera.GetTranslation();
+    }
+
+    while (m_timer.StepFixed()) {
+        m_cameraSimulation.Previous = m_cameraSimulation.Current;
+
+        m_camera.SetTranslation(m_cameraSimulation.Current);
+        m_camera.Translate(translate);
+
+        m_cameraSimulation.Current = m_camera.GetTranslation();
+    }
+
+    const auto alpha = static_cast<float>(m_timer.GetInterpolationAlpha());
+
+    m_cameraSimulation.Rendered = m_cameraSimulation.Previous * (1.0f - alpha) + m_cameraSimulation.Current * alpha;
+    m_camera.SetTranslation(m_cameraSimulation.Rendered);
 
     const auto& cameraRotation = Quaternion::FromPitchYawRoll(
         Math::ToRadians(m_cameraControls.Pitch),
@@ -412,19 +521,17 @@ void Graphics::UpdateCamera() noexcept {
         0.0f); 
 
     m_camera.SetRotation(cameraRotation);
+
+    //Resolve the cached view matrix here, the light tasks read it concurrently
+    m_camera.GetView();
 }
 
-void Graphics::UpdateLights() noexcept {
+void Graphics::UpdatePointLights() noexcept {
     const auto viewMatrix = m_camera.GetView();
 
     //Load the lighproperties from the editor
-    const auto& lightProperties      = m_editorContext->Get<LightProperties>();
+    const auto& pointLightProperties = m_editorContext->Get<LightProperties>().mPointLightProperties;
 
-    auto& directionalLightProperties = lightProperties.mDirectionalLightProperties;
-    auto& pointLightProperties       = lightProperties.mPointLightProperties;
-    auto& spotLightProperties        = lightProperties.mSpotLightProperties;
-
-    //Pointlight...
     auto& pointLight                = m_pointLights[0];
     pointLight.Color                = pointLightProperties.Color;
     pointLight.ConstantAttenuation  = pointLightProperties.ConstantAttenuation;
@@ -435,8 +542,13 @@ void Graphics::UpdateLights() noexcept {
 
     auto& pointLightWorldSpacePosition = pointLight.WorldSpacePosition;
     pointLight.ViewSpacePosition       = Vector4::TransformCoord(pointLightWorldSpacePosition, viewMatrix);
+}
+
+void Graphics::UpdateDirectionalLights() noexcept {
+    const auto viewMatrix = m_camera.GetView();
+
+    const auto& directionalLightProperties = m_editorContext->Get<LightProperties>().mDirectionalLightProperties;
 
-    //Directional light...
     auto& directionalLight                 = m_directionalLights[0];
     directionalLight.Ambient               = directionalLightProperties.Ambient;
     directionalLight.Color                 = directionalLightProperties.Color;
@@ -448,8 +560,13 @@ void Graphics::UpdateLights() noexcept {
 
     directionalLight.WorldSpaceDirection = directionalLightWorldSpaceDirection;
     directionalLight.ViewSpaceDirection  =  Vector4::TransformNormal(directionalLightWorldSpaceDirection, viewMatrix);
+}
+
+void Graphics::UpdateSpotLights() noexcept {
+    const auto viewMatrix = m_camera.GetView();
+
+    const auto& spotLightProperties = m_editorContext->Get<LightProperties>().mSpotLightProperties;
 
-    //Spotlight...
     auto& spotLight                 = m_spotLights[0];
     spotLight.Color                 = spotLightProperties.Color;
     spotLight.ConstantAttenuation   = spotLightProperties.ConstantAttenuation;
@@ -469,7 +586,9 @@ void Graphics::UpdateLights() noexcept {
     spotLight.WorldSpaceDirection = spotLightWorldSpaceDirection;
     spotLight.ViewSpaceDirection  = Vector4::TransformNormal(spotLightWorldSpaceDirection, viewMatrix);
     spotLight.ViewSpacePosition   = Vector4::TransformCoord(spotLightWorldSpacePosition, viewMatrix);
+}
 
+void Graphics::PackLights() noexcept {
     //Set the lights in the PSO
     m_lightingPSO->SetSpotLights(m_spotLights);
     m_lightingPSO->SetPointLights(m_pointLights);
@@ -542,6 +661,12 @@ void Graphics::OnOpenFileDialog() noexcept {
     if (m_fileDialog.Open() == DialogResult::OK) {
         const auto& filepath = m_fileDialog.GetFilePath();
 
-        m_loadingTask = std::async(std::launch::async, [this,filepath] { return LoadScene(ToNarrow(filepath)); });
+        //Loads write the scene, the camera and the copy queue, so only one runs at a time
+        if (m_loadingTask.valid() && m_loadingTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            crxlog::warn("A scene is still loading, ", ToNarrow(filepath), " was not opened");
+            return;
+        }
+
+        m_loadingTask = std::async(std::launch::async, [this, filepath] { return LoadScene(ToNarrow(filepath)); });
     }
 }
@@ -3,6 +3,8 @@
 #include "Camera.h"
 
 #include "Core/Time/GameTimer.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Jobs/TaskGraph.h"
 #include "Core/Filesystem/OpenFileDialog.h"
 #include "Core/Math/Vector4.h"
 #include "Core/Math/Quaternion.h"
@@ -11,11 +13,12 @@
 #include "API/DX12/Common.h"
 #include "API/DX12/RenderTarget.h"
 #include "Viewport.h"
+#include "RenderList.h"
 
 #include <memory>
 #include <array>
-#include <thread>
 #include <future>
+#include <thread>
 
 namespace Cyrex {
     struct VertexPosColor {
@@ -35,6 +38,7 @@ namespace Cyrex {
     class Mouse;
     class CommandQueue;
     class CommandList;
+    class ICommandList;
     class Device;
     class Mesh;
     class Scene;
@@ -87,11 +91,22 @@ namespace Cyrex {
 
         [[nodiscard]] std::tuple<uint32_t, uint32_t> GetScreenSize() const noexcept { return { m_clientWidth, m_clientHeight }; }
         [[nodiscard]] float GetFramesPerSecond() const noexcept { return m_fps; }
+        [[nodiscard]] const FrameTimeStats& GetFrameTimeStats() const noexcept { return m_frameTimeStats; }
+        [[nodiscard]] const TaskGraph& GetFrameGraph() const noexcept { return m_frameGraph; }
         [[nodiscard]] const LoadingData GetLoadingData() const noexcept { return { m_loadingProgress, m_isLoading, m_loadingText }; }
         [[nodiscard]] Device& GetDevice() const noexcept { return *m_device; }
     private:
+        void BuildFrameGraph();
+        void UpdateTimer() noexcept;
         void UpdateCamera() noexcept;
-        void UpdateLights() noexcept;
+        void UpdatePointLights() noexcept;
+        void UpdateSpotLights() noexcept;
+        void UpdateDirectionalLights() noexcept;
+        void PackLights() noexcept;
+        void UpdateScene();
+
+        void RecordScene(CommandQueue& commandQueue, std::vector<std::shared_ptr<CommandList>>& commandLists);
+        void RecordRenderItems(ICommandList& commandList, const EffectPSO& pso, std::span<const RenderItem> renderItems) const;
         static constexpr uint8_t m_bufferCount = 3;
 
         Camera m_camera;
@@ -117,6 +132,13 @@ namespace Cyrex {
         };
 
         CameraControls m_cameraControls;
+
+        //Camera positions after the last two fixed steps, rendering blends between them
+        struct CameraSimulation {
+            Cyrex::Math::Vector4 Previous;
+            Cyrex::Math::Vector4 Current;
+            Cyrex::Math::Vector4 Rendered;
+        } m_cameraSimulation;
         OpenFileDialog m_fileDialog;
 
         uint32_t m_clientWidth{};
@@ -142,10 +164,15 @@ namespace Cyrex {
 
         RenderTarget m_renderTarget;
         GameTimer m_timer;
+        TaskGraph m_frameGraph;
 
         std::shared_ptr<Scene> m_scene;
         std::shared_ptr<Scene> m_lightBulb;
 
+        RenderList m_renderList;
+        //Fewer draws than this are not worth a command list of their own
+        static constexpr uint32_t m_minDrawsPerCommandList = 64;
+
         std::shared_ptr<Scene> m_cube;
         std::shared_ptr<Scene> m_sphere;
         std::shared_ptr<Scene> m_flashLight;
@@ -157,11 +184,13 @@ namespace Cyrex {
         std::vector<DirectionalLight> m_directionalLights;
 
         std::atomic_bool  m_isLoading;
+        //Loads run on their own thread, a job would stall any frame that waits on the pool
         std::future<bool> m_loadingTask;
         float m_loadingProgress;
         std::string m_loadingText;
 
         float m_fps;
+        FrameTimeStats m_frameTimeStats;
         static constexpr auto m_testScene = "Resources/Models/crytek-sponza/sponza_nobanner.obj";
     };
 }
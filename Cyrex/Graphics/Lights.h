@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Core/Math/Math.h"
 #include "Core/Math/Vector4.h"
 
 namespace Cyrex {
@@ -29,7 +30,7 @@ namespace Cyrex {
         Cyrex::Math::Vector4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
 
         float Ambient{};
-        float SpotAngle{ DirectX::XM_PIDIV2 };
+        float SpotAngle{ Cyrex::Math::MathConstants::PI_DIV2 };
         float ConstantAttenuation{ 1.0f };
         float LinearAttenuation{ 0.0f };
         float QuadraticAttenuation{ 0.0f };
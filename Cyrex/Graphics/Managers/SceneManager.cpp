@@ -2,6 +2,7 @@
 #include "Graphics/Scene.h"
 #include "Graphics/SceneNode.h"
 #include "Graphics/Material.h"
+#include "Core/PoolAllocator.h"
 #include "Graphics/API/DX12/CommandList.h"
 #include "Graphics/API/DX12/Mesh.h"
 
@@ -44,10 +45,10 @@ std::shared_ptr<Cyrex::Scene> Cyrex::SceneManager::CreateScene(
     auto vertexBuffer = commandList.CopyVertexBuffer(vertices);
     auto indexBuffer  = commandList.CopyIndexBuffer(indices);
 
-    auto sceneNode = std::make_shared<SceneNode>();
-    auto material  = std::make_shared<Material>(Material::White);
+    auto sceneNode = MakePooled<SceneNode>();
+    auto material  = MakePooled<Material>(Material::White);
     auto scene     = std::make_shared<Scene>();
-    auto mesh      = std::make_shared<Mesh>();
+    auto mesh      = MakePooled<Mesh>();
  
     mesh->SetVertexBuffer(0, vertexBuffer);
     mesh->SetIndexBuffer(indexBuffer);
@@ -10,6 +10,8 @@
 
 #include "Core/Utils/StringUtils.h"
 #include "Core/Filesystem/FileSystem.h"
+#include "Core/Profiler.h"
+#include "Core/MemoryTracker.h"
 
 #include <wrl.h>
 #include <vector>
@@ -22,6 +24,9 @@ std::map<std::wstring, ID3D12Resource*> TextureManager::ms_textureCache;
 std::mutex TextureManager::ms_textureCacheMutex;
 
 std::shared_ptr<Texture> TextureManager::LoadTextureFromFile(CommandList& commandList, const std::string fileName, bool sRGB) {
+    CRX_PROFILE_FUNCTION();
+    CRX_MEMORY_TAG(Textures);
+
     std::shared_ptr<Texture> texture;
 
     if (!FileSystem::Exists(fileName)) {
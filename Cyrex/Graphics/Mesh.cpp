@@ -1,24 +1,23 @@
 #include "Mesh.h"
-#include "Graphics/API/DX12/CommandList.h"
-#include "Graphics/API/DX12/Device.h"
+#include "Core/Visitor.h"
+
+#ifdef _WIN32
 #include "Graphics/API/DX12/VertexBuffer.h"
 #include "Graphics/API/DX12/IndexBuffer.h"
-#include "Core/Visitor.h"
+#endif
 
-namespace dx = DirectX;
-namespace wrl = Microsoft::WRL;
 namespace crx = Cyrex;
 
 Cyrex::Mesh::Mesh()
     :
-    m_PrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST)
+    m_PrimitiveTopology(PrimitiveTopology::TriangleList)
 {}
 
-D3D12_PRIMITIVE_TOPOLOGY Cyrex::Mesh::GetPrimitiveTopology() const noexcept {
+Cyrex::PrimitiveTopology Cyrex::Mesh::GetPrimitiveTopology() const noexcept {
     return m_PrimitiveTopology;
 }
 
-void Cyrex::Mesh::SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveToplogy) noexcept {
+void Cyrex::Mesh::SetPrimitiveTopology(PrimitiveTopology primitiveToplogy) noexcept {
     m_PrimitiveTopology = primitiveToplogy;
 }
 
@@ -29,37 +28,41 @@ std::shared_ptr<Cyrex::VertexBuffer> Cyrex::Mesh::GetVertexBuffer(uint32_t slotI
     return vertexBuffer;
 }
 
+#ifdef _WIN32
 void Cyrex::Mesh::SetVertexBuffer(uint32_t slotID, const std::shared_ptr<VertexBuffer>& vertexBuffer) noexcept {
+    SetVertexBuffer(slotID, vertexBuffer, vertexBuffer ? vertexBuffer->GetNumVertices() : 0);
+}
+#endif
+
+void Cyrex::Mesh::SetVertexBuffer(uint32_t slotID, const std::shared_ptr<VertexBuffer>& vertexBuffer, size_t vertexCount) noexcept {
     m_vertexBuffers[slotID] = vertexBuffer;
+
+    if (slotID == m_vertexBuffers.cbegin()->first) {
+        m_vertexCount = vertexCount;
+    }
 }
 
 std::shared_ptr<Cyrex::IndexBuffer> Cyrex::Mesh::GetIndexBuffer() const noexcept {
     return m_indexBuffer;
 }
 
+#ifdef _WIN32
 void Cyrex::Mesh::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) noexcept {
+    SetIndexBuffer(indexBuffer, indexBuffer ? indexBuffer->GetNumIndices() : 0);
+}
+#endif
+
+void Cyrex::Mesh::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer, size_t indexCount) noexcept {
     m_indexBuffer = indexBuffer;
+    m_indexCount  = indexBuffer ? indexCount : 0;
 }
 
 size_t Cyrex::Mesh::GetIndexCount() const noexcept {
-    size_t indexCount = 0;
-
-    if (m_indexBuffer) {
-        indexCount = m_indexBuffer->GetNumIndices();
-    }
-    return indexCount;
+    return m_indexCount;
 }
 
 size_t Cyrex::Mesh::GetVertexCount() const noexcept {
-    size_t vertexCount = 0;
-
-    VertexBufferMap::const_iterator iter = m_vertexBuffers.cbegin();
-
-    if (iter != m_vertexBuffers.cend()) {
-        vertexCount = iter->second->GetNumVertices();
-    }
-
-    return vertexCount;
+    return m_vertexCount;
 }
 
 std::shared_ptr<Cyrex::Material> Cyrex::Mesh::GetMaterial() const noexcept {
@@ -70,11 +73,11 @@ void Cyrex::Mesh::SetMaterial(std::shared_ptr<Material> material) noexcept {
     m_material = material;
 }
 
-void Cyrex::Mesh::SetAABB(const DirectX::BoundingBox& aabb) noexcept {
+void Cyrex::Mesh::SetAABB(const Cyrex::Math::AABB& aabb) noexcept {
     m_AABB = aabb;
 }
 
-const DirectX::BoundingBox& Cyrex::Mesh::GetAABB() const noexcept {
+const Cyrex::Math::AABB& Cyrex::Mesh::GetAABB() const noexcept {
     return m_AABB;
 }
 
@@ -82,7 +85,7 @@ void Cyrex::Mesh::Accept(IVisitor& visitor) noexcept {
     visitor.Visit(*this);
 }
 
-void Cyrex::Mesh::Render(CommandList& commandList, uint32_t instanceCount, uint32_t firstInstance) {
+void Cyrex::Mesh::Render(ICommandList& commandList, uint32_t instanceCount, uint32_t firstInstance) {
     commandList.SetPrimitiveTopology(GetPrimitiveTopology());
 
     for (auto vertexBuffer : m_vertexBuffers) {
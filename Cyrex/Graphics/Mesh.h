@@ -1,11 +1,11 @@
 #pragma once
 #include <memory>
 #include <map>
-#include <d3d12.h>
-#include <DirectXCollision.h>
+#include "Core/Math/AABB.h"
+#include "Graphics/API/RenderBackend.h"
 
 namespace Cyrex {
-    class CommandList;
+    class ICommandList;
     class IndexBuffer;
     class VertexBuffer;
     class Material;
@@ -20,16 +20,20 @@ namespace Cyrex {
         Mesh& operator=(const Mesh& rhs) = delete;
         virtual ~Mesh() = default;
 
-        [[nodiscard]] D3D12_PRIMITIVE_TOPOLOGY GetPrimitiveTopology() const noexcept;
-        void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveToplogy) noexcept;
+        [[nodiscard]] PrimitiveTopology GetPrimitiveTopology() const noexcept;
+        void SetPrimitiveTopology(PrimitiveTopology primitiveToplogy) noexcept;
 
+        //The counts are taken from the buffers. The overloads taking a count are for buffers
+        //that don't know theirs, like the handles of the null backend.
         std::shared_ptr<VertexBuffer> GetVertexBuffer(uint32_t slotID) const noexcept;
         void SetVertexBuffer(uint32_t slotID, const std::shared_ptr<VertexBuffer>& vertexBuffer) noexcept;
+        void SetVertexBuffer(uint32_t slotID, const std::shared_ptr<VertexBuffer>& vertexBuffer, size_t vertexCount) noexcept;
         
         [[nodiscard]] const VertexBufferMap& GetVertexBuffers() const noexcept { return m_vertexBuffers; }
 
         [[nodiscard]] std::shared_ptr<IndexBuffer> GetIndexBuffer() const noexcept;
         void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) noexcept;
+        void SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer, size_t indexCount) noexcept;
 
         [[nodiscard]] size_t GetIndexCount() const noexcept;
         [[nodiscard]] size_t GetVertexCount() const noexcept;
@@ -37,19 +41,23 @@ namespace Cyrex {
         [[nodiscard]] std::shared_ptr<Material> GetMaterial() const noexcept;
         void SetMaterial(std::shared_ptr<Material> material) noexcept;
        
-        [[nodiscard]] const DirectX::BoundingBox& GetAABB() const noexcept;
+        [[nodiscard]] const Cyrex::Math::AABB& GetAABB() const noexcept;
 
-        void SetAABB(const DirectX::BoundingBox& aabb) noexcept;
+        void SetAABB(const Cyrex::Math::AABB& aabb) noexcept;
        
         void Accept(IVisitor& visitor) noexcept;
-        void Render(CommandList& commandList, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+        void Render(ICommandList& commandList, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
     private:
         VertexBufferMap m_vertexBuffers;
         std::shared_ptr<IndexBuffer> m_indexBuffer;
 
+        //Of the index buffer and of the vertex buffer in the lowest slot
+        size_t m_indexCount{ 0 };
+        size_t m_vertexCount{ 0 };
+
         std::shared_ptr<Material> m_material;
-        D3D12_PRIMITIVE_TOPOLOGY m_PrimitiveTopology;
+        PrimitiveTopology m_PrimitiveTopology;
 
-        DirectX::BoundingBox m_AABB;
+        Cyrex::Math::AABB m_AABB;
     };
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "RenderList.h"
+#include "SceneNode.h"
+#include "EffectPSO.h"
+#include "Material.h"
+#include "Mesh.h"
+
+#include <algorithm>
+
+using namespace Cyrex;
+
+RenderListBuilder::RenderListBuilder(RenderList& renderList) noexcept
+    :
+    m_renderList(renderList)
+{}
+
+void RenderListBuilder::Visit(Scene&) {}
+
+void RenderListBuilder::Visit(SceneNode& sceneNode) {
+    m_worldMatrix = sceneNode.GetWorldTransform();
+}
+
+void RenderListBuilder::Visit(Mesh& mesh) {
+    const auto material = mesh.GetMaterial();
+
+    if (material && material->IsTransparent()) {
+        m_renderList.Transparent.push_back({ m_worldMatrix, &mesh });
+    }
+    else {
+        m_renderList.Opaque.push_back({ m_worldMatrix, &mesh });
+    }
+}
+
+std::vector<RenderChunk> Cyrex::SplitIntoChunks(size_t numItems, uint32_t minItemsPerChunk, uint32_t maxChunks) {
+    std::vector<RenderChunk> chunks;
+
+    if (numItems == 0) {
+        return chunks;
+    }
+
+    minItemsPerChunk = std::max(1u, minItemsPerChunk);
+
+    const auto count     = static_cast<uint32_t>(numItems);
+    const auto numChunks = std::clamp((count + minItemsPerChunk - 1) / minItemsPerChunk, 1u, std::max(1u, maxChunks));
+
+    //Spread the remainder over the first chunks so no chunk is more than one item larger
+    const auto itemsPerChunk = count / numChunks;
+    const auto remainder     = count % numChunks;
+
+    chunks.reserve(numChunks);
+
+    uint32_t begin = 0;
+    for (uint32_t i = 0; i < numChunks; ++i) {
+        const auto size = itemsPerChunk + (i < remainder ? 1 : 0);
+
+        chunks.push_back({ begin, begin + size });
+        begin += size;
+    }
+
+    return chunks;
+}
+
+void Cyrex::DrawRenderItems(ICommandList& commandList, const EffectPSO& pso, std::span<const RenderItem> renderItems) {
+    EffectPSO chunkPSO = pso;
+
+    for (const auto& renderItem : renderItems) {
+        chunkPSO.SetWorldMatrix(renderItem.WorldMatrix);
+        chunkPSO.SetMaterial(renderItem.Geometry->GetMaterial());
+
+        chunkPSO.Apply(commandList);
+        renderItem.Geometry->Render(commandList);
+    }
+}
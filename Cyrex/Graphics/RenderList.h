@@ -0,0 +1,74 @@
+#pragma once
+#include "Core/Visitor.h"
+#include "Core/Math/Matrix.h"
+#include "Core/Jobs/JobSystem.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Cyrex {
+    class EffectPSO;
+    class ICommandList;
+    class Mesh;
+
+    struct RenderItem {
+        Cyrex::Math::Matrix WorldMatrix;
+        Mesh* Geometry;
+    };
+
+    struct RenderList {
+        std::vector<RenderItem> Opaque;
+        std::vector<RenderItem> Transparent;
+
+        //Keeps the capacity around for the next frame
+        void Clear() noexcept {
+            Opaque.clear();
+            Transparent.clear();
+        }
+    };
+
+    //Flattens a scene into draw items. A single traversal fills both passes.
+    class RenderListBuilder : public IVisitor {
+    public:
+        explicit RenderListBuilder(RenderList& renderList) noexcept;
+
+        void Visit(Scene& scene) override;
+        void Visit(SceneNode& sceneNode) override;
+        void Visit(Mesh& mesh) override;
+    private:
+        RenderList& m_renderList;
+        Cyrex::Math::Matrix m_worldMatrix;
+    };
+
+    struct RenderChunk {
+        uint32_t Begin;
+        uint32_t End;
+
+        [[nodiscard]] uint32_t Size() const noexcept { return End - Begin; }
+    };
+
+    //Splits numItems into at most maxChunks contiguous chunks holding at least
+    //minItemsPerChunk items each (except when there are fewer items than that).
+    [[nodiscard]] std::vector<RenderChunk> SplitIntoChunks(size_t numItems, uint32_t minItemsPerChunk, uint32_t maxChunks);
+
+    //Applies pso and renders every item. The items are drawn with a copy of pso that tracks
+    //its own dirty state, so several lists can be recorded from the same pso at once.
+    void DrawRenderItems(ICommandList& commandList, const EffectPSO& pso, std::span<const RenderItem> renderItems);
+
+    //Records every chunk on the job system. acquire(chunkIndex) returns the command list
+    //a chunk is recorded into and record(commandList, chunk) fills it. The lists are
+    //returned in chunk order no matter which thread recorded them, so submitting them
+    //in that order is deterministic.
+    template<typename CommandListPtr, typename Acquire, typename Record>
+    [[nodiscard]] std::vector<CommandListPtr> RecordChunks(JobSystem& jobSystem, std::span<const RenderChunk> chunks, Acquire&& acquire, Record&& record) {
+        std::vector<CommandListPtr> commandLists(chunks.size());
+
+        jobSystem.ParallelFor(static_cast<uint32_t>(chunks.size()), 1, [&](uint32_t i) {
+            commandLists[i] = acquire(i);
+            record(*commandLists[i], chunks[i]);
+        });
+
+        return commandLists;
+    }
+}
@@ -6,8 +6,13 @@
 #include "Graphics/API/DX12/Texture.h"
 #include "Material.h"
 #include "SceneNode.h"
+#include "TransformHierarchy.h"
 #include "API/DX12/VertexTypes.h"
 #include "Core/Visitor.h"
+#include "Core/FrameArena.h"
+#include "Core/Profiler.h"
+#include "Core/MemoryTracker.h"
+#include "Core/PoolAllocator.h"
 #include "Managers/TextureManager.h"
 
 #include "Core/Filesystem/FileSystem.h"
@@ -50,20 +55,15 @@ private:
     std::function<bool(float)> m_progressCB;
 };
 
-//Helper function to create an DirectX::BoundingBox from an aiAABB.
-inline DirectX::BoundingBox CreateBoundingBox(const aiAABB& aabb) {
-    auto min = dx::XMVectorSet(aabb.mMin.x, aabb.mMin.y, aabb.mMin.z, 1.0f);
-    auto max = dx::XMVectorSet(aabb.mMax.x, aabb.mMax.y, aabb.mMax.z, 1.0f);
-
-    DirectX::BoundingBox bb;
-
-    DirectX::BoundingBox::CreateFromPoints(bb, min, max);
-
-    return bb;
+//Helper function to create an AABB from an aiAABB.
+inline Cyrex::Math::AABB CreateBoundingBox(const aiAABB& aabb) {
+    return Cyrex::Math::AABB::FromMinMax(
+        { aabb.mMin.x, aabb.mMin.y, aabb.mMin.z },
+        { aabb.mMax.x, aabb.mMax.y, aabb.mMax.z });
 }
 
-DirectX::BoundingBox Cyrex::Scene::GetAABB() const noexcept {
-    DirectX::BoundingBox aabb{ { 0, 0, 0 }, { 0, 0, 0 } };
+Cyrex::Math::AABB Cyrex::Scene::GetAABB() const noexcept {
+    Cyrex::Math::AABB aabb{ { 0, 0, 0 }, { 0, 0, 0 } };
 
     if (m_rootNode) {
         aabb = m_rootNode->GetAABB();
@@ -79,7 +79,15 @@ void Cyrex::Scene::Accept(IVisitor& visitor) {
     }
 }
 
+void Cyrex::Scene::UpdateTransforms(JobSystem& jobSystem) {
+    if (m_transforms) {
+        m_transforms->Update(jobSystem);
+    }
+}
+
 bool Cyrex::Scene::LoadSceneFromFile(CommandList& commandList, const std::string& fileName, const std::function<bool(float)>& loadingProgress) {
+    CRX_PROFILE_FUNCTION();
+
     auto exportPath = FileSystem::ReplaceExtension(fileName, "assbin");
 
     std::string parentPath;
@@ -168,6 +176,12 @@ void Cyrex::Scene::ImportScene(CommandList& commandList, const aiScene& scene, c
 
     //Import the root node
     m_rootNode = ImportSceneNode(nullptr, scene.mRootNode);
+
+    //The nodes were imported depth first, so binding them only appends to the arrays
+    if (m_rootNode) {
+        m_transforms = std::make_shared<TransformHierarchy>();
+        m_rootNode->BindTransforms(m_transforms);
+    }
 }
 
 void Cyrex::Scene::ImportMaterial(CommandList& commandList, const aiMaterial& material, const std::string& parentPath) {
@@ -188,7 +202,7 @@ void Cyrex::Scene::ImportMaterial(CommandList& commandList, const aiMaterial& ma
     float shininess;
     float bumpIntensity;
 
-    auto pMaterial = std::make_shared<Material>();
+    auto pMaterial = MakePooled<Material>();
 
     if (material.Get(AI_MATKEY_COLOR_AMBIENT, ambientColor) == aiReturn_SUCCESS) {
         pMaterial->SetAmbientColor({ ambientColor.r, ambientColor.g, ambientColor.b, ambientColor.a });
@@ -324,9 +338,12 @@ void Cyrex::Scene::ImportMaterial(CommandList& commandList, const aiMaterial& ma
 }
 
 void Cyrex::Scene::ImportMesh(CommandList& commandList, const aiMesh& aiMesh) {
-    auto mesh = std::make_shared<Mesh>();
+    auto mesh = MakePooled<Mesh>();
+
+    //Loading spans frames, so the staging data lives in a scope of its own
+    FrameArena::Scope scope(FrameArena::Get());
 
-    std::vector<cx::VertexPositionNormalTangentBitangentTexture> vertexData(aiMesh.mNumVertices);
+    FrameVector<cx::VertexPositionNormalTangentBitangentTexture> vertexData(aiMesh.mNumVertices);
 
     assert(aiMesh.mMaterialIndex < m_materials.size());
     mesh->SetMaterial(m_materials.at(aiMesh.mMaterialIndex));
@@ -363,7 +380,8 @@ void Cyrex::Scene::ImportMesh(CommandList& commandList, const aiMesh& aiMesh) {
 
     //process indices
     if (aiMesh.HasFaces()) {
-        std::vector<uint32_t> indices;
+        FrameVector<uint32_t> indices;
+        indices.reserve(static_cast<size_t>(aiMesh.mNumFaces) * 3);
 
         for (index = 0; index < aiMesh.mNumFaces; index++) {
             const aiFace& face = aiMesh.mFaces[index];
@@ -392,7 +410,10 @@ std::shared_ptr<Cyrex::SceneNode> Cyrex::Scene::ImportSceneNode(std::shared_ptr<
         return nullptr;
     }
 
-    auto node = std::make_shared<SceneNode>(*reinterpret_cast<const Matrix*>(&aiNode->mTransformation));
+    CRX_MEMORY_TAG(SceneGraph);
+
+    //assimp's matrices transform column vectors, ours row vectors
+    auto node = MakePooled<SceneNode>(Matrix::Transpose(*reinterpret_cast<const Matrix*>(&aiNode->mTransformation)));
     node->SetParent(parent);
 
     if (aiNode->mName.length > 0) {
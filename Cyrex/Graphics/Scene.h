@@ -1,6 +1,6 @@
 #pragma once
 
-#include <DirectXCollision.h>
+#include "Core/Math/AABB.h"
 #include <functional>
 #include <memory>
 #include <map>
@@ -18,6 +18,8 @@ namespace Cyrex {
     class Mesh;
     class Material;
     class IVisitor;
+    class JobSystem;
+    class TransformHierarchy;
 
     class Scene {
     public:
@@ -27,9 +29,13 @@ namespace Cyrex {
         std::shared_ptr<SceneNode> GetRootNode() const noexcept { return m_rootNode; }
         void SetRootNode(std::shared_ptr<SceneNode> node) noexcept { m_rootNode = node; }
 
-        DirectX::BoundingBox GetAABB() const noexcept;
+        Cyrex::Math::AABB GetAABB() const noexcept;
         virtual void Accept(IVisitor& visitor);
 
+        //Brings the world transforms of the imported nodes up to date, once per frame before
+        //the scene is visited
+        void UpdateTransforms(JobSystem& jobSystem);
+
         bool LoadSceneFromFile(CommandList& commandList, const std::string& fileName, const std::function<bool(float)>& loadingProgress);
         bool LoadSceneFromString(CommandList& commandList, const std::string& sceneString, const std::string format);
     private:
@@ -47,6 +53,7 @@ namespace Cyrex {
         MeshList     m_meshes;
 
         std::shared_ptr<SceneNode> m_rootNode;
+        std::shared_ptr<TransformHierarchy> m_transforms;
 
         std::wstring m_sceneFile;
     };
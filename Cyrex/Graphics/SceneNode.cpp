@@ -2,15 +2,24 @@
 #include "Mesh.h"
 #include "Core/Visitor.h"
 
+#include <cassert>
+
 using namespace Cyrex;
 using namespace Cyrex::Math;
 
 SceneNode::SceneNode(const Matrix& localTransform) {
-    m_alignedData = new AlignedData();
+    SetLocalTransform(localTransform);
 }
 
+//Takes the descendants' transforms along, they compute their own once unbound
 SceneNode::~SceneNode() {
-    delete m_alignedData;
+    if (m_transforms) {
+        m_transforms->Destroy(m_transformHandle);
+
+        for (auto& child : m_children) {
+            child->UnbindSubtree();
+        }
+    }
 }
 
 const std::string& SceneNode::GetName() const noexcept {
@@ -22,23 +31,81 @@ void SceneNode::SetName(const std::string name) noexcept {
 }
 
 Matrix SceneNode::GetLocalTransform() const noexcept {
-    return m_alignedData->LocalTransform;
+    return m_alignedData.LocalTransform.ToMatrix();
+}
+
+const Affine3x4& SceneNode::GetLocalAffine() const noexcept {
+    return m_alignedData.LocalTransform;
 }
 
 void SceneNode::SetLocalTransform(const Matrix& localTransform) {
-    m_alignedData->LocalTransform = localTransform;
+    SetLocalTransform(Affine3x4(localTransform));
+}
+
+void SceneNode::SetLocalTransform(const Affine3x4& localTransform) {
+    m_alignedData.LocalTransform   = localTransform;
+    m_alignedData.InverseTransform = Affine3x4::Inverse(localTransform);
+
+    if (m_transforms) {
+        m_transforms->SetLocalTransform(m_transformHandle, localTransform);
+    }
+
+    InvalidateWorldTransform();
 }
 
 Matrix SceneNode::GetInverseLocalTransform() const noexcept {
-    return m_alignedData->InverseTransform;
+    return m_alignedData.InverseTransform.ToMatrix();
 }
 
 Matrix SceneNode::GetWorldTransform() const noexcept {
-    return m_alignedData->LocalTransform * GetParentWorldTransform();
+    return GetWorldAffine().ToMatrix();
+}
+
+const Affine3x4& SceneNode::GetWorldAffine() const noexcept {
+    if (m_transforms) {
+        return m_transforms->GetWorldTransform(m_transformHandle);
+    }
+
+    if (m_isWorldDirty) {
+        m_cachedData.WorldTransform = m_alignedData.LocalTransform * GetParentWorldAffine();
+        m_isWorldDirty = false;
+    }
+    return m_cachedData.WorldTransform;
 }
 
+//A bound node is not told when the hierarchy moves it, its world version tells instead
 Matrix SceneNode::GetInverseWorldTransform() const noexcept {
-    return Matrix::Inverse(GetWorldTransform());
+    if (m_transforms) {
+        const auto version = m_transforms->GetWorldVersion(m_transformHandle);
+
+        if (m_isInverseWorldDirty || version != m_inverseWorldVersion) {
+            m_cachedData.InverseWorldTransform = Affine3x4::Inverse(GetWorldAffine());
+            m_inverseWorldVersion = version;
+            m_isInverseWorldDirty = false;
+        }
+        return m_cachedData.InverseWorldTransform.ToMatrix();
+    }
+
+    if (m_isInverseWorldDirty) {
+        m_cachedData.InverseWorldTransform = Affine3x4::Inverse(GetWorldAffine());
+        m_isInverseWorldDirty = false;
+    }
+    return m_cachedData.InverseWorldTransform.ToMatrix();
+}
+
+uint64_t SceneNode::GetWorldVersion() const noexcept {
+    return m_transforms ? m_transforms->GetWorldVersion(m_transformHandle) : m_worldVersion;
+}
+
+void SceneNode::BindTransforms(std::shared_ptr<TransformHierarchy> hierarchy) {
+    assert(hierarchy && !m_transforms);
+
+    BindSubtree(hierarchy);
+    hierarchy->Update();
+}
+
+TransformHierarchy::Handle SceneNode::GetTransformHandle() const noexcept {
+    return m_transformHandle;
 }
 
 void SceneNode::AddChild(std::shared_ptr<SceneNode> childNode) {
@@ -47,13 +114,23 @@ void SceneNode::AddChild(std::shared_ptr<SceneNode> childNode) {
 
         if (nodeListIter == m_children.cend()) {
             childNode->m_parentNode = shared_from_this();
+            childNode->InvalidateWorldTransform();
 
-            auto worldTransform = childNode->GetWorldTransform();
-            auto localTransform = worldTransform * GetInverseWorldTransform();
+            auto worldTransform = childNode->GetLocalAffine() * GetWorldAffine();
+            auto localTransform = worldTransform * Affine3x4::Inverse(GetWorldAffine());
             childNode->SetLocalTransform(localTransform);
 
             m_children.push_back(childNode);
 
+            if (m_transforms) {
+                if (childNode->m_transforms == m_transforms) {
+                    m_transforms->SetParent(childNode->m_transformHandle, m_transformHandle);
+                }
+                else {
+                    childNode->BindSubtree(m_transforms);
+                }
+            }
+
             if (!childNode->GetName().empty()) {
                 m_childrenByName.emplace(childNode->GetName(), childNode);
             }
@@ -90,9 +167,14 @@ void SceneNode::SetParent(std::shared_ptr<SceneNode> parentNode) {
         parentNode->AddChild(me);
     }
     else if (auto parent = m_parentNode.lock()) {
-        auto worldTransform = GetWorldTransform();
+        auto worldTransform = GetWorldAffine();
         parent->RemoveChild(me);
         m_parentNode.reset();
+
+        if (m_transforms) {
+            m_transforms->SetParent(m_transformHandle, TransformHierarchy::InvalidHandle);
+        }
+
         SetLocalTransform(worldTransform);
     }
 }
@@ -108,7 +190,7 @@ size_t SceneNode::AddMesh(std::shared_ptr<Mesh> mesh) {
 
             m_meshes.push_back(mesh);
 
-            dx::BoundingBox::CreateMerged(m_AABB, m_AABB, mesh->GetAABB());
+            m_AABB = AABB::Merge(m_AABB, mesh->GetAABB());
         }
         else {
             index = iter - m_meshes.begin();
@@ -135,7 +217,7 @@ std::shared_ptr<Mesh> SceneNode::GetMesh(size_t index) noexcept {
     return mesh;
 }
 
-const DirectX::BoundingBox& SceneNode::GetAABB() const noexcept {
+const AABB& SceneNode::GetAABB() const noexcept {
     return m_AABB;
 }
 
@@ -153,11 +235,61 @@ void SceneNode::Accept(IVisitor& visitor) {
     }
 }
 
-Matrix SceneNode::GetParentWorldTransform() const noexcept {
-    auto parentTransform = Matrix();
+//Stops at dirty nodes, their descendants are dirty too as reading a world transform cleans
+//the ancestors first. Their version has not been seen with the current transform either.
+void SceneNode::InvalidateWorldTransform() noexcept {
+    if (m_isWorldDirty) {
+        return;
+    }
+
+    m_isWorldDirty        = true;
+    m_isInverseWorldDirty = true;
+    ++m_worldVersion;
+
+    for (auto& child : m_children) {
+        child->InvalidateWorldTransform();
+    }
+}
+
+//Parents first, so the children find their parent's handle
+void SceneNode::BindSubtree(const std::shared_ptr<TransformHierarchy>& hierarchy) {
+    assert(!m_transforms);
+
+    auto parentHandle = TransformHierarchy::InvalidHandle;
+
+    if (auto parentNode = m_parentNode.lock(); parentNode && parentNode->m_transforms == hierarchy) {
+        parentHandle = parentNode->m_transformHandle;
+    }
+
+    m_transforms      = hierarchy;
+    m_transformHandle = hierarchy->Create(m_alignedData.LocalTransform, parentHandle);
+
+    //Versions start over in the hierarchy
+    m_isInverseWorldDirty = true;
+
+    for (auto& child : m_children) {
+        child->BindSubtree(hierarchy);
+    }
+}
+
+void SceneNode::UnbindSubtree() noexcept {
+    m_transforms.reset();
+    m_transformHandle = TransformHierarchy::InvalidHandle;
+
+    m_isWorldDirty        = true;
+    m_isInverseWorldDirty = true;
+    ++m_worldVersion;
+
+    for (auto& child : m_children) {
+        child->UnbindSubtree();
+    }
+}
+
+Affine3x4 SceneNode::GetParentWorldAffine() const noexcept {
+    auto parentTransform = Affine3x4();
 
     if (auto parentNode = m_parentNode.lock()) {
-        parentTransform = parentNode->GetWorldTransform();
+        parentTransform = parentNode->GetWorldAffine();
     }
     return parentTransform;
 }
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
-#include <DirectXCollision.h>
 
+#include "Core/Math/AABB.h"
+#include "Core/Math/Affine3x4.h"
 #include "Core/Math/Matrix.h"
+#include "TransformHierarchy.h"
 
 namespace Cyrex {
     class Mesh;
@@ -21,14 +24,30 @@ namespace Cyrex {
         const std::string& GetName() const noexcept;
         void SetName(const std::string name) noexcept;
 
+        //The transforms are stored and composed as Affine3x4, the Matrix versions are for the GPU upload
         Cyrex::Math::Matrix GetLocalTransform() const noexcept;
+        const Cyrex::Math::Affine3x4& GetLocalAffine() const noexcept;
         void SetLocalTransform(const Cyrex::Math::Matrix& localTransform);
+        void SetLocalTransform(const Cyrex::Math::Affine3x4& localTransform);
 
         Cyrex::Math::Matrix GetInverseLocalTransform() const noexcept;
 
+        //Cached, a local transform or parent change marks the node and its descendants dirty
+        //and the next read recomputes them. Not safe to read from several threads at once.
         Cyrex::Math::Matrix GetWorldTransform() const noexcept;
+        const Cyrex::Math::Affine3x4& GetWorldAffine() const noexcept;
         Cyrex::Math::Matrix GetInverseWorldTransform() const noexcept;
 
+        //Changes whenever the world transform does, so per node constants can skip the upload
+        //while it matches the version they were last written with
+        uint64_t GetWorldVersion() const noexcept;
+
+        //Moves the transforms of the node and its descendants into the hierarchy, children added
+        //later join it too. A bound node reads the world transforms of the hierarchy's last Update
+        //instead of computing its own, BindTransforms runs one.
+        void BindTransforms(std::shared_ptr<TransformHierarchy> hierarchy);
+        TransformHierarchy::Handle GetTransformHandle() const noexcept;
+
         void AddChild(std::shared_ptr<SceneNode> childNode);
         void RemoveChild(std::shared_ptr<SceneNode> childNode);
         void SetParent(std::shared_ptr<SceneNode> parentNode);
@@ -38,12 +57,16 @@ namespace Cyrex {
 
         std::shared_ptr<Mesh> GetMesh(size_t index = 0) noexcept;
 
-        const DirectX::BoundingBox& GetAABB() const noexcept;
+        const Cyrex::Math::AABB& GetAABB() const noexcept;
 
         void Accept(IVisitor& visitor);
     protected:
-        Cyrex::Math::Matrix GetParentWorldTransform() const noexcept;
+        Cyrex::Math::Affine3x4 GetParentWorldAffine() const noexcept;
     private:
+        void InvalidateWorldTransform() noexcept;
+        void BindSubtree(const std::shared_ptr<TransformHierarchy>& hierarchy);
+        void UnbindSubtree() noexcept;
+
         using NodePtr     = std::shared_ptr<SceneNode>;
         using NodeList    = std::vector<NodePtr>;
         using NodeNameMap = std::multimap<std::string, NodePtr>;
@@ -51,11 +74,28 @@ namespace Cyrex {
 
         std::string m_name{ "SceneNode" };
 
-        struct AlignedData
+        //Kept inline so a node and its transforms share the same pool slot
+        struct alignas(16) AlignedData
         {
-            Cyrex::Math::Matrix LocalTransform;
-            Cyrex::Math::Matrix InverseTransform;
-        }* m_alignedData;
+            Cyrex::Math::Affine3x4 LocalTransform;
+            Cyrex::Math::Affine3x4 InverseTransform;
+        } m_alignedData{};
+
+        struct alignas(16) CachedData
+        {
+            Cyrex::Math::Affine3x4 WorldTransform;
+            Cyrex::Math::Affine3x4 InverseWorldTransform;
+        };
+
+        mutable CachedData m_cachedData{};
+        mutable bool m_isWorldDirty{ true };
+        mutable bool m_isInverseWorldDirty{ true };
+        uint64_t m_worldVersion{ 1 };
+        //The hierarchy's world version the cached inverse of a bound node was computed from
+        mutable uint64_t m_inverseWorldVersion{ 0 };
+
+        std::shared_ptr<TransformHierarchy> m_transforms;
+        TransformHierarchy::Handle m_transformHandle{ TransformHierarchy::InvalidHandle };
 
         std::weak_ptr<SceneNode> m_parentNode;
 
@@ -63,6 +103,6 @@ namespace Cyrex {
         NodeNameMap m_childrenByName;
         MeshList m_meshes;
 
-        DirectX::BoundingBox m_AABB{ { 0, 0, 0 }, {0, 0, 0} };
+        Cyrex::Math::AABB m_AABB{ { 0, 0, 0 }, {0, 0, 0} };
     };
 }
\ No newline at end of file
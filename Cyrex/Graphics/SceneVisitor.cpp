@@ -5,12 +5,12 @@
 #include "EffectPSO.h"
 #include "Material.h"
 
-#include "API/DX12/CommandList.h"
+#include "API/RenderBackend.h"
 #include "Mesh.h"
 
 using namespace Cyrex;
 
-SceneVisitor::SceneVisitor(CommandList& commandList, const Camera& camera, EffectPSO& pso, RenderPass transparentPass)
+SceneVisitor::SceneVisitor(ICommandList& commandList, const Camera& camera, EffectPSO& pso, RenderPass transparentPass)
     :
     m_commandList(commandList),
     m_camera(camera),
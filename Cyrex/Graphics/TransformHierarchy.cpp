@@ -0,0 +1,282 @@
+#include "TransformHierarchy.h"
+#include "Core/Jobs/JobSystem.h"
+
+#include <cassert>
+
+using namespace Cyrex;
+using namespace Cyrex::Math;
+
+namespace {
+    template<typename T>
+    void Permute(std::vector<T>& values, std::span<const uint32_t> order) {
+        std::vector<T> permuted;
+        permuted.reserve(order.size());
+
+        for (auto index : order) {
+            permuted.push_back(values[index]);
+        }
+        values = std::move(permuted);
+    }
+}
+
+TransformHierarchy::Handle TransformHierarchy::Create(const Affine3x4& localTransform, Handle parent) {
+    assert(parent == InvalidHandle || (parent < m_indices.size() && m_indices[parent] != NoParent));
+
+    Handle handle;
+
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else {
+        handle = static_cast<Handle>(m_indices.size());
+        m_indices.push_back(NoParent);
+    }
+
+    const auto index       = static_cast<uint32_t>(m_parents.size());
+    const auto parentIndex = parent == InvalidHandle ? NoParent : m_indices[parent];
+
+    m_localTransforms.push_back(localTransform);
+    m_worldTransforms.push_back(localTransform);
+    m_parents.push_back(parentIndex);
+    m_subtreeSizes.push_back(1);
+    m_worldVersions.push_back(0);
+    m_flags.push_back(LocalChanged);
+    m_handles.push_back(handle);
+    m_indices[handle] = index;
+
+    if (parentIndex != NoParent) {
+        const auto subtreeEnd = parentIndex + m_subtreeSizes[parentIndex];
+        AddToSubtreeSizes(parentIndex, 1);
+
+        //Move the node to the end of its parent's subtree
+        if (subtreeEnd != index) {
+            std::vector<uint32_t> order;
+            order.reserve(index + 1);
+
+            for (uint32_t i = 0; i < subtreeEnd; ++i) {
+                order.push_back(i);
+            }
+
+            order.push_back(index);
+
+            for (auto i = subtreeEnd; i < index; ++i) {
+                order.push_back(i);
+            }
+
+            Reorder(order);
+        }
+    }
+
+    m_isPartitionDirty = true;
+    return handle;
+}
+
+void TransformHierarchy::Destroy(Handle node) {
+    assert(node < m_indices.size() && m_indices[node] != NoParent);
+
+    const auto begin = m_indices[node];
+    const auto end   = begin + m_subtreeSizes[begin];
+    const auto count = static_cast<uint32_t>(m_parents.size());
+
+    if (m_parents[begin] != NoParent) {
+        AddToSubtreeSizes(m_parents[begin], -static_cast<int32_t>(end - begin));
+    }
+
+    for (auto i = begin; i < end; ++i) {
+        m_indices[m_handles[i]] = NoParent;
+        m_freeHandles.push_back(m_handles[i]);
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(count - (end - begin));
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (i < begin || i >= end) {
+            order.push_back(i);
+        }
+    }
+
+    Reorder(order);
+    m_isPartitionDirty = true;
+}
+
+void TransformHierarchy::SetParent(Handle node, Handle parent) {
+    assert(node < m_indices.size() && m_indices[node] != NoParent);
+    assert(parent == InvalidHandle || (parent < m_indices.size() && m_indices[parent] != NoParent));
+
+    const auto begin       = m_indices[node];
+    const auto size        = m_subtreeSizes[begin];
+    const auto end         = begin + size;
+    const auto count       = static_cast<uint32_t>(m_parents.size());
+    const auto parentIndex = parent == InvalidHandle ? NoParent : m_indices[parent];
+
+    //A node can't become its own descendant
+    if (parentIndex != NoParent && parentIndex >= begin && parentIndex < end) {
+        assert(false && "The parent is a descendant of the node");
+        return;
+    }
+
+    //The subtree moves in front of whatever follows the new parent's subtree
+    const auto insertBefore = parentIndex == NoParent ? count : parentIndex + m_subtreeSizes[parentIndex];
+
+    if (m_parents[begin] != NoParent) {
+        AddToSubtreeSizes(m_parents[begin], -static_cast<int32_t>(size));
+    }
+    if (parentIndex != NoParent) {
+        AddToSubtreeSizes(parentIndex, static_cast<int32_t>(size));
+    }
+
+    m_parents[begin] = parentIndex;
+    m_flags[begin]  |= LocalChanged;
+
+    std::vector<uint32_t> order;
+    order.reserve(count);
+
+    for (uint32_t i = 0; i <= count; ++i) {
+        if (i == insertBefore) {
+            for (auto j = begin; j < end; ++j) {
+                order.push_back(j);
+            }
+        }
+        if (i < count && (i < begin || i >= end)) {
+            order.push_back(i);
+        }
+    }
+
+    Reorder(order);
+    m_isPartitionDirty = true;
+}
+
+void TransformHierarchy::SetLocalTransform(Handle node, const Affine3x4& localTransform) noexcept {
+    const auto index = m_indices[node];
+
+    m_localTransforms[index] = localTransform;
+    m_flags[index] |= LocalChanged;
+}
+
+const Affine3x4& TransformHierarchy::GetLocalTransform(Handle node) const noexcept {
+    return m_localTransforms[m_indices[node]];
+}
+
+TransformHierarchy::Handle TransformHierarchy::GetParent(Handle node) const noexcept {
+    const auto parentIndex = m_parents[m_indices[node]];
+    return parentIndex == NoParent ? InvalidHandle : m_handles[parentIndex];
+}
+
+const Affine3x4& TransformHierarchy::GetWorldTransform(Handle node) const noexcept {
+    return m_worldTransforms[m_indices[node]];
+}
+
+uint64_t TransformHierarchy::GetWorldVersion(Handle node) const noexcept {
+    return m_worldVersions[m_indices[node]];
+}
+
+void TransformHierarchy::Update() noexcept {
+    UpdateRange(0, static_cast<uint32_t>(m_parents.size()));
+}
+
+void TransformHierarchy::Update(JobSystem& jobSystem) {
+    if (m_parents.size() <= ParallelGrain) {
+        Update();
+        return;
+    }
+
+    if (m_isPartitionDirty) {
+        Partition();
+    }
+
+    for (auto index : m_sequentialNodes) {
+        UpdateRange(index, index + 1);
+    }
+
+    jobSystem.ParallelFor(static_cast<uint32_t>(m_parallelRanges.size()), 1, [this](uint32_t i) {
+        UpdateRange(m_parallelRanges[i].Begin, m_parallelRanges[i].End);
+    });
+}
+
+//A node changes when its local transform or its parent's world transform did. The parent's
+//flags were already rewritten by this update, its index is lower.
+void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end) noexcept {
+    for (auto i = begin; i < end; ++i) {
+        const auto parent    = m_parents[i];
+        const bool isChanged = (m_flags[i] & LocalChanged) || (parent != NoParent && (m_flags[parent] & WorldChanged));
+
+        if (isChanged) {
+            m_worldTransforms[i] = parent == NoParent ? m_localTransforms[i] : m_localTransforms[i] * m_worldTransforms[parent];
+            ++m_worldVersions[i];
+        }
+
+        m_flags[i] = isChanged ? WorldChanged : 0;
+    }
+}
+
+//Whole subtrees are gathered into ranges of about ParallelGrain nodes. A subtree larger than
+//that is entered instead: its root goes to the sequential nodes and its children's subtrees
+//follow it, so every range only depends on sequential nodes and itself.
+void TransformHierarchy::Partition() {
+    m_sequentialNodes.clear();
+    m_parallelRanges.clear();
+
+    const auto count = static_cast<uint32_t>(m_parents.size());
+    uint32_t rangeBegin = 0;
+
+    for (uint32_t i = 0; i < count;) {
+        const auto size = m_subtreeSizes[i];
+
+        if (size > ParallelGrain) {
+            if (rangeBegin < i) {
+                m_parallelRanges.push_back({ rangeBegin, i });
+            }
+
+            m_sequentialNodes.push_back(i);
+            rangeBegin = ++i;
+        }
+        else {
+            if (rangeBegin < i && i + size - rangeBegin > ParallelGrain) {
+                m_parallelRanges.push_back({ rangeBegin, i });
+                rangeBegin = i;
+            }
+
+            i += size;
+        }
+    }
+
+    if (rangeBegin < count) {
+        m_parallelRanges.push_back({ rangeBegin, count });
+    }
+
+    m_isPartitionDirty = false;
+}
+
+void TransformHierarchy::Reorder(std::span<const uint32_t> order) {
+    std::vector<uint32_t> newIndices(m_parents.size(), NoParent);
+
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        newIndices[order[i]] = i;
+    }
+
+    Permute(m_localTransforms, order);
+    Permute(m_worldTransforms, order);
+    Permute(m_parents, order);
+    Permute(m_subtreeSizes, order);
+    Permute(m_worldVersions, order);
+    Permute(m_flags, order);
+    Permute(m_handles, order);
+
+    for (auto& parent : m_parents) {
+        if (parent != NoParent) {
+            parent = newIndices[parent];
+        }
+    }
+
+    for (uint32_t i = 0; i < m_handles.size(); ++i) {
+        m_indices[m_handles[i]] = i;
+    }
+}
+
+void TransformHierarchy::AddToSubtreeSizes(uint32_t index, int32_t count) noexcept {
+    for (auto i = index; i != NoParent; i = m_parents[i]) {
+        m_subtreeSizes[i] += count;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "Core/Math/Affine3x4.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Cyrex {
+    class JobSystem;
+
+    //The transforms of a scene graph in flat arrays, stored depth first so every parent comes
+    //before its children and every subtree is one contiguous range. Update walks the arrays once
+    //from the front, the parent's world transform is always computed and usually still in cache.
+    //Nodes are addressed by handles, which stay valid while the arrays are reordered.
+    class TransformHierarchy {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle InvalidHandle = UINT32_MAX;
+
+        TransformHierarchy() = default;
+        TransformHierarchy(const TransformHierarchy& rhs) = delete;
+        TransformHierarchy& operator=(const TransformHierarchy& rhs) = delete;
+
+        //Appends when the parent's subtree ends the arrays, so creating the nodes depth first
+        //(the order a scene is imported in) never moves any. Otherwise it is O(nodes).
+        Handle Create(const Cyrex::Math::Affine3x4& localTransform, Handle parent = InvalidHandle);
+
+        //Destroys the node and its descendants
+        void Destroy(Handle node);
+
+        //Keeps the local transform, InvalidHandle makes the node a root. O(nodes).
+        void SetParent(Handle node, Handle parent);
+
+        void SetLocalTransform(Handle node, const Cyrex::Math::Affine3x4& localTransform) noexcept;
+
+        [[nodiscard]] const Cyrex::Math::Affine3x4& GetLocalTransform(Handle node) const noexcept;
+        [[nodiscard]] Handle GetParent(Handle node) const noexcept;
+
+        //As of the last Update
+        [[nodiscard]] const Cyrex::Math::Affine3x4& GetWorldTransform(Handle node) const noexcept;
+        [[nodiscard]] uint64_t GetWorldVersion(Handle node) const noexcept;
+
+        //Recomputes the world transforms of the changed nodes and their descendants
+        void Update() noexcept;
+
+        //The same, with the subtrees spread over the workers. Subtrees too large for one worker
+        //are split below their root, which is updated on the calling thread first.
+        void Update(JobSystem& jobSystem);
+
+        [[nodiscard]] size_t GetNumNodes() const noexcept { return m_parents.size(); }
+    private:
+        static constexpr uint32_t NoParent = UINT32_MAX;
+
+        //Nodes a worker gets at least, unless the hierarchy is smaller
+        static constexpr uint32_t ParallelGrain = 1024;
+
+        enum Flags : uint8_t {
+            LocalChanged = 1 << 0,
+            WorldChanged = 1 << 1
+        };
+
+        struct Range {
+            uint32_t Begin;
+            uint32_t End;
+        };
+
+        void UpdateRange(uint32_t begin, uint32_t end) noexcept;
+        void Partition();
+
+        //order[newIndex] is the node's old index, nodes left out are dropped
+        void Reorder(std::span<const uint32_t> order);
+        void AddToSubtreeSizes(uint32_t index, int32_t count) noexcept;
+
+        //Indexed by position in depth first order
+        std::vector<Cyrex::Math::Affine3x4> m_localTransforms;
+        std::vector<Cyrex::Math::Affine3x4> m_worldTransforms;
+        std::vector<uint32_t> m_parents;
+        std::vector<uint32_t> m_subtreeSizes;
+        std::vector<uint64_t> m_worldVersions;
+        std::vector<uint8_t> m_flags;
+        std::vector<Handle> m_handles;
+
+        //Indexed by handle
+        std::vector<uint32_t> m_indices;
+        std::vector<Handle> m_freeHandles;
+
+        //The split Update(JobSystem&) uses, rebuilt after the hierarchy changed shape
+        std::vector<uint32_t> m_sequentialNodes;
+        std::vector<Range> m_parallelRanges;
+        bool m_isPartitionDirty{ true };
+    };
+}